@@ -76,6 +76,10 @@ int LogIOWorker::init(const LogIOWorkerConfig &config,
                                              allocator,
                                              &wait_cost_stat_))) {
     PALF_LOG(ERROR, "BatchLogIOFlushLogTaskMgr init failed", K(ret), K(config));
+  // NB: the LogIOWorker of sys log streams has few palf instances, no need to flush parallelly.
+  } else if (0 < config.flush_parallelism_ && !need_igore_throttle
+      && OB_FAIL(flush_helper_.init(config.flush_parallelism_))) {
+    PALF_LOG(ERROR, "ParallelFlushHelper init failed", K(ret), K(config));
   } else {
     share::ObThreadPool::set_run_wrapper(MTL_CTX());
     log_io_worker_num_ = config.io_worker_num_;
@@ -120,6 +124,30 @@ void LogIOWorker::destroy()
   log_io_worker_num_ = -1;
   queue_.destroy();
   batch_io_task_mgr_.destroy();
+  flush_helper_.destroy();
+}
+
+int LogIOWorker::start()
+{
+  int ret = OB_SUCCESS;
+  if (flush_helper_.is_inited() && OB_FAIL(flush_helper_.start())) {
+    PALF_LOG(ERROR, "start ParallelFlushHelper failed", K(ret));
+  } else if (OB_FAIL(share::ObThreadPool::start())) {
+    PALF_LOG(ERROR, "start LogIOWorker failed", K(ret));
+  }
+  return ret;
+}
+
+void LogIOWorker::stop()
+{
+  share::ObThreadPool::stop();
+  flush_helper_.stop();
+}
+
+void LogIOWorker::wait()
+{
+  share::ObThreadPool::wait();
+  flush_helper_.wait();
 }
 
 int LogIOWorker::submit_io_task(LogIOTask *io_task)
@@ -319,7 +347,7 @@ int LogIOWorker::reduce_io_task_(void *task)
     }
   }
 
-  if (OB_FAIL(batch_io_task_mgr_.handle(cb_thread_pool_tg_id_, palf_env_impl_))) {
+  if (OB_FAIL(batch_io_task_mgr_.handle(cb_thread_pool_tg_id_, palf_env_impl_, &flush_helper_))) {
     PALF_LOG(WARN, "batch_io_task_mgr_ handle failed", K(ret), K(batch_io_task_mgr_));
   }
 
@@ -357,8 +385,11 @@ int LogIOWorker::BatchLogIOFlushLogTaskMgr::init(int64_t batch_width,
 {
   int ret = OB_SUCCESS;
   batch_io_task_array_.set_allocator(allocator);
+  ret_array_.set_allocator(allocator);
   if (OB_FAIL(batch_io_task_array_.init(batch_width))) {
     PALF_LOG(ERROR, "batch_io_task_array_ init failed", K(ret));
+  } else if (OB_FAIL(ret_array_.prepare_allocate(batch_width))) {
+    PALF_LOG(ERROR, "ret_array_ init failed", K(ret));
   } else {
     for (int i = 0; i < batch_width  && OB_SUCC(ret); i++) {
       bool last_io_task_push_success = false;
@@ -406,6 +437,7 @@ void LogIOWorker::BatchLogIOFlushLogTaskMgr::destroy()
   }
   wait_cost_stat_ = NULL;
   batch_io_task_array_.destroy();
+  ret_array_.destroy();
 }
 
 int LogIOWorker::BatchLogIOFlushLogTaskMgr::insert(LogIOFlushLogTask *io_task)
@@ -422,7 +454,9 @@ int LogIOWorker::BatchLogIOFlushLogTaskMgr::insert(LogIOFlushLogTask *io_task)
   return ret;
 }
 
-int LogIOWorker::BatchLogIOFlushLogTaskMgr::handle(const int64_t tg_id, IPalfEnvImpl *palf_env_impl)
+int LogIOWorker::BatchLogIOFlushLogTaskMgr::handle(const int64_t tg_id,
+                                                   IPalfEnvImpl *palf_env_impl,
+                                                   ParallelFlushHelper *flush_helper)
 {
   int ret = OB_SUCCESS;
   const int64_t count = batch_io_task_array_.count() - usable_count_;
@@ -430,15 +464,30 @@ int LogIOWorker::BatchLogIOFlushLogTaskMgr::handle(const int64_t tg_id, IPalfEnv
   // even if execute 'do_task_' for one of LogIOFlushLogTask failed, we need
   // execute 'do_task_' for next LogIOFlushLogTask.
   const int64_t first_handle_ts = ObTimeUtility::fast_current_time();
+  const bool need_parallel_flush = count > 1 && OB_NOT_NULL(flush_helper) && flush_helper->is_inited();
   for (int64_t i = 0; i < count; i++) {
+    ret_array_[i] = OB_SUCCESS;
     BatchLogIOFlushLogTask *io_task = batch_io_task_array_[i];
     if (OB_ISNULL(io_task)) {
-      ret = OB_ERR_UNEXPECTED;
+      ret_array_[i] = OB_ERR_UNEXPECTED;
       PALF_LOG(ERROR, "BatchLogIOFlushLogTask in batch_io_task_array_ is nullptr, unexpected error!!!",
                K(ret), KP(io_task), K(i));
-    } else if (OB_FAIL(statistics_wait_cost_(first_handle_ts, io_task))) {
-      PALF_LOG(WARN, "do statistics failed", K(ret));
-    } else if (OB_FAIL(io_task->do_task(tg_id, palf_env_impl))) {
+    } else if (OB_SUCCESS != (ret_array_[i] = statistics_wait_cost_(first_handle_ts, io_task))) {
+      PALF_LOG(WARN, "do statistics failed", "ret", ret_array_[i]);
+    } else if (!need_parallel_flush) {
+      ret_array_[i] = io_task->do_task(tg_id, palf_env_impl);
+    }
+  }
+  // the tasks which failed above are skipped by 'flush_helper'.
+  if (need_parallel_flush
+      && OB_FAIL(flush_helper->do_tasks(&batch_io_task_array_[0], count, tg_id, palf_env_impl,
+                                        &ret_array_[0]))) {
+    PALF_LOG(ERROR, "ParallelFlushHelper do_tasks failed", K(ret), K(count));
+  }
+  for (int64_t i = 0; i < count; i++) {
+    BatchLogIOFlushLogTask *io_task = batch_io_task_array_[i];
+    if (OB_SUCCESS != ret_array_[i]) {
+      ret = ret_array_[i];
       PALF_LOG(WARN, "do_task failed", K(ret), KP(io_task));
     } else {
       if (OB_NOT_NULL(wait_cost_stat_)) {
@@ -502,6 +551,158 @@ int LogIOWorker::BatchLogIOFlushLogTaskMgr::find_usable_batch_io_task_(
   return ret;
 }
 
+LogIOWorker::ParallelFlushHelper::ParallelFlushHelper()
+  : cond_(),
+    thread_num_(0),
+    task_seq_(0),
+    tasks_(NULL),
+    rets_(NULL),
+    count_(0),
+    next_idx_(0),
+    finished_count_(0),
+    active_helper_count_(0),
+    tg_id_(-1),
+    palf_env_impl_(NULL),
+    is_inited_(false)
+{}
+
+LogIOWorker::ParallelFlushHelper::~ParallelFlushHelper()
+{
+  destroy();
+}
+
+int LogIOWorker::ParallelFlushHelper::init(const int64_t thread_num)
+{
+  int ret = OB_SUCCESS;
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    PALF_LOG(ERROR, "ParallelFlushHelper init twice", K(ret));
+  } else if (0 >= thread_num) {
+    ret = OB_INVALID_ARGUMENT;
+    PALF_LOG(ERROR, "invalid argument", K(ret), K(thread_num));
+  } else if (OB_FAIL(cond_.init(ObWaitEventIds::DEFAULT_COND_WAIT))) {
+    PALF_LOG(ERROR, "cond_ init failed", K(ret));
+  } else if (OB_FAIL(set_thread_count(thread_num))) {
+    PALF_LOG(ERROR, "set_thread_count failed", K(ret), K(thread_num));
+  } else {
+    share::ObThreadPool::set_run_wrapper(MTL_CTX());
+    thread_num_ = thread_num;
+    is_inited_ = true;
+    PALF_LOG(INFO, "ParallelFlushHelper init success", K(ret), KPC(this));
+  }
+  return ret;
+}
+
+void LogIOWorker::ParallelFlushHelper::destroy()
+{
+  if (IS_INIT) {
+    share::ObThreadPool::stop();
+    share::ObThreadPool::wait();
+    share::ObThreadPool::destroy();
+    cond_.destroy();
+  }
+  is_inited_ = false;
+  thread_num_ = 0;
+  task_seq_ = 0;
+  tasks_ = NULL;
+  rets_ = NULL;
+  count_ = 0;
+  next_idx_ = 0;
+  finished_count_ = 0;
+  active_helper_count_ = 0;
+  tg_id_ = -1;
+  palf_env_impl_ = NULL;
+}
+
+void LogIOWorker::ParallelFlushHelper::run1()
+{
+  lib::set_thread_name("IOWorkerHelper");
+  int64_t handled_seq = 0;
+  while (!has_set_stop()) {
+    bool has_task = false;
+    {
+      ObThreadCondGuard guard(cond_);
+      if (handled_seq == task_seq_) {
+        (void)cond_.wait(IDLE_WAIT_TIME_MS);
+      }
+      if (handled_seq != task_seq_) {
+        handled_seq = task_seq_;
+        active_helper_count_++;
+        has_task = true;
+      }
+    }
+    if (has_task) {
+      consume_();
+      ObThreadCondGuard guard(cond_);
+      if (0 == --active_helper_count_) {
+        (void)cond_.broadcast();
+      }
+    }
+  }
+}
+
+void LogIOWorker::ParallelFlushHelper::consume_()
+{
+  int64_t idx = 0;
+  while ((idx = ATOMIC_FAA(&next_idx_, 1)) < count_) {
+    BatchLogIOFlushLogTask *io_task = tasks_[idx];
+    if (OB_SUCCESS == rets_[idx]) {
+      rets_[idx] = io_task->do_task(tg_id_, palf_env_impl_);
+    }
+    if (count_ == ATOMIC_AAF(&finished_count_, 1)) {
+      ObThreadCondGuard guard(cond_);
+      (void)cond_.broadcast();
+    }
+  }
+}
+
+int LogIOWorker::ParallelFlushHelper::do_tasks(BatchLogIOFlushLogTask **tasks,
+                                               const int64_t count,
+                                               const int tg_id,
+                                               IPalfEnvImpl *palf_env_impl,
+                                               int *rets)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+  } else {
+    // helpers of the last round must have left consume_() before the task
+    // array is replaced, otherwise they may claim a task twice.
+    ObThreadCondGuard guard(cond_);
+    if (OB_FAIL(guard.get_ret())) {
+      PALF_LOG(ERROR, "lock cond_ failed", K(ret));
+    } else {
+      while (0 < active_helper_count_) {
+        (void)cond_.wait(IDLE_WAIT_TIME_MS);
+      }
+      tasks_ = tasks;
+      rets_ = rets;
+      tg_id_ = tg_id;
+      palf_env_impl_ = palf_env_impl;
+      count_ = count;
+      ATOMIC_STORE(&finished_count_, 0);
+      ATOMIC_STORE(&next_idx_, 0);
+      task_seq_++;
+      (void)cond_.broadcast();
+    }
+  }
+  if (OB_SUCC(ret)) {
+    // LogIOWorker thread flushes together with the helpers.
+    consume_();
+    ObThreadCondGuard guard(cond_);
+    while (ATOMIC_LOAD(&finished_count_) < count) {
+      (void)cond_.wait(IDLE_WAIT_TIME_MS);
+    }
+  } else {
+    for (int64_t i = 0; i < count; i++) {
+      if (OB_SUCCESS == rets[i]) {
+        rets[i] = tasks[i]->do_task(tg_id, palf_env_impl);
+      }
+    }
+  }
+  return ret;
+}
+
 int64_t LogIOWorker::inc_and_fetch_purge_throttling_submitted_seq_()
 {
   return ATOMIC_AAF(&purge_throttling_task_submitted_seq_, 1);
@@ -21,6 +21,7 @@
 #include "lib/container/ob_fixed_array.h"           // ObSEArrayy
 #include "lib/hash/ob_array_hash_map.h"             // ObArrayHashMap
 #include "lib/atomic/ob_atomic.h"                   // ATOMIC_LOAD
+#include "lib/lock/ob_thread_cond.h"                // ObThreadCond
 #include "lib/function/ob_function.h"               // ObFunction
 #include "share/ob_thread_pool.h"                   // ObThreadPool
 #include "common/ob_clock_generator.h"              // ObClockGenerator
@@ -51,7 +52,8 @@ struct LogIOWorkerConfig
   }
   bool is_valid() const
   {
-    return 0 < io_worker_num_ && 0 < io_queue_capcity_ && 0 <= batch_width_ && 0 <= batch_depth_;
+    return 0 < io_worker_num_ && 0 < io_queue_capcity_ && 0 <= batch_width_ && 0 <= batch_depth_
+        && 0 <= flush_parallelism_;
   }
   void reset()
   {
@@ -59,12 +61,17 @@ struct LogIOWorkerConfig
     io_queue_capcity_ = 0;
     batch_width_ = 0;
     batch_depth_ = 0;
+    flush_parallelism_ = 0;
   }
   int64_t io_worker_num_;
   int64_t io_queue_capcity_;
   int64_t batch_width_;
   int64_t batch_depth_;
-  TO_STRING_KV(K_(io_worker_num), K_(io_queue_capcity), K_(batch_width), K_(batch_depth));
+  // the number of helper threads of each LogIOWorker which flush the logs of
+  // different palf instances in one batch concurrently, 0 means flushing serially.
+  int64_t flush_parallelism_;
+  TO_STRING_KV(K_(io_worker_num), K_(io_queue_capcity), K_(batch_width), K_(batch_depth),
+               K_(flush_parallelism));
 };
 
 class LogIOWorker : public share::ObThreadPool
@@ -80,6 +87,9 @@ public:
            const bool need_ignore_throttle,
            IPalfEnvImpl *palf_env_impl);
   void destroy();
+  int start() override final;
+  void stop() override final;
+  void wait() override final;
 
   void run1() override final;
   int submit_io_task(LogIOTask *io_task);
@@ -102,6 +112,45 @@ private:
   static constexpr int64_t QUEUE_WAIT_TIME = 100 * 1000;
 private:
 
+  // Each BatchLogIOFlushLogTask writes the logs of one palf instance with
+  // O_DIRECT | O_SYNC, flushing them one by one costs a sync latency per palf
+  // instance. ParallelFlushHelper executes the BatchLogIOFlushLogTasks of one
+  // batch with the LogIOWorker thread and its helper threads together, so the
+  // writes to different block files overlap in the disk queue.
+  class ParallelFlushHelper : public share::ObThreadPool {
+  public:
+    ParallelFlushHelper();
+    ~ParallelFlushHelper();
+    int init(const int64_t thread_num);
+    void destroy();
+    void run1() override final;
+    // return after all tasks have been executed, ret of each task is saved in 'rets'.
+    int do_tasks(BatchLogIOFlushLogTask **tasks,
+                 const int64_t count,
+                 const int tg_id,
+                 IPalfEnvImpl *palf_env_impl,
+                 int *rets);
+    bool is_inited() const { return is_inited_; }
+    TO_STRING_KV(K_(thread_num), K_(task_seq), K_(count), K_(next_idx), K_(finished_count),
+                 K_(active_helper_count));
+  private:
+    void consume_();
+  private:
+    static constexpr int64_t IDLE_WAIT_TIME_MS = 100;
+    common::ObThreadCond cond_;
+    int64_t thread_num_;
+    int64_t task_seq_;
+    BatchLogIOFlushLogTask **tasks_;
+    int *rets_;
+    int64_t count_;
+    int64_t next_idx_;
+    int64_t finished_count_;
+    int64_t active_helper_count_;
+    int tg_id_;
+    IPalfEnvImpl *palf_env_impl_;
+    bool is_inited_;
+  };
+
   class BatchLogIOFlushLogTaskMgr {
   public:
     BatchLogIOFlushLogTaskMgr();
@@ -109,7 +158,7 @@ private:
     int init(int64_t batch_width, int64_t batch_depth, ObIAllocator *allocator, ObMiniStat::ObStatItem *wait_cost_stat);
     void destroy();
     int insert(LogIOFlushLogTask *io_task);
-    int handle(const int64_t tg_id, IPalfEnvImpl *palf_env_impl);
+    int handle(const int64_t tg_id, IPalfEnvImpl *palf_env_impl, ParallelFlushHelper *flush_helper);
     bool empty();
     TO_STRING_KV(K_(batch_io_task_array), K_(usable_count), K_(batch_width));
   private:
@@ -118,6 +167,7 @@ private:
   private:
     typedef ObFixedArray<BatchLogIOFlushLogTask *, common::ObIAllocator> BatchLogIOFlushLogTaskArray;
     BatchLogIOFlushLogTaskArray batch_io_task_array_;
+    ObFixedArray<int, common::ObIAllocator> ret_array_;
     int64_t handle_count_;
     int64_t usable_count_;
     int64_t batch_width_;
@@ -136,6 +186,7 @@ private:
   IPalfEnvImpl *palf_env_impl_;
   ObLightyQueue queue_;
   BatchLogIOFlushLogTaskMgr batch_io_task_mgr_;
+  ParallelFlushHelper flush_helper_;
   int64_t do_task_used_ts_;
   int64_t do_task_count_;
   int64_t print_log_interval_;
@@ -231,6 +231,7 @@ int PalfEnvImpl::init(
     PALF_LOG(ERROR, "invalid arguments", K(ret), KP(transport), KP(batch_rpc), K(base_dir), K(self), KP(transport),
              KP(log_alloc_mgr), KP(log_block_pool), KP(monitor));
   } else if (OB_FAIL(init_log_io_worker_config_(options.disk_options_.log_writer_parallelism_,
+                                                options.disk_options_.log_writer_flush_parallelism_,
                                                 tenant_id,
                                                 log_io_worker_config_))) {
     PALF_LOG(WARN, "init_log_io_worker_config_ failed", K(options));
@@ -1382,6 +1383,7 @@ void PalfEnvImpl::period_calc_disk_usage()
 }
 
 int PalfEnvImpl::init_log_io_worker_config_(const int log_writer_parallelism,
+                                            const int log_writer_flush_parallelism,
                                             const int64_t tenant_id,
                                             LogIOWorkerConfig &config)
 {
@@ -1405,6 +1407,7 @@ int PalfEnvImpl::init_log_io_worker_config_(const int log_writer_parallelism,
   // a balanced state.
   constexpr int64_t default_min_io_queue_cap = PALF_SLIDING_WINDOW_SIZE * 2;
   constexpr int64_t default_min_batch_width = 1;
+  constexpr int64_t default_io_batch_width_per_flush_thread = 4;
   // Assume that a maximum of 100 * 1024 I/O tasks exist simultaneously in single PalfEnvImpl
   config.io_worker_num_ = real_log_writer_parallelism;
   config.io_queue_capcity_ = MAX(default_min_io_queue_cap,
@@ -1412,7 +1415,15 @@ int PalfEnvImpl::init_log_io_worker_config_(const int log_writer_parallelism,
   config.batch_width_ = MAX(default_min_batch_width,
                             tmp_upper_align_div(default_io_batch_width, real_log_writer_parallelism));
   config.batch_depth_ = PALF_SLIDING_WINDOW_SIZE;
-  PALF_LOG(INFO, "init_log_io_worker_config_ success", K(config), K(tenant_id), K(log_writer_parallelism));
+  // When the BatchLogIOFlushLogTasks of one batch are flushed parallelly, a wider batch
+  // let more palf instances share the sync latency of one round.
+  config.flush_parallelism_ = is_user_tenant(tenant_id) ? log_writer_flush_parallelism : 0;
+  if (0 < config.flush_parallelism_) {
+    config.batch_width_ = MAX(config.batch_width_,
+                              default_io_batch_width_per_flush_thread * (config.flush_parallelism_ + 1));
+  }
+  PALF_LOG(INFO, "init_log_io_worker_config_ success", K(config), K(tenant_id), K(log_writer_parallelism),
+           K(log_writer_flush_parallelism));
   return ret;
 }
 
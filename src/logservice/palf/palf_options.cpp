@@ -41,6 +41,7 @@ void PalfDiskOptions::reset()
   log_disk_throttling_percentage_ = -1;
   log_disk_throttling_maximum_duration_ = -1;
   log_writer_parallelism_ = -1;
+  log_writer_flush_parallelism_ = 0;
 }
 
 bool PalfDiskOptions::is_valid() const
@@ -55,7 +56,8 @@ bool PalfDiskOptions::is_valid() const
     && log_disk_throttling_percentage_ <= 100
     && log_disk_throttling_maximum_duration_ >= MIN_DURATION
     && log_disk_throttling_maximum_duration_ <= MAX_DURATION
-    && log_writer_parallelism_ >= 1 && log_writer_parallelism_ <= 8;
+    && log_writer_parallelism_ >= 1 && log_writer_parallelism_ <= 8
+    && log_writer_flush_parallelism_ >= 0 && log_writer_flush_parallelism_ <= 16;
 }
 
 bool PalfDiskOptions::operator==(const PalfDiskOptions &palf_disk_options) const
@@ -65,7 +67,8 @@ bool PalfDiskOptions::operator==(const PalfDiskOptions &palf_disk_options) const
     && log_disk_utilization_limit_threshold_ == palf_disk_options.log_disk_utilization_limit_threshold_
     && log_disk_throttling_percentage_ == palf_disk_options.log_disk_throttling_percentage_
     && log_disk_throttling_maximum_duration_ == palf_disk_options.log_disk_throttling_maximum_duration_
-    && log_writer_parallelism_ == palf_disk_options.log_writer_parallelism_;
+    && log_writer_parallelism_ == palf_disk_options.log_writer_parallelism_
+    && log_writer_flush_parallelism_ == palf_disk_options.log_writer_flush_parallelism_;
 }
 
 bool PalfDiskOptions::operator!=(const PalfDiskOptions &palf_disk_options) const
@@ -81,6 +84,7 @@ PalfDiskOptions &PalfDiskOptions::operator=(const PalfDiskOptions &other)
   log_disk_throttling_percentage_ = other.log_disk_throttling_percentage_;
   log_disk_throttling_maximum_duration_ = other.log_disk_throttling_maximum_duration_;
   log_writer_parallelism_ = other.log_writer_parallelism_;
+  log_writer_flush_parallelism_ = other.log_writer_flush_parallelism_;
   return *this;
 }
 
@@ -351,6 +351,12 @@ public:
     ICMP_SLE, //< signed less or equal
   };
 
+  enum OVERFLOWTYPE {
+    SADD_OVERFLOW, //< signed add with overflow
+    SSUB_OVERFLOW, //< signed sub with overflow
+    SMUL_OVERFLOW, //< signed mul with overflow
+  };
+
 public:
   ObLLVMHelper(common::ObIAllocator &allocator)
     : is_inited_(false),
@@ -401,6 +407,18 @@ public:
   int create_add(ObLLVMValue &value1, int64_t &value2, ObLLVMValue &result);
   int create_sub(ObLLVMValue &value1, ObLLVMValue &value2, ObLLVMValue &result);
   int create_sub(ObLLVMValue &value1, int64_t &value2, ObLLVMValue &result);
+  int create_mul(ObLLVMValue &value1, ObLLVMValue &value2, ObLLVMValue &result);
+  int create_mul(ObLLVMValue &value1, int64_t &value2, ObLLVMValue &result);
+  int create_and(ObLLVMValue &value1, ObLLVMValue &value2, ObLLVMValue &result);
+  int create_or(ObLLVMValue &value1, ObLLVMValue &value2, ObLLVMValue &result);
+  int create_xor(ObLLVMValue &value1, ObLLVMValue &value2, ObLLVMValue &result);
+  int create_shl(ObLLVMValue &value1, ObLLVMValue &value2, ObLLVMValue &result);
+  int create_lshr(ObLLVMValue &value1, ObLLVMValue &value2, ObLLVMValue &result);
+  int create_not(ObLLVMValue &value, ObLLVMValue &result);
+  // result = arith(value1, value2), overflow is set to i1 true if the signed result overflowed
+  int create_with_overflow(ObLLVMValue &value1, ObLLVMValue &value2, OVERFLOWTYPE type,
+                           ObLLVMValue &result, ObLLVMValue &overflow);
+  int create_select(ObLLVMValue &cond, ObLLVMValue &true_value, ObLLVMValue &false_value, ObLLVMValue &result);
   int create_ret(ObLLVMValue &value);
   int create_gep(const common::ObString &name, ObLLVMValue &value, common::ObIArray<int64_t> &idxs, ObLLVMValue &result);
   int create_gep(const common::ObString &name, ObLLVMValue &value, common::ObIArray<ObLLVMValue> &idxs, ObLLVMValue &result);
@@ -415,6 +433,8 @@ public:
   int create_addr_space_cast(const common::ObString &name, const ObLLVMValue &value, const ObLLVMType &type, ObLLVMValue &result);
   int create_sext(const common::ObString &name, const ObLLVMValue &value, const ObLLVMType &type, ObLLVMValue &result);
   int create_sext_or_bitcast(const common::ObString &name, const ObLLVMValue &value, const ObLLVMType &type, ObLLVMValue &result);
+  int create_zext(const common::ObString &name, const ObLLVMValue &value, const ObLLVMType &type, ObLLVMValue &result);
+  int create_trunc(const common::ObString &name, const ObLLVMValue &value, const ObLLVMType &type, ObLLVMValue &result);
   int create_landingpad(const common::ObString &name, ObLLVMType &type, ObLLVMLandingPad &result);
   int create_switch(ObLLVMValue &value, ObLLVMBasicBlock &default_block, ObLLVMSwitch &result);
   int create_resume(ObLLVMValue &value);
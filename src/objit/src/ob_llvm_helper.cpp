@@ -1341,8 +1341,136 @@ int ObLLVMHelper::create_##name(ObLLVMValue &value1, int64_t &value2, ObLLVMValu
   return ret; \
 }
 
+#define DEFINE_CREATE_BINARY(func_name, inst_name) \
+int ObLLVMHelper::func_name(ObLLVMValue &value1, ObLLVMValue &value2, ObLLVMValue &result) \
+{ \
+  int ret = OB_SUCCESS; \
+  if (OB_ISNULL(jc_)) { \
+    ret = OB_NOT_INIT; \
+    LOG_WARN("jc is NULL", K(ret)); \
+  } else if (OB_ISNULL(value1.get_v()) || OB_ISNULL(value2.get_v())) { \
+    ret = OB_INVALID_ARGUMENT; \
+    LOG_WARN("value is NULL", K(value1), K(value2), K(ret)); \
+  } else { \
+    llvm::Value *value = jc_->get_builder().Create##inst_name(value1.get_v(), value2.get_v()); \
+    if (OB_ISNULL(value)) { \
+      ret = OB_ERR_UNEXPECTED; \
+      LOG_WARN("failed to " #func_name, K(ret)); \
+    } else { \
+      result.set_v(value); \
+    } \
+  } \
+  return ret; \
+}
+
+DEFINE_CREATE_BINARY(create_mul, Mul)
+DEFINE_CREATE_BINARY(create_and, And)
+DEFINE_CREATE_BINARY(create_or, Or)
+DEFINE_CREATE_BINARY(create_xor, Xor)
+DEFINE_CREATE_BINARY(create_shl, Shl)
+DEFINE_CREATE_BINARY(create_lshr, LShr)
+
 DEFINE_CREATE_ARITH_INT(add)
 DEFINE_CREATE_ARITH_INT(sub)
+DEFINE_CREATE_ARITH_INT(mul)
+
+int ObLLVMHelper::create_not(ObLLVMValue &value, ObLLVMValue &result)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(jc_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("jc is NULL", K(ret));
+  } else if (OB_ISNULL(value.get_v())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("value is NULL", K(value), K(ret));
+  } else {
+    llvm::Value *not_value = jc_->get_builder().CreateNot(value.get_v());
+    if (OB_ISNULL(not_value)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("failed to create not", K(ret));
+    } else {
+      result.set_v(not_value);
+    }
+  }
+  return ret;
+}
+
+int ObLLVMHelper::create_with_overflow(ObLLVMValue &value1,
+                                       ObLLVMValue &value2,
+                                       OVERFLOWTYPE type,
+                                       ObLLVMValue &result,
+                                       ObLLVMValue &overflow)
+{
+  int ret = OB_SUCCESS;
+  llvm::Intrinsic::ID id = llvm::Intrinsic::not_intrinsic;
+  if (OB_ISNULL(jc_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("jc is NULL", K(ret));
+  } else if (OB_ISNULL(value1.get_v()) || OB_ISNULL(value2.get_v())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("value is NULL", K(value1), K(value2), K(ret));
+  } else {
+    switch (type) {
+    case SADD_OVERFLOW: {
+      id = llvm::Intrinsic::sadd_with_overflow;
+    }
+    break;
+    case SSUB_OVERFLOW: {
+      id = llvm::Intrinsic::ssub_with_overflow;
+    }
+    break;
+    case SMUL_OVERFLOW: {
+      id = llvm::Intrinsic::smul_with_overflow;
+    }
+    break;
+    default: {
+      ret = OB_INVALID_ARGUMENT;
+      LOG_WARN("invalid overflow type", K(type), K(ret));
+    }
+    break;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    llvm::Value *pair = jc_->get_builder().CreateCall(
+      llvm::Intrinsic::getDeclaration(&(jc_->get_module()), id, value1.get_v()->getType()),
+      {value1.get_v(), value2.get_v()});
+    if (OB_ISNULL(pair)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("failed to call arith with overflow", K(type), K(ret));
+    } else {
+      result.set_v(jc_->get_builder().CreateExtractValue(pair, 0));
+      overflow.set_v(jc_->get_builder().CreateExtractValue(pair, 1));
+    }
+  }
+  return ret;
+}
+
+int ObLLVMHelper::create_select(ObLLVMValue &cond,
+                                ObLLVMValue &true_value,
+                                ObLLVMValue &false_value,
+                                ObLLVMValue &result)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(jc_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("jc is NULL", K(ret));
+  } else if (OB_ISNULL(cond.get_v())
+             || OB_ISNULL(true_value.get_v())
+             || OB_ISNULL(false_value.get_v())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("value is NULL", K(cond), K(true_value), K(false_value), K(ret));
+  } else {
+    llvm::Value *value = jc_->get_builder().CreateSelect(
+        cond.get_v(), true_value.get_v(), false_value.get_v());
+    if (OB_ISNULL(value)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("failed to create select", K(ret));
+    } else {
+      result.set_v(value);
+    }
+  }
+  return ret;
+}
 
 int ObLLVMHelper::create_ret(ObLLVMValue &value)
 {
@@ -1528,6 +1656,8 @@ DEFINE_CREATE_CAST(pointer_cast, PointerCast)
 DEFINE_CREATE_CAST(addr_space_cast, AddrSpaceCast)
 DEFINE_CREATE_CAST(sext_or_bitcast, SExtOrBitCast)
 DEFINE_CREATE_CAST(sext, SExt);
+DEFINE_CREATE_CAST(zext, ZExt);
+DEFINE_CREATE_CAST(trunc, Trunc);
 
 int ObLLVMHelper::create_landingpad(const ObString &name, ObLLVMType &type, ObLLVMLandingPad &result)
 {
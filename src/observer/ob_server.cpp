@@ -101,6 +101,7 @@
 #include "storage/ob_file_system_router.h"
 #include "storage/blocksstable/ob_storage_cache_suite.h"
 #include "storage/blocksstable/ob_object_manager.h"
+#include "storage/blocksstable/ob_block_cache_warmer.h"
 #include "storage/tablelock/ob_table_lock_rpc_client.h"
 #include "storage/compaction/ob_compaction_diagnose.h"
 #include "storage/meta_mem/ob_tenant_meta_mem_mgr.h"
@@ -768,6 +769,10 @@ void ObServer::destroy()
     TG_DESTROY(lib::TGDefIDs::DiskUseReport);
     FLOG_INFO("disk usage report task destroyed");
 
+    FLOG_INFO("begin to destroy block cache warmer");
+    OB_BLOCK_CACHE_WARMER.destroy();
+    FLOG_INFO("block cache warmer destroyed");
+
     FLOG_INFO("begin to destroy store cache");
     OB_STORE_CACHE.destroy();
     FLOG_INFO("store cache destroyed");
@@ -1145,6 +1150,12 @@ int ObServer::start()
       FLOG_INFO("success to start location service");
     }
 
+    if (FAILEDx(OB_BLOCK_CACHE_WARMER.start())) {
+      LOG_ERROR("fail to start block cache warmer", KR(ret));
+    } else {
+      FLOG_INFO("success to start block cache warmer");
+    }
+
 #ifdef OB_BUILD_ARBITRATION
     if (FAILEDx(arb_gcs_.start())) {
       LOG_ERROR("start arb_gcs_ failed", KR(ret));
@@ -1523,6 +1534,10 @@ int ObServer::stop()
     location_service_.stop();
     FLOG_INFO("location service stopped");
 
+    FLOG_INFO("begin to stop block cache warmer");
+    OB_BLOCK_CACHE_WARMER.stop();
+    FLOG_INFO("block cache warmer stopped");
+
     FLOG_INFO("begin to stop timer monitor");
     ObTimerMonitor::get_instance().stop();
     FLOG_INFO("timer monitor stopped");
@@ -1950,6 +1965,10 @@ int ObServer::wait()
     location_service_.wait();
     FLOG_INFO("wait location service success");
 
+    FLOG_INFO("begin to wait block cache warmer");
+    OB_BLOCK_CACHE_WARMER.wait();
+    FLOG_INFO("wait block cache warmer success");
+
     FLOG_INFO("begin to wait ts mgr");
     OB_TS_MGR.wait();
     FLOG_INFO("wait ts mgr success");
@@ -3089,6 +3108,8 @@ int ObServer::init_storage()
                                     storage_env_.bf_cache_miss_count_threshold_,
                                     storage_env_.storage_meta_cache_priority_))) {
       LOG_WARN("Fail to init OB_STORE_CACHE, ", KR(ret), K(storage_env_.data_dir_));
+    } else if (OB_FAIL(OB_BLOCK_CACHE_WARMER.init(storage_env_.data_dir_))) {
+      LOG_WARN("fail to init block cache warmer", KR(ret), K(storage_env_.data_dir_));
     } else if (OB_FAIL(OB_STORAGE_OBJECT_MGR.init(
         GCTX.is_shared_storage_mode(), storage_env_.default_block_size_))) {
       LOG_ERROR("init storage object mgr fail", KR(ret));
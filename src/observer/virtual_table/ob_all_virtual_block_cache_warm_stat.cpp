@@ -0,0 +1,219 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "observer/virtual_table/ob_all_virtual_block_cache_warm_stat.h"
+#include "storage/blocksstable/ob_storage_cache_suite.h"
+
+namespace oceanbase
+{
+using namespace blocksstable;
+namespace observer
+{
+
+ObAllVirtualBlockCacheWarmStat::ObAllVirtualBlockCacheWarmStat()
+  : ObVirtualTableScannerIterator(),
+    stat_iter_(0),
+    addr_(nullptr),
+    ipstr_(),
+    port_(0),
+    warm_stats_(),
+    str_buf_()
+{
+}
+
+ObAllVirtualBlockCacheWarmStat::~ObAllVirtualBlockCacheWarmStat()
+{
+  reset();
+}
+
+void ObAllVirtualBlockCacheWarmStat::reset()
+{
+  ObVirtualTableScannerIterator::reset();
+  stat_iter_ = 0;
+  addr_ = nullptr;
+  port_ = 0;
+  ipstr_.reset();
+  str_buf_.reset();
+  warm_stats_.reset();
+}
+
+int ObAllVirtualBlockCacheWarmStat::inner_get_next_row(ObNewRow *&row)
+{
+  int ret = OB_SUCCESS;
+
+  row = nullptr;
+  if (OB_UNLIKELY(NULL == allocator_)) {
+    ret = OB_NOT_INIT;
+    SERVER_LOG(WARN, "allocator is NULL", K(ret));
+  } else if (stat_iter_ >= warm_stats_.count()) {
+    ret = OB_ITER_END;
+  } else if (OB_FAIL(process_row(warm_stats_.at(stat_iter_++)))) {
+    SERVER_LOG(WARN, "Fail to process current row", K(ret), K(stat_iter_));
+  } else {
+    row = &cur_row_;
+  }
+
+  return ret;
+}
+
+int ObAllVirtualBlockCacheWarmStat::set_ip()
+{
+  int ret = OB_SUCCESS;
+  char ipbuf[common::OB_IP_STR_BUFF];
+  if (nullptr == addr_) {
+    ret = OB_ENTRY_NOT_EXIST;
+    SERVER_LOG(WARN, "Null address", K(ret), KP(addr_));
+  } else if (!addr_->ip_to_string(ipbuf, sizeof(ipbuf))) {
+    ret = OB_ERR_UNEXPECTED;
+    SERVER_LOG(ERROR, "Fail to cast ip to string", K(ret));
+  } else {
+    ipstr_ = ObString::make_string(ipbuf);
+    port_ = addr_->get_port();
+    if (OB_FAIL(ob_write_string(*allocator_, ipstr_, ipstr_))) {
+      SERVER_LOG(WARN, "Failed to write string", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObAllVirtualBlockCacheWarmStat::inner_open()
+{
+  int ret = OB_SUCCESS;
+
+  warm_stats_.reset();
+  if (OB_FAIL(set_ip())) {
+    SERVER_LOG(WARN, "Fail to get ip in ObAllVirtualBlockCacheWarmStat", K(ret));
+  } else if (OB_FAIL(OB_BLOCK_CACHE_WARMER.get_warm_stats(warm_stats_))) {
+    SERVER_LOG(WARN, "Fail to get block cache warm stats", K(ret));
+  }
+
+  return ret;
+}
+
+// hit ratio of the cache since the observer started, shows how fast the
+// cache recovers after the warm up
+int ObAllVirtualBlockCacheWarmStat::get_hit_ratio(
+    const uint64_t tenant_id,
+    const bool is_data_block,
+    number::ObNumber &num)
+{
+  int ret = OB_SUCCESS;
+  static const int64_t MAX_DOUBLE_PRINT_SIZE = 64;
+  char buf[MAX_DOUBLE_PRINT_SIZE];
+  memset(buf, 0, MAX_DOUBLE_PRINT_SIZE);
+  const ObDataMicroBlockCache &cache = OB_STORE_CACHE.get_micro_block_cache(is_data_block);
+  const int64_t hit_cnt = cache.get_hit_cnt(tenant_id);
+  const int64_t miss_cnt = cache.get_miss_cnt(tenant_id);
+  const double value = (hit_cnt + miss_cnt) > 0
+      ? static_cast<double>(hit_cnt) / static_cast<double>(hit_cnt + miss_cnt) : 0;
+  if (OB_UNLIKELY(0 > snprintf(buf, MAX_DOUBLE_PRINT_SIZE, "%lf", value))) {
+    ret = OB_IO_ERROR;
+    SERVER_LOG(WARN, "snprintf fail", K(ret), K(errno), KERRNOMSG(errno));
+  } else if (OB_FAIL(num.from(buf, str_buf_))) {
+    SERVER_LOG(WARN, "Fail to cast to number", K(ret), K(buf));
+  }
+  return ret;
+}
+
+int ObAllVirtualBlockCacheWarmStat::process_row(const ObBlockCacheWarmStat &stat)
+{
+  int ret = OB_SUCCESS;
+
+  str_buf_.reset();
+  cur_row_.count_ = reserved_column_cnt_;
+  for (int64_t cell_idx = 0 ; OB_SUCC(ret) && cell_idx < output_column_ids_.count() ; ++cell_idx) {
+    uint64_t col_id = output_column_ids_.at(cell_idx);
+    switch (col_id) {
+      case SVR_IP : {
+        cur_row_.cells_[cell_idx].set_varchar(ipstr_);
+        cur_row_.cells_[cell_idx].set_collation_type(ObCharset::get_default_collation(ObCharset::get_default_charset()));
+        break;
+      }
+      case SVR_PORT : {
+        cur_row_.cells_[cell_idx].set_int(port_);
+        break;
+      }
+      case TENANT_ID : {
+        cur_row_.cells_[cell_idx].set_int(stat.tenant_id_);
+        break;
+      }
+      case STATUS : {
+        cur_row_.cells_[cell_idx].set_varchar(ObBlockCacheWarmStat::get_status_str(stat.status_));
+        cur_row_.cells_[cell_idx].set_collation_type(ObCharset::get_default_collation(ObCharset::get_default_charset()));
+        break;
+      }
+      case SNAPSHOT_TIME : {
+        if (stat.snapshot_ts_ > 0) {
+          cur_row_.cells_[cell_idx].set_timestamp(stat.snapshot_ts_);
+        } else {
+          cur_row_.cells_[cell_idx].set_null();
+        }
+        break;
+      }
+      case TOTAL_BLOCK_COUNT : {
+        cur_row_.cells_[cell_idx].set_int(stat.total_cnt_);
+        break;
+      }
+      case LOADED_BLOCK_COUNT : {
+        cur_row_.cells_[cell_idx].set_int(stat.loaded_cnt_);
+        break;
+      }
+      case SKIPPED_BLOCK_COUNT : {
+        cur_row_.cells_[cell_idx].set_int(stat.skipped_cnt_);
+        break;
+      }
+      case FAILED_BLOCK_COUNT : {
+        cur_row_.cells_[cell_idx].set_int(stat.failed_cnt_);
+        break;
+      }
+      case LOADED_BYTES : {
+        cur_row_.cells_[cell_idx].set_int(stat.loaded_bytes_);
+        break;
+      }
+      case START_TIME : {
+        if (stat.start_ts_ > 0) {
+          cur_row_.cells_[cell_idx].set_timestamp(stat.start_ts_);
+        } else {
+          cur_row_.cells_[cell_idx].set_null();
+        }
+        break;
+      }
+      case FINISH_TIME : {
+        if (stat.finish_ts_ > 0) {
+          cur_row_.cells_[cell_idx].set_timestamp(stat.finish_ts_);
+        } else {
+          cur_row_.cells_[cell_idx].set_null();
+        }
+        break;
+      }
+      case DATA_BLOCK_CACHE_HIT_RATIO :
+      case INDEX_BLOCK_CACHE_HIT_RATIO : {
+        number::ObNumber num;
+        if (OB_FAIL(get_hit_ratio(stat.tenant_id_, DATA_BLOCK_CACHE_HIT_RATIO == col_id, num))) {
+          SERVER_LOG(WARN, "Fail to get hit ratio", K(ret), K(cell_idx), K(col_id));
+        } else {
+          cur_row_.cells_[cell_idx].set_number(num);
+        }
+        break;
+      }
+      default : {
+        ret = OB_ERR_UNEXPECTED;
+        SERVER_LOG(WARN, "Invalid column id", K(ret), K(cell_idx), K(col_id), K(output_column_ids_));
+        break;
+      }
+    }
+  }
+  return ret;
+}
+
+} // observer
+} // oceanbase
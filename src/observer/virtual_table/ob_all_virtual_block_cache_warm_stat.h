@@ -0,0 +1,66 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OB_ALL_VIRTUAL_BLOCK_CACHE_WARM_STAT_H_
+#define OB_ALL_VIRTUAL_BLOCK_CACHE_WARM_STAT_H_
+#include "share/ob_virtual_table_scanner_iterator.h"
+#include "storage/blocksstable/ob_block_cache_warmer.h"
+
+namespace oceanbase
+{
+namespace observer
+{
+
+class ObAllVirtualBlockCacheWarmStat : public common::ObVirtualTableScannerIterator
+{
+public:
+  ObAllVirtualBlockCacheWarmStat();
+  virtual ~ObAllVirtualBlockCacheWarmStat();
+  virtual void reset();
+  OB_INLINE void set_addr(common::ObAddr &addr) {addr_ = &addr;}
+  virtual int inner_get_next_row(common::ObNewRow *&row);
+private:
+  virtual int set_ip();
+  virtual int inner_open() override;
+  int process_row(const blocksstable::ObBlockCacheWarmStat &stat);
+  int get_hit_ratio(const uint64_t tenant_id, const bool is_data_block, common::number::ObNumber &num);
+private:
+  enum WARM_STAT_COLUMN
+  {
+    SVR_IP = common::OB_APP_MIN_COLUMN_ID,
+    SVR_PORT,
+    TENANT_ID,
+    STATUS,
+    SNAPSHOT_TIME,
+    TOTAL_BLOCK_COUNT,
+    LOADED_BLOCK_COUNT,
+    SKIPPED_BLOCK_COUNT,
+    FAILED_BLOCK_COUNT,
+    LOADED_BYTES,
+    START_TIME,
+    FINISH_TIME,
+    DATA_BLOCK_CACHE_HIT_RATIO,
+    INDEX_BLOCK_CACHE_HIT_RATIO
+  };
+  int64_t stat_iter_;
+  common::ObAddr *addr_;
+  common::ObString ipstr_;
+  int32_t port_;
+  common::ObSEArray<blocksstable::ObBlockCacheWarmStat, 16> warm_stats_;
+  common::ObStringBuf str_buf_;
+  DISALLOW_COPY_AND_ASSIGN(ObAllVirtualBlockCacheWarmStat);
+};
+
+}  // observer
+}  // oceanbase
+
+#endif // OB_ALL_VIRTUAL_BLOCK_CACHE_WARM_STAT_H_
@@ -196,6 +196,7 @@
 #include "observer/virtual_table/ob_all_virtual_dml_stats.h"
 #include "observer/virtual_table/ob_tenant_virtual_privilege.h"
 #include "observer/virtual_table/ob_all_virtual_kvcache_store_memblock.h"
+#include "observer/virtual_table/ob_all_virtual_block_cache_warm_stat.h"
 #include "observer/virtual_table/ob_information_query_response_time.h"
 #include "observer/virtual_table/ob_all_virtual_storage_leak_info.h"
 #include "observer/virtual_table/ob_all_virtual_schema_memory.h"
@@ -2574,6 +2575,16 @@ int ObVTIterCreator::create_vt_iter(ObVTableScanParam &params,
             }
             break;
           }
+          case OB_ALL_VIRTUAL_BLOCK_CACHE_WARM_STAT_TID: {
+            ObAllVirtualBlockCacheWarmStat *block_cache_warm_stat = nullptr;
+            if (OB_FAIL(NEW_VIRTUAL_TABLE(ObAllVirtualBlockCacheWarmStat, block_cache_warm_stat))) {
+              SERVER_LOG(ERROR, "Fail to create __all_virtual_block_cache_warm_stat", K(ret));
+            } else {
+              block_cache_warm_stat->set_addr(addr_);
+              vt_iter = static_cast<ObVirtualTableIterator *>(block_cache_warm_stat);
+            }
+            break;
+          }
           case OB_ALL_VIRTUAL_TRACEPOINT_INFO_TID: {
             ObAllTracepointInfo *tp_info = NULL;
             if (OB_FAIL(NEW_VIRTUAL_TABLE(ObAllTracepointInfo, tp_info))) {
@@ -166,6 +166,12 @@ public:
   int get_batch_data_block_cache_key(ObIArray<blocksstable::ObMicroBlockCacheKey> &keys) {
     return map_.get_batch_data_block_cache_key(DEFAULT_ONCE_BATCH_GET_BUCKET_NUM, keys);
   }
+  int get_batch_block_cache_key_stat(
+      int64_t &start_pos,
+      ObIArray<blocksstable::ObMicroBlockCacheKey> &keys,
+      ObIArray<ObKVCacheKeyStat> &stats) {
+    return map_.get_batch_block_cache_key_stat(start_pos, DEFAULT_ONCE_BATCH_GET_BUCKET_NUM, keys, stats);
+  }
   OB_INLINE int64_t get_bucket_num() const { return map_.get_bucket_num(); }
 private:
   template<class Key, class Value> friend class ObIKVCache;
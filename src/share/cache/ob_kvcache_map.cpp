@@ -164,6 +164,47 @@ int ObKVCacheMap::get_batch_data_block_cache_key(
   return ret;
 }
 
+int ObKVCacheMap::get_batch_block_cache_key_stat(
+  int64_t &start_pos,
+  const int64_t bucket_count,
+  ObIArray<blocksstable::ObMicroBlockCacheKey> &keys,
+  ObIArray<ObKVCacheKeyStat> &stats)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "The ObKVCacheMap has not been inited, ", K(ret));
+  } else if (OB_UNLIKELY(start_pos < 0 || start_pos >= bucket_num_ || bucket_count <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "Invalid argument, ", K(ret), K(start_pos), K(bucket_count), K_(bucket_num));
+  } else {
+    const int64_t end_pos = MIN(start_pos + bucket_count, bucket_num_);
+    ObKVCacheHazardGuard hazard_guard(global_hazard_station_);
+    if (OB_FAIL(hazard_guard.get_ret())) {
+      COMMON_LOG(WARN, "Fail to acquire hazard version", K(ret));
+    } else {
+      for (int64_t i = start_pos; i < end_pos && OB_SUCC(ret); i++) {
+        Node *iter = get_bucket_node(i);
+        while (OB_SUCC(ret) && nullptr != iter) {
+          if (iter->inst_->is_block_cache_ && store_->add_handle_ref(iter->mb_handle_, iter->seq_num_)) {
+            if (OB_FAIL(keys.push_back(*static_cast<const blocksstable::ObMicroBlockCacheKey *>(iter->key_)))) {
+              COMMON_LOG(WARN, "Fail to push back micro block cache key", K(ret), K(keys.count()), KPC(iter));
+            } else if (OB_FAIL(stats.push_back(ObKVCacheKeyStat(iter->inst_->cache_id_, iter->get_cnt_)))) {
+              COMMON_LOG(WARN, "Fail to push back key stat", K(ret), K(stats.count()), KPC(iter));
+            }
+            store_->de_handle_ref(iter->mb_handle_);
+          }
+          iter = iter->next_;
+        }
+      }
+      if (OB_SUCC(ret)) {
+        start_pos = end_pos >= bucket_num_ ? 0 : end_pos;
+      }
+    }
+  }
+  return ret;
+}
+
 int ObKVCacheMap::put(
   ObKVCacheInst &inst,
   const ObIKVCacheKey &key,
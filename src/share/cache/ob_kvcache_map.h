@@ -61,6 +61,14 @@ public:
     ObKVMemBlockHandle *&out_handle);
   int erase(const int64_t cache_id, const ObIKVCacheKey &key);
   int get_batch_data_block_cache_key(const int bucket_count, ObIArray<blocksstable::ObMicroBlockCacheKey> &keys);
+  // Get keys of block caches in buckets [start_pos, start_pos + bucket_count) with
+  // their LFU stat, start_pos is set to the next bucket to scan or 0 if all
+  // buckets are scanned.
+  int get_batch_block_cache_key_stat(
+      int64_t &start_pos,
+      const int64_t bucket_count,
+      ObIArray<blocksstable::ObMicroBlockCacheKey> &keys,
+      ObIArray<ObKVCacheKeyStat> &stats);
   OB_INLINE int64_t get_bucket_num() const { return bucket_num_; }
   void print_hazard_version_info();
 private:
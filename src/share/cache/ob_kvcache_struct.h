@@ -220,6 +220,19 @@ struct ObKVCacheInfo
   TO_STRING_KV(K_(inst_key), K_(status));
 };
 
+// LFU stat of a kvcache node
+struct ObKVCacheKeyStat
+{
+public:
+  ObKVCacheKeyStat() : cache_id_(-1), get_cnt_(0) {}
+  ObKVCacheKeyStat(const int64_t cache_id, const int64_t get_cnt)
+    : cache_id_(cache_id), get_cnt_(get_cnt) {}
+  TO_STRING_KV(K_(cache_id), K_(get_cnt));
+public:
+  int64_t cache_id_;
+  int64_t get_cnt_;
+};
+
 struct ObKVCacheStoreMemblockInfo
 {
 public:
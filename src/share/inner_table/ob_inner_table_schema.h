@@ -1110,6 +1110,7 @@ public:
   static int all_virtual_kv_client_info_schema(share::schema::ObTableSchema &table_schema);
   static int all_virtual_function_io_stat_schema(share::schema::ObTableSchema &table_schema);
   static int all_virtual_temp_file_schema(share::schema::ObTableSchema &table_schema);
+  static int all_virtual_block_cache_warm_stat_schema(share::schema::ObTableSchema &table_schema);
   static int all_virtual_sql_audit_ora_schema(share::schema::ObTableSchema &table_schema);
   static int all_virtual_plan_stat_ora_schema(share::schema::ObTableSchema &table_schema);
   static int all_virtual_plan_cache_plan_explain_ora_schema(share::schema::ObTableSchema &table_schema);
@@ -3981,6 +3982,7 @@ const schema_create_func virtual_table_schema_creators [] = {
   ObInnerTableSchema::all_virtual_kv_client_info_schema,
   ObInnerTableSchema::all_virtual_function_io_stat_schema,
   ObInnerTableSchema::all_virtual_temp_file_schema,
+  ObInnerTableSchema::all_virtual_block_cache_warm_stat_schema,
   ObInnerTableSchema::all_virtual_ash_all_virtual_ash_i1_schema,
   ObInnerTableSchema::all_virtual_sql_plan_monitor_all_virtual_sql_plan_monitor_i1_schema,
   ObInnerTableSchema::all_virtual_sql_audit_all_virtual_sql_audit_i1_schema,
@@ -10651,7 +10653,8 @@ const uint64_t cluster_distributed_vtables [] = {
   OB_ALL_VIRTUAL_STORAGE_HA_ERROR_DIAGNOSE_TID,
   OB_ALL_VIRTUAL_STORAGE_HA_PERF_DIAGNOSE_TID,
   OB_ALL_VIRTUAL_TENANT_SCHEDULER_RUNNING_JOB_TID,
-  OB_ALL_VIRTUAL_SHARED_STORAGE_COMPACTION_INFO_TID,  };
+  OB_ALL_VIRTUAL_SHARED_STORAGE_COMPACTION_INFO_TID,
+  OB_ALL_VIRTUAL_BLOCK_CACHE_WARM_STAT_TID,  };
 
 const uint64_t tenant_distributed_vtables [] = {
   OB_ALL_VIRTUAL_PROCESSLIST_TID,
@@ -13629,11 +13632,11 @@ static inline int get_sys_table_lob_aux_schema(const uint64_t tid,
 
 const int64_t OB_CORE_TABLE_COUNT = 4;
 const int64_t OB_SYS_TABLE_COUNT = 305;
-const int64_t OB_VIRTUAL_TABLE_COUNT = 852;
+const int64_t OB_VIRTUAL_TABLE_COUNT = 853;
 const int64_t OB_SYS_VIEW_COUNT = 965;
-const int64_t OB_SYS_TENANT_TABLE_COUNT = 2127;
+const int64_t OB_SYS_TENANT_TABLE_COUNT = 2128;
 const int64_t OB_CORE_SCHEMA_VERSION = 1;
-const int64_t OB_BOOTSTRAP_SCHEMA_VERSION = 2130;
+const int64_t OB_BOOTSTRAP_SCHEMA_VERSION = 2131;
 
 } // end namespace share
 } // end namespace oceanbase
@@ -15156,6 +15156,34 @@ def_table_schema(
 
 # 12506: __all_virtual_ncomp_dll_v2
 
+def_table_schema(
+  owner = 'agent',
+  table_name = '__all_virtual_block_cache_warm_stat',
+  table_id = '12507',
+  table_type = 'VIRTUAL_TABLE',
+  gm_columns = [],
+  rowkey_columns = [
+  ],
+  normal_columns = [
+    ('svr_ip', 'varchar:MAX_IP_ADDR_LENGTH', 'false'),
+    ('svr_port', 'int'),
+    ('tenant_id', 'int'),
+    ('status', 'varchar:16'),
+    ('snapshot_time', 'timestamp', 'true'),
+    ('total_block_count', 'int'),
+    ('loaded_block_count', 'int'),
+    ('skipped_block_count', 'int'),
+    ('failed_block_count', 'int'),
+    ('loaded_bytes', 'int'),
+    ('start_time', 'timestamp', 'true'),
+    ('finish_time', 'timestamp', 'true'),
+    ('data_block_cache_hit_ratio', 'number:38:3'),
+    ('index_block_cache_hit_ratio', 'number:38:3'),
+  ],
+  vtable_route_policy = 'distributed',
+  partition_columns = ['svr_ip', 'svr_port'],
+)
+
 # 余留位置（此行之前占位）
 # 本区域占位建议：采用真实表名进行占位
 ################################################################################
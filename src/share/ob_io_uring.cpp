@@ -0,0 +1,467 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+#include "share/ob_io_uring.h"
+#include "share/ob_errno.h"
+#include "share/ob_io_device_helper.h"
+#include "lib/utility/utility.h"
+
+// IORING_FEAT_EXT_ARG (linux 5.11) is needed for timed waits without an extra timeout SQE.
+#if defined(IORING_FEAT_EXT_ARG) && defined(__NR_io_uring_setup)
+#define OB_HAS_IO_URING 1
+#else
+#define OB_HAS_IO_URING 0
+#endif
+
+using namespace oceanbase::common;
+
+namespace oceanbase {
+namespace share {
+
+ObIOUring::ObIOUring()
+  : is_inited_(false),
+    ring_fd_(-1),
+    sq_ring_ptr_(MAP_FAILED),
+    sq_ring_size_(0),
+    cq_ring_ptr_(MAP_FAILED),
+    cq_ring_size_(0),
+    sqes_ptr_(MAP_FAILED),
+    sqes_size_(0),
+    sq_khead_(nullptr),
+    sq_ktail_(nullptr),
+    sq_array_(nullptr),
+    sq_mask_(0),
+    sq_entries_(0),
+    cq_khead_(nullptr),
+    cq_ktail_(nullptr),
+    cqes_(nullptr),
+    cq_mask_(0),
+    cq_entries_(0),
+    sq_tail_(0),
+    submitted_cnt_(0),
+    is_flushing_(false),
+    sq_lock_(),
+    fixed_fd_cnt_(0)
+{
+  for (int64_t i = 0; i < MAX_FIXED_FD_CNT; ++i) {
+    fixed_fds_[i] = -1;
+  }
+}
+
+ObIOUring::~ObIOUring()
+{
+  destroy();
+}
+
+#if OB_HAS_IO_URING
+
+bool ObIOUring::is_supported()
+{
+  // -1: not probed yet, 0: not supported, 1: supported
+  static int supported = -1;
+  if (-1 == ATOMIC_LOAD(&supported)) {
+    int probe_ret = 0;
+    struct io_uring_params params;
+    MEMSET(&params, 0, sizeof(params));
+    const int fd = static_cast<int>(::syscall(__NR_io_uring_setup, 2, &params));
+    if (fd < 0) {
+      probe_ret = 0;
+      SHARE_LOG(INFO, "io_uring is not available", K(errno), KERRMSG);
+    } else {
+      probe_ret = (0 != (params.features & IORING_FEAT_EXT_ARG)) ? 1 : 0;
+      if (0 == probe_ret) {
+        SHARE_LOG(INFO, "io_uring lacks IORING_FEAT_EXT_ARG", "features", params.features);
+      }
+      ::close(fd);
+    }
+    ATOMIC_STORE(&supported, probe_ret);
+  }
+  return 1 == ATOMIC_LOAD(&supported);
+}
+
+int ObIOUring::init(const uint32_t entries, const int *fixed_fds, const int64_t fixed_fd_cnt)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    SHARE_LOG(WARN, "io uring has been inited", K(ret));
+  } else if (OB_UNLIKELY(0 == entries || fixed_fd_cnt < 0 || fixed_fd_cnt > MAX_FIXED_FD_CNT
+                         || (fixed_fd_cnt > 0 && OB_ISNULL(fixed_fds)))) {
+    ret = OB_INVALID_ARGUMENT;
+    SHARE_LOG(WARN, "invalid argument", K(ret), K(entries), KP(fixed_fds), K(fixed_fd_cnt));
+  } else if (!is_supported()) {
+    ret = OB_NOT_SUPPORTED;
+    SHARE_LOG(WARN, "io uring is not supported by the kernel", K(ret));
+  } else if (OB_FAIL(setup_ring_(entries))) {
+    SHARE_LOG(WARN, "fail to setup io uring", K(ret), K(entries));
+  } else if (OB_FAIL(register_files_(fixed_fds, fixed_fd_cnt))) {
+    SHARE_LOG(WARN, "fail to register fixed files", K(ret), K(fixed_fd_cnt));
+  } else {
+    sq_tail_ = *sq_ktail_;
+    submitted_cnt_ = sq_tail_;
+    is_flushing_ = false;
+    is_inited_ = true;
+  }
+  if (OB_FAIL(ret)) {
+    destroy();
+  }
+  return ret;
+}
+
+void ObIOUring::destroy()
+{
+  if (MAP_FAILED != sqes_ptr_) {
+    ::munmap(sqes_ptr_, sqes_size_);
+  }
+  if (MAP_FAILED != cq_ring_ptr_ && cq_ring_ptr_ != sq_ring_ptr_) {
+    ::munmap(cq_ring_ptr_, cq_ring_size_);
+  }
+  if (MAP_FAILED != sq_ring_ptr_) {
+    ::munmap(sq_ring_ptr_, sq_ring_size_);
+  }
+  if (ring_fd_ >= 0) {
+    ::close(ring_fd_);
+  }
+  ring_fd_ = -1;
+  sq_ring_ptr_ = MAP_FAILED;
+  sq_ring_size_ = 0;
+  cq_ring_ptr_ = MAP_FAILED;
+  cq_ring_size_ = 0;
+  sqes_ptr_ = MAP_FAILED;
+  sqes_size_ = 0;
+  sq_khead_ = nullptr;
+  sq_ktail_ = nullptr;
+  sq_array_ = nullptr;
+  sq_mask_ = 0;
+  sq_entries_ = 0;
+  cq_khead_ = nullptr;
+  cq_ktail_ = nullptr;
+  cqes_ = nullptr;
+  cq_mask_ = 0;
+  cq_entries_ = 0;
+  sq_tail_ = 0;
+  submitted_cnt_ = 0;
+  is_flushing_ = false;
+  for (int64_t i = 0; i < MAX_FIXED_FD_CNT; ++i) {
+    fixed_fds_[i] = -1;
+  }
+  fixed_fd_cnt_ = 0;
+  is_inited_ = false;
+}
+
+int ObIOUring::setup_ring_(const uint32_t entries)
+{
+  int ret = OB_SUCCESS;
+  struct io_uring_params params;
+  MEMSET(&params, 0, sizeof(params));
+  if ((ring_fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params))) < 0) {
+    ret = ObIODeviceLocalFileOp::convert_sys_errno();
+    SHARE_LOG(WARN, "fail to setup io uring", K(ret), K(entries), K(errno), KERRMSG);
+  } else {
+    const bool single_mmap = 0 != (params.features & IORING_FEAT_SINGLE_MMAP);
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (single_mmap) {
+      sq_ring_size_ = MAX(sq_ring_size_, cq_ring_size_);
+      cq_ring_size_ = sq_ring_size_;
+    }
+    sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+    if (MAP_FAILED == (sq_ring_ptr_ = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING))) {
+      ret = ObIODeviceLocalFileOp::convert_sys_errno();
+      SHARE_LOG(WARN, "fail to mmap sq ring", K(ret), K_(sq_ring_size), KERRMSG);
+    } else if (single_mmap) {
+      cq_ring_ptr_ = sq_ring_ptr_;
+    } else if (MAP_FAILED == (cq_ring_ptr_ = ::mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING))) {
+      ret = ObIODeviceLocalFileOp::convert_sys_errno();
+      SHARE_LOG(WARN, "fail to mmap cq ring", K(ret), K_(cq_ring_size), KERRMSG);
+    }
+    if (OB_FAIL(ret)) {
+    } else if (MAP_FAILED == (sqes_ptr_ = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES))) {
+      ret = ObIODeviceLocalFileOp::convert_sys_errno();
+      SHARE_LOG(WARN, "fail to mmap sqes", K(ret), K_(sqes_size), KERRMSG);
+    } else {
+      char *sq_ptr = static_cast<char *>(sq_ring_ptr_);
+      char *cq_ptr = static_cast<char *>(cq_ring_ptr_);
+      sq_khead_ = reinterpret_cast<uint32_t *>(sq_ptr + params.sq_off.head);
+      sq_ktail_ = reinterpret_cast<uint32_t *>(sq_ptr + params.sq_off.tail);
+      sq_array_ = reinterpret_cast<uint32_t *>(sq_ptr + params.sq_off.array);
+      sq_mask_ = *reinterpret_cast<uint32_t *>(sq_ptr + params.sq_off.ring_mask);
+      sq_entries_ = params.sq_entries;
+      cq_khead_ = reinterpret_cast<uint32_t *>(cq_ptr + params.cq_off.head);
+      cq_ktail_ = reinterpret_cast<uint32_t *>(cq_ptr + params.cq_off.tail);
+      cqes_ = cq_ptr + params.cq_off.cqes;
+      cq_mask_ = *reinterpret_cast<uint32_t *>(cq_ptr + params.cq_off.ring_mask);
+      cq_entries_ = params.cq_entries;
+    }
+  }
+  return ret;
+}
+
+int ObIOUring::register_files_(const int *fixed_fds, const int64_t fixed_fd_cnt)
+{
+  int ret = OB_SUCCESS;
+  if (fixed_fd_cnt > 0) {
+    if (0 != ::syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_FILES,
+                       fixed_fds, static_cast<uint32_t>(fixed_fd_cnt))) {
+      ret = ObIODeviceLocalFileOp::convert_sys_errno();
+      SHARE_LOG(WARN, "fail to register files", K(ret), K(fixed_fd_cnt), KERRMSG);
+    } else {
+      for (int64_t i = 0; i < fixed_fd_cnt; ++i) {
+        fixed_fds_[i] = fixed_fds[i];
+      }
+      fixed_fd_cnt_ = fixed_fd_cnt;
+    }
+  }
+  return ret;
+}
+
+int ObIOUring::get_fixed_index_(const int fd) const
+{
+  int index = -1;
+  for (int64_t i = 0; -1 == index && i < fixed_fd_cnt_; ++i) {
+    if (fixed_fds_[i] == fd) {
+      index = static_cast<int>(i);
+    }
+  }
+  return index;
+}
+
+int ObIOUring::submit(const struct iocb &cb)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    SHARE_LOG(WARN, "io uring not init", K(ret));
+  } else if (OB_FAIL(push_sqe_(cb))) {
+    if (OB_EAGAIN != ret) {
+      SHARE_LOG(WARN, "fail to push sqe", K(ret));
+    }
+  } else {
+    // The SQE is published to the kernel once pushed and can't be taken back, so the
+    // request belongs to the ring from now on and the submit is reported as succeeded.
+    // SQEs left by a failed flush are flushed again by the next submit or get_events.
+    int tmp_ret = OB_SUCCESS;
+    if (OB_TMP_FAIL(try_flush_())) {
+      SHARE_LOG_RET(WARN, tmp_ret, "fail to flush submission queue, retry later", KPC(this));
+    }
+  }
+  return ret;
+}
+
+int ObIOUring::push_sqe_(const struct iocb &cb)
+{
+  int ret = OB_SUCCESS;
+  uint8_t opcode = 0;
+  switch (cb.aio_lio_opcode) {
+    case IO_CMD_PREAD:
+      opcode = IORING_OP_READ;
+      break;
+    case IO_CMD_PWRITE:
+      opcode = IORING_OP_WRITE;
+      break;
+    default:
+      ret = OB_NOT_SUPPORTED;
+      SHARE_LOG(WARN, "unsupported aio opcode", K(ret), "opcode", cb.aio_lio_opcode);
+      break;
+  }
+  if (OB_SUCC(ret)) {
+    ObSpinLockGuard guard(sq_lock_);
+    const uint32_t head = ATOMIC_LOAD_ACQ(sq_khead_);
+    if (sq_tail_ - head >= sq_entries_) {
+      // the kernel has not consumed earlier SQEs yet, let the io sender retry
+      ret = OB_EAGAIN;
+    } else {
+      const uint32_t idx = sq_tail_ & sq_mask_;
+      struct io_uring_sqe *sqe = static_cast<struct io_uring_sqe *>(sqes_ptr_) + idx;
+      const int fixed_index = get_fixed_index_(cb.aio_fildes);
+      MEMSET(sqe, 0, sizeof(*sqe));
+      sqe->opcode = opcode;
+      if (fixed_index >= 0) {
+        sqe->fd = fixed_index;
+        sqe->flags |= IOSQE_FIXED_FILE;
+      } else {
+        sqe->fd = cb.aio_fildes;
+      }
+      sqe->addr = reinterpret_cast<uint64_t>(cb.u.c.buf);
+      sqe->len = static_cast<uint32_t>(cb.u.c.nbytes);
+      sqe->off = static_cast<uint64_t>(cb.u.c.offset);
+      sqe->user_data = reinterpret_cast<uint64_t>(cb.data);
+      sq_array_[idx] = idx;
+      ATOMIC_STORE(&sq_tail_, sq_tail_ + 1);
+      ATOMIC_STORE_REL(sq_ktail_, sq_tail_);
+    }
+  }
+  return ret;
+}
+
+int ObIOUring::try_flush_()
+{
+  int ret = OB_SUCCESS;
+  // Whoever wins is_flushing_ submits everything pushed so far. A pusher that loses
+  // the race is covered because the winner re-checks the tail after releasing the flag.
+  while (OB_SUCC(ret)
+         && ATOMIC_LOAD(&sq_tail_) != ATOMIC_LOAD(&submitted_cnt_)
+         && ATOMIC_BCAS(&is_flushing_, false, true)) {
+    ret = flush_sq_();
+    ATOMIC_STORE(&is_flushing_, false);
+  }
+  return ret;
+}
+
+int ObIOUring::flush_sq_()
+{
+  int ret = OB_SUCCESS;
+  uint32_t to_submit = ATOMIC_LOAD(&sq_tail_) - submitted_cnt_;
+  int64_t retry_cnt = 0;
+  while (OB_SUCC(ret) && to_submit > 0) {
+    const int sys_ret = static_cast<int>(::syscall(__NR_io_uring_enter, ring_fd_, to_submit, 0, 0, nullptr, 0));
+    if (sys_ret > 0) {
+      ATOMIC_STORE(&submitted_cnt_, submitted_cnt_ + static_cast<uint32_t>(sys_ret));
+      to_submit -= static_cast<uint32_t>(sys_ret);
+    } else if (sys_ret < 0 && EINTR == errno) {
+      // retry
+    } else if ((0 == sys_ret || EAGAIN == errno || EBUSY == errno) && ++retry_cnt < MAX_ENTER_RETRY_CNT) {
+      // completion queue is backed up, wait for the reaper to drain it
+      ob_usleep(10);
+    } else {
+      ret = 0 == sys_ret ? OB_EAGAIN : ObIODeviceLocalFileOp::convert_sys_errno();
+      SHARE_LOG(WARN, "fail to enter io uring", K(ret), K(sys_ret), K(to_submit), K(errno), KERRMSG);
+    }
+  }
+  return ret;
+}
+
+int ObIOUring::get_events(
+    const int64_t min_nr,
+    const int64_t max_nr,
+    struct io_event *events,
+    const struct timespec *timeout,
+    int64_t &complete_cnt)
+{
+  int ret = OB_SUCCESS;
+  complete_cnt = 0;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    SHARE_LOG(WARN, "io uring not init", K(ret));
+  } else if (OB_UNLIKELY(min_nr < 0 || max_nr <= 0 || min_nr > max_nr || OB_ISNULL(events))) {
+    ret = OB_INVALID_ARGUMENT;
+    SHARE_LOG(WARN, "invalid argument", K(ret), K(min_nr), K(max_nr), KP(events));
+  } else {
+    int tmp_ret = OB_SUCCESS;
+    if (OB_TMP_FAIL(try_flush_())) {
+      SHARE_LOG_RET(WARN, tmp_ret, "fail to flush pending sqes", KPC(this));
+    }
+    // completions already posted are consumed from the shared ring without a syscall
+    complete_cnt = reap_cqes_(max_nr, events);
+    if (complete_cnt < min_nr) {
+      if (OB_FAIL(wait_cqes_(min_nr - complete_cnt, timeout))) {
+        SHARE_LOG(WARN, "fail to wait cqes", K(ret), K(min_nr), K(complete_cnt));
+      } else {
+        complete_cnt += reap_cqes_(max_nr - complete_cnt, events + complete_cnt);
+      }
+    }
+  }
+  return ret;
+}
+
+int64_t ObIOUring::reap_cqes_(const int64_t max_nr, struct io_event *events)
+{
+  int64_t reap_cnt = 0;
+  uint32_t head = *cq_khead_;
+  const uint32_t tail = ATOMIC_LOAD_ACQ(cq_ktail_);
+  while (head != tail && reap_cnt < max_nr) {
+    const struct io_uring_cqe *cqe = static_cast<const struct io_uring_cqe *>(cqes_) + (head & cq_mask_);
+    struct io_event &event = events[reap_cnt];
+    event.data = reinterpret_cast<void *>(cqe->user_data);
+    event.obj = nullptr;
+    // keep the libaio convention: negative errno on failure, transferred bytes on success
+    event.res = static_cast<unsigned long>(static_cast<long>(cqe->res));
+    event.res2 = 0;
+    ++head;
+    ++reap_cnt;
+  }
+  if (reap_cnt > 0) {
+    ATOMIC_STORE_REL(cq_khead_, head);
+  }
+  return reap_cnt;
+}
+
+int ObIOUring::wait_cqes_(const int64_t wait_nr, const struct timespec *timeout)
+{
+  int ret = OB_SUCCESS;
+  struct __kernel_timespec ts;
+  struct io_uring_getevents_arg arg;
+  MEMSET(&ts, 0, sizeof(ts));
+  MEMSET(&arg, 0, sizeof(arg));
+  if (nullptr != timeout) {
+    ts.tv_sec = timeout->tv_sec;
+    ts.tv_nsec = timeout->tv_nsec;
+    arg.ts = reinterpret_cast<uint64_t>(&ts);
+  }
+  const int sys_ret = static_cast<int>(::syscall(__NR_io_uring_enter, ring_fd_, 0,
+      static_cast<uint32_t>(wait_nr), IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg)));
+  if (sys_ret < 0 && ETIME != errno && EINTR != errno) {
+    ret = ObIODeviceLocalFileOp::convert_sys_errno();
+    SHARE_LOG(WARN, "fail to wait io uring completions", K(ret), K(wait_nr), K(errno), KERRMSG);
+  }
+  return ret;
+}
+
+#else // OB_HAS_IO_URING
+
+bool ObIOUring::is_supported()
+{
+  return false;
+}
+
+int ObIOUring::init(const uint32_t entries, const int *fixed_fds, const int64_t fixed_fd_cnt)
+{
+  UNUSEDx(entries, fixed_fds, fixed_fd_cnt);
+  return OB_NOT_SUPPORTED;
+}
+
+void ObIOUring::destroy()
+{
+  is_inited_ = false;
+}
+
+int ObIOUring::submit(const struct iocb &cb)
+{
+  UNUSED(cb);
+  return OB_NOT_SUPPORTED;
+}
+
+int ObIOUring::get_events(
+    const int64_t min_nr,
+    const int64_t max_nr,
+    struct io_event *events,
+    const struct timespec *timeout,
+    int64_t &complete_cnt)
+{
+  UNUSEDx(min_nr, max_nr, events, timeout);
+  complete_cnt = 0;
+  return OB_NOT_SUPPORTED;
+}
+
+#endif // OB_HAS_IO_URING
+
+} /* namespace share */
+} /* namespace oceanbase */
@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef SRC_SHARE_OB_IO_URING_H_
+#define SRC_SHARE_OB_IO_URING_H_
+
+#include <libaio.h>
+#include "lib/lock/ob_spin_lock.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase {
+namespace share {
+
+/*
+ * A minimal io_uring ring driven by raw syscalls, used by ObLocalDevice as an
+ * alternative to libaio. Requests are still prepared as libaio iocbs, so the
+ * ObIODevice prepare interfaces stay unchanged, and are translated into SQEs
+ * at submit time.
+ *
+ * Submission: any number of threads may call submit(). Each call pushes one SQE
+ * under sq_lock_, then tries to become the flusher; the flusher hands every
+ * pending SQE to the kernel with one io_uring_enter, so concurrent submitters
+ * are batched into one syscall. A published SQE can't be withdrawn, so submit()
+ * succeeds once the SQE is pushed; if the flush fails, the pending SQEs are
+ * flushed again by the next submit() or get_events().
+ *
+ * Completion: get_events() is expected to be called by a single reaper thread.
+ * It consumes CQEs directly from the shared ring and only enters the kernel when
+ * fewer than min_nr completions are available.
+ */
+class ObIOUring final
+{
+public:
+  ObIOUring();
+  ~ObIOUring();
+  // fixed_fds are registered with the ring and referenced by index in SQEs.
+  int init(const uint32_t entries, const int *fixed_fds, const int64_t fixed_fd_cnt);
+  void destroy();
+  bool is_inited() const { return is_inited_; }
+  int submit(const struct iocb &cb);
+  int get_events(
+      const int64_t min_nr,
+      const int64_t max_nr,
+      struct io_event *events,
+      const struct timespec *timeout,
+      int64_t &complete_cnt);
+  // check whether the running kernel provides every io_uring feature we rely on.
+  static bool is_supported();
+  TO_STRING_KV(K_(is_inited), K_(ring_fd), K_(sq_entries), K_(cq_entries), K_(sq_tail),
+      K_(submitted_cnt), K_(fixed_fd_cnt));
+
+private:
+  int setup_ring_(const uint32_t entries);
+  int register_files_(const int *fixed_fds, const int64_t fixed_fd_cnt);
+  int push_sqe_(const struct iocb &cb);
+  int try_flush_();
+  int flush_sq_();
+  int64_t reap_cqes_(const int64_t max_nr, struct io_event *events);
+  int wait_cqes_(const int64_t wait_nr, const struct timespec *timeout);
+  int get_fixed_index_(const int fd) const;
+
+private:
+  static const int64_t MAX_FIXED_FD_CNT = 4;
+  static const int64_t MAX_ENTER_RETRY_CNT = 16;
+
+  bool is_inited_;
+  int ring_fd_;
+  void *sq_ring_ptr_;
+  int64_t sq_ring_size_;
+  void *cq_ring_ptr_;
+  int64_t cq_ring_size_;
+  void *sqes_ptr_;
+  int64_t sqes_size_;
+  // pointers into the shared SQ ring
+  uint32_t *sq_khead_;
+  uint32_t *sq_ktail_;
+  uint32_t *sq_array_;
+  uint32_t sq_mask_;
+  uint32_t sq_entries_;
+  // pointers into the shared CQ ring
+  uint32_t *cq_khead_;
+  uint32_t *cq_ktail_;
+  void *cqes_;
+  uint32_t cq_mask_;
+  uint32_t cq_entries_;
+  // local copy of the SQ tail, protected by sq_lock_
+  uint32_t sq_tail_;
+  // number of SQEs handed to the kernel, only modified by the flusher
+  uint32_t submitted_cnt_;
+  bool is_flushing_;
+  common::ObSpinLock sq_lock_;
+  int fixed_fds_[MAX_FIXED_FD_CNT];
+  int64_t fixed_fd_cnt_;
+  DISALLOW_COPY_AND_ASSIGN(ObIOUring);
+};
+
+} /* namespace share */
+} /* namespace oceanbase */
+
+#endif /* SRC_SHARE_OB_IO_URING_H_ */
@@ -102,9 +102,17 @@ class ObLightHashMap
 {
  typedef common::ObSEArray<Value *, 32> ValueArray;
 public:
-  ObLightHashMap() : is_inited_(false), total_cnt_(0) { OB_ASSERT(BUCKETS_CNT > 0); }
+  ObLightHashMap() : is_inited_(false) { OB_ASSERT(BUCKETS_CNT > 0); }
   ~ObLightHashMap() { destroy(); }
-  int64_t count() const { return ATOMIC_LOAD(&total_cnt_); }
+  // sums all stripes, only for statistics and emptiness checks, not for hot paths
+  int64_t count() const
+  {
+    int64_t total_cnt = 0;
+    for (int64_t i = 0; i < CNT_STRIPES; ++i) {
+      total_cnt += ATOMIC_LOAD(&total_cnt_[i].cnt_);
+    }
+    return total_cnt;
+  }
   int64_t alloc_cnt() const { return alloc_handle_.get_alloc_cnt(); }
   void reset()
   {
@@ -131,7 +139,9 @@ public:
       for (int64_t i = 0; i < LOCKS_CNT; ++i) {
         locks_[i].destroy();
       }
-      total_cnt_ = 0;
+      for (int64_t i = 0; i < CNT_STRIPES; ++i) {
+        total_cnt_[i].cnt_ = 0;
+      }
       is_inited_ = false;
     }
   }
@@ -195,7 +205,7 @@ public:
         value->next_ = buckets_[pos].next_;
         value->prev_ = NULL;
         buckets_[pos].next_ = value;
-        ATOMIC_INC(&total_cnt_);
+        ATOMIC_INC(&total_cnt_[pos % CNT_STRIPES].cnt_);
       } else {
         ret = OB_ENTRY_EXIST;
         if (old_value) {
@@ -247,7 +257,7 @@ public:
     }
     curr->prev_ = NULL;
     curr->next_ = NULL;
-    ATOMIC_DEC(&total_cnt_);
+    ATOMIC_DEC(&total_cnt_[pos % CNT_STRIPES].cnt_);
   }
 
   int get(const Key &key, Value *&value)
@@ -406,11 +416,19 @@ public:
     }
   }
 
-  int64_t get_total_cnt() { return ATOMIC_LOAD(&total_cnt_); }
+  int64_t get_total_cnt() { return count(); }
 
   static int64_t get_buckets_cnt() { return BUCKETS_CNT; }
 
 private:
+  // The entry count is striped by bucket, so that inserting and deleting on
+  // different buckets don't bounce one cache line between cores. A key always
+  // maps to the same stripe, so each stripe is never negative.
+  static const int64_t CNT_STRIPES = BUCKETS_CNT < 16 ? BUCKETS_CNT : 16;
+  struct ObLightHashCnt {
+    ObLightHashCnt() : cnt_(0) {}
+    int64_t cnt_;
+  } CACHE_ALIGNED;
   struct ObLightHashHeader {
     Value *next_;
     Value *hot_cache_val_;
@@ -514,7 +532,7 @@ private:
   bool is_inited_;
   ObLightHashHeader buckets_[BUCKETS_CNT];
   LockType locks_[LOCKS_CNT];
-  int64_t total_cnt_;
+  ObLightHashCnt total_cnt_[CNT_STRIPES];
 #ifdef ENABLE_DEBUG_LOG
 public:
 #endif
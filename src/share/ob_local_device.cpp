@@ -97,7 +97,8 @@ ObLocalDevice::ObLocalDevice()
     block_bitmap_(nullptr),
     allocator_(),
     iocb_pool_(),
-    is_fs_support_punch_hole_(true)
+    is_fs_support_punch_hole_(true),
+    enable_io_uring_(false)
 {
 
   MEMSET(store_dir_, 0, sizeof(store_dir_));
@@ -146,6 +147,8 @@ int ObLocalDevice::init(const common::ObIODOpts &opts)
         datafile_size = opts.opts_[i].value_.value_int64;
       } else if (0 == STRCMP(opts.opts_[i].key_, "media_id")) {
         media_id = opts.opts_[i].value_.value_int64;
+      } else if (0 == STRCMP(opts.opts_[i].key_, "enable_io_uring")) {
+        enable_io_uring_ = opts.opts_[i].value_.value_bool;
       } else {
         ret = OB_NOT_SUPPORTED;
         SHARE_LOG(WARN, "Not supported option, ", K(ret), K(i), K(opts.opts_[i].key_));
@@ -286,6 +289,7 @@ void ObLocalDevice::destroy()
   is_inited_ = false;
   is_marked_ = false;
   is_fs_support_punch_hole_ = true;
+  enable_io_uring_ = false;
 
   MEMSET(store_dir_, 0, sizeof(store_dir_));
   MEMSET(sstable_dir_, 0, sizeof(sstable_dir_));
@@ -917,7 +921,13 @@ int ObLocalDevice::io_setup(
     int sys_ret = 0;
     ObLocalIOContext *local_context = nullptr;
     local_context = new (buf) ObLocalIOContext();
-    if (0 != (sys_ret = ::io_setup(max_events, &(local_context->io_context_)))) {
+    if (enable_io_uring_ && OB_FAIL(setup_io_uring_(max_events, *local_context))) {
+      SHARE_LOG(WARN, "Fail to setup io uring, fall back to libaio, ", K(ret), K(max_events));
+      ret = OB_SUCCESS;
+    }
+    if (local_context->is_io_uring()) {
+      io_context = local_context;
+    } else if (0 != (sys_ret = ::io_setup(max_events, &(local_context->io_context_)))) {
       // libaio on error it returns a negated error number (the negative of one of the values listed in ERRORS)
       ret = ObIODeviceLocalFileOp::convert_sys_errno(-sys_ret);
       SHARE_LOG(WARN, "Fail to setup io context, ", K(ret), K(sys_ret), KERRMSG);
@@ -950,6 +960,9 @@ int ObLocalDevice::io_destroy(common::ObIOContext *io_context)
   } else if (OB_ISNULL(local_io_context = static_cast<ObLocalIOContext *> (io_context))) {
     ret = OB_ERR_UNEXPECTED;
     SHARE_LOG(WARN, "local io context is null", K(ret), KP(io_context));
+  } else if (local_io_context->is_io_uring()) {
+    local_io_context->io_uring_.destroy();
+    allocator_.free(io_context);
   } else {
     int sys_ret = 0;
     if ((sys_ret = ::io_destroy(local_io_context->io_context_)) != 0) {
@@ -1065,6 +1078,14 @@ int ObLocalDevice::io_submit(
   } else if (OB_ISNULL(local_io_context = static_cast<ObLocalIOContext *> (io_context))) {
     ret = OB_ERR_UNEXPECTED;
     SHARE_LOG(WARN, "local io context pointer is null", K(ret), KP(io_context));
+  } else if (local_io_context->is_io_uring()) {
+    // concurrent submitters are batched into one io_uring_enter by ObIOUring
+    if (OB_FAIL(local_io_context->io_uring_.submit(local_iocb->iocb_))) {
+      if (OB_EAGAIN != ret) {
+        SHARE_LOG(WARN, "Fail to submit io uring request, ", K(ret), K(local_io_context->io_uring_));
+      }
+    }
+    time_guard.click("LocalDevice_submit");
   } else {
     iocbp = &(local_iocb->iocb_);
     int submit_ret = ::io_submit(local_io_context->io_context_, 1, &iocbp);
@@ -1104,6 +1125,9 @@ int ObLocalDevice::io_cancel(
   } else if (OB_ISNULL(local_io_context = static_cast<ObLocalIOContext *> (io_context))) {
     ret = OB_ERR_UNEXPECTED;
     SHARE_LOG(WARN, "local io context pointer is null", K(ret), KP(io_context));
+  } else if (local_io_context->is_io_uring()) {
+    ret = OB_NOT_SUPPORTED;
+    SHARE_LOG(DEBUG, "io uring does not support cancel", K(ret));
   } else {
     int sys_ret = 0;
     if ((sys_ret = ::io_cancel(local_io_context->io_context_, &(local_iocb->iocb_), &local_event)) < 0) {
@@ -1142,6 +1166,18 @@ int ObLocalDevice::io_getevents(
   } else if (OB_ISNULL(local_io_context = static_cast<ObLocalIOContext *> (io_context))) {
     ret = OB_ERR_UNEXPECTED;
     SHARE_LOG(WARN, "local io context pointer is null", K(ret), KP(io_context));
+  } else if (local_io_context->is_io_uring()) {
+    int64_t complete_cnt = 0;
+    {
+      oceanbase::lib::Thread::WaitGuard guard(oceanbase::lib::Thread::WAIT_FOR_IO_EVENT);
+      ret = local_io_context->io_uring_.get_events(
+          min_nr, local_io_events->max_event_cnt_, local_io_events->io_events_, timeout, complete_cnt);
+    }
+    if (OB_FAIL(ret)) {
+      SHARE_LOG(WARN, "Fail to get io uring events, ", K(ret), K(min_nr));
+    } else {
+      local_io_events->complete_io_cnt_ = complete_cnt;
+    }
   } else {
     int sys_ret = 0;
     {
@@ -1164,6 +1200,19 @@ int ObLocalDevice::io_getevents(
   return ret;
 }
 
+int ObLocalDevice::setup_io_uring_(const uint32_t max_events, ObLocalIOContext &local_context)
+{
+  int ret = OB_SUCCESS;
+  // the block file is registered as a fixed file so the kernel skips the fd lookup per request
+  const int64_t fixed_fd_cnt = block_fd_ > 0 ? 1 : 0;
+  if (OB_FAIL(local_context.io_uring_.init(max_events, &block_fd_, fixed_fd_cnt))) {
+    SHARE_LOG(WARN, "Fail to init io uring, ", K(ret), K(max_events), K(block_fd_));
+  } else {
+    SHARE_LOG(INFO, "Succeed to setup io uring context, ", K(max_events), K(local_context.io_uring_));
+  }
+  return ret;
+}
+
 common::ObIOCB* ObLocalDevice::alloc_iocb(const uint64_t tenant_id)
 {
   UNUSED(tenant_id);
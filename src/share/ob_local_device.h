@@ -16,6 +16,7 @@
 #include <libaio.h>
 #include "lib/allocator/ob_fifo_allocator.h"
 #include "common/storage/ob_io_device.h"
+#include "share/ob_io_uring.h"
 
 namespace oceanbase {
 namespace share {
@@ -39,15 +40,17 @@ private:
 class ObLocalIOContext : public common::ObIOContext
 {
 public:
-  ObLocalIOContext() : io_context_() {}
+  ObLocalIOContext() : io_context_(), io_uring_() {}
   virtual ~ObLocalIOContext() {}
   virtual ObIOContextType get_type() const override
   {
     return ObIOContextType::IO_CONTEXT_TYPE_LOCAL;
   }
+  bool is_io_uring() const { return io_uring_.is_inited(); }
 private:
   friend class ObLocalDevice;
   io_context_t io_context_;
+  ObIOUring io_uring_; // used instead of io_context_ when the device runs on io_uring
 };
 
 class ObLocalIOEvents : public common::ObIOEvents
@@ -217,6 +220,7 @@ private:
   int resize_block_file(const int64_t new_size);
   int64_t get_block_file_offset(const common::ObIOFd &fd, const int64_t offset);
   int try_punch_hole(const int64_t block_index);
+  int setup_io_uring_(const uint32_t max_events, ObLocalIOContext &local_context);
 
 private:
   static const int64_t DEFUALT_PRE_ALLOCATED_IOCB_COUNT = 32 * 512;// 32 thread * max_io_depth
@@ -240,6 +244,7 @@ private:
   common::ObFIFOAllocator allocator_;
   ObIOCBPool<ObLocalIOCB> iocb_pool_;
   bool is_fs_support_punch_hole_;
+  bool enable_io_uring_;
 };
 
 OB_INLINE int64_t ObLocalDevice::get_block_file_offset(const common::ObIOFd &fd, const int64_t offset)
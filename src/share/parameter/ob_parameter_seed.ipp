@@ -507,6 +507,10 @@ DEF_INT(_enable_hash_join_processor, OB_TENANT_PARAMETER, "7", "[1, 7]",
          "which path to process for hash join, default 7 to auto choose "
          "1: nest loop, 2: recursive, 4: in-memory",
          ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_hash_join_radix_build, OB_TENANT_PARAMETER, "False",
+         "radix partition the rows before building a hash join table much larger than cache "
+         "Value:  True:turned on  False: turned off",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(_pushdown_storage_level, OB_TENANT_PARAMETER, "4", "[0, 4]",
         "the level of storage pushdown. Range: [0, 4] "
         "0: disabled, 1:blockscan, 2: blockscan & filter, 3: blockscan & filter & aggregate, 4: blockscan & filter & aggregate & group by",
@@ -715,6 +719,11 @@ DEF_INT(_log_writer_parallelism, OB_TENANT_PARAMETER, "3",
        "[1,8]",
        "the number of parallel log writer threads that can be used to write redo log entries to disk. ",
        ObParameterAttr(Section::LOGSERVICE, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_INT(_log_writer_flush_parallelism, OB_TENANT_PARAMETER, "0",
+       "[0,16]",
+       "the number of helper threads of each log writer which flush the logs of different log streams concurrently, "
+       "0 means flushing serially. ",
+       ObParameterAttr(Section::LOGSERVICE, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
 
 DEF_TIME(_ls_gc_wait_readonly_tx_time, OB_TENANT_PARAMETER, "24h",
         "[0s,)",
@@ -866,6 +875,10 @@ DEF_CAP(_parallel_redo_logging_trigger, OB_CLUSTER_PARAMETER, "16M", "[0B,)",
 DEF_TIME(_ob_get_gts_ahead_interval, OB_CLUSTER_PARAMETER, "0s", "[0s, 1s]",
          "get gts ahead interval. Range: [0s, 1s]",
          ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_TIME(_gts_request_batch_interval, OB_CLUSTER_PARAMETER, "0us", "[0us, 10ms]",
+         "a gts request waits for the gts rpc sent within this interval instead of sending a new one, "
+         "0 means every request which needs a newer gts sends the rpc. Range: [0us, 10ms]",
+         ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(_tx_debug_level, OB_TENANT_PARAMETER, "0", "[0, 10]",
         "the debug level of transaction module. Range: [0, 10] in integer.",
         ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -946,6 +959,24 @@ DEF_INT(bf_cache_miss_count_threshold, OB_CLUSTER_PARAMETER, "100", "[0,)", "bf
 DEF_INT(fuse_row_cache_priority, OB_CLUSTER_PARAMETER, "1", "[1,)", "fuse row cache priority. Range:[1, )", ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(storage_meta_cache_priority, OB_CLUSTER_PARAMETER, "10", "[1,)", "storage meta cache priority. Range:[1, )",
         ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_block_cache_warm_restart, OB_CLUSTER_PARAMETER, "False",
+         "whether to persist the hot keys of block caches periodically and reload the blocks after restart. "
+         "Value:  True:turned on  False: turned off",
+         ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_TIME(_block_cache_warm_snapshot_interval, OB_CLUSTER_PARAMETER, "10m", "[1m,)",
+         "the interval to persist the hot keys of block caches. Range: [1m, +∞)",
+         ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_block_cache_warm_snapshot_key_count, OB_CLUSTER_PARAMETER, "200000", "[1000, 10000000]",
+        "the max count of hot block cache keys to persist. Range: [1000, 10000000]",
+        ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_CAP(_block_cache_warm_up_bandwidth, OB_CLUSTER_PARAMETER, "64M", "[1M,)",
+        "the max io bandwidth per second to reload the blocks of block caches after restart. Range: [1M, +∞)",
+        ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_compressed_block_cache, OB_CLUSTER_PARAMETER, "False",
+         "whether to keep the compressed copies of the data micro blocks read from disk in a secondary block cache, "
+         "a block evicted from the user block cache is decompressed from it instead of being read again. "
+         "Value:  True:turned on  False: turned off",
+         ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 // shared storage local disk cache config
 DEF_INT(_ss_major_compaction_prewarm_level, OB_TENANT_PARAMETER, "0", "[0, 2]",
@@ -1000,6 +1031,13 @@ DEF_BOOL(_enable_parallel_minor_merge, OB_TENANT_PARAMETER, "True",
          "specifies whether enable parallel minor merge. "
          "Value: True:turned on;  False: turned off",
          ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_dirty_aware_major_range_split, OB_TENANT_PARAMETER, "False",
+         "specifies whether the parallel ranges of the major merge are split by the macro blocks "
+         "modified in the incremental sstables instead of uniformly by the macro blocks of the base "
+         "sstable. The ranges are decided by the ls leader when scheduling the medium compaction and "
+         "recorded in medium info, so that all replicas merge the same ranges. "
+         "Value: True:turned on;  False: turned off",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_BOOL(_enable_adaptive_compaction, OB_TENANT_PARAMETER, "True",
          "specifies whether allow adaptive compaction schedule and information collection",
          ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -1069,6 +1107,30 @@ DEF_BOOL(_enable_adaptive_merge_schedule, OB_TENANT_PARAMETER, "True",
          "specifies whether the tenant's adaptive merge scheduling is enabled"
          "Value: True:turned on;  False: turned off",
          ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_TIME(_compaction_query_latency_target, OB_TENANT_PARAMETER, "0ms", "[0ms,]",
+         "the p99 query response time of the tenant above which the running compaction tasks are "
+         "throttled, sampled every second from the query response time statistics, which needs "
+         "query_response_time_stats turned on. 0 means not throttled by the query response time. "
+         "Range: [0ms, +∞)",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_memtable_tag_hash_index, OB_TENANT_PARAMETER, "False",
+         "specifies whether new memtables of the tenant index rows for point select by the "
+         "tag probed extendible hash instead of the split ordered list hash. "
+         "Value: True:turned on;  False: turned off",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_encoding_micro_block_hash_index, OB_TENANT_PARAMETER, "False",
+         "specifies whether the encoded micro blocks written by major compaction of the tenant "
+         "carry a rowkey hash index for point select. It is recorded in the medium compaction "
+         "scheduled by the leader, so all replicas follow the same choice. Observers older than "
+         "this version can not read such micro blocks, turn it on after all observers are upgraded. "
+         "Value: True:turned on;  False: turned off",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_merge_bloom_filter, OB_TENANT_PARAMETER, "False",
+         "specifies whether the compaction of the tenant builds the rowkey bloom filters of the "
+         "data macro blocks it writes into the bloom filter cache, instead of building them "
+         "after empty reads. "
+         "Value: True:turned on;  False: turned off",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 DEF_INT(sys_bkgd_migration_retry_num, OB_CLUSTER_PARAMETER, "3", "[3,100]",
         "retry num limit during migration. Range: [3, 100] in integer",
@@ -1561,12 +1623,20 @@ DEF_BOOL(enable_sql_extension, OB_TENANT_PARAMETER, "False",
 DEF_BOOL(_enable_block_file_punch_hole, OB_CLUSTER_PARAMETER, "False",
          "specifies whether to punch whole when free blocks in block_file",
          ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_io_uring, OB_CLUSTER_PARAMETER, "False",
+         "specifies whether the local device submits async io through io_uring instead of libaio. "
+         "Falls back to libaio if the kernel does not support it. The default value is False",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
 DEF_BOOL(_enable_trace_session_leak, OB_CLUSTER_PARAMETER, "False",
          "specifies whether to enable tracing session leak",
          ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_BOOL(_ob_enable_fast_parser, OB_CLUSTER_PARAMETER, "True",
          "control if enable fast parser",
          ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_ob_fast_parser_cache_size, OB_CLUSTER_PARAMETER, "0", "[0,64]",
+        "the number of recently executed sql texts whose fast parser results are cached by each session, "
+        "0 means disable the cache. Range: [0,64]",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 DEF_TIME(_ob_obj_dep_maint_task_interval, OB_CLUSTER_PARAMETER, "1ms", "[0,10s]",
          "The execution interval of the task of maintaining the dependency of the object. "\
@@ -1781,6 +1851,10 @@ DEF_BOOL(_px_join_skew_handling, OB_TENANT_PARAMETER, "False",
 DEF_INT(_px_join_skew_minfreq, OB_TENANT_PARAMETER, "30", "[1,100]",
         "sets minimum frequency(%) for skewed value for parallel joins. Range: [1, 100] in integer",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_px_large_partition_first, OB_TENANT_PARAMETER, "False",
+        "whether to hand out the partition granules of larger partitions first to the px workers, "
+        "which shortens the completion time of scanning skewed partitions. The default value is False.",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_BOOL(_enable_protocol_diagnose, OB_CLUSTER_PARAMETER, "True",
         "enables protocol layer diagnosis. The default value is False.",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -1790,6 +1864,10 @@ DEF_BOOL(_enable_transaction_internal_routing, OB_TENANT_PARAMETER, "True",
 DEF_BOOL(_enable_wait_remote_lock, OB_TENANT_PARAMETER, "True",
          "enable remote execution wait in lock wait mgr when lock conflict occurs",
          ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_lock_wait_hand_off, OB_TENANT_PARAMETER, "False",
+         "enable lock wait mgr to hand off a row to the woken request once it locks the row, "
+         "the next waiter of the row is woken up when the row is released instead of when the request ends",
+         ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_STR(_load_tde_encrypt_engine, OB_CLUSTER_PARAMETER, "NONE",
         "load the engine that meet the security classification requirement to encrypt data.  default NONE",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -2175,6 +2253,12 @@ DEF_STR_WITH_CHECKER(_regex_engine, OB_TENANT_PARAMETER, "ICU",
                      "specifies the regexp engine. Values: ICU(International Components for Unicode), Hyperscan",
                      ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
+DEF_BOOL(_enable_expr_jit_filter, OB_TENANT_PARAMETER, "False",
+         "whether to compile the integer filters of vectorized operators into native code when the session "
+         "variable ob_enable_jit is AUTO or FORCE. "
+         "Value:  True:turned on  False: turned off",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+
 DEF_BOOL(_preset_runtime_bloom_filter_size, OB_CLUSTER_PARAMETER, "False",
          "Whether build runtime bloom filter with row count estimated by optimizor."
          "Value:  True:turned on  False: turned off",
@@ -3383,17 +3383,20 @@ bool ObDagPrioScheduler::check_need_load_shedding_(const bool for_schedule)
 {
   bool need_shedding = false;
   compaction::ObTenantTabletScheduler *tablet_scheduler = nullptr;
+  ObTenantTabletStatMgr *stat_mgr = nullptr;
 
-  if (OB_ISNULL(tablet_scheduler = MTL(compaction::ObTenantTabletScheduler *))) {
+  if (OB_ISNULL(tablet_scheduler = MTL(compaction::ObTenantTabletScheduler *))
+      || OB_ISNULL(stat_mgr = MTL(ObTenantTabletStatMgr *))) {
     // may be during the start phase
-  } else if (tablet_scheduler->enable_adaptive_merge_schedule()) {
-    ObTenantTabletStatMgr *stat_mgr = MTL(ObTenantTabletStatMgr *);
-    int64_t load_shedding_factor = 1;
+  } else {
+    // the latency shedding factor is only raised when _compaction_query_latency_target is set
+    int64_t load_shedding_factor = MAX(1, stat_mgr->get_latency_shedding_factor());
     const int64_t extra_limit = for_schedule ? 0 : 1;
+    if (tablet_scheduler->enable_adaptive_merge_schedule()) {
+      load_shedding_factor = MAX(load_shedding_factor, stat_mgr->get_load_shedding_factor());
+    }
 
-    if (OB_ISNULL(stat_mgr)) {
-    } else if (FALSE_IT(load_shedding_factor = MAX(1, stat_mgr->get_load_shedding_factor()))) {
-    } else if (load_shedding_factor <= 1 || !is_compaction_dag_prio()) {
+    if (load_shedding_factor <= 1 || !is_compaction_dag_prio()) {
       // no need to load shedding
     } else {
       const int64_t load_shedding_limit = MAX(2, adaptive_task_limit_ / load_shedding_factor);
@@ -4570,6 +4573,7 @@ void ObTenantDagScheduler::run1()
   while (!has_set_stop()) {
     diagnose_for_suggestion();
     dump_dag_status();
+    refresh_query_latency();
     loop_dag_net();
     {
       if (!has_set_stop()) {
@@ -4589,6 +4593,15 @@ void ObTenantDagScheduler::run1()
   }
 }
 
+void ObTenantDagScheduler::refresh_query_latency()
+{
+  ObTenantTabletStatMgr *stat_mgr = MTL(ObTenantTabletStatMgr *);
+  if (OB_NOT_NULL(stat_mgr) && stat_mgr->is_inited()) {
+    // the scheduler wakes up at least every second, which bounds the delay of throttling
+    stat_mgr->refresh_query_latency();
+  }
+}
+
 void ObReclaimUtil::reset()
 {
   total_periodic_running_worker_cnt_ = 0;
@@ -1256,6 +1256,7 @@ private:
   void inner_get_suggestion_reason(const ObDagType::ObDagTypeEnum type, int64_t &reason);
   void dump_dag_status(const bool force_dump = false);
   void diagnose_for_suggestion();
+  void refresh_query_latency();
   bool is_dag_map_full();
   int gene_basic_info(
       ObDagSchedulerInfo *info_list,
@@ -226,6 +226,12 @@ int ObStaticEngineCG::generate(const ObLogPlan &log_plan, ObPhysicalPlan &phy_pl
     phy_plan.set_root_op_spec(root_spec);
     if (OB_FAIL(set_other_properties(log_plan, phy_plan))) {
       LOG_WARN("set other properties failed", K(ret));
+    } else if (NULL != phy_plan.get_expr_jit_compiler()) {
+      // jit is best effort, specs fall back to interpreter if compile failed.
+      int tmp_ret = OB_SUCCESS;
+      if (OB_SUCCESS != (tmp_ret = phy_plan.get_expr_jit_compiler()->compile())) {
+        LOG_WARN("compile jit filters failed", K(tmp_ret));
+      }
     }
   }
   return ret;
@@ -347,6 +353,8 @@ int ObStaticEngineCG::postorder_generate_op(ObLogicalOperator &op,
     LOG_WARN("generate operator spec basic failed", K(ret));
   } else if (OB_FAIL(generate_spec_final(op, *spec))) {
     LOG_WARN("generate operator spec final failed", K(ret));
+  } else if (OB_FAIL(generate_jit_filter(op, *spec))) {
+    LOG_WARN("generate jit filter failed", K(ret));
   } else if (spec->is_dml_operator()) {
     ObTableModifySpec *dml_spec = static_cast<ObTableModifySpec *>(spec);
     if (dml_spec->use_dist_das()) {
@@ -887,6 +895,55 @@ int ObStaticEngineCG::extract_all_mview_ids(const ObRawExpr *expr)
   return ret;
 }
 
+int ObStaticEngineCG::generate_jit_filter(ObLogicalOperator &op, ObOpSpec &spec)
+{
+  int ret = OB_SUCCESS;
+  ObSQLSessionInfo *session = NULL;
+  ObJITEnableMode jit_mode = ObJITEnableMode::OFF;
+  double input_rows = op.get_card();
+  for (int64_t i = 0; i < op.get_num_of_child(); i++) {
+    if (NULL != op.get_child(i)) {
+      input_rows = std::max(input_rows, op.get_child(i)->get_card());
+    }
+  }
+  if (spec.filters_.empty() || !spec.is_vectorized()) {
+    // do nothing
+  } else if (OB_ISNULL(opt_ctx_) || OB_ISNULL(session = opt_ctx_->get_session_info())
+             || OB_ISNULL(phy_plan_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected NULL", K(ret), KP(opt_ctx_), KP(session), KP(phy_plan_));
+  } else if (OB_FAIL(session->get_expr_jit_mode(jit_mode))) {
+    LOG_WARN("get expr jit mode failed", K(ret));
+  } else if (ObJITEnableMode::OFF == jit_mode
+             || (ObJITEnableMode::AUTO == jit_mode && input_rows < EXPR_JIT_AUTO_MIN_ROWS)) {
+    // do nothing
+  } else {
+    ObSEArray<ObExpr *, 16> input_exprs;
+    ObExprJitCompiler *compiler = NULL;
+    ObExprJitFilter *jit_filter = NULL;
+    for (int64_t i = 0; OB_SUCC(ret) && i < op.get_num_of_child(); i++) {
+      if (OB_ISNULL(op.get_child(i))) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("child is NULL", K(ret), K(i));
+      } else if (OB_FAIL(generate_rt_exprs(op.get_child(i)->get_output_exprs(), input_exprs))) {
+        LOG_WARN("generate child output exprs failed", K(ret));
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(phy_plan_->get_or_create_expr_jit_compiler(compiler))) {
+      LOG_WARN("get expr jit compiler failed", K(ret));
+    } else if (OB_FAIL(compiler->add_filter(spec.filters_, input_exprs, jit_filter))) {
+      // jit is best effort, keep the interpreter
+      LOG_WARN("add jit filter failed, use interpreter", K(ret), K(spec.id_));
+      ret = OB_SUCCESS;
+    } else {
+      spec.jit_filter_ = jit_filter;
+      LOG_TRACE("generate jit filter", K(spec.id_), KPC(jit_filter));
+    }
+  }
+  return ret;
+}
+
 int ObStaticEngineCG::generate_calc_exprs(
     const ObIArray<ObRawExpr *> &dep_exprs,
     const ObIArray<ObRawExpr *> &cur_exprs,
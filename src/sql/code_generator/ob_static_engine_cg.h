@@ -209,6 +209,8 @@ public:
   //set is json constraint type is strict or relax
   const static uint8_t IS_JSON_CONSTRAINT_RELAX = 1;
   const static uint8_t IS_JSON_CONSTRAINT_STRICT = 4;
+  // filters with fewer estimated input rows are not jit compiled in AUTO mode
+  const static int64_t EXPR_JIT_AUTO_MIN_ROWS = 100000;
 
   static int check_op_vectorization(ObLogicalOperator *op, ObSqlSchemaGuard *schema_guard,
                                     const ObPhyOperatorType phy_type, bool &disable_vectorize);
@@ -260,6 +262,10 @@ private:
   // some operator need this phase to do some special generation.
   int generate_spec_final(ObLogicalOperator &op, ObOpSpec &spec);
 
+  // Fuse filters of vectorized operator into native kernel if _enable_expr_jit_filter
+  // and ob_enable_jit are on.
+  int generate_jit_filter(ObLogicalOperator &op, ObOpSpec &spec);
+
   int generate_calc_exprs(const common::ObIArray<ObRawExpr *> &dep_exprs,
                           const common::ObIArray<ObRawExpr *> &cur_exprs,
                           common::ObIArray<ObExpr *> &calc_exprs,
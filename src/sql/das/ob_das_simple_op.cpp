@@ -367,5 +367,49 @@ int ObDASSimpleUtils::get_multi_ranges_cost(ObExecContext &exec_ctx,
   return ret;
 }
 
+int ObDASSimpleUtils::get_tablets_ranges_cost(ObExecContext &exec_ctx,
+                                              const common::ObIArray<ObDASTabletLoc*> &tablet_locs,
+                                              const common::ObIArray<common::ObStoreRange> &ranges,
+                                              common::ObIArray<int64_t> &total_sizes)
+{
+  int ret = OB_SUCCESS;
+  ObEvalCtx eval_ctx(exec_ctx);
+  ObDASRef das_ref(eval_ctx, exec_ctx);
+  ObPhysicalPlanCtx *plan_ctx = nullptr;
+  ObSEArray<ObDASRangesCostOp*, 16> ranges_cost_ops;
+  das_ref.set_mem_attr(ObMemAttr(MTL_ID(), "DASGetRangeCost"));
+  total_sizes.reuse();
+  if (OB_ISNULL(plan_ctx = exec_ctx.get_physical_plan_ctx())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected nullptr", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < tablet_locs.count(); i++) {
+    ObIDASTaskOp *task_op = nullptr;
+    ObDASRangesCostOp *ranges_cost_op = nullptr;
+    if (OB_FAIL(das_ref.create_das_task(tablet_locs.at(i), DAS_OP_GET_RANGES_COST, task_op))) {
+      LOG_WARN("prepare das get_multi_ranges_cost task failed", K(ret), K(i));
+    } else if (FALSE_IT(ranges_cost_op = static_cast<ObDASRangesCostOp*>(task_op))) {
+    } else if (FALSE_IT(ranges_cost_op->set_can_part_retry(
+                          GET_MIN_CLUSTER_VERSION() >= CLUSTER_VERSION_4_2_1_0))) {
+    } else if (OB_FAIL(ranges_cost_op->init(ranges,
+                           plan_ctx->get_timeout_timestamp() - ObTimeUtility::current_time()))) {
+      LOG_WARN("failed to init das ranges cost op", K(ret));
+    } else if (OB_FAIL(ranges_cost_ops.push_back(ranges_cost_op))) {
+      LOG_WARN("failed to push back ranges cost op", K(ret));
+    }
+  }
+  if (OB_FAIL(ret) || ranges_cost_ops.empty()) {
+  } else if (OB_FAIL(das_ref.execute_all_task())) {
+    LOG_WARN("execute das get_multi_ranges_cost task failed", K(ret));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < ranges_cost_ops.count(); i++) {
+      if (OB_FAIL(total_sizes.push_back(ranges_cost_ops.at(i)->get_total_size()))) {
+        LOG_WARN("failed to push back total size", K(ret), K(i));
+      }
+    }
+  }
+  return ret;
+}
+
 } // namespace sql
 } // namespace oceanbase
@@ -180,6 +180,13 @@ public:
                                    ObDASTabletLoc *tablet_loc,
                                    const common::ObIArray<common::ObStoreRange> &ranges,
                                    int64_t &total_size);
+
+  // get the cost of the same ranges of each tablet, the tasks of all tablets
+  // are executed at once, so the tablets of a remote server cost one request
+  static int get_tablets_ranges_cost(ObExecContext &exec_ctx,
+                                     const common::ObIArray<ObDASTabletLoc*> &tablet_locs,
+                                     const common::ObIArray<common::ObStoreRange> &ranges,
+                                     common::ObIArray<int64_t> &total_sizes);
 };
 
 }  // namespace sql
@@ -0,0 +1,833 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include "sql/engine/expr/ob_expr_jit_filter.h"
+#include "objit/ob_llvm_helper.h"
+#include "share/vector/ob_fixed_length_base.h"
+#include "share/vector/ob_uniform_base.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace jit;
+namespace sql
+{
+
+// the generated code reads ObExprJitLeafParam as int64_t words
+static_assert(sizeof(ObExprJitLeafParam) == 5 * sizeof(int64_t),
+              "ObExprJitLeafParam must be consist of 8 bytes words");
+static const int64_t LEAF_PARAM_WORDS = sizeof(ObExprJitLeafParam) / sizeof(int64_t);
+static const int64_t LEAF_DATA_WORD = offsetof(ObExprJitLeafParam, data_) / sizeof(int64_t);
+static const int64_t LEAF_NULLS_WORD = offsetof(ObExprJitLeafParam, nulls_) / sizeof(int64_t);
+static const int64_t LEAF_STRIDE_WORD = offsetof(ObExprJitLeafParam, stride_) / sizeof(int64_t);
+// same as jit::ObPLOptLevel::O2
+static const int EXPR_JIT_OPT_LEVEL = 2;
+static const int64_t MAX_FUNC_NAME_LEN = 64;
+
+int ObExprJitFilter::prepare_leaves(ObEvalCtx &eval_ctx,
+                                    const bool use_rich_format,
+                                    const ObBitVector &skip,
+                                    const int64_t bsize,
+                                    const bool all_active,
+                                    ObExprJitLeafParam *params,
+                                    LeafLayout &layout,
+                                    bool &supported) const
+{
+  int ret = OB_SUCCESS;
+  bool has_fixed = false;
+  bool has_datum = false;
+  supported = true;
+  // pass 1: evaluate leaves, scalar leaves are kept as datum with zero stride
+  for (int64_t i = 0; OB_SUCC(ret) && supported && i < leaves_.count(); i++) {
+    const ObExpr *e = leaves_.at(i);
+    ObExprJitLeafParam &param = params[i];
+    MEMSET(&param, 0, sizeof(param));
+    if (use_rich_format) {
+      ObIVector *vec = NULL;
+      if (OB_FAIL(e->eval_vector(eval_ctx, skip, bsize, all_active))) {
+        LOG_WARN("evaluate vector failed", K(ret), KPC(e));
+      } else if (FALSE_IT(vec = e->get_vector(eval_ctx))) {
+      } else if (!e->is_batch_result()) {
+        param.data_ = reinterpret_cast<const char *>(
+            &static_cast<ObUniformBase *>(vec)->get_datums()[0]);
+      } else if (VEC_FIXED == e->get_format(eval_ctx)) {
+        ObFixedLengthBase *fixed_vec = static_cast<ObFixedLengthBase *>(vec);
+        if (sizeof(int64_t) != fixed_vec->get_length()) {
+          supported = false;
+        } else {
+          param.data_ = fixed_vec->get_data();
+          param.nulls_ = fixed_vec->get_nulls()->align_at(0);
+          param.stride_ = 1;
+          has_fixed = true;
+        }
+      } else if (VEC_UNIFORM == e->get_format(eval_ctx)) {
+        param.data_ = reinterpret_cast<const char *>(
+            static_cast<ObUniformBase *>(vec)->get_datums());
+        param.stride_ = 1;
+        has_datum = true;
+      } else {
+        supported = false;
+      }
+    } else {
+      if (OB_FAIL(e->eval_batch(eval_ctx, skip, bsize))) {
+        LOG_WARN("evaluate batch failed", K(ret), KPC(e));
+      } else if (!e->is_batch_result()) {
+        param.data_ = reinterpret_cast<const char *>(&e->locate_expr_datum(eval_ctx));
+      } else {
+        param.data_ = reinterpret_cast<const char *>(e->locate_batch_datums(eval_ctx));
+        param.stride_ = 1;
+        has_datum = true;
+      }
+    }
+  }
+  if (OB_FAIL(ret) || !supported) {
+  } else if (has_fixed && has_datum) {
+    // mixed vector formats, not worth another kernel variant
+    supported = false;
+  } else if (has_fixed) {
+    layout = FIXED_LAYOUT;
+    // pass 2: convert scalar leaves to fixed format
+    for (int64_t i = 0; i < leaves_.count(); i++) {
+      ObExprJitLeafParam &param = params[i];
+      if (0 == param.stride_) {
+        const ObDatum *d = reinterpret_cast<const ObDatum *>(param.data_);
+        param.scalar_null_ = d->is_null() ? 1 : 0;
+        param.scalar_val_ = d->is_null() ? 0 : *d->int_;
+        param.data_ = reinterpret_cast<const char *>(&param.scalar_val_);
+        param.nulls_ = &param.scalar_null_;
+      }
+    }
+  } else {
+    layout = DATUM_LAYOUT;
+  }
+  return ret;
+}
+
+int ObExprJitFilter::filter(ObEvalCtx &eval_ctx,
+                            const bool use_rich_format,
+                            ObBitVector &skip,
+                            const int64_t bsize,
+                            bool &all_filtered,
+                            bool &all_active,
+                            bool &done) const
+{
+  int ret = OB_SUCCESS;
+  ObExprJitLeafParam params[MAX_LEAF_CNT];
+  LeafLayout layout = MAX_LAYOUT;
+  bool supported = false;
+  done = false;
+  if (OB_UNLIKELY(!is_compiled() || leaves_.count() > MAX_LEAF_CNT)) {
+    // do nothing, fall back to interpreter
+  } else if (OB_FAIL(prepare_leaves(eval_ctx, use_rich_format, skip, bsize, all_active,
+                                    params, layout, supported))) {
+    LOG_WARN("prepare jit filter leaves failed", K(ret));
+  } else if (supported) {
+    int64_t filtered_cnt = 0;
+    const int64_t output_rows = funcs_[layout](params, skip.align_at(0), bsize, &filtered_cnt);
+    if (output_rows >= 0) {
+      done = true;
+      all_filtered = (0 == output_rows);
+      all_active &= (0 == filtered_cnt);
+    } else {
+      LOG_DEBUG("jit filter fall back to interpreter", K_(id), K(bsize));
+    }
+  }
+  return ret;
+}
+
+struct ObExprJitCompiler::GenValue
+{
+  // int64 value, comparison and logic results are 0 or 1
+  ObLLVMValue val_;
+  // i1 null flag
+  ObLLVMValue null_;
+};
+
+struct ObExprJitCompiler::GenCtx
+{
+  GenCtx(ObLLVMHelper &helper,
+         const ObExprJitFilter::LeafLayout layout,
+         const ObIArray<ObExpr *> &leaves)
+    : helper_(helper), layout_(layout), leaves_(leaves), has_overflow_(false)
+  {}
+
+  ObLLVMHelper &helper_;
+  const ObExprJitFilter::LeafLayout layout_;
+  const ObIArray<ObExpr *> &leaves_;
+  ObLLVMType int32_type_;
+  ObLLVMType int64_type_;
+  ObLLVMType int8_ptr_type_;
+  ObLLVMType int32_ptr_type_;
+  ObLLVMType int64_ptr_type_;
+  ObLLVMValue true_;
+  ObLLVMValue false_;
+  // address of an int64 zero, loaded instead of the value of null datum
+  ObLLVMValue zero_addr_;
+  // current row index
+  ObLLVMValue idx_;
+  ObSEArray<ObLLVMValue, 8> leaf_data_;
+  ObSEArray<ObLLVMValue, 8> leaf_nulls_;
+  ObSEArray<ObLLVMValue, 8> leaf_stride_;
+  // i1, any arithmetic of current row overflowed
+  ObLLVMValue overflow_;
+  bool has_overflow_;
+};
+
+// pointer arithmetic: &ptr[idx]
+static int create_ptr_gep(ObLLVMHelper &helper, ObLLVMValue &ptr, ObLLVMValue &idx, ObLLVMValue &res)
+{
+  int ret = OB_SUCCESS;
+  ObSEArray<ObLLVMValue, 1> idxs;
+  if (OB_FAIL(idxs.push_back(idx))) {
+    LOG_WARN("push back failed", K(ret));
+  } else if (OB_FAIL(helper.create_gep(ObString("ptr"), ptr, idxs, res))) {
+    LOG_WARN("create gep failed", K(ret));
+  }
+  return ret;
+}
+
+ObExprJitCompiler::ObExprJitCompiler(ObIAllocator &alloc)
+  : alloc_(alloc), helper_(NULL), filters_(), is_compiled_(false)
+{
+}
+
+ObExprJitCompiler::~ObExprJitCompiler()
+{
+  destroy();
+}
+
+void ObExprJitCompiler::destroy()
+{
+  FOREACH(f, filters_) {
+    if (NULL != *f) {
+      (*f)->~ObExprJitFilter();
+      alloc_.free(*f);
+    }
+  }
+  filters_.reset();
+  // native code is released with the helper
+  if (NULL != helper_) {
+    helper_->~ObLLVMHelper();
+    alloc_.free(helper_);
+    helper_ = NULL;
+  }
+  is_compiled_ = false;
+}
+
+int ObExprJitCompiler::init_helper()
+{
+  int ret = OB_SUCCESS;
+  void *mem = NULL;
+  if (NULL != helper_) {
+    // do nothing
+  } else if (OB_ISNULL(mem = alloc_.alloc(sizeof(ObLLVMHelper)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret));
+  } else {
+    helper_ = new (mem) ObLLVMHelper(alloc_);
+    if (OB_FAIL(helper_->init())) {
+      LOG_WARN("init llvm helper failed", K(ret));
+      helper_->~ObLLVMHelper();
+      alloc_.free(helper_);
+      helper_ = NULL;
+    }
+  }
+  return ret;
+}
+
+bool ObExprJitCompiler::is_leaf(const ObExpr &expr, const ExprSet &input_set)
+{
+  return T_REF_COLUMN == expr.type_
+      || T_QUESTIONMARK == expr.type_
+      || IS_CONST_LITERAL(expr.type_)
+      || OB_HASH_EXIST == input_set.exist_refactored(reinterpret_cast<uint64_t>(&expr));
+}
+
+int ObExprJitCompiler::check_supported(const ObExpr &expr,
+                                       const ExprSet &input_set,
+                                       ObIArray<ObExpr *> &leaves,
+                                       bool &supported) const
+{
+  int ret = OB_SUCCESS;
+  int64_t arg_cnt = expr.arg_cnt_;
+  if (!ob_is_int_tc(expr.datum_meta_.type_)) {
+    supported = false;
+  } else if (is_leaf(expr, input_set)) {
+    if (OB_FAIL(add_var_to_array_no_dup(leaves, const_cast<ObExpr *>(&expr)))) {
+      LOG_WARN("add leaf failed", K(ret));
+    } else if (leaves.count() > ObExprJitFilter::MAX_LEAF_CNT) {
+      supported = false;
+    }
+  } else {
+    switch (expr.type_) {
+      case T_OP_EQ:
+      case T_OP_NE:
+      case T_OP_LT:
+      case T_OP_LE:
+      case T_OP_GT:
+      case T_OP_GE:
+      case T_OP_NSEQ:
+      case T_OP_ADD:
+      case T_OP_MINUS:
+      case T_OP_MUL: {
+        supported = (2 == arg_cnt);
+        break;
+      }
+      case T_OP_NEG:
+      case T_OP_NOT: {
+        supported = (1 == arg_cnt);
+        break;
+      }
+      case T_OP_AND:
+      case T_OP_OR:
+      case T_OP_CASE: {
+        supported = (arg_cnt >= 2);
+        break;
+      }
+      case T_FUN_SYS_CAST: {
+        // args_[1] is the const of destination type, only widening to bigint is identical
+        supported = (ObIntType == expr.datum_meta_.type_ && arg_cnt >= 1);
+        arg_cnt = 1;
+        break;
+      }
+      default: {
+        supported = false;
+        break;
+      }
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && supported && i < arg_cnt; i++) {
+      if (OB_ISNULL(expr.args_[i])) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("arg is NULL", K(ret), K(i));
+      } else if (OB_FAIL(check_supported(*expr.args_[i], input_set, leaves, supported))) {
+        LOG_WARN("check supported failed", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObExprJitCompiler::add_filter(const ObIArray<ObExpr *> &filters,
+                                  const ObIArray<ObExpr *> &input_exprs,
+                                  ObExprJitFilter *&jit_filter)
+{
+  int ret = OB_SUCCESS;
+  ExprSet input_set;
+  ObSEArray<ObExpr *, 8> leaves;
+  bool supported = !filters.empty();
+  jit_filter = NULL;
+  if (OB_UNLIKELY(is_compiled_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("module already compiled", K(ret));
+  } else if (OB_FAIL(input_set.create(std::max(input_exprs.count(), 1L) * 2,
+                                      ObMemAttr(MTL_ID(), "SqlExprJit")))) {
+    LOG_WARN("create hash set failed", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < input_exprs.count(); i++) {
+    if (OB_FAIL(input_set.set_refactored(reinterpret_cast<uint64_t>(input_exprs.at(i))))) {
+      LOG_WARN("add input expr failed", K(ret));
+    }
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && supported && i < filters.count(); i++) {
+    if (OB_ISNULL(filters.at(i))) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("filter is NULL", K(ret), K(i));
+    } else if (OB_FAIL(check_supported(*filters.at(i), input_set, leaves, supported))) {
+      LOG_WARN("check supported failed", K(ret));
+    }
+  }
+  if (OB_FAIL(ret) || !supported) {
+  } else if (OB_FAIL(init_helper())) {
+    LOG_WARN("init helper failed", K(ret));
+  } else if (OB_ISNULL(jit_filter = OB_NEWx(ObExprJitFilter, (&alloc_), alloc_))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret));
+  } else if (FALSE_IT(jit_filter->id_ = filters_.count())) {
+  } else if (OB_FAIL(filters_.push_back(jit_filter))) {
+    LOG_WARN("push back failed", K(ret));
+    jit_filter->~ObExprJitFilter();
+    alloc_.free(jit_filter);
+  } else if (OB_FAIL(jit_filter->leaves_.assign(leaves))) {
+    LOG_WARN("assign leaves failed", K(ret));
+  } else if (OB_FAIL(generate_func(*jit_filter, filters, ObExprJitFilter::FIXED_LAYOUT))) {
+    LOG_WARN("generate fixed layout kernel failed", K(ret));
+  } else if (OB_FAIL(generate_func(*jit_filter, filters, ObExprJitFilter::DATUM_LAYOUT))) {
+    LOG_WARN("generate datum layout kernel failed", K(ret));
+  }
+  if (OB_FAIL(ret)) {
+    jit_filter = NULL;
+  }
+  return ret;
+}
+
+int ObExprJitCompiler::compile()
+{
+  int ret = OB_SUCCESS;
+  char name[MAX_FUNC_NAME_LEN];
+  if (filters_.empty() || is_compiled_) {
+    // do nothing
+  } else if (OB_ISNULL(helper_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("helper is NULL", K(ret));
+  } else if (OB_FAIL(helper_->verify_module())) {
+    LOG_WARN("verify module failed", K(ret));
+  } else if (OB_FAIL(helper_->compile_module(static_cast<jit::ObPLOptLevel>(EXPR_JIT_OPT_LEVEL)))) {
+    LOG_WARN("compile module failed", K(ret));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < filters_.count(); i++) {
+      ObExprJitFilter *f = filters_.at(i);
+      for (int64_t l = 0; OB_SUCC(ret) && l < ObExprJitFilter::MAX_LAYOUT; l++) {
+        uint64_t addr = 0;
+        get_func_name(f->id_, static_cast<ObExprJitFilter::LeafLayout>(l), name, sizeof(name));
+        if (OB_FAIL(helper_->get_function_address(ObString(name), addr))) {
+          LOG_WARN("get function address failed", K(ret), K(name));
+        } else {
+          f->funcs_[l] = reinterpret_cast<ObExprJitFilterFunc>(addr);
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      is_compiled_ = true;
+    } else {
+      FOREACH(f, filters_) {
+        MEMSET((*f)->funcs_, 0, sizeof((*f)->funcs_));
+      }
+    }
+  }
+  return ret;
+}
+
+void ObExprJitCompiler::get_func_name(const int64_t id,
+                                      const ObExprJitFilter::LeafLayout layout,
+                                      char *buf,
+                                      const int64_t buf_len)
+{
+  int64_t pos = 0;
+  (void)databuff_printf(buf, buf_len, pos, "ob_jit_filter_%ld_%s", id,
+                        ObExprJitFilter::FIXED_LAYOUT == layout ? "fixed" : "datum");
+}
+
+// Kernel generated (pseudo code):
+//
+// int64_t kernel(ObExprJitLeafParam *leaves, uint64_t *skip, int64_t size, int64_t *filtered_cnt)
+// {
+//   int64_t output = 0, filtered = 0;
+//   for (int64_t i = 0; i < size; i++) {
+//     if (skip[i / 64] & (1 << (i % 64))) continue;
+//     <evaluate all filters of row i, branch free>
+//     if (overflow) return -1;
+//     if (all filters true) { output++; }
+//     else { skip[i / 64] |= (1 << (i % 64)); filtered++; }
+//   }
+//   *filtered_cnt = filtered;
+//   return output;
+// }
+int ObExprJitCompiler::generate_func(const ObExprJitFilter &jit_filter,
+                                     const ObIArray<ObExpr *> &filters,
+                                     const ObExprJitFilter::LeafLayout layout)
+{
+  int ret = OB_SUCCESS;
+  char name[MAX_FUNC_NAME_LEN];
+  ObLLVMHelper &h = *helper_;
+  GenCtx ctx(h, layout, jit_filter.leaves_);
+  ObLLVMType int8_type;
+  ObLLVMFunctionType func_type;
+  ObLLVMFunction func;
+  ObSEArray<ObLLVMType, 4> arg_types;
+  ObLLVMValue leaves_arg, skip_arg, size_arg, filtered_arg;
+  ObLLVMBasicBlock entry, loop_cond, loop_body, eval, bail, row_pass, row_filter, loop_inc, loop_end;
+  ObLLVMValue idx_ptr, out_ptr, filtered_ptr, zero_ptr;
+  ObLLVMValue zero, one, minus_one, word_shift, bit_mask;
+  get_func_name(jit_filter.id_, layout, name, sizeof(name));
+
+  OZ (h.get_llvm_type(ObInt32Type, ctx.int32_type_));
+  OZ (h.get_llvm_type(ObIntType, ctx.int64_type_));
+  OZ (h.get_llvm_type(ObTinyIntType, int8_type));
+  OZ (int8_type.get_pointer_to(ctx.int8_ptr_type_));
+  OZ (ctx.int32_type_.get_pointer_to(ctx.int32_ptr_type_));
+  OZ (ctx.int64_type_.get_pointer_to(ctx.int64_ptr_type_));
+  OZ (arg_types.push_back(ctx.int64_ptr_type_)); // leaves
+  OZ (arg_types.push_back(ctx.int64_ptr_type_)); // skip
+  OZ (arg_types.push_back(ctx.int64_type_));     // size
+  OZ (arg_types.push_back(ctx.int64_ptr_type_)); // filtered_cnt
+  OZ (ObLLVMFunctionType::get(ctx.int64_type_, arg_types, func_type));
+  OZ (h.create_function(ObString(name), func_type, func));
+  OZ (func.get_argument(0, leaves_arg));
+  OZ (func.get_argument(1, skip_arg));
+  OZ (func.get_argument(2, size_arg));
+  OZ (func.get_argument(3, filtered_arg));
+  OZ (h.create_block(ObString("entry"), func, entry));
+  OZ (h.create_block(ObString("loop_cond"), func, loop_cond));
+  OZ (h.create_block(ObString("loop_body"), func, loop_body));
+  OZ (h.create_block(ObString("eval"), func, eval));
+  OZ (h.create_block(ObString("bail"), func, bail));
+  OZ (h.create_block(ObString("row_pass"), func, row_pass));
+  OZ (h.create_block(ObString("row_filter"), func, row_filter));
+  OZ (h.create_block(ObString("loop_inc"), func, loop_inc));
+  OZ (h.create_block(ObString("loop_end"), func, loop_end));
+
+  // entry: init locals and load leaf params once
+  OZ (h.set_insert_point(entry));
+  OZ (h.get_int64(0, zero));
+  OZ (h.get_int64(1, one));
+  OZ (h.get_int64(-1, minus_one));
+  OZ (h.get_int64(6, word_shift));
+  OZ (h.get_int64(63, bit_mask));
+  OZ (h.create_icmp(zero, zero, ObLLVMHelper::ICMP_EQ, ctx.true_));
+  OZ (h.create_icmp(zero, zero, ObLLVMHelper::ICMP_NE, ctx.false_));
+  OZ (h.create_alloca(ObString("idx"), ctx.int64_type_, idx_ptr));
+  OZ (h.create_alloca(ObString("output"), ctx.int64_type_, out_ptr));
+  OZ (h.create_alloca(ObString("filtered"), ctx.int64_type_, filtered_ptr));
+  OZ (h.create_alloca(ObString("zero"), ctx.int64_type_, zero_ptr));
+  OZ (h.create_store(zero, idx_ptr));
+  OZ (h.create_store(zero, out_ptr));
+  OZ (h.create_store(zero, filtered_ptr));
+  OZ (h.create_store(zero, zero_ptr));
+  OZ (h.create_ptr_to_int(ObString("zero_addr"), zero_ptr, ctx.int64_type_, ctx.zero_addr_));
+  for (int64_t i = 0; OB_SUCC(ret) && i < jit_filter.leaves_.count(); i++) {
+    ObLLVMValue word_idx, word_ptr, data, nulls, stride;
+    OZ (h.get_int64(i * LEAF_PARAM_WORDS + LEAF_DATA_WORD, word_idx));
+    OZ (create_ptr_gep(h, leaves_arg, word_idx, word_ptr));
+    OZ (h.create_load(ObString("leaf_data"), word_ptr, data));
+    OZ (h.get_int64(i * LEAF_PARAM_WORDS + LEAF_NULLS_WORD, word_idx));
+    OZ (create_ptr_gep(h, leaves_arg, word_idx, word_ptr));
+    OZ (h.create_load(ObString("leaf_nulls"), word_ptr, nulls));
+    OZ (h.get_int64(i * LEAF_PARAM_WORDS + LEAF_STRIDE_WORD, word_idx));
+    OZ (create_ptr_gep(h, leaves_arg, word_idx, word_ptr));
+    OZ (h.create_load(ObString("leaf_stride"), word_ptr, stride));
+    OZ (ctx.leaf_data_.push_back(data));
+    OZ (ctx.leaf_nulls_.push_back(nulls));
+    OZ (ctx.leaf_stride_.push_back(stride));
+  }
+  OZ (h.create_br(loop_cond));
+
+  // loop_cond: i < size
+  ObLLVMValue is_loop;
+  OZ (h.set_insert_point(loop_cond));
+  OZ (h.create_load(ObString("i"), idx_ptr, ctx.idx_));
+  OZ (h.create_icmp(ctx.idx_, size_arg, ObLLVMHelper::ICMP_SLT, is_loop));
+  OZ (h.create_cond_br(is_loop, loop_body, loop_end));
+
+  // loop_body: test skip bit
+  ObLLVMValue skip_word_idx, skip_word_ptr, skip_word, skip_bit_idx, skip_bit, skip_shifted, is_skip;
+  OZ (h.set_insert_point(loop_body));
+  OZ (h.create_lshr(ctx.idx_, word_shift, skip_word_idx));
+  OZ (create_ptr_gep(h, skip_arg, skip_word_idx, skip_word_ptr));
+  OZ (h.create_load(ObString("skip_word"), skip_word_ptr, skip_word));
+  OZ (h.create_and(ctx.idx_, bit_mask, skip_bit_idx));
+  OZ (h.create_shl(one, skip_bit_idx, skip_bit));
+  OZ (h.create_and(skip_word, skip_bit, skip_shifted));
+  OZ (h.create_icmp(skip_shifted, 0, ObLLVMHelper::ICMP_NE, is_skip));
+  OZ (h.create_cond_br(is_skip, loop_inc, eval));
+
+  // eval: all filters of the row, the row passes if every filter is true
+  ObLLVMValue pass = ctx.true_;
+  OZ (h.set_insert_point(eval));
+  for (int64_t i = 0; OB_SUCC(ret) && i < filters.count(); i++) {
+    GenValue v;
+    ObLLVMValue not_null, is_true, row_true;
+    OZ (generate_expr(ctx, *filters.at(i), v));
+    OZ (h.create_icmp(v.val_, 0, ObLLVMHelper::ICMP_NE, is_true));
+    OZ (h.create_xor(v.null_, ctx.true_, not_null));
+    OZ (h.create_and(is_true, not_null, row_true));
+    OZ (h.create_and(pass, row_true, pass));
+  }
+  if (OB_FAIL(ret)) {
+  } else if (ctx.has_overflow_) {
+    ObLLVMBasicBlock check;
+    OZ (h.create_block(ObString("check"), func, check));
+    OZ (h.create_cond_br(ctx.overflow_, bail, check));
+    OZ (h.set_insert_point(check));
+  }
+  OZ (h.create_cond_br(pass, row_pass, row_filter));
+
+  // bail: let the interpreter evaluate the batch and report the error
+  OZ (h.set_insert_point(bail));
+  OZ (h.create_ret(minus_one));
+
+  // row_pass: ++output
+  ObLLVMValue out_cnt;
+  OZ (h.set_insert_point(row_pass));
+  OZ (h.create_load(ObString("output"), out_ptr, out_cnt));
+  OZ (h.create_add(out_cnt, one, out_cnt));
+  OZ (h.create_store(out_cnt, out_ptr));
+  OZ (h.create_br(loop_inc));
+
+  // row_filter: set skip bit, ++filtered
+  ObLLVMValue new_word, filtered_cnt;
+  OZ (h.set_insert_point(row_filter));
+  OZ (h.create_or(skip_word, skip_bit, new_word));
+  OZ (h.create_store(new_word, skip_word_ptr));
+  OZ (h.create_load(ObString("filtered"), filtered_ptr, filtered_cnt));
+  OZ (h.create_add(filtered_cnt, one, filtered_cnt));
+  OZ (h.create_store(filtered_cnt, filtered_ptr));
+  OZ (h.create_br(loop_inc));
+
+  // loop_inc: ++i
+  ObLLVMValue next_idx;
+  OZ (h.set_insert_point(loop_inc));
+  OZ (h.create_add(ctx.idx_, one, next_idx));
+  OZ (h.create_store(next_idx, idx_ptr));
+  OZ (h.create_br(loop_cond));
+
+  // loop_end
+  ObLLVMValue ret_filtered, ret_output;
+  OZ (h.set_insert_point(loop_end));
+  OZ (h.create_load(ObString("filtered"), filtered_ptr, ret_filtered));
+  OZ (h.create_store(ret_filtered, filtered_arg));
+  OZ (h.create_load(ObString("output"), out_ptr, ret_output));
+  OZ (h.create_ret(ret_output));
+  return ret;
+}
+
+int ObExprJitCompiler::generate_leaf(GenCtx &ctx, const int64_t leaf_idx, GenValue &res)
+{
+  int ret = OB_SUCCESS;
+  ObLLVMHelper &h = ctx.helper_;
+  ObLLVMValue pos;
+  OZ (h.create_mul(ctx.idx_, ctx.leaf_stride_.at(leaf_idx), pos));
+  if (OB_FAIL(ret)) {
+  } else if (ObExprJitFilter::FIXED_LAYOUT == ctx.layout_) {
+    // value: ((int64_t *)data)[pos], null: nulls[pos / 64] >> (pos % 64) & 1
+    ObLLVMValue data_ptr, val_ptr, nulls_ptr, word_idx, word_ptr, word, bit_idx, bit, low_bit;
+    ObLLVMValue one, shift, mask;
+    OZ (h.get_int64(1, one));
+    OZ (h.get_int64(6, shift));
+    OZ (h.get_int64(63, mask));
+    OZ (h.create_int_to_ptr(ObString("data"), ctx.leaf_data_.at(leaf_idx), ctx.int64_ptr_type_, data_ptr));
+    OZ (create_ptr_gep(h, data_ptr, pos, val_ptr));
+    OZ (h.create_load(ObString("val"), val_ptr, res.val_));
+    OZ (h.create_int_to_ptr(ObString("nulls"), ctx.leaf_nulls_.at(leaf_idx), ctx.int64_ptr_type_, nulls_ptr));
+    OZ (h.create_lshr(pos, shift, word_idx));
+    OZ (create_ptr_gep(h, nulls_ptr, word_idx, word_ptr));
+    OZ (h.create_load(ObString("null_word"), word_ptr, word));
+    OZ (h.create_and(pos, mask, bit_idx));
+    OZ (h.create_lshr(word, bit_idx, bit));
+    OZ (h.create_and(bit, one, low_bit));
+    OZ (h.create_icmp(low_bit, 0, ObLLVMHelper::ICMP_NE, res.null_));
+  } else {
+    // ObDatum is packed, address it by bytes
+    ObDatum datum;
+    const int64_t ptr_offset = reinterpret_cast<char *>(&datum.ptr_) - reinterpret_cast<char *>(&datum);
+    const int64_t pack_offset = reinterpret_cast<char *>(&datum.pack_) - reinterpret_cast<char *>(&datum);
+    ObDatumDesc null_desc;
+    null_desc.set_null();
+    ObLLVMValue datum_size, off, base, datum_ptr, ptr_off, ptr_addr, ptr_int;
+    ObLLVMValue pack_off, pack_addr, pack, null_mask, null_bits, safe_ptr, val_ptr;
+    OZ (h.get_int64(sizeof(ObDatum), datum_size));
+    OZ (h.create_mul(pos, datum_size, off));
+    OZ (h.create_int_to_ptr(ObString("datums"), ctx.leaf_data_.at(leaf_idx), ctx.int8_ptr_type_, base));
+    OZ (create_ptr_gep(h, base, off, datum_ptr));
+    OZ (h.get_int64(ptr_offset, ptr_off));
+    OZ (create_ptr_gep(h, datum_ptr, ptr_off, ptr_addr));
+    OZ (h.create_bit_cast(ObString("ptr_addr"), ptr_addr, ctx.int64_ptr_type_, ptr_addr));
+    OZ (h.create_load(ObString("ptr"), ptr_addr, ptr_int));
+    OZ (h.get_int64(pack_offset, pack_off));
+    OZ (create_ptr_gep(h, datum_ptr, pack_off, pack_addr));
+    OZ (h.create_bit_cast(ObString("pack_addr"), pack_addr, ctx.int32_ptr_type_, pack_addr));
+    OZ (h.create_load(ObString("pack"), pack_addr, pack));
+    OZ (h.get_int32(static_cast<int32_t>(null_desc.pack_), null_mask));
+    OZ (h.create_and(pack, null_mask, null_bits));
+    OZ (h.create_icmp(null_bits, 0, ObLLVMHelper::ICMP_NE, res.null_));
+    // pointer of null datum may be invalid, read the zero scratch instead
+    OZ (h.create_select(res.null_, ctx.zero_addr_, ptr_int, safe_ptr));
+    OZ (h.create_int_to_ptr(ObString("val_ptr"), safe_ptr, ctx.int64_ptr_type_, val_ptr));
+    OZ (h.create_load(ObString("val"), val_ptr, res.val_));
+  }
+  return ret;
+}
+
+int ObExprJitCompiler::generate_logic(GenCtx &ctx, const ObExpr &expr, GenValue &res)
+{
+  int ret = OB_SUCCESS;
+  ObLLVMHelper &h = ctx.helper_;
+  const bool is_and = (T_OP_AND == expr.type_);
+  // AND: decided by any non-null false; OR: decided by any non-null true
+  ObLLVMValue decided = ctx.false_;
+  ObLLVMValue any_null = ctx.false_;
+  for (int64_t i = 0; OB_SUCC(ret) && i < expr.arg_cnt_; i++) {
+    GenValue v;
+    ObLLVMValue not_null, cond, arg_decided;
+    OZ (generate_expr(ctx, *expr.args_[i], v));
+    OZ (h.create_icmp(v.val_, 0, is_and ? ObLLVMHelper::ICMP_EQ : ObLLVMHelper::ICMP_NE, cond));
+    OZ (h.create_xor(v.null_, ctx.true_, not_null));
+    OZ (h.create_and(cond, not_null, arg_decided));
+    OZ (h.create_or(decided, arg_decided, decided));
+    OZ (h.create_or(any_null, v.null_, any_null));
+  }
+  ObLLVMValue not_decided, res_bool;
+  OZ (h.create_xor(decided, ctx.true_, not_decided));
+  OZ (h.create_and(not_decided, any_null, res.null_));
+  if (is_and) {
+    // true only if not decided and no null
+    ObLLVMValue no_null;
+    OZ (h.create_xor(any_null, ctx.true_, no_null));
+    OZ (h.create_and(not_decided, no_null, res_bool));
+  } else {
+    res_bool = decided;
+  }
+  OZ (h.create_zext(ObString("logic"), res_bool, ctx.int64_type_, res.val_));
+  return ret;
+}
+
+int ObExprJitCompiler::generate_case(GenCtx &ctx, const ObExpr &expr, GenValue &res)
+{
+  int ret = OB_SUCCESS;
+  ObLLVMHelper &h = ctx.helper_;
+  const bool has_else = (expr.arg_cnt_ % 2 != 0);
+  const int64_t loop = has_else ? expr.arg_cnt_ - 1 : expr.arg_cnt_;
+  if (has_else) {
+    OZ (generate_expr(ctx, *expr.args_[expr.arg_cnt_ - 1], res));
+  } else {
+    OZ (h.get_int64(0, res.val_));
+    OX (res.null_ = ctx.true_);
+  }
+  // select from the last branch, so the first matched branch wins
+  for (int64_t i = loop - 2; OB_SUCC(ret) && i >= 0; i -= 2) {
+    GenValue when, then;
+    ObLLVMValue is_true, not_null, matched;
+    OZ (generate_expr(ctx, *expr.args_[i], when));
+    OZ (generate_expr(ctx, *expr.args_[i + 1], then));
+    OZ (h.create_icmp(when.val_, 0, ObLLVMHelper::ICMP_NE, is_true));
+    OZ (h.create_xor(when.null_, ctx.true_, not_null));
+    OZ (h.create_and(is_true, not_null, matched));
+    OZ (h.create_select(matched, then.val_, res.val_, res.val_));
+    OZ (h.create_select(matched, then.null_, res.null_, res.null_));
+  }
+  return ret;
+}
+
+int ObExprJitCompiler::generate_expr(GenCtx &ctx, const ObExpr &expr, GenValue &res)
+{
+  int ret = OB_SUCCESS;
+  ObLLVMHelper &h = ctx.helper_;
+  int64_t leaf_idx = -1;
+  for (int64_t i = 0; leaf_idx < 0 && i < ctx.leaves_.count(); i++) {
+    if (&expr == ctx.leaves_.at(i)) {
+      leaf_idx = i;
+    }
+  }
+  if (leaf_idx >= 0) {
+    OZ (generate_leaf(ctx, leaf_idx, res));
+  } else {
+    switch (expr.type_) {
+      case T_OP_EQ:
+      case T_OP_NE:
+      case T_OP_LT:
+      case T_OP_LE:
+      case T_OP_GT:
+      case T_OP_GE: {
+        GenValue l, r;
+        ObLLVMValue cmp;
+        ObLLVMHelper::CMPTYPE cmp_type = ObLLVMHelper::ICMP_EQ;
+        switch (expr.type_) {
+          case T_OP_NE: cmp_type = ObLLVMHelper::ICMP_NE; break;
+          case T_OP_LT: cmp_type = ObLLVMHelper::ICMP_SLT; break;
+          case T_OP_LE: cmp_type = ObLLVMHelper::ICMP_SLE; break;
+          case T_OP_GT: cmp_type = ObLLVMHelper::ICMP_SGT; break;
+          case T_OP_GE: cmp_type = ObLLVMHelper::ICMP_SGE; break;
+          default: break;
+        }
+        OZ (generate_expr(ctx, *expr.args_[0], l));
+        OZ (generate_expr(ctx, *expr.args_[1], r));
+        OZ (h.create_icmp(l.val_, r.val_, cmp_type, cmp));
+        OZ (h.create_zext(ObString("cmp"), cmp, ctx.int64_type_, res.val_));
+        OZ (h.create_or(l.null_, r.null_, res.null_));
+        break;
+      }
+      case T_OP_NSEQ: {
+        // both null, or both not null and equal
+        GenValue l, r;
+        ObLLVMValue cmp, both_null, any_null, not_any_null, equal, nseq;
+        OZ (generate_expr(ctx, *expr.args_[0], l));
+        OZ (generate_expr(ctx, *expr.args_[1], r));
+        OZ (h.create_icmp(l.val_, r.val_, ObLLVMHelper::ICMP_EQ, cmp));
+        OZ (h.create_and(l.null_, r.null_, both_null));
+        OZ (h.create_or(l.null_, r.null_, any_null));
+        OZ (h.create_xor(any_null, ctx.true_, not_any_null));
+        OZ (h.create_and(cmp, not_any_null, equal));
+        OZ (h.create_or(both_null, equal, nseq));
+        OZ (h.create_zext(ObString("nseq"), nseq, ctx.int64_type_, res.val_));
+        OX (res.null_ = ctx.false_);
+        break;
+      }
+      case T_OP_ADD:
+      case T_OP_MINUS:
+      case T_OP_MUL:
+      case T_OP_NEG: {
+        GenValue l, r;
+        ObLLVMValue overflow, not_null;
+        ObLLVMHelper::OVERFLOWTYPE type = ObLLVMHelper::SADD_OVERFLOW;
+        if (T_OP_NEG == expr.type_) {
+          // -x is 0 - x
+          type = ObLLVMHelper::SSUB_OVERFLOW;
+          OZ (h.get_int64(0, l.val_));
+          OX (l.null_ = ctx.false_);
+          OZ (generate_expr(ctx, *expr.args_[0], r));
+        } else {
+          type = T_OP_ADD == expr.type_ ? ObLLVMHelper::SADD_OVERFLOW
+              : (T_OP_MINUS == expr.type_ ? ObLLVMHelper::SSUB_OVERFLOW : ObLLVMHelper::SMUL_OVERFLOW);
+          OZ (generate_expr(ctx, *expr.args_[0], l));
+          OZ (generate_expr(ctx, *expr.args_[1], r));
+        }
+        OZ (h.create_with_overflow(l.val_, r.val_, type, res.val_, overflow));
+        OZ (h.create_or(l.null_, r.null_, res.null_));
+        // overflow of null result is not an error
+        OZ (h.create_xor(res.null_, ctx.true_, not_null));
+        OZ (h.create_and(overflow, not_null, overflow));
+        if (OB_FAIL(ret)) {
+        } else if (ctx.has_overflow_) {
+          OZ (h.create_or(ctx.overflow_, overflow, ctx.overflow_));
+        } else {
+          ctx.overflow_ = overflow;
+          ctx.has_overflow_ = true;
+        }
+        break;
+      }
+      case T_OP_NOT: {
+        GenValue v;
+        ObLLVMValue is_false;
+        OZ (generate_expr(ctx, *expr.args_[0], v));
+        OZ (h.create_icmp(v.val_, 0, ObLLVMHelper::ICMP_EQ, is_false));
+        OZ (h.create_zext(ObString("not"), is_false, ctx.int64_type_, res.val_));
+        OX (res.null_ = v.null_);
+        break;
+      }
+      case T_OP_AND:
+      case T_OP_OR: {
+        OZ (generate_logic(ctx, expr, res));
+        break;
+      }
+      case T_OP_CASE: {
+        OZ (generate_case(ctx, expr, res));
+        break;
+      }
+      case T_FUN_SYS_CAST: {
+        // integer widening to bigint, the datum value is identical
+        OZ (generate_expr(ctx, *expr.args_[0], res));
+        break;
+      }
+      default: {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected expr type", K(ret), K(expr.type_));
+        break;
+      }
+    }
+  }
+  return ret;
+}
+
+} // end namespace sql
+} // end namespace oceanbase
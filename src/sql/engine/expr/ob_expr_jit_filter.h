@@ -0,0 +1,169 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef SRC_SQL_ENGINE_EXPR_OB_EXPR_JIT_FILTER_H_
+#define SRC_SQL_ENGINE_EXPR_OB_EXPR_JIT_FILTER_H_
+
+#include "lib/hash/ob_hashset.h"
+#include "sql/engine/expr/ob_expr.h"
+
+namespace oceanbase
+{
+namespace jit
+{
+class ObLLVMHelper;
+}
+namespace sql
+{
+
+// Per leaf argument of a compiled filter kernel, every member is 8 bytes wide
+// because the generated code addresses this struct as an int64_t array.
+struct ObExprJitLeafParam
+{
+  // FIXED_LAYOUT: int64_t array; DATUM_LAYOUT: ObDatum array
+  const char *data_;
+  // FIXED_LAYOUT only: null bitmap words
+  const uint64_t *nulls_;
+  // 1 for batch results, 0 for scalar (const or param) leaves
+  int64_t stride_;
+  // backing storage of scalar leaves in FIXED_LAYOUT
+  int64_t scalar_val_;
+  uint64_t scalar_null_;
+  TO_STRING_KV(KP_(data), KP_(nulls), K_(stride), K_(scalar_val), K_(scalar_null));
+};
+
+// Return the number of rows passed, or -1 if any row needs the interpreter
+// (e.g. arithmetic overflow), in which case %skip may be partially updated
+// with rows that are filtered without doubt.
+typedef int64_t (*ObExprJitFilterFunc)(ObExprJitLeafParam *leaves,
+                                       uint64_t *skip,
+                                       const int64_t size,
+                                       int64_t *filtered_cnt);
+
+// Filter conjunction of an operator fused into one native batch kernel.
+// Immutable after compiled, shared by all executions of the cached plan.
+class ObExprJitFilter
+{
+public:
+  enum LeafLayout
+  {
+    FIXED_LAYOUT = 0,
+    DATUM_LAYOUT = 1,
+    MAX_LAYOUT
+  };
+  static const int64_t MAX_LEAF_CNT = 32;
+
+  explicit ObExprJitFilter(common::ObIAllocator &alloc)
+    : id_(0), leaves_(&alloc)
+  {
+    MEMSET(funcs_, 0, sizeof(funcs_));
+  }
+  ~ObExprJitFilter() {}
+
+  bool is_compiled() const { return NULL != funcs_[FIXED_LAYOUT] && NULL != funcs_[DATUM_LAYOUT]; }
+  // Evaluate the filter for the batch. %done is set to false if the kernel is
+  // not applicable to this batch and the caller should fall back to the
+  // interpreter.
+  int filter(ObEvalCtx &eval_ctx,
+             const bool use_rich_format,
+             ObBitVector &skip,
+             const int64_t bsize,
+             bool &all_filtered,
+             bool &all_active,
+             bool &done) const;
+
+  TO_STRING_KV(K_(id), K_(leaves), KP(funcs_[FIXED_LAYOUT]), KP(funcs_[DATUM_LAYOUT]));
+
+private:
+  int prepare_leaves(ObEvalCtx &eval_ctx,
+                     const bool use_rich_format,
+                     const ObBitVector &skip,
+                     const int64_t bsize,
+                     const bool all_active,
+                     ObExprJitLeafParam *params,
+                     LeafLayout &layout,
+                     bool &supported) const;
+
+public:
+  int64_t id_;
+  // leaf expressions evaluated by the interpreter before running the kernel,
+  // the position in the array is the leaf index in the kernel
+  ExprFixedArray leaves_;
+  ObExprJitFilterFunc funcs_[MAX_LAYOUT];
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObExprJitFilter);
+};
+
+// Generate filter kernels of a physical plan into one LLVM module. Owned by the
+// physical plan, so the native code is cached in plan cache with the plan and
+// released with it.
+//
+// Supported expressions are signed integer type class only:
+//   column ref, param, const, and any expression produced by child operator (leaves)
+//   + - * and unary minus, overflow makes the kernel fall back to interpreter
+//   = <> < <= > >= <=>
+//   AND OR NOT with three-valued logic
+//   CASE WHEN, and casts between integer types widening to bigint
+class ObExprJitCompiler
+{
+public:
+  explicit ObExprJitCompiler(common::ObIAllocator &alloc);
+  ~ObExprJitCompiler();
+  void destroy();
+
+  // Try generate kernel for %filters, %input_exprs are exprs calculated by
+  // child operators which are treated as leaves. %jit_filter is set to NULL
+  // if some expression is not supported.
+  int add_filter(const common::ObIArray<ObExpr *> &filters,
+                 const common::ObIArray<ObExpr *> &input_exprs,
+                 ObExprJitFilter *&jit_filter);
+  // Compile the module and resolve kernel address of all added filters.
+  int compile();
+  int64_t get_filter_count() const { return filters_.count(); }
+
+  TO_STRING_KV(K_(is_compiled), K_(filters));
+
+private:
+  typedef common::hash::ObHashSet<uint64_t, common::hash::NoPthreadDefendMode> ExprSet;
+  struct GenCtx;
+  struct GenValue;
+
+  int init_helper();
+  int check_supported(const ObExpr &expr,
+                      const ExprSet &input_set,
+                      common::ObIArray<ObExpr *> &leaves,
+                      bool &supported) const;
+  static bool is_leaf(const ObExpr &expr, const ExprSet &input_set);
+  int generate_func(const ObExprJitFilter &jit_filter,
+                    const common::ObIArray<ObExpr *> &filters,
+                    const ObExprJitFilter::LeafLayout layout);
+  int generate_expr(GenCtx &ctx, const ObExpr &expr, GenValue &res);
+  int generate_leaf(GenCtx &ctx, const int64_t leaf_idx, GenValue &res);
+  int generate_logic(GenCtx &ctx, const ObExpr &expr, GenValue &res);
+  int generate_case(GenCtx &ctx, const ObExpr &expr, GenValue &res);
+  static void get_func_name(const int64_t id,
+                            const ObExprJitFilter::LeafLayout layout,
+                            char *buf,
+                            const int64_t buf_len);
+
+private:
+  common::ObIAllocator &alloc_;
+  jit::ObLLVMHelper *helper_;
+  common::ObSEArray<ObExprJitFilter *, 4> filters_;
+  bool is_compiled_;
+  DISALLOW_COPY_AND_ASSIGN(ObExprJitCompiler);
+};
+
+} // end namespace sql
+} // end namespace oceanbase
+
+#endif // SRC_SQL_ENGINE_EXPR_OB_EXPR_JIT_FILTER_H_
@@ -75,6 +75,8 @@ int JoinHashTable::init(JoinTableCtx &hjt_ctx, ObIAllocator &allocator)
     LOG_WARN("fail to new hash table", K(ret));
   } else if (OB_FAIL(hash_table_->init(allocator, hjt_ctx.max_batch_size_))) {
     LOG_WARN("alloc bucket array failed", K(ret));
+  } else {
+    allocator_ = &allocator;
   }
   return ret;
 }
@@ -88,26 +90,151 @@ int JoinHashTable::build(JoinPartitionRowIter &iter, JoinTableCtx &ctx) {
   int ret = OB_SUCCESS;
   int64_t used_buckets = 0;
   int64_t collisions = 0;
-  while (OB_SUCC(ret)) {
+  const int64_t radix_bits = get_radix_bits(ctx);
+  if (radix_bits > 0) {
+    if (OB_FAIL(build_with_radix_partition(iter, ctx, radix_bits))) {
+      LOG_WARN("fail to build with radix partition", K(ret), K(radix_bits));
+    }
+  } else {
+    while (OB_SUCC(ret)) {
+      int64_t read_size = 0;
+      if (OB_FAIL(iter.get_next_batch(ctx.stored_rows_,
+                                      ctx.max_batch_size_,
+                                      read_size))) {
+        if (OB_ITER_END != ret) {
+          LOG_WARN("get next batch failed", K(ret));
+        }
+      } else if (OB_FAIL(hash_table_->insert_batch(ctx,
+              const_cast<ObHJStoredRow **>(ctx.stored_rows_), read_size, used_buckets, collisions))) {
+        LOG_WARN("fail to insert batch", K(ret));
+      }
+      LOG_DEBUG("build hash join table", K(read_size), K(ret));
+    }
+    hash_table_->set_diag_info(used_buckets, collisions);
+
+    if (OB_ITER_END == ret) {
+      ret = OB_SUCCESS;
+    }
+  }
+
+  return ret;
+}
+
+// Radix partition only pays off when the bucket array is much larger than the
+// cache, the shared hash table is built concurrently by all threads of the sqc,
+// which is not supported.
+int64_t JoinHashTable::get_radix_bits(const JoinTableCtx &ctx) const
+{
+  int64_t radix_bits = 0;
+  if (ctx.enable_radix_build_ && !ctx.is_shared_ && OB_NOT_NULL(allocator_)
+      && hash_table_->get_row_count() >= ObHJRadixPartitioner::MAX_FANOUT) {
+    radix_bits = ObHJRadixPartitioner::calc_radix_bits(hash_table_->get_nbuckets(),
+                                                       hash_table_->get_one_bucket_size());
+  }
+  return radix_bits;
+}
+
+// Rows are read and partitioned chunk by chunk, then inserted in the order of
+// their bucket position, so the inserting of each chunk sweeps the bucket
+// array instead of jumping around it.
+int JoinHashTable::build_with_radix_partition(JoinPartitionRowIter &iter,
+                                              JoinTableCtx &ctx,
+                                              const int64_t radix_bits)
+{
+  int ret = OB_SUCCESS;
+  int64_t used_buckets = 0;
+  int64_t collisions = 0;
+  bool iter_end = false;
+  int64_t charged_size = 0;
+  ObHJRadixPartitioner partitioner;
+  const int64_t capacity = MAX(ctx.max_batch_size_,
+      MIN(hash_table_->get_row_count(), ObHJRadixPartitioner::MAX_CHUNK_ITEM_CNT));
+  if (OB_FAIL(partitioner.init(*allocator_, capacity))) {
+    LOG_WARN("fail to init radix partitioner", K(ret), K(capacity));
+  } else if (OB_NOT_NULL(ctx.sql_mem_processor_)) {
+    // the chunk buffer is extra memory of the operator, account it until the build ends
+    charged_size = partitioner.get_mem_size();
+    ctx.sql_mem_processor_->alloc(charged_size);
+  }
+  while (OB_SUCC(ret) && !iter_end) {
     int64_t read_size = 0;
     if (OB_FAIL(iter.get_next_batch(ctx.stored_rows_,
                                     ctx.max_batch_size_,
                                     read_size))) {
       if (OB_ITER_END != ret) {
         LOG_WARN("get next batch failed", K(ret));
+      } else {
+        iter_end = true;
+        read_size = 0;
+        ret = OB_SUCCESS;
       }
-    } else if (OB_FAIL(hash_table_->insert_batch(ctx,
-            const_cast<ObHJStoredRow **>(ctx.stored_rows_), read_size, used_buckets, collisions))) {
-      LOG_WARN("fail to insert batch", K(ret));
     }
-    LOG_DEBUG("build hash join table", K(read_size), K(ret));
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(add_to_radix_chunk(ctx, partitioner, read_size, iter_end, radix_bits,
+                                          used_buckets, collisions))) {
+      LOG_WARN("fail to add rows to radix chunk", K(ret), K(read_size), K(partitioner));
+    }
+  }
+  if (charged_size > 0) {
+    ctx.sql_mem_processor_->free(charged_size);
   }
   hash_table_->set_diag_info(used_buckets, collisions);
+  LOG_DEBUG("build hash join table with radix partition", K(ret), K(radix_bits),
+            "row_count", hash_table_->get_row_count(), "nbuckets", hash_table_->get_nbuckets());
+  return ret;
+}
 
-  if (OB_ITER_END == ret) {
-    ret = OB_SUCCESS;
+// Rows of ctx.stored_rows_ are added to the chunk, the chunk is partitioned and
+// inserted once it can not hold another batch or the input is drained.
+int JoinHashTable::add_to_radix_chunk(JoinTableCtx &ctx,
+                                      ObHJRadixPartitioner &partitioner,
+                                      const int64_t size,
+                                      const bool is_last,
+                                      const int64_t radix_bits,
+                                      int64_t &used_buckets,
+                                      int64_t &collisions)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(size > partitioner.remain())) {
+    ret = OB_SIZE_OVERFLOW;
+    LOG_WARN("radix chunk overflow", K(ret), K(size), K(partitioner));
+  } else {
+    for (int64_t i = 0; i < size; i++) {
+      partitioner.add(ctx.stored_rows_[i]->get_hash_value(ctx.build_row_meta_),
+                      const_cast<ObHJStoredRow *>(ctx.stored_rows_[i]));
+    }
   }
+  if (OB_FAIL(ret) || 0 == partitioner.count()) {
+  } else if (!is_last && partitioner.remain() >= ctx.max_batch_size_) {
+    // chunk not full
+  } else if (OB_FAIL(partitioner.partition(hash_table_->get_nbuckets(), radix_bits))) {
+    LOG_WARN("fail to radix partition", K(ret), K(radix_bits), K(partitioner));
+  } else if (OB_FAIL(insert_partitioned_rows(ctx, partitioner, used_buckets, collisions))) {
+    LOG_WARN("fail to insert partitioned rows", K(ret), K(partitioner));
+  } else {
+    partitioner.reuse();
+  }
+  return ret;
+}
 
+int JoinHashTable::insert_partitioned_rows(JoinTableCtx &ctx,
+                                           const ObHJRadixPartitioner &partitioner,
+                                           int64_t &used_buckets,
+                                           int64_t &collisions)
+{
+  int ret = OB_SUCCESS;
+  const ObHJRadixItem *items = partitioner.items();
+  for (int64_t start = 0; OB_SUCC(ret) && start < partitioner.count();
+       start += ctx.max_batch_size_) {
+    const int64_t size = MIN(ctx.max_batch_size_, partitioner.count() - start);
+    for (int64_t i = 0; i < size; i++) {
+      ctx.stored_rows_[i] = items[start + i].row_;
+    }
+    if (OB_FAIL(hash_table_->insert_batch(ctx,
+            const_cast<ObHJStoredRow **>(ctx.stored_rows_), size, used_buckets, collisions))) {
+      LOG_WARN("fail to insert batch", K(ret));
+    }
+  }
   return ret;
 }
 
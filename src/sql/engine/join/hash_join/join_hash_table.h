@@ -14,6 +14,7 @@
 #define SRC_SQL_ENGINE_JOIN_HASH_JOIN_JOIN_HASH_TABLE_H_
 
 #include "sql/engine/join/hash_join/hash_table.h"
+#include "sql/engine/join/hash_join/ob_hj_radix_partitioner.h"
 
 namespace oceanbase
 {
@@ -22,7 +23,7 @@ namespace sql
 
 class JoinHashTable {
 public:
-  JoinHashTable() : hash_table_(NULL)
+  JoinHashTable() : hash_table_(NULL), allocator_(NULL)
   {}
   int init(JoinTableCtx &hjt_ctx, ObIAllocator &allocator);
   bool use_normalized_ht(JoinTableCtx &hjt_ctx);
@@ -57,8 +58,26 @@ public:
   int64_t get_nbuckets() { return hash_table_->get_nbuckets(); }
   int64_t get_collisions() { return hash_table_->get_collisions(); }
 
+private:
+  int64_t get_radix_bits(const JoinTableCtx &ctx) const;
+  int build_with_radix_partition(JoinPartitionRowIter &iter,
+                                 JoinTableCtx &ctx,
+                                 const int64_t radix_bits);
+  int add_to_radix_chunk(JoinTableCtx &ctx,
+                         ObHJRadixPartitioner &partitioner,
+                         const int64_t size,
+                         const bool is_last,
+                         const int64_t radix_bits,
+                         int64_t &used_buckets,
+                         int64_t &collisions);
+  int insert_partitioned_rows(JoinTableCtx &ctx,
+                              const ObHJRadixPartitioner &partitioner,
+                              int64_t &used_buckets,
+                              int64_t &collisions);
+
 private:
   IHashTable *hash_table_;
+  ObIAllocator *allocator_;
 };
 
 } // end namespace sql
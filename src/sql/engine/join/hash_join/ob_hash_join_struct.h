@@ -27,6 +27,7 @@ namespace oceanbase
 {
 namespace sql
 {
+class ObSqlMemMgrProcessor;
 
 static const uint64_t END_ITEM = UINT64_MAX >> 1;
 
@@ -214,6 +215,7 @@ public:
                    build_key_proj_(NULL), probe_key_proj_(NULL), cur_bkid_(-1),
                    cur_tuple_(reinterpret_cast<void *>(END_ITEM)), max_output_cnt_(NULL),
                    cur_items_(NULL), stored_rows_(NULL), max_batch_size_(0),
+                   enable_radix_build_(false), sql_mem_processor_(NULL),
                    output_info_(NULL), probe_batch_rows_(NULL)
   {}
   void reuse() {
@@ -272,6 +274,10 @@ public:
   //template buffer for build table
   const ObHJStoredRow **stored_rows_;
   int64_t max_batch_size_;
+  // radix partition rows before inserting into large bucket array
+  bool enable_radix_build_;
+  // memory of the radix partition chunk is charged to it
+  ObSqlMemMgrProcessor *sql_mem_processor_;
 
   OutputInfo *output_info_;
   ProbeBatchRows *probe_batch_rows_;
@@ -211,6 +211,8 @@ int ObHashJoinVecOp::inner_open()
     if (tenant_config.is_valid()) {
       force_hash_join_spill_ = tenant_config->_force_hash_join_spill;
       hash_join_processor_ = tenant_config->_enable_hash_join_processor;
+      jt_ctx_.enable_radix_build_ = tenant_config->_enable_hash_join_radix_build;
+      jt_ctx_.sql_mem_processor_ = &sql_mem_processor_;
       if (0 == (hash_join_processor_ & HJ_PROCESSOR_MASK)) {
         ret = OB_ERR_UNEXPECTED;
         LOG_WARN("unexpect hash join processor", K(ret), K(hash_join_processor_));
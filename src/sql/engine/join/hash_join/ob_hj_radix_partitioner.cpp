@@ -0,0 +1,159 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+#define USING_LOG_PREFIX SQL_ENG
+
+#include "sql/engine/join/hash_join/ob_hj_radix_partitioner.h"
+#include "lib/oblog/ob_log.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace sql
+{
+
+int ObHJRadixPartitioner::init(ObIAllocator &alloc, const int64_t capacity)
+{
+  int ret = OB_SUCCESS;
+  // two item arrays for scatter and the cache line buffers, the buffers need
+  // to be cache line aligned
+  const int64_t size = calc_mem_size(capacity);
+  if (OB_NOT_NULL(buf_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret));
+  } else if (capacity <= 0) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(capacity));
+  } else if (OB_ISNULL(buf_ = alloc.alloc(size))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc radix partition buffer", K(ret), K(size));
+  } else {
+    alloc_ = &alloc;
+    swwc_bufs_ = reinterpret_cast<SWWCBuffer *>(
+        upper_align(reinterpret_cast<int64_t>(buf_), CACHE_ALIGN_SIZE));
+    items_ = reinterpret_cast<ObHJRadixItem *>(swwc_bufs_ + MAX_FANOUT);
+    tmp_items_ = items_ + capacity;
+    capacity_ = capacity;
+    count_ = 0;
+  }
+  return ret;
+}
+
+void ObHJRadixPartitioner::destroy()
+{
+  if (OB_NOT_NULL(buf_) && OB_NOT_NULL(alloc_)) {
+    alloc_->free(buf_);
+  }
+  alloc_ = NULL;
+  buf_ = NULL;
+  items_ = NULL;
+  tmp_items_ = NULL;
+  swwc_bufs_ = NULL;
+  capacity_ = 0;
+  count_ = 0;
+}
+
+int64_t ObHJRadixPartitioner::calc_radix_bits(const int64_t nbuckets, const int64_t bucket_size)
+{
+  int64_t bits = 0;
+  const int64_t table_size = nbuckets * bucket_size;
+  if (nbuckets > 0 && table_size >= MIN_TABLE_SIZE) {
+    const int64_t bucket_bits = __builtin_ctzll(nbuckets);
+    while (bits < MAX_RADIX_BITS && (table_size >> bits) > TARGET_RANGE_SIZE) {
+      bits++;
+    }
+    bits = MIN(bits, bucket_bits);
+  }
+  return bits;
+}
+
+void ObHJRadixPartitioner::scatter(const ObHJRadixItem *src,
+                                   ObHJRadixItem *dst,
+                                   const int64_t count,
+                                   const int64_t shift,
+                                   const int64_t bits,
+                                   int64_t *part_ends)
+{
+  const int64_t fanout = 1L << bits;
+  const uint64_t mask = fanout - 1;
+  int64_t cursors[MAX_FANOUT];
+  int64_t buf_cnts[MAX_FANOUT];
+  MEMSET(cursors, 0, sizeof(cursors[0]) * fanout);
+  MEMSET(buf_cnts, 0, sizeof(buf_cnts[0]) * fanout);
+  // histogram and prefix sum
+  for (int64_t i = 0; i < count; i++) {
+    cursors[(src[i].hash_ >> shift) & mask]++;
+  }
+  int64_t offset = 0;
+  for (int64_t p = 0; p < fanout; p++) {
+    const int64_t cnt = cursors[p];
+    cursors[p] = offset;
+    offset += cnt;
+    part_ends[p] = offset;
+  }
+  // Fill the cache line buffer of the partition and flush it when full. The
+  // first flush of a partition may be unaligned to cache line, which only
+  // costs a partial write.
+  for (int64_t i = 0; i < count; i++) {
+    const int64_t p = (src[i].hash_ >> shift) & mask;
+    SWWCBuffer &buf = swwc_bufs_[p];
+    buf.items_[buf_cnts[p]++] = src[i];
+    if (SWWC_ITEM_CNT == buf_cnts[p]) {
+      MEMCPY(dst + cursors[p], buf.items_, sizeof(buf.items_));
+      cursors[p] += SWWC_ITEM_CNT;
+      buf_cnts[p] = 0;
+    }
+  }
+  for (int64_t p = 0; p < fanout; p++) {
+    if (buf_cnts[p] > 0) {
+      MEMCPY(dst + cursors[p], swwc_bufs_[p].items_, buf_cnts[p] * sizeof(ObHJRadixItem));
+    }
+  }
+}
+
+int ObHJRadixPartitioner::partition(const int64_t nbuckets, const int64_t radix_bits)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(buf_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (nbuckets <= 0 || 0 != (nbuckets & (nbuckets - 1))
+             || radix_bits <= 0 || radix_bits > MAX_RADIX_BITS
+             || (1L << radix_bits) > nbuckets) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(nbuckets), K(radix_bits));
+  } else if (count_ > 0) {
+    const int64_t bucket_bits = __builtin_ctzll(nbuckets);
+    const int64_t first_bits = MIN(radix_bits, FANOUT_BITS);
+    const int64_t second_bits = radix_bits - first_bits;
+    int64_t part_ends[MAX_FANOUT];
+    int64_t unused_ends[MAX_FANOUT];
+    scatter(items_, tmp_items_, count_, bucket_bits - first_bits, first_bits, part_ends);
+    if (0 == second_bits) {
+      std::swap(items_, tmp_items_);
+    } else {
+      // partition each first pass partition by the following bits back to items_
+      int64_t begin = 0;
+      for (int64_t p = 0; p < (1L << first_bits); p++) {
+        const int64_t end = part_ends[p];
+        if (end > begin) {
+          scatter(tmp_items_ + begin, items_ + begin, end - begin,
+                  bucket_bits - radix_bits, second_bits, unused_ends);
+        }
+        begin = end;
+      }
+    }
+  }
+  return ret;
+}
+
+} // end namespace sql
+} // end namespace oceanbase
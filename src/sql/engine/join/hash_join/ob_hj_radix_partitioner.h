@@ -0,0 +1,119 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef SRC_SQL_ENGINE_JOIN_HASH_JOIN_OB_HJ_RADIX_PARTITIONER_H_
+#define SRC_SQL_ENGINE_JOIN_HASH_JOIN_OB_HJ_RADIX_PARTITIONER_H_
+
+#include "lib/allocator/ob_allocator.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+
+struct ObHJStoredRow;
+
+struct ObHJRadixItem
+{
+  uint64_t hash_;
+  ObHJStoredRow *row_;
+};
+
+// In-memory radix partitioner for the build side of hash join.
+//
+// When the bucket array is much larger than the cache, inserting rows in input
+// order touches a random bucket (cache line and page) for every row. The
+// partitioner clusters a chunk of (hash, row) items by the highest bits of
+// their bucket position, so that inserting them in the result order fills the
+// bucket array range by range, which saves the TLB and cache misses.
+//
+// Items are scattered through software write-combining buffers of one cache
+// line per partition, partitions are written out with full cache line copies.
+// Up to FANOUT_BITS bits are done in one pass, more bits (up to MAX_RADIX_BITS)
+// are done in two passes to keep the fanout of each pass TLB friendly.
+class ObHJRadixPartitioner
+{
+public:
+  static const int64_t FANOUT_BITS = 8;
+  static const int64_t MAX_FANOUT = 1L << FANOUT_BITS;
+  static const int64_t MAX_RADIX_BITS = 2 * FANOUT_BITS;
+  // Bucket array smaller than this is built directly, the batch prefetch of
+  // insert_batch already hides most cache misses of it.
+  static const int64_t MIN_TABLE_SIZE = 128L << 20;
+  // bucket array range of one partition, covered by a few huge pages
+  static const int64_t TARGET_RANGE_SIZE = 4L << 20;
+  // max items partitioned at once, bounds the extra memory to 32MB
+  static const int64_t MAX_CHUNK_ITEM_CNT = 1L << 20;
+private:
+  static const int64_t SWWC_ITEM_CNT = CACHE_ALIGN_SIZE / sizeof(ObHJRadixItem);
+  struct SWWCBuffer
+  {
+    ObHJRadixItem items_[SWWC_ITEM_CNT];
+  } CACHE_ALIGNED;
+public:
+  ObHJRadixPartitioner()
+    : alloc_(NULL), buf_(NULL), items_(NULL), tmp_items_(NULL), swwc_bufs_(NULL),
+      capacity_(0), count_(0)
+  {}
+  ~ObHJRadixPartitioner() { destroy(); }
+  int init(common::ObIAllocator &alloc, const int64_t capacity);
+  void destroy();
+  // memory allocated by init for %capacity items
+  static int64_t calc_mem_size(const int64_t capacity)
+  {
+    return 2 * capacity * sizeof(ObHJRadixItem) + MAX_FANOUT * sizeof(SWWCBuffer) + CACHE_ALIGN_SIZE;
+  }
+  int64_t get_mem_size() const { return NULL == buf_ ? 0 : calc_mem_size(capacity_); }
+  void reuse() { count_ = 0; }
+  int64_t count() const { return count_; }
+  int64_t remain() const { return capacity_ - count_; }
+  const ObHJRadixItem *items() const { return items_; }
+  OB_INLINE void add(const uint64_t hash, ObHJStoredRow *row)
+  {
+    items_[count_].hash_ = hash;
+    items_[count_].row_ = row;
+    count_++;
+  }
+  // Reorder the added items by the highest %radix_bits bits of their bucket
+  // position (hash & (nbuckets - 1)), the result is in items().
+  int partition(const int64_t nbuckets, const int64_t radix_bits);
+
+  // Return the radix bits to partition for a bucket array, 0 means the array
+  // is small enough to build directly.
+  static int64_t calc_radix_bits(const int64_t nbuckets, const int64_t bucket_size);
+
+  TO_STRING_KV(K_(capacity), K_(count));
+private:
+  // Scatter %src to %dst by bits [shift, shift + bits) of the hash,
+  // part_ends[i] is the end offset of partition i in %dst.
+  void scatter(const ObHJRadixItem *src,
+               ObHJRadixItem *dst,
+               const int64_t count,
+               const int64_t shift,
+               const int64_t bits,
+               int64_t *part_ends);
+private:
+  common::ObIAllocator *alloc_;
+  void *buf_;
+  ObHJRadixItem *items_;
+  ObHJRadixItem *tmp_items_;
+  SWWCBuffer *swwc_bufs_;
+  int64_t capacity_;
+  int64_t count_;
+  DISALLOW_COPY_AND_ASSIGN(ObHJRadixPartitioner);
+};
+
+} // end namespace sql
+} // end namespace oceanbase
+
+#endif /* SRC_SQL_ENGINE_JOIN_HASH_JOIN_OB_HJ_RADIX_PARTITIONER_H_ */
@@ -18,6 +18,7 @@
 #include "sql/engine/ob_exec_context.h"
 #include "common/ob_smart_call.h"
 #include "sql/engine/ob_exec_feedback_info.h"
+#include "sql/engine/expr/ob_expr_jit_filter.h"
 #include "observer/ob_server.h"
 
 namespace oceanbase
@@ -119,6 +120,7 @@ ObOpSpec::ObOpSpec(ObIAllocator &alloc, const ObPhyOperatorType type)
     output_(&alloc),
     startup_filters_(&alloc),
     filters_(&alloc),
+    jit_filter_(NULL),
     calc_exprs_(&alloc),
     cost_(0),
     rows_(0),
@@ -1515,10 +1517,21 @@ int ObOperator::filter_rows(const ObExprPtrIArray &exprs,
                             bool &all_filtered,
                             bool &all_active)
 {
-  return spec_.use_rich_format_
-         ? filter_vector_rows(exprs, skip, bsize, all_filtered, all_active)
-         : filter_batch_rows(exprs, skip, bsize, all_filtered, all_active);
-
+  int ret = OB_SUCCESS;
+  bool done = false;
+  if (NULL != spec_.jit_filter_ && &exprs == &spec_.filters_) {
+    if (OB_FAIL(spec_.jit_filter_->filter(eval_ctx_, spec_.use_rich_format_, skip, bsize,
+                                          all_filtered, all_active, done))) {
+      LOG_WARN("jit filter rows failed", K(ret));
+    }
+  }
+  if (OB_FAIL(ret) || done) {
+  } else {
+    ret = spec_.use_rich_format_
+          ? filter_vector_rows(exprs, skip, bsize, all_filtered, all_active)
+          : filter_batch_rows(exprs, skip, bsize, all_filtered, all_active);
+  }
+  return ret;
 }
 
 int ObOperator::filter_vector_rows(const ObExprPtrIArray &exprs,
@@ -42,6 +42,7 @@ class ObOperator;
 class ObOpInput;
 class ObTaskInfo;
 class ObExecFeedbackNode;
+class ObExprJitFilter;
 
 struct ObPhyOpSeriCtx
 {
@@ -331,6 +332,9 @@ public:
   ExprFixedArray startup_filters_;
   // Filter expressions
   ExprFixedArray filters_;
+  // Native kernel of %filters_ owned by physical plan, not serialized, so
+  // remote or px workers without it use the interpreter.
+  const ObExprJitFilter *jit_filter_;
   // All expressions used in this operator but not exists in children's output.
   // Need to reset those expressions' evaluated_ flag after fetch row from child.
   ExprFixedArray calc_exprs_;
@@ -148,7 +148,8 @@ ObPhysicalPlan::ObPhysicalPlan(MemoryContext &mem_context /* = CURRENT_CONTEXT *
     need_switch_to_table_lock_worker_(false),
     data_complement_gen_doc_id_(false),
     dml_table_ids_(&allocator_),
-    direct_load_need_sort_(false)
+    direct_load_need_sort_(false),
+    expr_jit_compiler_(NULL)
 {
 }
 
@@ -255,12 +256,14 @@ void ObPhysicalPlan::reset()
   data_complement_gen_doc_id_ = false;
   dml_table_ids_.reset();
   direct_load_need_sort_ = false;
+  destroy_expr_jit_compiler();
 }
 void ObPhysicalPlan::destroy()
 {
 #ifndef NDEBUG
   bit_set_.reset();
 #endif
+  destroy_expr_jit_compiler();
   sql_expression_factory_.destroy();
   expr_op_factory_.destroy();
   stat_.expected_worker_map_.destroy();
@@ -268,6 +271,28 @@ void ObPhysicalPlan::destroy()
   subschema_ctx_.destroy();
 }
 
+int ObPhysicalPlan::get_or_create_expr_jit_compiler(ObExprJitCompiler *&compiler)
+{
+  int ret = OB_SUCCESS;
+  if (NULL == expr_jit_compiler_) {
+    if (OB_ISNULL(expr_jit_compiler_ = OB_NEWx(ObExprJitCompiler, (&allocator_), allocator_))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate memory failed", K(ret));
+    }
+  }
+  compiler = expr_jit_compiler_;
+  return ret;
+}
+
+void ObPhysicalPlan::destroy_expr_jit_compiler()
+{
+  if (NULL != expr_jit_compiler_) {
+    expr_jit_compiler_->~ObExprJitCompiler();
+    allocator_.free(expr_jit_compiler_);
+    expr_jit_compiler_ = NULL;
+  }
+}
+
 int ObPhysicalPlan::copy_common_info(ObPhysicalPlan &src)
 {
   int ret = OB_SUCCESS;
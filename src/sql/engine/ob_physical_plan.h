@@ -32,6 +32,7 @@
 #include "storage/tx/ob_trans_define.h"
 #include "sql/monitor/ob_plan_info_manager.h"
 #include "sql/engine/ob_subschema_ctx.h"
+#include "sql/engine/expr/ob_expr_jit_filter.h"
 
 namespace oceanbase
 {
@@ -553,6 +554,7 @@ private:
   static const int64_t COMMON_PARAM_NUM = 12;
   static const int64_t SAMPLE_TIMES = 10;
 private:
+  void destroy_expr_jit_compiler();
   DISALLOW_COPY_AND_ASSIGN(ObPhysicalPlan);
 private:
   ObPhyPlanHint phy_hint_; //hints for this plan
@@ -742,6 +744,8 @@ private:
   // to decide whether it read uncommitted data
   common::ObFixedArray<uint64_t, common::ObIAllocator> dml_table_ids_;
   bool direct_load_need_sort_;
+  // owns the native code of jit compiled filters referenced by operator specs
+  ObExprJitCompiler *expr_jit_compiler_;
 };
 
 inline void ObPhysicalPlan::set_affected_last_insert_id(bool affected_last_insert_id)
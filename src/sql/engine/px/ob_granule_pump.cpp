@@ -18,6 +18,7 @@
 #include "sql/engine/px/ob_px_util.h"
 #include "sql/session/ob_basic_session_info.h"
 #include "share/config/ob_server_config.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 #include "share/schema/ob_part_mgr_util.h"
 #include "sql/engine/dml/ob_table_modify_op.h"
 #include "sql/engine/ob_engine_op_traits.h"
@@ -1003,8 +1004,21 @@ int ObRandomGranuleSplitter::split_granule(ObGranulePumpArgs &args,
         K(ObGranuleUtil::desc_order(args.gi_attri_flag_)));
   }
   const common::ObIArray<DASTabletLocArray> &tablet_arrays = args.tablet_arrays_;
+  // the partition granules are handed out from the shared pool in the tablet
+  // order, a large partition fetched by the last idle worker dominates the
+  // completion time if the partitions are skewed. hand out the larger first if
+  // the order of the tasks does not matter.
+  bool large_partition_first = false;
+  if (ObGITaskSet::GI_RANDOM_NONE == random_type &&
+      !ObGranuleUtil::asc_order(args.gi_attri_flag_) &&
+      !ObGranuleUtil::desc_order(args.gi_attri_flag_) &&
+      !ObGranuleUtil::with_param_down(args.gi_attri_flag_)) {
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+    large_partition_first = tenant_config.is_valid() && tenant_config->_px_large_partition_first;
+  }
   ARRAY_FOREACH_X(scan_ops, idx, cnt, OB_SUCC(ret)) {
     const ObTableScanSpec *tsc = scan_ops.at(idx);
+    DASTabletLocSEArray sorted_tablets;
     if (OB_ISNULL(tsc) || scan_ops.count() != tablet_arrays.count()) {
       ret = OB_ERR_UNEXPECTED;
       LOG_WARN("get a null tsc ptr", K(ret), K(scan_ops.count()), K(tablet_arrays.count()));
@@ -1013,15 +1027,32 @@ int ObRandomGranuleSplitter::split_granule(ObGranulePumpArgs &args,
       uint64_t op_id = tsc->get_id();
       ObGITaskSet total_task_set;
       ObGITaskArray &taskset_array = gi_task_array_result.at(idx).taskset_array_;
+      const common::ObIArray<ObDASTabletLoc*> *tablets = &tablet_arrays.at(idx);
       partition_granule = is_virtual_table(scan_key_id) || partition_granule;
-      if (OB_FAIL(split_gi_task(args,
-                                tsc,
-                                scan_key_id,
-                                op_id,
-                                tablet_arrays.at(idx),
-                                partition_granule,
-                                total_task_set,
-                                random_type))) {
+      if (large_partition_first && partition_granule && OB_NOT_NULL(args.ctx_) &&
+          !is_virtual_table(scan_key_id) &&
+          !tsc->tsc_ctdef_.scan_ctdef_.is_external_table_ &&
+          tablets->count() > args.parallelism_ &&
+          tablets->count() <= ObGranuleUtil::MAX_SORT_TABLET_CNT) {
+        // the order is best effort, keep the tablet order if the sizes are unknown
+        int tmp_ret = OB_SUCCESS;
+        if (OB_TMP_FAIL(sorted_tablets.assign(*tablets))) {
+          LOG_WARN("failed to assign tablets", K(tmp_ret));
+        } else if (OB_TMP_FAIL(ObGranuleUtil::sort_tablets_by_size(*args.ctx_, sorted_tablets))) {
+          LOG_WARN("failed to sort tablets by size, keep the tablet order", K(tmp_ret));
+        } else {
+          tablets = &sorted_tablets;
+        }
+      }
+      if (OB_FAIL(ret)) {
+      } else if (OB_FAIL(split_gi_task(args,
+                                       tsc,
+                                       scan_key_id,
+                                       op_id,
+                                       *tablets,
+                                       partition_granule,
+                                       total_task_set,
+                                       random_type))) {
         LOG_WARN("failed to init granule iter pump", K(ret), K(idx), K(tablet_arrays));
       } else if (OB_FAIL(total_task_set.set_block_order(
             ObGranuleUtil::desc_order(args.gi_attri_flag_)))) {
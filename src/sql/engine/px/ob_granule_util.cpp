@@ -252,6 +252,66 @@ int ObGranuleUtil::split_block_ranges(ObExecContext &exec_ctx,
   return ret;
 }
 
+int ObGranuleUtil::sort_tablets_by_size(ObExecContext &exec_ctx,
+                                        ObIArray<ObDASTabletLoc*> &tablets)
+{
+  int ret = OB_SUCCESS;
+  ObSEArray<int64_t, 16> tablet_sizes;
+  ObSEArray<ObStoreRange, 1> whole_ranges;
+  ObStoreRange whole_range;
+  whole_range.set_whole_range();
+  if (tablets.count() > MAX_SORT_TABLET_CNT) {
+    ret = OB_SIZE_OVERFLOW;
+    LOG_TRACE("too many tablets to estimate", K(ret), K(tablets.count()));
+  } else if (OB_FAIL(whole_ranges.push_back(whole_range))) {
+    LOG_WARN("failed to push back whole range", K(ret));
+  } else if (OB_FAIL(ObDASSimpleUtils::get_tablets_ranges_cost(exec_ctx, tablets,
+                                                               whole_ranges,
+                                                               tablet_sizes))) {
+    LOG_WARN("failed to get tablets ranges cost", K(ret), K(tablets.count()));
+  } else if (OB_FAIL(sort_tablets_by_size(tablet_sizes, tablets))) {
+    LOG_WARN("failed to sort tablets by size", K(ret));
+  }
+  return ret;
+}
+
+int ObGranuleUtil::sort_tablets_by_size(const ObIArray<int64_t> &tablet_sizes,
+                                        ObIArray<ObDASTabletLoc*> &tablets)
+{
+  struct TabletSize
+  {
+    TabletSize() : size_(0), idx_(0), tablet_(nullptr) {}
+    TabletSize(int64_t size, int64_t idx, ObDASTabletLoc *tablet)
+      : size_(size), idx_(idx), tablet_(tablet) {}
+    int64_t size_;
+    int64_t idx_;
+    ObDASTabletLoc *tablet_;
+  };
+  int ret = OB_SUCCESS;
+  ObSEArray<TabletSize, 16> sizes;
+  if (OB_UNLIKELY(tablet_sizes.count() != tablets.count())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("tablet sizes mismatch", K(ret), K(tablet_sizes.count()), K(tablets.count()));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < tablets.count(); i++) {
+    if (OB_FAIL(sizes.push_back(TabletSize(tablet_sizes.at(i), i, tablets.at(i))))) {
+      LOG_WARN("failed to push back tablet size", K(ret));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    auto compare_fun = [](const TabletSize &a, const TabletSize &b) -> bool {
+      return a.size_ > b.size_ || (a.size_ == b.size_ && a.idx_ < b.idx_);
+    };
+    lib::ob_sort(sizes.begin(), sizes.end(), compare_fun);
+    for (int64_t i = 0; i < sizes.count(); i++) {
+      tablets.at(i) = sizes.at(i).tablet_;
+    }
+    LOG_TRACE("sort tablets by size", K(tablets.count()),
+              "max_size", sizes.empty() ? 0 : sizes.at(0).size_);
+  }
+  return ret;
+}
+
 int ObGranuleUtil::remove_empty_range(const common::ObIArray<common::ObNewRange> &in_ranges,
                                       common::ObIArray<common::ObNewRange> &ranges,
                                       bool &only_empty_range) {
@@ -148,6 +148,8 @@ struct ObParallelBlockRangeTaskParams
 class ObGranuleUtil
 {
 public:
+  // the max count of tablets whose sizes are estimated to sort the partition granules
+  static const int64_t MAX_SORT_TABLET_CNT = 1024;
   /**
    *  table_partition_info  IN    partition info
    *  parallelism           IN    the parallelism from hint
@@ -184,6 +186,26 @@ public:
                                 common::ObIArray<int64_t> &granule_idx,
                                 bool range_independent);
 
+  /**
+   * reorder tablets by the estimated data size, the larger first. the partition
+   * granules are handed out in this order, so a large partition is not left to
+   * the end and scanned by one worker while the others are idle.
+   * the sizes of all tablets are estimated by one batch of das tasks, tablets
+   * more than MAX_SORT_TABLET_CNT are not estimated and OB_SIZE_OVERFLOW is
+   * returned. tablets is not changed if failed.
+   * tablets                    IN/OUT the tablets to scan
+   */
+  static int sort_tablets_by_size(ObExecContext &exec_ctx,
+                                  common::ObIArray<ObDASTabletLoc*> &tablets);
+  /**
+   * reorder tablets by tablet_sizes, the larger first and keep the order of
+   * the same size.
+   * tablet_sizes               IN     the size of each tablet
+   * tablets                    IN/OUT the tablets to scan
+   */
+  static int sort_tablets_by_size(const common::ObIArray<int64_t> &tablet_sizes,
+                                  common::ObIArray<ObDASTabletLoc*> &tablets);
+
   static bool is_partition_granule(int64_t partition_count,
                                    int64_t parallelism,
                                    int64_t partition_scan_hold,
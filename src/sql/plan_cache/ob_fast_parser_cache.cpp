@@ -0,0 +1,353 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_PC
+#include "sql/plan_cache/ob_fast_parser_cache.h"
+#include "lib/hash_func/murmur_hash.h"
+#include "sql/parser/parse_node.h"
+#include "sql/plan_cache/ob_plan_cache_util.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace sql
+{
+
+void ObFastParserCache::Entry::reset()
+{
+  allocator_.reset();
+  hash_ = 0;
+  last_access_ = 0;
+  sql_mode_ = 0;
+  charsets4parser_ = ObCharsets4Parser();
+  enable_batched_multi_stmt_ = false;
+  sql_.reset();
+  no_param_sql_.reset();
+  params_ = NULL;
+  param_cnt_ = 0;
+  values_token_pos_ = 0;
+  values_tokens_ = NULL;
+  values_token_cnt_ = 0;
+}
+
+ObFastParserCache::ObFastParserCache()
+  : tenant_id_(OB_SERVER_TENANT_ID),
+    entries_(NULL),
+    seen_hashes_(NULL),
+    seen_pos_(0),
+    access_seq_(0),
+    hit_cnt_(0),
+    miss_cnt_(0),
+    insert_cnt_(0)
+{
+}
+
+void ObFastParserCache::destroy()
+{
+  if (OB_NOT_NULL(entries_)) {
+    for (int64_t i = 0; i < MAX_CACHE_SIZE; i++) {
+      entries_[i].~Entry();
+    }
+    ob_free(entries_);
+    entries_ = NULL;
+  }
+  if (OB_NOT_NULL(seen_hashes_)) {
+    ob_free(seen_hashes_);
+    seen_hashes_ = NULL;
+  }
+  seen_pos_ = 0;
+  access_seq_ = 0;
+  hit_cnt_ = 0;
+  miss_cnt_ = 0;
+  insert_cnt_ = 0;
+}
+
+bool ObFastParserCache::can_cache(const FPContext &fp_ctx, const ObString &sql)
+{
+  // the result of udr or format mode depends on more than the sql text
+  return !fp_ctx.is_udr_mode_
+      && !fp_ctx.is_format_
+      && NULL == fp_ctx.def_name_ctx_
+      && sql.length() > 0
+      && sql.length() <= MAX_CACHED_SQL_LEN;
+}
+
+uint64_t ObFastParserCache::calc_hash_(const ObString &sql)
+{
+  return murmurhash(sql.ptr(), sql.length(), 0);
+}
+
+// deep_copy_parse_node() copies str_value_ only when str_len_ > 0, but the
+// fast parser gives an empty string literal '' a valid empty str_value_, which
+// is kept for the copy
+int ObFastParserCache::deep_copy_param_node_(ObIAllocator &allocator,
+                                             const ParseNode &src,
+                                             ParseNode &dst)
+{
+  int ret = OB_SUCCESS;
+  char *buf = NULL;
+  if (OB_FAIL(deep_copy_parse_node(&allocator, &src, &dst))) {
+    LOG_WARN("fail to deep copy parse node", K(ret));
+  } else if (NULL == src.str_value_ || src.str_len_ > 0) {
+    // copied already
+  } else if (OB_ISNULL(buf = static_cast<char *>(allocator.alloc(1)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc empty string", K(ret));
+  } else {
+    buf[0] = '\0';
+    dst.str_value_ = buf;
+    dst.str_len_ = 0;
+  }
+  if (OB_SUCC(ret)) {
+    dst.sql_str_off_ = src.sql_str_off_;
+  }
+  return ret;
+}
+
+ObFastParserCache::Entry *ObFastParserCache::lookup_(const uint64_t hash,
+                                                     const FPContext &fp_ctx,
+                                                     const ObString &sql)
+{
+  Entry *entry = NULL;
+  for (int64_t i = 0; NULL == entry && NULL != entries_ && i < MAX_CACHE_SIZE; i++) {
+    Entry &e = entries_[i];
+    if (e.is_valid()
+        && e.hash_ == hash
+        && e.sql_mode_ == fp_ctx.sql_mode_
+        && e.charsets4parser_.string_collation_ == fp_ctx.charsets4parser_.string_collation_
+        && e.charsets4parser_.nls_collation_ == fp_ctx.charsets4parser_.nls_collation_
+        && e.enable_batched_multi_stmt_ == fp_ctx.enable_batched_multi_stmt_
+        && e.sql_ == sql) {
+      entry = &e;
+    }
+  }
+  return entry;
+}
+
+int ObFastParserCache::get(const FPContext &fp_ctx,
+                           const ObString &sql,
+                           ObIAllocator &allocator,
+                           ObFastParserResult &fp_result)
+{
+  int ret = OB_SUCCESS;
+  Entry *entry = NULL;
+  if (!can_cache(fp_ctx, sql)) {
+    ret = OB_HASH_NOT_EXIST;
+  } else if (OB_ISNULL(entry = lookup_(calc_hash_(sql), fp_ctx, sql))) {
+    ret = OB_HASH_NOT_EXIST;
+    miss_cnt_++;
+  } else {
+    // the raw params may be modified during parameterization, hence they
+    // are copied for every execution
+    char *buf = NULL;
+    const int64_t param_cnt = entry->param_cnt_;
+    const int64_t alloc_size = param_cnt * (sizeof(ObPCParam) + sizeof(ParseNode));
+    fp_result.raw_params_.reset();
+    fp_result.reset_question_mark_ctx();
+    fp_result.values_tokens_.reuse();
+    if (param_cnt > 0 && OB_ISNULL(buf = static_cast<char *>(allocator.alloc(alloc_size)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc memory for pc param", K(ret), K(param_cnt));
+    } else if (param_cnt > 0 && OB_FAIL(fp_result.raw_params_.reserve(param_cnt))) {
+      LOG_WARN("fail to reserve raw params", K(ret), K(param_cnt));
+    } else if (OB_FAIL(ob_write_string(allocator, entry->no_param_sql_, fp_result.pc_key_.name_))) {
+      // the entry may be replaced before the request finishes, e.g. a batched multi stmt
+      LOG_WARN("fail to copy no param sql", K(ret));
+    } else {
+      fp_result.values_tokens_.set_capacity(entry->values_token_cnt_);
+      if (param_cnt > 0) {
+        MEMSET(buf, 0, alloc_size);
+      }
+      ObPCParam *pc_params = reinterpret_cast<ObPCParam *>(buf);
+      ParseNode *nodes = reinterpret_cast<ParseNode *>(buf + param_cnt * sizeof(ObPCParam));
+      for (int64_t i = 0; OB_SUCC(ret) && i < param_cnt; i++) {
+        ObPCParam *pc_param = new(pc_params + i) ObPCParam();
+        pc_param->node_ = nodes + i;
+        if (OB_FAIL(deep_copy_param_node_(allocator, entry->params_[i], *pc_param->node_))) {
+          LOG_WARN("fail to deep copy parse node", K(ret), K(i));
+        } else if (OB_FAIL(fp_result.raw_params_.push_back(pc_param))) {
+          LOG_WARN("fail to push back raw param", K(ret), K(i));
+        }
+      }
+      for (int64_t i = 0; OB_SUCC(ret) && i < entry->values_token_cnt_; i++) {
+        if (OB_FAIL(fp_result.values_tokens_.push_back(entry->values_tokens_[i]))) {
+          LOG_WARN("fail to push back values token", K(ret), K(i));
+        }
+      }
+      if (OB_SUCC(ret)) {
+        fp_result.values_token_pos_ = entry->values_token_pos_;
+        entry->last_access_ = ++access_seq_;
+        hit_cnt_++;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObFastParserCache::prepare_entries_()
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(entries_)) {
+    ObMemAttr attr(tenant_id_, "FastParserCache");
+    void *buf = NULL;
+    if (OB_ISNULL(buf = ob_malloc(sizeof(Entry) * MAX_CACHE_SIZE, attr))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc fast parser cache", K(ret), K_(tenant_id));
+    } else {
+      entries_ = static_cast<Entry *>(buf);
+      for (int64_t i = 0; i < MAX_CACHE_SIZE; i++) {
+        new(entries_ + i) Entry(attr);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObFastParserCache::prepare_seen_hashes_()
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(seen_hashes_)) {
+    ObMemAttr attr(tenant_id_, "FastParserCache");
+    if (OB_ISNULL(seen_hashes_ = static_cast<uint64_t *>(
+                    ob_malloc(sizeof(uint64_t) * SEEN_HASH_CNT, attr)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc seen hashes", K(ret), K_(tenant_id));
+    } else {
+      MEMSET(seen_hashes_, 0, sizeof(uint64_t) * SEEN_HASH_CNT);
+      seen_pos_ = 0;
+    }
+  }
+  return ret;
+}
+
+// return true if the hash has been recorded by the last SEEN_HASH_CNT puts, and
+// forget it. Otherwise record it, replacing the oldest one.
+bool ObFastParserCache::check_and_record_seen_(const uint64_t hash)
+{
+  bool seen = false;
+  for (int64_t i = 0; !seen && i < SEEN_HASH_CNT; i++) {
+    if (seen_hashes_[i] == hash) {
+      seen_hashes_[i] = 0;
+      seen = true;
+    }
+  }
+  if (!seen) {
+    seen_hashes_[seen_pos_] = hash;
+    seen_pos_ = (seen_pos_ + 1) % SEEN_HASH_CNT;
+  }
+  return seen;
+}
+
+// the invalid entries are used first, or the least recently used one
+ObFastParserCache::Entry *ObFastParserCache::get_replace_entry_(const int64_t cache_size)
+{
+  Entry *entry = NULL;
+  const int64_t size = std::min(cache_size, MAX_CACHE_SIZE);
+  for (int64_t i = 0; i < size; i++) {
+    if (NULL == entry || entries_[i].last_access_ < entry->last_access_) {
+      entry = &entries_[i];
+    }
+  }
+  return entry;
+}
+
+int ObFastParserCache::fill_entry_(const uint64_t hash,
+                                   const FPContext &fp_ctx,
+                                   const ObString &sql,
+                                   const ObFastParserResult &fp_result,
+                                   Entry &entry)
+{
+  int ret = OB_SUCCESS;
+  const int64_t param_cnt = fp_result.raw_params_.count();
+  const int64_t values_token_cnt = fp_result.values_tokens_.count();
+  ObIAllocator &allocator = entry.allocator_;
+  entry.reset();
+  if (OB_FAIL(ob_write_string(allocator, sql, entry.sql_))) {
+    LOG_WARN("fail to copy sql", K(ret));
+  } else if (OB_FAIL(ob_write_string(allocator, fp_result.pc_key_.name_, entry.no_param_sql_))) {
+    LOG_WARN("fail to copy no param sql", K(ret));
+  } else if (param_cnt > 0
+             && OB_ISNULL(entry.params_ = static_cast<ParseNode *>(
+                            allocator.alloc(sizeof(ParseNode) * param_cnt)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc params", K(ret), K(param_cnt));
+  } else if (values_token_cnt > 0
+             && OB_ISNULL(entry.values_tokens_ = static_cast<ObValuesTokenPos *>(
+                            allocator.alloc(sizeof(ObValuesTokenPos) * values_token_cnt)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc values tokens", K(ret), K(values_token_cnt));
+  } else {
+    if (param_cnt > 0) {
+      MEMSET(entry.params_, 0, sizeof(ParseNode) * param_cnt);
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < param_cnt; i++) {
+      const ObPCParam *pc_param = fp_result.raw_params_.at(i);
+      if (OB_ISNULL(pc_param) || OB_ISNULL(pc_param->node_)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("invalid raw param", K(ret), K(i), KP(pc_param));
+      } else if (OB_FAIL(deep_copy_param_node_(allocator, *pc_param->node_, entry.params_[i]))) {
+        LOG_WARN("fail to deep copy parse node", K(ret), K(i));
+      }
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < values_token_cnt; i++) {
+      entry.values_tokens_[i] = fp_result.values_tokens_.at(i);
+    }
+    if (OB_SUCC(ret)) {
+      entry.hash_ = hash;
+      entry.sql_mode_ = fp_ctx.sql_mode_;
+      entry.charsets4parser_ = fp_ctx.charsets4parser_;
+      entry.enable_batched_multi_stmt_ = fp_ctx.enable_batched_multi_stmt_;
+      entry.param_cnt_ = param_cnt;
+      entry.values_token_cnt_ = values_token_cnt;
+      entry.values_token_pos_ = fp_result.values_token_pos_;
+      entry.last_access_ = ++access_seq_;
+      insert_cnt_++;
+    }
+  }
+  if (OB_FAIL(ret)) {
+    entry.reset();
+  }
+  return ret;
+}
+
+int ObFastParserCache::put(const FPContext &fp_ctx,
+                           const ObString &sql,
+                           const ObFastParserResult &fp_result,
+                           const int64_t cache_size)
+{
+  int ret = OB_SUCCESS;
+  const uint64_t hash = calc_hash_(sql);
+  Entry *entry = NULL;
+  if (cache_size <= 0 || !can_cache(fp_ctx, sql)) {
+    // do nothing
+  } else if (fp_result.question_mark_ctx_.count_ > 0
+             || NULL != fp_result.question_mark_ctx_.name_) {
+    // the question marks of a prepared sql text are not cached
+  } else if (OB_NOT_NULL(lookup_(hash, fp_ctx, sql))) {
+    // cached already
+  } else if (OB_FAIL(prepare_seen_hashes_())) {
+    LOG_WARN("fail to prepare seen hashes", K(ret));
+  } else if (!check_and_record_seen_(hash)) {
+    // put the first time, cache it when it's put again
+  } else if (OB_FAIL(prepare_entries_())) {
+    LOG_WARN("fail to prepare entries", K(ret));
+  } else if (OB_ISNULL(entry = get_replace_entry_(cache_size))) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("no entry to replace", K(ret), K(cache_size));
+  } else if (OB_FAIL(fill_entry_(hash, fp_ctx, sql, fp_result, *entry))) {
+    LOG_WARN("fail to fill entry", K(ret), K(sql));
+  }
+  return ret;
+}
+
+} // namespace sql
+} // namespace oceanbase
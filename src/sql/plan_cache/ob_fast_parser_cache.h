@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SQL_PLAN_CACHE_OB_FAST_PARSER_CACHE_
+#define OCEANBASE_SQL_PLAN_CACHE_OB_FAST_PARSER_CACHE_
+
+#include "lib/allocator/page_arena.h"
+#include "lib/string/ob_string.h"
+#include "sql/parser/ob_fast_parser.h"
+#include "sql/plan_cache/ob_plan_cache_struct.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+
+// The fast parser results of the sql texts recently executed by a session.
+//
+// OLTP clients send the same sql text again and again, a sql text found in the
+// cache skips the fast parser: its parameterized sql and raw params are copied
+// from the cache, which is much cheaper than lexing the whole text. The cache is
+// keyed by the raw sql text and the parser settings of the session, so a sql
+// text with different literals is another entry. A sql text is cached only when
+// it's put the second time, so that a stream of distinct sql texts doesn't pay
+// for the copies and doesn't replace the entries which are hit. Entries are
+// replaced in LRU order, the cache size is controlled by _ob_fast_parser_cache_size.
+//
+// Not thread safe, it's accessed by the thread which holds the session only.
+class ObFastParserCache
+{
+public:
+  static const int64_t MAX_CACHE_SIZE = 64;
+  // a long sql text such as a batch insert is not worth caching
+  static const int64_t MAX_CACHED_SQL_LEN = 4096;
+  // the hashes of the sql texts put once but not cached yet
+  static const int64_t SEEN_HASH_CNT = 2 * MAX_CACHE_SIZE;
+public:
+  ObFastParserCache();
+  ~ObFastParserCache() { destroy(); }
+  void destroy();
+  void set_tenant_id(const uint64_t tenant_id) { tenant_id_ = tenant_id; }
+  // fill fp_result with the cached result, the raw params are deep copied with
+  // allocator. return OB_HASH_NOT_EXIST if the sql is not cached
+  int get(const FPContext &fp_ctx,
+          const common::ObString &sql,
+          common::ObIAllocator &allocator,
+          ObFastParserResult &fp_result);
+  // cache the fast parser result of sql if it has been put before, the least
+  // recently used entry is replaced if the cache is full
+  int put(const FPContext &fp_ctx,
+          const common::ObString &sql,
+          const ObFastParserResult &fp_result,
+          const int64_t cache_size);
+  static bool can_cache(const FPContext &fp_ctx, const common::ObString &sql);
+  int64_t get_hit_count() const { return hit_cnt_; }
+  int64_t get_miss_count() const { return miss_cnt_; }
+  int64_t get_insert_count() const { return insert_cnt_; }
+  TO_STRING_KV(K_(tenant_id), K_(access_seq), K_(hit_cnt), K_(miss_cnt), K_(insert_cnt));
+private:
+  struct Entry
+  {
+    explicit Entry(const lib::ObMemAttr &attr) : allocator_(attr) { reset(); }
+    void reset();
+    bool is_valid() const { return 0 != last_access_; }
+    common::ObArenaAllocator allocator_;
+    uint64_t hash_;
+    int64_t last_access_;
+    ObSQLMode sql_mode_;
+    ObCharsets4Parser charsets4parser_;
+    bool enable_batched_multi_stmt_;
+    common::ObString sql_;
+    common::ObString no_param_sql_;
+    ParseNode *params_;
+    int64_t param_cnt_;
+    int64_t values_token_pos_;
+    ObValuesTokenPos *values_tokens_;
+    int64_t values_token_cnt_;
+  };
+  int prepare_entries_();
+  int prepare_seen_hashes_();
+  bool check_and_record_seen_(const uint64_t hash);
+  Entry *lookup_(const uint64_t hash, const FPContext &fp_ctx, const common::ObString &sql);
+  Entry *get_replace_entry_(const int64_t cache_size);
+  int fill_entry_(const uint64_t hash,
+                  const FPContext &fp_ctx,
+                  const common::ObString &sql,
+                  const ObFastParserResult &fp_result,
+                  Entry &entry);
+  static uint64_t calc_hash_(const common::ObString &sql);
+  static int deep_copy_param_node_(common::ObIAllocator &allocator,
+                                   const ParseNode &src,
+                                   ParseNode &dst);
+private:
+  uint64_t tenant_id_;
+  Entry *entries_;
+  uint64_t *seen_hashes_;
+  int64_t seen_pos_;
+  int64_t access_seq_;
+  int64_t hit_cnt_;
+  int64_t miss_cnt_;
+  int64_t insert_cnt_;
+  DISALLOW_COPY_AND_ASSIGN(ObFastParserCache);
+};
+
+} // namespace sql
+} // namespace oceanbase
+
+#endif // OCEANBASE_SQL_PLAN_CACHE_OB_FAST_PARSER_CACHE_
@@ -212,8 +212,15 @@ int64_t ObILibCacheNode::dec_ref_count(const CacheRefHandleID ref_handle)
       LOG_ERROR("invalid null lib cache");
     } else {
       ObLCNodeFactory &ln_factory = lib_cache_->get_cache_node_factory();
-      lib_cache_->dec_mem_used(get_mem_size());
-      ln_factory.destroy_cache_node(this);
+      if (lib_cache_->get_node_qsync().try_sync()) {
+        // no reader which gets the node without reference count is left
+        lib_cache_->dec_mem_used(get_mem_size());
+        ln_factory.destroy_cache_node(this);
+      } else {
+        // never wait for the readers here, the caller may hold the bucket lock
+        // of cache_key_node_map_ which a reader is waiting for
+        lib_cache_->retire_cache_node(this);
+      }
     }
   } else {
     LOG_ERROR("invalid pcv_set ref count", K(ref_count));
@@ -96,6 +96,7 @@ typedef ObList<ObILibCacheObject*, ObIAllocator> CacheObjList;
 class ObILibCacheNode
 {
 friend class ObLCNodeFactory;
+friend class ObPlanCache;
 public:
   ObILibCacheNode(ObPlanCache *lib_cache, lib::MemoryContext &mem_context)
     : mem_context_(mem_context),
@@ -104,7 +105,8 @@ public:
       ref_count_(0),
       lib_cache_(lib_cache),
       co_list_lock_(common::ObLatchIds::PLAN_SET_LOCK),
-      co_list_(allocator_)
+      co_list_(allocator_),
+      retired_next_(NULL)
   {
     lock_timeout_ts_ = GCONF.large_query_threshold;
   }
@@ -211,6 +213,8 @@ protected:
   ObPlanCache *lib_cache_;
   common::SpinRWLock co_list_lock_;
   CacheObjList co_list_;
+  // link of ObPlanCache::retired_nodes_
+  ObILibCacheNode *retired_next_;
 };
 
 } // namespace common
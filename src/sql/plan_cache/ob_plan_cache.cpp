@@ -44,6 +44,7 @@
 #endif
 #include "pl/pl_cache/ob_pl_cache_mgr.h"
 #include "sql/plan_cache/ob_values_table_compression.h"
+#include "sql/plan_cache/ob_fast_parser_cache.h"
 
 using namespace oceanbase::common;
 using namespace oceanbase::common::hash;
@@ -372,6 +373,7 @@ ObPlanCache::ObPlanCache()
    ref_handle_mgr_(),
    pcm_(NULL),
    destroy_(0),
+   retired_nodes_(NULL),
    tg_id_(-1)
 {
 }
@@ -389,6 +391,8 @@ void ObPlanCache::destroy()
     if (OB_SUCCESS != (cache_evict_all_obj())) {
       SQL_PC_LOG_RET(WARN, OB_ERROR, "fail to evict all lib cache cache");
     }
+    WaitQuiescent(node_qsync_);
+    destroy_retired_cache_nodes();
     if (root_context_ != NULL) {
       DESTROY_CONTEXT(root_context_);
       root_context_ = NULL;
@@ -714,10 +718,7 @@ int ObPlanCache::construct_fast_parser_result(common::ObIAllocator &allocator,
       ObString first_truncated_sql;
       int64_t batch_count = 0;
       bool is_insert_values = false;
-      if (OB_FAIL(ObSqlParameterization::fast_parser(allocator,
-                                                    fp_ctx,
-                                                    raw_sql,
-                                                    fp_result))) {
+      if (OB_FAIL(fast_parser_with_cache(allocator, pc_ctx, fp_ctx, raw_sql, fp_result))) {
         LOG_WARN("failed to fast parser", K(ret), K(sql_mode), K(pc_ctx.raw_sql_));
       } else if (OB_FAIL(check_can_do_insert_opt(allocator,
                                                  pc_ctx,
@@ -761,6 +762,43 @@ int ObPlanCache::construct_fast_parser_result(common::ObIAllocator &allocator,
   return ret;
 }
 
+// a sql text executed again by the session gets the fast parser result from
+// the session's fast parser cache
+int ObPlanCache::fast_parser_with_cache(common::ObIAllocator &allocator,
+                                        ObPlanCacheCtx &pc_ctx,
+                                        const FPContext &fp_ctx,
+                                        const common::ObString &raw_sql,
+                                        ObFastParserResult &fp_result)
+{
+  int ret = OB_SUCCESS;
+  const int64_t cache_size = GCONF._ob_fast_parser_cache_size;
+  ObFastParserCache *fp_cache = NULL;
+  if (cache_size > 0
+      && ObFastParserCache::can_cache(fp_ctx, raw_sql)
+      && OB_NOT_NULL(fp_cache = pc_ctx.sql_ctx_.session_info_->get_fast_parser_cache())) {
+    ret = fp_cache->get(fp_ctx, raw_sql, allocator, fp_result);
+    if (OB_HASH_NOT_EXIST != ret && OB_SUCCESS != ret) {
+      LOG_WARN("failed to get fast parser result from cache", K(ret), K(raw_sql));
+    }
+  } else {
+    ret = OB_HASH_NOT_EXIST;
+  }
+  if (OB_HASH_NOT_EXIST != ret) {
+    // hit the cache, or fail
+  } else if (OB_FAIL(ObSqlParameterization::fast_parser(allocator,
+                                                        fp_ctx,
+                                                        raw_sql,
+                                                        fp_result))) {
+    LOG_WARN("failed to fast parser", K(ret), K(raw_sql));
+  } else if (OB_NOT_NULL(fp_cache)) {
+    int tmp_ret = OB_SUCCESS;
+    if (OB_TMP_FAIL(fp_cache->put(fp_ctx, raw_sql, fp_result, cache_size))) {
+      LOG_WARN("failed to put fast parser result into cache", K(tmp_ret), K(raw_sql));
+    }
+  }
+  return ret;
+}
+
 // For insert into t1 values(1,1),(2,2),(3,3); After parameterization,
 // the SQL will become insert into t1 values(?,?),(?,?),(?,?);
 // After inspection, it is found that insert multi-values ​​batch optimization can be done,
@@ -1223,12 +1261,14 @@ int ObPlanCache::get_cache_obj(ObILibCacheCtx &ctx,
   int ret = OB_SUCCESS;
   ObILibCacheNode *cache_node = NULL;
   ObILibCacheObject *cache_obj = NULL;
-  // get the read lock and increase reference count
-  ObLibCacheRlockAndRef r_ref_lock(LC_NODE_RD_HANDLE);
+  // the cache node is not destroyed until leaving the critical section, so only
+  // get the read lock, the reference count of a hot cache node is not touched
+  CriticalGuard(node_qsync_);
+  ObLibCacheRlock r_lock(LC_NODE_RD_HANDLE);
   if (OB_ISNULL(key)) {
     ret = OB_INVALID_ARGUMENT;
     SQL_PC_LOG(WARN, "invalid null argument", K(ret), K(key));
-  } else if (OB_FAIL(get_value(key, cache_node, r_ref_lock /*read locked*/))) {
+  } else if (OB_FAIL(get_value(key, cache_node, r_lock /*read locked*/))) {
     ret = OB_ERR_UNEXPECTED;
     SQL_PC_LOG(TRACE, "failed to get cache node from lib cache by key", K(ret));
   } else if (OB_UNLIKELY(NULL == cache_node)) {
@@ -1248,7 +1288,6 @@ int ObPlanCache::get_cache_obj(ObILibCacheCtx &ctx,
     }
     // release lock whatever
     (void)cache_node->unlock();
-    (void)cache_node->dec_ref_count(LC_NODE_RD_HANDLE);
     NG_TRACE(pc_choose_plan);
   }
 
@@ -1482,6 +1521,39 @@ int ObPlanCache::cache_evict()
   return ret;
 }
 
+void ObPlanCache::retire_cache_node(ObILibCacheNode *node)
+{
+  ObILibCacheNode *head = NULL;
+  do {
+    head = ATOMIC_LOAD(&retired_nodes_);
+    node->retired_next_ = head;
+  } while (head != ATOMIC_VCAS(&retired_nodes_, head, node));
+}
+
+// The nodes retired before try_sync() can't be found by the readers entering
+// the critical section later, so they are destroyed if no reader is in the
+// critical section, otherwise they are retired again and tried next time.
+void ObPlanCache::destroy_retired_cache_nodes()
+{
+  ObILibCacheNode *nodes = ATOMIC_TAS(&retired_nodes_, NULL);
+  if (NULL == nodes) {
+    // do nothing
+  } else if (node_qsync_.try_sync()) {
+    while (NULL != nodes) {
+      ObILibCacheNode *node = nodes;
+      nodes = node->retired_next_;
+      dec_mem_used(node->get_mem_size());
+      cn_factory_.destroy_cache_node(node);
+    }
+  } else {
+    while (NULL != nodes) {
+      ObILibCacheNode *node = nodes;
+      nodes = node->retired_next_;
+      retire_cache_node(node);
+    }
+  }
+}
+
 int ObPlanCache::cache_evict_by_glitch_node()
 {
   int ret = OB_SUCCESS;
@@ -2724,6 +2796,7 @@ void ObPlanCacheEliminationTask::run_plan_cache_task()
   if (OB_FAIL(plan_cache_->update_memory_conf())) { //如果失败, 则不更新设置, 也不影响其他流程
     SQL_PC_LOG(WARN, "fail to update plan cache memory sys val", K(ret));
   }
+  plan_cache_->destroy_retired_cache_nodes();
   if (OB_FAIL(plan_cache_->cache_evict())) {
     SQL_PC_LOG(ERROR, "Plan cache evict failed, please check", K(ret));
   }  else if (OB_FAIL(plan_cache_->cache_evict_by_glitch_node())) {
@@ -16,6 +16,7 @@
 #include "lib/net/ob_addr.h"
 #include "lib/hash/ob_hashmap.h"
 #include "lib/alloc/alloc_func.h"
+#include "lib/allocator/ob_qsync.h"
 #include "sql/plan_cache/ob_plan_cache_util.h"
 #include "sql/plan_cache/ob_id_manager_allocator.h"
 #include "sql/plan_cache/ob_sql_parameterization.h"
@@ -384,6 +385,11 @@ public:
   int remove_cache_node(ObILibCacheKey *key);
   ObLCObjectManager &get_cache_obj_mgr() { return co_mgr_; }
   ObLCNodeFactory &get_cache_node_factory() { return cn_factory_; }
+  common::ObQSync &get_node_qsync() { return node_qsync_; }
+  // a cache node released while readers may still be in the critical section
+  // of node_qsync_ is retired, and destroyed after they leave
+  void retire_cache_node(ObILibCacheNode *node);
+  void destroy_retired_cache_nodes();
   int alloc_cache_obj(ObCacheObjGuard& guard, ObLibCacheNameSpace ns, uint64_t tenant_id);
   void free_cache_obj(ObILibCacheObject *&cache_obj, const CacheRefHandleID ref_handle);
   int destroy_cache_obj(const bool is_leaked, const uint64_t object_id);
@@ -393,6 +399,11 @@ public:
                                           ObFastParserResult &fp_result);
   static int construct_multi_stmt_fast_parser_result(common::ObIAllocator &allocator,
                                                      ObPlanCacheCtx &pc_ctx);
+  static int fast_parser_with_cache(common::ObIAllocator &allocator,
+                                    ObPlanCacheCtx &pc_ctx,
+                                    const FPContext &fp_ctx,
+                                    const common::ObString &raw_sql,
+                                    ObFastParserResult &fp_result);
   int dump_all_objs() const;
   int dump_deleted_objs_by_ns(ObIArray<AllocCacheObjInfo> &deleted_objs,
                               const int64_t safe_timestamp,
@@ -494,6 +505,12 @@ private:
   ObLCObjectManager co_mgr_;
   ObLCNodeFactory cn_factory_;
   CacheKeyNodeMap cache_key_node_map_;
+  // get_cache_obj reads the cache node in the critical section of node_qsync_
+  // instead of increasing its reference count, a cache node is destroyed after
+  // the readers leave the critical section.
+  common::ObQSync node_qsync_;
+  // the retired cache nodes linked by ObILibCacheNode::retired_next_
+  ObILibCacheNode *retired_nodes_;
   ObPlanCacheEliminationTask evict_task_;
   int tg_id_;
 };
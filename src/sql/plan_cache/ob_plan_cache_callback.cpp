@@ -22,7 +22,9 @@ using namespace oceanbase::common;
 void ObLibCacheAtomicOp::operator()(LibCacheKV &entry)
 {
   if (NULL != entry.second) {
-    entry.second->inc_ref_count(ref_handle_);
+    if (need_ref_) {
+      entry.second->inc_ref_count(ref_handle_);
+    }
     cache_node_ = entry.second;
     SQL_PC_LOG(DEBUG, "succ to get cache_node", "ref_count", cache_node_->get_ref_count());
   } else {
@@ -41,7 +43,7 @@ int ObLibCacheAtomicOp::get_value(ObILibCacheNode *&cache_node)
   } else if (OB_SUCC(lock(*cache_node_))) {
     cache_node = cache_node_;
   } else {
-    if (NULL != cache_node_) {
+    if (NULL != cache_node_ && need_ref_) {
       cache_node_->dec_ref_count(ref_handle_);
     }
     SQL_PC_LOG(DEBUG, "failed to get read lock of lib cache value", K(ret));
@@ -26,8 +26,8 @@ protected:
   typedef common::hash::HashMapPair<ObILibCacheKey*, ObILibCacheNode *> LibCacheKV;
 
 public:
-  ObLibCacheAtomicOp(const CacheRefHandleID ref_handle)
-    : cache_node_(NULL), ref_handle_(ref_handle)
+  ObLibCacheAtomicOp(const CacheRefHandleID ref_handle, const bool need_ref = true)
+    : cache_node_(NULL), ref_handle_(ref_handle), need_ref_(need_ref)
   {
   }
   virtual ~ObLibCacheAtomicOp() {}
@@ -45,6 +45,8 @@ protected:
   // cache_node_ - the plan cache value that is referenced.
   ObILibCacheNode *cache_node_;
   CacheRefHandleID ref_handle_;
+  // false if the cache node is protected by ObPlanCache::node_qsync_ instead
+  bool need_ref_;
 private:
   DISALLOW_COPY_AND_ASSIGN(ObLibCacheAtomicOp);
 };
@@ -81,6 +83,26 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ObLibCacheRlockAndRef);
 };
 
+// Get the read lock of the cache node without increasing its reference count,
+// which is contended by all the threads executing the same sql. It can only be
+// used in the critical section of ObPlanCache::node_qsync_, the cache node is
+// not destroyed until the critical section is left.
+class ObLibCacheRlock : public ObLibCacheAtomicOp
+{
+public:
+  ObLibCacheRlock(const CacheRefHandleID ref_handle)
+    : ObLibCacheAtomicOp(ref_handle, false /*need_ref*/)
+  {
+  }
+  virtual ~ObLibCacheRlock() {}
+  int lock(ObILibCacheNode &cache_node)
+  {
+    return cache_node.lock(true/*rlock*/);
+  };
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObLibCacheRlock);
+};
+
 class ObCacheObjAtomicOp
 {
 protected:
@@ -542,6 +542,7 @@ int ObConfigInfoInPC::load_influence_plan_config()
     enable_das_keep_order_ = tenant_config->_enable_das_keep_order;
     enable_hyperscan_regexp_engine_ =
         (0 == ObString::make_string("Hyperscan").case_compare(tenant_config->_regex_engine.str()));
+    enable_expr_jit_filter_ = tenant_config->_enable_expr_jit_filter;
   }
 
   return ret;
@@ -603,6 +604,9 @@ int ObConfigInfoInPC::serialize_configs(char *buf, int buf_len, int64_t &pos)
   } else if (OB_FAIL(databuff_printf(buf, buf_len, pos,
                                "%d,", enable_hyperscan_regexp_engine_))) {
     SQL_PC_LOG(WARN, "failed to databuff_printf", K(ret), K(enable_hyperscan_regexp_engine_));
+  } else if (OB_FAIL(databuff_printf(buf, buf_len, pos,
+                               "%d,", enable_expr_jit_filter_))) {
+    SQL_PC_LOG(WARN, "failed to databuff_printf", K(ret), K(enable_expr_jit_filter_));
   } else if (OB_FAIL(databuff_printf(buf, buf_len, pos,
                                "%d", realistic_runtime_bloom_filter_size_))) {
     SQL_PC_LOG(WARN, "failed to databuff_printf", K(ret), K(realistic_runtime_bloom_filter_size_));
@@ -1040,6 +1040,7 @@ public:
     bloom_filter_ratio_(0),
     enable_hyperscan_regexp_engine_(false),
     realistic_runtime_bloom_filter_size_(false),
+    enable_expr_jit_filter_(false),
     cluster_config_version_(-1),
     tenant_config_version_(-1),
     tenant_id_(0)
@@ -1087,6 +1088,7 @@ public:
   int bloom_filter_ratio_;
   bool enable_hyperscan_regexp_engine_;
   bool realistic_runtime_bloom_filter_size_;
+  bool enable_expr_jit_filter_;
 
 private:
   // current cluster config version_
@@ -1321,6 +1321,15 @@ public:
     jit_mode = ObJITEnableMode::OFF;
     return common::OB_SUCCESS;
   }
+  // JIT mode of sql expression filters, not subject to the PL forbid above,
+  // ob_enable_jit takes effect only if _enable_expr_jit_filter is turned on.
+  int get_expr_jit_mode(ObJITEnableMode &jit_mode) const
+  {
+    jit_mode = inf_pc_configs_.enable_expr_jit_filter_
+               ? sys_vars_cache_.get_ob_enable_jit()
+               : ObJITEnableMode::OFF;
+    return common::OB_SUCCESS;
+  }
 
   bool get_enable_exact_mode() const
   {
@@ -55,6 +55,7 @@
 #include "lib/string/ob_hex_utils_base.h"
 #include "share/stat/ob_opt_stat_manager.h"
 #include "sql/plan_cache/ob_ps_cache.h"
+#include "sql/plan_cache/ob_fast_parser_cache.h"
 #include "observer/ob_sql_client_decorator.h"
 #include "ob_sess_info_verify.h"
 #include "share/schema/ob_schema_utils.h"
@@ -175,6 +176,7 @@ ObSQLSessionInfo::ObSQLSessionInfo(const uint64_t tenant_id) :
       inner_conn_(NULL),
       encrypt_info_(),
       enable_role_array_(),
+      fast_parser_cache_(NULL),
       in_definer_named_proc_(false),
       priv_user_id_(OB_INVALID_ID),
       xa_end_timeout_seconds_(transaction::ObXADefault::OB_XA_TIMEOUT_SECONDS),
@@ -356,6 +358,10 @@ void ObSQLSessionInfo::reset(bool skip_sys_var)
     pl_sync_pkg_vars_ = NULL;
     //encrypt_info_.reset();
     cached_schema_guard_info_.reset();
+    if (OB_NOT_NULL(fast_parser_cache_)) {
+      OB_DELETE(ObFastParserCache, "unused", fast_parser_cache_);
+      fast_parser_cache_ = NULL;
+    }
     encrypt_info_.reset();
     enable_role_array_.reset();
     in_definer_named_proc_ = false;
@@ -3459,6 +3465,22 @@ int ObErrorSyncSysVarEncoder::display_sess_info(ObSQLSessionInfo &sess, const ch
   return ret;
 }
 
+ObFastParserCache *ObSQLSessionInfo::get_fast_parser_cache()
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(NULL == fast_parser_cache_)) {
+    const uint64_t tenant_id = get_effective_tenant_id();
+    if (OB_ISNULL(fast_parser_cache_ = OB_NEW(ObFastParserCache,
+                                              ObMemAttr(tenant_id, "FastParserCache")))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc fast parser cache", K(ret), K(tenant_id));
+    } else {
+      fast_parser_cache_->set_tenant_id(tenant_id);
+    }
+  }
+  return fast_parser_cache_;
+}
+
 int ObSQLSessionInfo::get_mem_ctx_alloc(common::ObIAllocator *&alloc)
 {
   int ret = OB_SUCCESS;
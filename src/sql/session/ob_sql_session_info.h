@@ -92,6 +92,7 @@ namespace sql
 class ObResultSet;
 class ObPlanCache;
 class ObPsCache;
+class ObFastParserCache;
 class ObPsSessionInfo;
 class ObPsStmtInfo;
 class ObStmt;
@@ -1317,6 +1318,8 @@ public:
   void set_table_name_hidden(const bool is_hidden) { is_table_name_hidden_ = is_hidden; }
 
   ObTenantCachedSchemaGuardInfo &get_cached_schema_guard_info() { return cached_schema_guard_info_; }
+  // allocated at the first access, return NULL if out of memory
+  ObFastParserCache *get_fast_parser_cache();
   int set_enable_role_array(const common::ObIArray<uint64_t> &role_id_array);
   common::ObIArray<uint64_t>& get_enable_role_array() { return get_enable_role_ids(); }
   const common::ObIArray<uint64_t>& get_enable_role_array() const { return get_enable_role_ids(); }
@@ -1631,6 +1634,7 @@ private:
 
   common::ObSEArray<uint64_t, 8> enable_role_array_;
   ObTenantCachedSchemaGuardInfo cached_schema_guard_info_;
+  ObFastParserCache *fast_parser_cache_;
   bool in_definer_named_proc_;
   uint64_t priv_user_id_;
   int64_t xa_end_timeout_seconds_;
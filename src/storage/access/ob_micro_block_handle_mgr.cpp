@@ -436,7 +436,7 @@ int ObMicroBlockHandleMgr::get_micro_block_handle(
                                                     K(micro_block_handle.cache_handle_), K(cur_level));
   } else {
     ObMicroBlockCacheKey key(tenant_id, index_block_info);
-    if (OB_FAIL(cache->get_cache_block(key, micro_block_handle.cache_handle_))) {
+    if (OB_FAIL(cache->get_cache_block(key, micro_block_handle.des_meta_, micro_block_handle.cache_handle_))) {
       // get data / index block cache from disk
       if (!need_submit_io) {
       } else if (cache_mem_ctrl_.need_sync_io(*query_flag_, micro_block_handle, cache, block_io_allocator_)) {
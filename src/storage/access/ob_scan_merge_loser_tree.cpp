@@ -48,16 +48,19 @@ int ObScanMergeLoserTreeCmp::init(const int64_t rowkey_size, const ObStorageDatu
 int ObScanMergeLoserTreeCmp::compare_rowkey(const ObDatumRow &l_row, const ObDatumRow &r_row, int64_t &cmp_result)
 {
   int ret = OB_SUCCESS;
+  int temp_cmp_ret = 0;
   if (OB_UNLIKELY(!l_row.is_valid() || !r_row.is_valid() || nullptr == datum_utils_)) {
     ret = OB_INVALID_ARGUMENT;
     LOG_WARN("invalid argument", K(ret), K(l_row), K(r_row), KP(datum_utils_));
   } else if (OB_UNLIKELY(l_row.get_column_count() < rowkey_size_ || r_row.get_column_count() < rowkey_size_)) {
     ret = OB_ERR_UNEXPECTED;
     STORAGE_LOG(WARN, "Unexpected row column cnt", K(ret), K(l_row), K(r_row), K_(rowkey_size));
+  } else if (datum_utils_->compare_norm_key(l_row.storage_datums_[0], r_row.storage_datums_[0], temp_cmp_ret)) {
+    // decided by the normalized keys of the first rowkey column
+    cmp_result = temp_cmp_ret;
   } else {
     ObDatumRowkey l_key;
     ObDatumRowkey r_key;
-    int temp_cmp_ret = 0;
     if (OB_FAIL(l_key.assign(l_row.storage_datums_, rowkey_size_))) {
       STORAGE_LOG(WARN, "Failed to assign store rowkey", K(ret), K(l_row), K_(rowkey_size));
     } else if (OB_FAIL(r_key.assign(r_row.storage_datums_, rowkey_size_))) {
@@ -535,22 +535,24 @@ int ObConstDecoder::nu_nn_operator(
       if (OB_FAIL(result_bitmap.bit_not())) {
         LOG_WARN("Failed to flip all bits in result bitmap", K(ret));
       }
-      for (int64_t pos = 0; OB_SUCC(ret) && pos < meta_header_->count_; ++pos) {
+      int64_t begin_pos = 0;
+      int64_t end_pos = 0;
+      get_except_pos_range(row_ids, pd_filter_info, begin_pos, end_pos);
+      for (int64_t pos = begin_pos; OB_SUCC(ret) && pos < end_pos; ++pos) {
         row_id = row_ids.at_(meta_header_->payload_ + meta_header_->count_, pos);
-        if (row_id >= pd_filter_info.start_
-            && row_id < pd_filter_info.start_ + pd_filter_info.count_
-            && OB_FAIL(result_bitmap.set(row_id - pd_filter_info.start_, false))) {
+        if (OB_FAIL(result_bitmap.set(row_id - pd_filter_info.start_, false))) {
           LOG_WARN("Failed to set result bitmap", K(ret), K(row_id), K(pd_filter_info));
         }
       }
     } else {
-      for (int64_t pos = 0; OB_SUCC(ret) && pos < meta_header_->count_; ++pos) {
+      int64_t begin_pos = 0;
+      int64_t end_pos = 0;
+      get_except_pos_range(row_ids, pd_filter_info, begin_pos, end_pos);
+      for (int64_t pos = begin_pos; OB_SUCC(ret) && pos < end_pos; ++pos) {
         ref = reinterpret_cast<const uint8_t*>(meta_header_->payload_)[pos];
         if (ref == dict_count) {
           row_id = row_ids.at_(meta_header_->payload_ + meta_header_->count_, pos);
-          if (row_id >= pd_filter_info.start_ &&
-              row_id < pd_filter_info.start_ + pd_filter_info.count_
-              && OB_FAIL(result_bitmap.set(row_id - pd_filter_info.start_))) {
+          if (OB_FAIL(result_bitmap.set(row_id - pd_filter_info.start_))) {
             LOG_WARN("Failed to set result bitmap", K(ret), K(row_id), K(pd_filter_info));
           }
         }
@@ -846,12 +848,14 @@ int ObConstDecoder::traverse_refs_and_set_res(
   int ret = OB_SUCCESS;
   int64_t ref;
   int64_t row_id;
-  for (int64_t pos = 0; OB_SUCC(ret) && pos < meta_header_->count_; ++pos) {
+  int64_t begin_pos = 0;
+  int64_t end_pos = 0;
+  get_except_pos_range(row_ids, pd_filter_info, begin_pos, end_pos);
+  for (int64_t pos = begin_pos; OB_SUCC(ret) && pos < end_pos; ++pos) {
     ref = reinterpret_cast<const uint8_t*>(meta_header_->payload_)[pos];
     if (ref == dict_ref) {
       row_id = row_ids.at_(meta_header_->payload_ + meta_header_->count_, pos);
-      if (row_id >= pd_filter_info.start_ && row_id < pd_filter_info.start_ + pd_filter_info.count_
-          && OB_FAIL(result_bitmap.set(row_id - pd_filter_info.start_, flag))) {
+      if (OB_FAIL(result_bitmap.set(row_id - pd_filter_info.start_, flag))) {
         LOG_WARN("Failed to set result bitmap", K(ret), K(row_id), K(pd_filter_info), K(flag));
       }
     }
@@ -869,12 +873,14 @@ int ObConstDecoder::set_res_with_bitset(
   int ret = OB_SUCCESS;
   int64_t ref;
   int64_t row_id;
-  for (int64_t pos = 0; OB_SUCC(ret) && pos < meta_header_->count_; ++pos) {
+  int64_t begin_pos = 0;
+  int64_t end_pos = 0;
+  get_except_pos_range(row_ids, pd_filter_info, begin_pos, end_pos);
+  for (int64_t pos = begin_pos; OB_SUCC(ret) && pos < end_pos; ++pos) {
     ref = reinterpret_cast<const uint8_t*>(meta_header_->payload_)[pos];
     if (ref_bitset->exist(ref)) {
       row_id = row_ids.at_(meta_header_->payload_ + meta_header_->count_, pos);
-      if (row_id >= pd_filter_info.start_ && row_id < pd_filter_info.start_ + pd_filter_info.count_
-          && OB_FAIL(result_bitmap.set(row_id - pd_filter_info.start_, flag))) {
+      if (OB_FAIL(result_bitmap.set(row_id - pd_filter_info.start_, flag))) {
         LOG_WARN("Failed to set result bitmap", K(ret), K(row_id), K(pd_filter_info), K(flag));
       }
     }
@@ -148,6 +148,19 @@ private:
       const sql::PushdownFilterInfo &pd_filter_info,
       ObBitmap &result_bitmap) const;
 
+  // Exception row ids are ascending, get positions of exceptions in filter range
+  OB_INLINE void get_except_pos_range(
+      const ObIntArrayFuncTable &row_ids,
+      const sql::PushdownFilterInfo &pd_filter_info,
+      int64_t &begin_pos,
+      int64_t &end_pos) const
+  {
+    const void *row_id_arr = meta_header_->payload_ + meta_header_->count_;
+    begin_pos = row_ids.lower_bound_(row_id_arr, 0, meta_header_->count_, pd_filter_info.start_);
+    end_pos = row_ids.lower_bound_(row_id_arr, begin_pos, meta_header_->count_,
+                                   pd_filter_info.start_ + pd_filter_info.count_);
+  }
+
   template<typename T = ObDatum *>
   int extract_ref_and_null_count(
       const int32_t *row_ids,
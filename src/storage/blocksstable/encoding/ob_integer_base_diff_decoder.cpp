@@ -14,9 +14,11 @@
 
 #include "ob_integer_base_diff_decoder.h"
 #include "ob_encoding_query_util.h"
+#include "ob_raw_decoder.h"
 #include "storage/blocksstable/ob_block_sstable_struct.h"
 #include "ob_bit_stream.h"
 #include "ob_integer_array.h"
+#include "common/ob_target_specific.h"
 
 namespace oceanbase
 {
@@ -478,6 +480,180 @@ inline int ObIntegerBaseDiffDecoder::get_delta<int64_t>(
   return ret;
 }
 
+typedef void (*int_diff_bt_function)(
+            const unsigned char *delta_data,
+            const uint64_t lower,
+            const uint64_t range,
+            uint8_t *selection,
+            uint32_t from,
+            uint32_t to);
+
+typedef void (*int_diff_in_function)(
+            const unsigned char *delta_data,
+            const uint64_t *values,
+            const int64_t value_cnt,
+            uint8_t *selection,
+            uint32_t from,
+            uint32_t to);
+
+template <typename DataType>
+class IntDiffFilterFunctionImpl
+{
+public:
+  // Deltas are unsigned, so lower <= delta <= lower + range equals to (delta - lower) <= range
+  OB_MULTITARGET_FUNCTION_AVX2_SSE42(
+  OB_MULTITARGET_FUNCTION_HEADER(static void), bt_function, OB_MULTITARGET_FUNCTION_BODY((
+      const unsigned char *delta_data,
+      const uint64_t lower,
+      const uint64_t range,
+      uint8_t *selection,
+      uint32_t from,
+      uint32_t to)
+  {
+    const DataType lower_value = static_cast<DataType>(lower);
+    const DataType range_value = static_cast<DataType>(range);
+    const DataType *start_pos = reinterpret_cast<const DataType *>(delta_data);
+    const DataType *a_end = start_pos + to;
+    const DataType * __restrict a_pos = start_pos + from;
+    uint8_t * __restrict c_pos = selection;
+    while (a_pos < a_end) {
+      *c_pos = static_cast<DataType>(*a_pos - lower_value) <= range_value;
+      ++a_pos;
+      ++c_pos;
+    }
+  }))
+
+  OB_MULTITARGET_FUNCTION_AVX2_SSE42(
+  OB_MULTITARGET_FUNCTION_HEADER(static void), in_function, OB_MULTITARGET_FUNCTION_BODY((
+      const unsigned char *delta_data,
+      const uint64_t *values,
+      const int64_t value_cnt,
+      uint8_t *selection,
+      uint32_t from,
+      uint32_t to)
+  {
+    const DataType *start_pos = reinterpret_cast<const DataType *>(delta_data);
+    const DataType *a_end = start_pos + to;
+    MEMSET(selection, 0, to - from);
+    for (int64_t i = 0; i < value_cnt; ++i) {
+      const DataType value = static_cast<DataType>(values[i]);
+      const DataType * __restrict a_pos = start_pos + from;
+      uint8_t * __restrict c_pos = selection;
+      while (a_pos < a_end) {
+        *c_pos |= static_cast<uint8_t>(*a_pos == value);
+        ++a_pos;
+        ++c_pos;
+      }
+    }
+  }))
+};
+
+class IntDiffFilterFunctionFactory
+{
+public:
+  static constexpr uint32_t FIX_LEN_TAG_CNT = 4;
+public:
+  static IntDiffFilterFunctionFactory &instance()
+  {
+    static IntDiffFilterFunctionFactory ret;
+    return ret;
+  }
+  int_diff_bt_function get_bt_function(const int32_t fix_len_tag) const
+  {
+    return bt_functions_[fix_len_tag];
+  }
+  int_diff_in_function get_in_function(const int32_t fix_len_tag) const
+  {
+    return in_functions_[fix_len_tag];
+  }
+private:
+  template <int32_t LEN_TAG>
+  void produce(const bool use_avx2)
+  {
+    typedef typename ObEncodingTypeInference<false, LEN_TAG>::Type DataType;
+#if OB_USE_MULTITARGET_CODE
+    if (use_avx2) {
+      bt_functions_[LEN_TAG] = IntDiffFilterFunctionImpl<DataType>::bt_function_avx2;
+      in_functions_[LEN_TAG] = IntDiffFilterFunctionImpl<DataType>::in_function_avx2;
+    } else {
+      bt_functions_[LEN_TAG] = IntDiffFilterFunctionImpl<DataType>::bt_function;
+      in_functions_[LEN_TAG] = IntDiffFilterFunctionImpl<DataType>::in_function;
+    }
+#else
+    UNUSED(use_avx2);
+    bt_functions_[LEN_TAG] = IntDiffFilterFunctionImpl<DataType>::bt_function;
+    in_functions_[LEN_TAG] = IntDiffFilterFunctionImpl<DataType>::in_function;
+#endif
+  }
+  IntDiffFilterFunctionFactory()
+  {
+    const bool use_avx2 = is_arch_supported(ObTargetArch::AVX2);
+    produce<0>(use_avx2);
+    produce<1>(use_avx2);
+    produce<2>(use_avx2);
+    produce<3>(use_avx2);
+  }
+  ~IntDiffFilterFunctionFactory() = default;
+  DISALLOW_COPY_AND_ASSIGN(IntDiffFilterFunctionFactory);
+private:
+  int_diff_bt_function bt_functions_[FIX_LEN_TAG_CNT];
+  int_diff_in_function in_functions_[FIX_LEN_TAG_CNT];
+};
+
+struct IntDiffCmpFilter
+{
+  IntDiffCmpFilter(const sql::ObWhiteFilterOperatorType op_type, const uint64_t value)
+    : op_type_(op_type), value_(value) {}
+  void operator()(
+      const unsigned char *delta_data,
+      const int32_t fix_len_tag,
+      uint8_t *selection,
+      uint32_t from,
+      uint32_t to) const
+  {
+    RawCompareFunctionFactory::instance().get_cmp_function(false, fix_len_tag, op_type_)(
+        delta_data, value_, selection, from, to);
+  }
+  const sql::ObWhiteFilterOperatorType op_type_;
+  const uint64_t value_;
+};
+
+struct IntDiffBetweenFilter
+{
+  IntDiffBetweenFilter(const uint64_t lower, const uint64_t upper)
+    : lower_(lower), range_(upper - lower) {}
+  void operator()(
+      const unsigned char *delta_data,
+      const int32_t fix_len_tag,
+      uint8_t *selection,
+      uint32_t from,
+      uint32_t to) const
+  {
+    IntDiffFilterFunctionFactory::instance().get_bt_function(fix_len_tag)(
+        delta_data, lower_, range_, selection, from, to);
+  }
+  const uint64_t lower_;
+  const uint64_t range_;
+};
+
+struct IntDiffInFilter
+{
+  IntDiffInFilter(const uint64_t *values, const int64_t value_cnt)
+    : values_(values), value_cnt_(value_cnt) {}
+  void operator()(
+      const unsigned char *delta_data,
+      const int32_t fix_len_tag,
+      uint8_t *selection,
+      uint32_t from,
+      uint32_t to) const
+  {
+    IntDiffFilterFunctionFactory::instance().get_in_function(fix_len_tag)(
+        delta_data, values_, value_cnt_, selection, from, to);
+  }
+  const uint64_t *values_;
+  const int64_t value_cnt_;
+};
+
 int ObIntegerBaseDiffDecoder::comparison_operator(
     const sql::ObPushdownFilterExecutor *parent,
     const ObColumnDecoderCtx &col_ctx,
@@ -487,7 +663,6 @@ int ObIntegerBaseDiffDecoder::comparison_operator(
     ObBitmap &result_bitmap) const
 {
   int ret = OB_SUCCESS;
-  uint64_t delta_value = 0;
   uint64_t param_delta_value = 0;
   common::ObObjMeta filter_val_meta;
   if (OB_UNLIKELY(pd_filter_info.count_ != result_bitmap.size()
@@ -519,7 +694,6 @@ int ObIntegerBaseDiffDecoder::comparison_operator(
     bool  filter_obj_smaller_than_base = false;
 
     const sql::ObWhiteFilterOperatorType op_type = filter.get_op_type();
-    ObGetFilterCmpRetFunc get_cmp_ret = get_filter_cmp_ret_func(op_type);
     int cmp_res = 0;
     if (FAILEDx(cmp_func(ref_datum, base_datum, cmp_res))) {
       LOG_WARN("Failed to compare datum", K(ret), K(ref_datum), K(base_datum));
@@ -536,16 +710,7 @@ int ObIntegerBaseDiffDecoder::comparison_operator(
         result_bitmap.reuse();
       }
     } else {
-      #define UINT_DIFF_CMP(l, r) ( l == r ? 0 : (l < r ? -1 : 1) )
-      uint8_t cell_len = header_->length_;
-      int64_t data_offset = 0;
-      bool null_value_contained = result_bitmap.popcnt() > 0;
-      bool exist_parent_filter = nullptr != parent;
       const ObObjType &ref_obj_type = filter_val_meta.get_type();
-      if (col_ctx.has_extend_value()) {
-        data_offset = col_ctx.micro_block_header_->row_count_
-            * col_ctx.micro_block_header_->extend_value_bit_;
-      }
       if (ObIntSC == column_sc) {
         if (OB_FAIL(get_delta<int64_t>(ref_obj_type, ref_datum, param_delta_value))) {
           LOG_WARN("Failed to get delta value", K(ret), K(ref_datum));
@@ -560,51 +725,19 @@ int ObIntegerBaseDiffDecoder::comparison_operator(
       }
 
       if (OB_FAIL(ret)) {
-      } else if (col_ctx.is_bit_packing()) {
-        int64_t row_id = 0;
-        for (int64_t offset = 0; OB_SUCC(ret) && offset < pd_filter_info.count_; ++offset) {
-          row_id = offset + pd_filter_info.start_;
-          if (exist_parent_filter && parent->can_skip_filter(offset)) {
-          } else if (null_value_contained && result_bitmap.test(offset)) {
-            if (OB_FAIL(result_bitmap.set(offset, false))) {
-              LOG_WARN("Failed to set row with null object to false",
-                  K(ret), K(offset));
-            }
-          } else if (OB_FAIL(ObBitStream::get(
-                col_data, data_offset + row_id * cell_len, cell_len, delta_value))) {
-              LOG_WARN("Failed to get bit packing value", K(ret), K_(header));
-          } else {
-            if (get_cmp_ret(UINT_DIFF_CMP(delta_value, param_delta_value))) {
-              if (OB_FAIL(result_bitmap.set(offset))) {
-                LOG_WARN("Failed to set result bitmap",
-                    K(ret), K(offset), K(filter));
-              }
-            }
-          }
-        }
-      } else {
-        data_offset = (data_offset + CHAR_BIT - 1) / CHAR_BIT;
-        int64_t row_id = 0;
-        for (int64_t offset = 0; OB_SUCC(ret) && offset < pd_filter_info.count_; ++offset) {
-          row_id = offset + pd_filter_info.start_;
-          if (exist_parent_filter && parent->can_skip_filter(offset)) {
-          } else if (null_value_contained && result_bitmap.test(offset)) {
-            if (OB_FAIL(result_bitmap.set(offset, false))) {
-              LOG_WARN("Failed to set row with null object to false",
-                  K(ret), K(offset));
-            }
-          } else {
-            MEMCPY(&delta_value, col_data + data_offset + row_id * cell_len, cell_len);
-            if (get_cmp_ret(UINT_DIFF_CMP(delta_value, param_delta_value))) {
-              if (OB_FAIL(result_bitmap.set(offset))) {
-                LOG_WARN("Failed to set result bitmap",
-                    K(ret), K(offset), K(filter));
-              }
-            }
+      } else if (param_delta_value > get_max_delta(col_ctx)) {
+        // Filter value is larger than all values in micro block
+        if (op_type == sql::WHITE_OP_LT || op_type == sql::WHITE_OP_LE || op_type == sql::WHITE_OP_NE) {
+          if (OB_FAIL(result_bitmap.bit_not())) {
+            LOG_WARN("Failed to flip all bits in bitmap", K(ret));
           }
+        } else {
+          result_bitmap.reuse();
         }
+      } else if (OB_FAIL(batch_filter_deltas(parent, col_ctx, col_data,
+          IntDiffCmpFilter(op_type, param_delta_value), pd_filter_info, result_bitmap))) {
+        LOG_WARN("Failed to filter deltas in batch", K(ret), K(col_ctx), K(pd_filter_info));
       }
-      #undef UINT_DIFF_CMP
     }
   }
   return ret;
@@ -619,6 +752,7 @@ int ObIntegerBaseDiffDecoder::bt_operator(
     ObBitmap &result_bitmap) const
 {
   int ret = OB_SUCCESS;
+  common::ObObjMeta filter_val_meta;
   if (OB_UNLIKELY(pd_filter_info.count_ != result_bitmap.size()
                           || NULL == col_data
                           || filter.get_datums().count() != 2)) {
@@ -630,8 +764,13 @@ int ObIntegerBaseDiffDecoder::bt_operator(
     // Can't compare by uint directly, support this later with float point number compare later
     ret = OB_NOT_SUPPORTED;
     LOG_DEBUG("Double/Float with INT_DIFF encoding, back to retro path", K(col_ctx));
-  } else if (ObUIntSC == get_store_class_map()[col_ctx.obj_meta_.get_type_class()]
-        || ObIntSC == get_store_class_map()[col_ctx.obj_meta_.get_type_class()]) {
+  } else if (ObUIntSC != get_store_class_map()[col_ctx.obj_meta_.get_type_class()]
+        && ObIntSC != get_store_class_map()[col_ctx.obj_meta_.get_type_class()]) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Integer base encoding should only encode data as IntSC", K(ret), K(filter));
+  } else if (OB_FAIL(filter.get_filter_node().get_filter_val_meta(filter_val_meta))) {
+    LOG_WARN("Fail to find datum meta", K(ret), K(filter));
+  } else if (filter.get_datums().at(0).is_null() || filter.get_datums().at(1).is_null()) {
     if (OB_FAIL(traverse_all_data(parent, col_ctx, col_data,
                 filter, pd_filter_info, result_bitmap,
                 [](const ObDatum &cur_datum,
@@ -653,8 +792,29 @@ int ObIntegerBaseDiffDecoder::bt_operator(
       LOG_WARN("Failed to traverse all data in micro block", K(ret));
     }
   } else {
-    ret = OB_ERR_UNEXPECTED;
-    LOG_WARN("Integer base encoding should only encode data as IntSC", K(ret), K(filter));
+    const ObObjType &ref_obj_type = filter_val_meta.get_type();
+    const uint64_t max_delta = get_max_delta(col_ctx);
+    bool lower_less_than_base = false;
+    bool upper_less_than_base = false;
+    uint64_t lower_delta = 0;
+    uint64_t upper_delta = 0;
+    if (OB_FAIL(get_filter_delta(col_ctx, filter, ref_obj_type, filter.get_datums().at(1),
+                                 upper_less_than_base, upper_delta))) {
+      LOG_WARN("Failed to get delta of upper bound", K(ret), K(filter));
+    } else if (upper_less_than_base) {
+      // All rows are false
+      result_bitmap.reuse();
+    } else if (OB_FAIL(get_filter_delta(col_ctx, filter, ref_obj_type, filter.get_datums().at(0),
+                                        lower_less_than_base, lower_delta))) {
+      LOG_WARN("Failed to get delta of lower bound", K(ret), K(filter));
+    } else if (FALSE_IT(lower_delta = lower_less_than_base ? 0 : lower_delta)) {
+    } else if (FALSE_IT(upper_delta = MIN(upper_delta, max_delta))) {
+    } else if (lower_delta > upper_delta) {
+      result_bitmap.reuse();
+    } else if (OB_FAIL(batch_filter_deltas(parent, col_ctx, col_data,
+        IntDiffBetweenFilter(lower_delta, upper_delta), pd_filter_info, result_bitmap))) {
+      LOG_WARN("Failed to filter deltas in batch", K(ret), K(col_ctx), K(pd_filter_info));
+    }
   }
   return ret;
 }
@@ -668,11 +828,52 @@ int ObIntegerBaseDiffDecoder::in_operator(
     ObBitmap &result_bitmap) const
 {
   int ret = OB_SUCCESS;
+  common::ObObjMeta filter_val_meta;
+  bool fast_filter_valid = false;
   if (OB_UNLIKELY(filter.get_datums().count() == 0
                   || result_bitmap.size() != pd_filter_info.count_)) {
     ret = OB_INVALID_ARGUMENT;
     LOG_WARN("Pushdown in operator: Invalid arguments",
         K(ret), K(col_ctx), K(pd_filter_info), K(result_bitmap.size()), K(filter));
+  } else if (OB_FAIL(filter.get_filter_node().get_filter_val_meta(filter_val_meta))) {
+    LOG_WARN("Fail to find datum meta", K(ret), K(filter));
+  } else {
+    // IN list with the same type as column is compared on deltas, others go through
+    // the datum hash set
+    const ObObjTypeClass col_tc = col_ctx.obj_meta_.get_type_class();
+    const ObObjTypeStoreClass column_sc = get_store_class_map()[col_tc];
+    fast_filter_valid = filter.get_datums().count() <= MAX_FAST_IN_CNT
+        && ObFloatTC != col_tc
+        && ObDoubleTC != col_tc
+        && (ObIntSC == column_sc || ObUIntSC == column_sc)
+        && filter_val_meta.get_type() == col_ctx.obj_meta_.get_type();
+  }
+
+  if (OB_FAIL(ret)) {
+  } else if (fast_filter_valid) {
+    const uint64_t max_delta = get_max_delta(col_ctx);
+    uint64_t in_deltas[MAX_FAST_IN_CNT];
+    int64_t in_cnt = 0;
+    bool less_than_base = false;
+    uint64_t delta = 0;
+    for (int64_t i = 0; OB_SUCC(ret) && i < filter.get_datums().count(); ++i) {
+      const ObDatum &in_datum = filter.get_datums().at(i);
+      if (in_datum.is_null()) {
+      } else if (OB_FAIL(get_filter_delta(col_ctx, filter, filter_val_meta.get_type(), in_datum,
+                                          less_than_base, delta))) {
+        LOG_WARN("Failed to get delta of in param", K(ret), K(in_datum));
+      } else if (!less_than_base && delta <= max_delta) {
+        in_deltas[in_cnt++] = delta;
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (0 == in_cnt) {
+      // All rows are false
+      result_bitmap.reuse();
+    } else if (OB_FAIL(batch_filter_deltas(parent, col_ctx, col_data,
+        IntDiffInFilter(in_deltas, in_cnt), pd_filter_info, result_bitmap))) {
+      LOG_WARN("Failed to filter deltas in batch", K(ret), K(col_ctx), K(pd_filter_info));
+    }
   } else if (OB_FAIL(traverse_all_data(parent, col_ctx, col_data,
                       filter, pd_filter_info, result_bitmap,
                       [](const ObDatum &cur_datum,
@@ -689,6 +890,131 @@ int ObIntegerBaseDiffDecoder::in_operator(
   return ret;
 }
 
+int ObIntegerBaseDiffDecoder::get_filter_delta(
+    const ObColumnDecoderCtx &col_ctx,
+    const sql::ObWhiteFilterExecutor &filter,
+    const ObObjType ref_obj_type,
+    const common::ObDatum &ref_datum,
+    bool &less_than_base,
+    uint64_t &delta) const
+{
+  int ret = OB_SUCCESS;
+  ObStorageDatum base_datum;
+  uint32_t base_datum_len = 0;
+  int cmp_res = 0;
+  const ObObjTypeStoreClass column_sc = get_store_class_map()[col_ctx.obj_meta_.get_type_class()];
+  less_than_base = false;
+  delta = 0;
+  if (OB_FAIL(get_uint_data_datum_len(
+      ObDatum::get_obj_datum_map_type(col_ctx.obj_meta_.get_type()),
+      base_datum_len))) {
+    LOG_WARN("Failed to get datum len for int data", K(ret));
+  } else if (FALSE_IT(base_datum.ptr_ = reinterpret_cast<const char *>(&base_))) {
+  } else if (FALSE_IT(base_datum.pack_ = base_datum_len)) {
+  } else if (OB_FAIL(filter.cmp_func_(base_datum, ref_datum, cmp_res))) {
+    LOG_WARN("Failed to compare datum", K(ret), K(base_datum), K(ref_datum));
+  } else if (cmp_res > 0) {
+    less_than_base = true;
+  } else if (ObIntSC == column_sc) {
+    if (OB_FAIL(get_delta<int64_t>(ref_obj_type, ref_datum, delta))) {
+      LOG_WARN("Failed to get delta value", K(ret), K(ref_datum));
+    }
+  } else if (ObUIntSC == column_sc) {
+    if (OB_FAIL(get_delta<uint64_t>(ref_obj_type, ref_datum, delta))) {
+      LOG_WARN("Failed to get delta value", K(ret), K(ref_datum));
+    }
+  } else {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected Store type for int_diff decoder", K(ret), K(column_sc));
+  }
+  return ret;
+}
+
+int ObIntegerBaseDiffDecoder::unpack_deltas(
+    const ObColumnDecoderCtx &col_ctx,
+    const unsigned char *col_data,
+    const int64_t data_offset,
+    const int64_t start,
+    const int64_t count,
+    uint64_t *deltas) const
+{
+  int ret = OB_SUCCESS;
+  const int64_t cell_len = header_->length_;
+  if (col_ctx.is_bit_packing()) {
+    const bitstream_unpack unpack_func = ObBitStream::get_unpack_func(cell_len);
+    const int64_t bs_len = data_offset + cell_len * col_ctx.micro_block_header_->row_count_;
+    int64_t bit_offset = data_offset + start * cell_len;
+    for (int64_t i = 0; OB_SUCC(ret) && i < count; ++i, bit_offset += cell_len) {
+      if (OB_FAIL(unpack_func(col_data, bit_offset, cell_len, bs_len,
+                              *reinterpret_cast<int64_t *>(deltas + i)))) {
+        LOG_WARN("Failed to get bit packing value", K(ret), K_(header), K(bit_offset));
+      }
+    }
+  } else {
+    const unsigned char *cell = col_data + data_offset + start * cell_len;
+    for (int64_t i = 0; i < count; ++i, cell += cell_len) {
+      deltas[i] = 0;
+      MEMCPY(deltas + i, cell, cell_len);
+    }
+  }
+  return ret;
+}
+
+template <typename Filter>
+int ObIntegerBaseDiffDecoder::batch_filter_deltas(
+    const sql::ObPushdownFilterExecutor *parent,
+    const ObColumnDecoderCtx &col_ctx,
+    const unsigned char *col_data,
+    const Filter &filter_func,
+    const sql::PushdownFilterInfo &pd_filter_info,
+    ObBitmap &result_bitmap) const
+{
+  int ret = OB_SUCCESS;
+  const int64_t cell_len = header_->length_;
+  // result_bitmap is the is-null bitmap of rows now
+  const bool has_null = col_ctx.has_extend_value() && result_bitmap.popcnt() > 0;
+  // Fixed deltas of 1/2/4/8 bytes are filtered in place, others are unpacked to uint64_t first
+  const bool filter_in_place = !col_ctx.is_bit_packing()
+      && (1 == cell_len || 2 == cell_len || 4 == cell_len || 8 == cell_len);
+  int64_t data_offset = 0;
+  if (col_ctx.has_extend_value()) {
+    data_offset = col_ctx.micro_block_header_->row_count_
+        * col_ctx.micro_block_header_->extend_value_bit_;
+  }
+  if (!col_ctx.is_bit_packing()) {
+    data_offset = (data_offset + CHAR_BIT - 1) / CHAR_BIT;
+  }
+  uint8_t *res = result_bitmap.get_data();
+  uint8_t selection[FILTER_BATCH_SIZE];
+  uint64_t deltas[FILTER_BATCH_SIZE];
+  for (int64_t offset = 0; OB_SUCC(ret) && offset < pd_filter_info.count_; offset += FILTER_BATCH_SIZE) {
+    const int64_t batch_cnt = MIN(FILTER_BATCH_SIZE, pd_filter_info.count_ - offset);
+    const int64_t row_id = pd_filter_info.start_ + offset;
+    uint8_t *batch_res = has_null ? selection : res + offset;
+    const bool skip_batch = nullptr != parent
+        && parent->can_skip_filter(offset, offset + batch_cnt - 1);
+    if (skip_batch) {
+      // Result of the whole batch is decided by parent already
+      MEMSET(res + offset, 0, batch_cnt);
+    } else if (filter_in_place) {
+      filter_func(col_data + data_offset, get_value_len_tag_map()[cell_len],
+                  batch_res, row_id, row_id + batch_cnt);
+    } else if (OB_FAIL(unpack_deltas(col_ctx, col_data, data_offset, row_id, batch_cnt, deltas))) {
+      LOG_WARN("Failed to unpack deltas", K(ret), K(row_id), K(batch_cnt));
+    } else {
+      filter_func(reinterpret_cast<const unsigned char *>(deltas), get_value_len_tag_map()[sizeof(uint64_t)],
+                  batch_res, 0, batch_cnt);
+    }
+    if (OB_SUCC(ret) && has_null && !skip_batch) {
+      uint8_t * __restrict out = res + offset;
+      for (int64_t i = 0; i < batch_cnt; ++i) {
+        out[i] = selection[i] & (out[i] ^ 1);
+      }
+    }
+  }
+  return ret;
+}
+
 int ObIntegerBaseDiffDecoder::traverse_all_data(
     const sql::ObPushdownFilterExecutor *parent,
     const ObColumnDecoderCtx &col_ctx,
@@ -132,7 +132,48 @@ private:
 
   template<typename VectorType, bool HAS_NULL>
   int inner_decode_vector(const ObColumnDecoderCtx &decoder_ctx, ObVectorDecodeCtx &vector_ctx) const;
+
+  // Delta of %ref_datum to base_, %less_than_base is set if %ref_datum < base_ and
+  // delta is not calculated in that case.
+  int get_filter_delta(
+      const ObColumnDecoderCtx &col_ctx,
+      const sql::ObWhiteFilterExecutor &filter,
+      const ObObjType ref_obj_type,
+      const common::ObDatum &ref_datum,
+      bool &less_than_base,
+      uint64_t &delta) const;
+
+  // Max delta value could be stored in this column
+  OB_INLINE uint64_t get_max_delta(const ObColumnDecoderCtx &col_ctx) const
+  {
+    const int64_t cell_len = header_->length_;
+    return col_ctx.is_bit_packing()
+        ? (cell_len >= 64 ? UINT64_MAX : (1ULL << cell_len) - 1)
+        : INTEGER_MASK_TABLE[cell_len];
+  }
+
+  int unpack_deltas(
+      const ObColumnDecoderCtx &col_ctx,
+      const unsigned char *col_data,
+      const int64_t data_offset,
+      const int64_t start,
+      const int64_t count,
+      uint64_t *deltas) const;
+
+  // Evaluate %filter_func on deltas of rows in pd_filter_info batch by batch with SIMD
+  // kernels, rows with null value are set to false. Batches that %parent can skip are
+  // not evaluated.
+  template <typename Filter>
+  int batch_filter_deltas(
+      const sql::ObPushdownFilterExecutor *parent,
+      const ObColumnDecoderCtx &col_ctx,
+      const unsigned char *col_data,
+      const Filter &filter_func,
+      const sql::PushdownFilterInfo &pd_filter_info,
+      ObBitmap &result_bitmap) const;
 private:
+  static const int64_t FILTER_BATCH_SIZE = 256;
+  static const int64_t MAX_FAST_IN_CNT = 16;
   const ObIntegerBaseDiffHeader *header_;
   uint64_t base_;
 };
@@ -460,14 +460,20 @@ int ObIEncodeBlockReader::do_init(
       LOG_WARN("fail to alloc local decoder pool memory", K(ret));
     } else {
       row_data_ = block_data.get_buf() + header_->row_data_offset_;
-      const int64_t row_data_len = block_data.get_buf_size() - header_->row_data_offset_;
+      int64_t hash_index_size = 0;
+      int64_t row_data_len = 0;
 
       if (NULL != block_data.get_extra_buf() && block_data.get_extra_size() > 0) {
         cached_decocer_ = reinterpret_cast<const ObBlockCachedDecoderHeader *>(
             block_data.get_extra_buf());
       }
 
-      if (header_->row_index_byte_ > 0) {
+      // the hash index is stored after the row index
+      if (OB_FAIL(ObMicroBlockHashIndex::get_hash_index_size(
+          *header_, block_data.get_buf(), block_data.get_buf_size(), hash_index_size))) {
+        LOG_WARN("failed to get hash index size", K(ret), K(block_data));
+      } else if (FALSE_IT(row_data_len = block_data.get_buf_size() - header_->row_data_offset_ - hash_index_size)) {
+      } else if (header_->row_index_byte_ > 0) {
         if (OB_FAIL(var_row_index_.init(row_data_, row_data_len,
             header_->row_count_, header_->row_index_byte_))) {
           LOG_WARN("init var row index failed", K(ret), KP_(row_data), K(row_data_len), K_(header));
@@ -617,6 +623,7 @@ void ObEncodeBlockGetReader::reuse()
 {
   ObIEncodeBlockReader::reuse();
   read_info_ = nullptr;
+  hash_index_.reset();
 }
 
 int ObEncodeBlockGetReader::init_by_read_info(
@@ -660,6 +667,8 @@ int ObEncodeBlockGetReader::init_by_read_info(
     if (OB_FAIL(ret)) {
     } else if (OB_FAIL(do_init(block_data, request_cnt))) {
       LOG_WARN("failed to do init", K(ret), K(block_data), K(request_cnt));
+    } else if (OB_FAIL(ObIMicroBlockGetReader::init_hash_index(block_data, hash_index_, header_))) {
+      LOG_WARN("failed to init micro block hash index", K(ret), K(block_data));
     } else {
       row_count_ = header_->row_count_;
       original_data_length_ = header_->original_length_;
@@ -736,18 +745,20 @@ int ObEncodeBlockGetReader::locate_row(
     bool &found)
 {
   int ret = OB_SUCCESS;
+  bool need_binary_search = true;
 
   if (OB_UNLIKELY(rowkey.get_datum_cnt() > datum_utils.get_rowkey_count())) {
     ret = OB_INVALID_ARGUMENT;
     STORAGE_LOG(WARN, "Invalid argument to locate row", K(ret), K(rowkey), K(datum_utils));
-  } else {
+  } else if (FALSE_IT(found = false)) {
+  } else if (OB_FAIL(locate_row_fast_path(rowkey, datum_utils, row_data, row_len, row_id,
+                                          need_binary_search, found))) {
+    LOG_WARN("failed to locate row by hash index", K(ret), K(rowkey));
+  } else if (need_binary_search) {
     found = false;
     row_data = NULL;
     row_len = 0;
     row_id = -1;
-    //reader_
-    const int64_t rowkey_cnt = rowkey.get_datum_cnt();
-    const ObStorageDatum *datums = rowkey.datums_;
     //binary search
     int32_t high = header_->row_count_ - 1;
     int32_t low = 0;
@@ -759,31 +770,82 @@ int ObEncodeBlockGetReader::locate_row(
       cmp_result = 0;
       if (OB_FAIL(setup_row(middle, row_len, row_data))) {
         LOG_WARN("failed to setup row", K(ret));
+      } else if (OB_FAIL(compare_rowkey(rowkey, datum_utils, middle, row_data, row_len, cmp_result))) {
+        LOG_WARN("failed to compare rowkey", K(ret), K(middle), K(rowkey));
+      } else if (cmp_result < 0) {
+        high = middle - 1;
+      } else if (cmp_result > 0) {
+        low = middle + 1;
       } else {
-        ObBitStream bs(reinterpret_cast<unsigned char *>(const_cast<char *>(row_data)), row_len);
-        for (int64_t i = 0; OB_SUCC(ret) && 0 == cmp_result && i < rowkey_cnt; ++i) {
-          if (OB_FAIL(decoders_[i].quick_compare(datums[i], datum_utils.get_cmp_funcs().at(i),
-                                                 middle, bs, row_data, row_len, cmp_result))) {
-            LOG_WARN("decode and compare cell failed", K(ret), K(middle), K(i), KP(row_data),
-                K(row_len), K(datums[i]));
-          }
-        }
+        found = true;
+        row_id = middle;
+        break;
+      }
+    }
+  }
 
-        if (OB_SUCC(ret)) {
-          if (cmp_result < 0) {
-            high = middle - 1;
-          } else if (cmp_result > 0) {
-            low = middle + 1;
-          } else {
-            found = true;
-            row_id = middle;
-            break;
-          }
-        }
+  return ret;
+}
+
+int ObEncodeBlockGetReader::locate_row_fast_path(
+    const ObDatumRowkey &rowkey,
+    const ObStorageDatumUtils &datum_utils,
+    const char *&row_data,
+    int64_t &row_len,
+    int64_t &row_id,
+    bool &need_binary_search,
+    bool &found)
+{
+  int ret = OB_SUCCESS;
+  need_binary_search = true;
+  if (hash_index_.is_inited()) {
+    uint64_t hash_value = 0;
+    if (OB_FAIL(rowkey.murmurhash(0, datum_utils, hash_value))) {
+      LOG_WARN("Failed to calc rowkey hash", K(ret), K(rowkey), K(datum_utils));
+    } else {
+      const uint16_t tmp_row_idx = hash_index_.find(hash_value);
+      int32_t cmp_result = 0;
+      if (tmp_row_idx == ObMicroBlockHashIndex::WIDE_NO_ENTRY) {
+        need_binary_search = false;
+        found = false;
+      } else if (tmp_row_idx == ObMicroBlockHashIndex::WIDE_COLLISION) {
+      } else if (OB_UNLIKELY(tmp_row_idx >= header_->row_count_)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("Unexpected row_idx", K(ret), K(tmp_row_idx), KPC_(header), K(rowkey));
+      } else if (OB_FAIL(setup_row(tmp_row_idx, row_len, row_data))) {
+        LOG_WARN("failed to setup row", K(ret), K(tmp_row_idx));
+      } else if (OB_FAIL(compare_rowkey(rowkey, datum_utils, tmp_row_idx, row_data, row_len, cmp_result))) {
+        LOG_WARN("failed to compare rowkey", K(ret), K(tmp_row_idx), K(rowkey));
+      } else {
+        need_binary_search = false;
+        found = (0 == cmp_result);
+        row_id = found ? tmp_row_idx : -1;
       }
     }
   }
+  return ret;
+}
 
+int ObEncodeBlockGetReader::compare_rowkey(
+    const ObDatumRowkey &rowkey,
+    const ObStorageDatumUtils &datum_utils,
+    const int64_t row_id,
+    const char *row_data,
+    const int64_t row_len,
+    int32_t &cmp_result)
+{
+  int ret = OB_SUCCESS;
+  const int64_t rowkey_cnt = rowkey.get_datum_cnt();
+  const ObStorageDatum *datums = rowkey.datums_;
+  ObBitStream bs(reinterpret_cast<unsigned char *>(const_cast<char *>(row_data)), row_len);
+  cmp_result = 0;
+  for (int64_t i = 0; OB_SUCC(ret) && 0 == cmp_result && i < rowkey_cnt; ++i) {
+    if (OB_FAIL(decoders_[i].quick_compare(datums[i], datum_utils.get_cmp_funcs().at(i),
+                                           row_id, bs, row_data, row_len, cmp_result))) {
+      LOG_WARN("decode and compare cell failed", K(ret), K(row_id), K(i), KP(row_data),
+          K(row_len), K(datums[i]));
+    }
+  }
   return ret;
 }
 
@@ -811,6 +873,8 @@ int ObEncodeBlockGetReader::init_by_columns_desc(
       LOG_WARN("get micro block meta failed", K(ret), K(block_data), KPC(header_));
     } else if (OB_FAIL(do_init(block_data, request_cnt))) {
       LOG_WARN("failed to do init", K(ret), K(block_data), K(request_cnt));
+    } else if (OB_FAIL(ObIMicroBlockGetReader::init_hash_index(block_data, hash_index_, header_))) {
+      LOG_WARN("failed to init micro block hash index", K(ret), K(block_data));
     }
   }
   return ret;
@@ -1357,7 +1421,8 @@ int ObMicroBlockDecoder::do_init(const ObMicroBlockData &block_data)
     row_count_ = header_->row_count_;
     original_data_length_ = header_->original_length_;
     row_data_ = block_data.get_buf() + header_->row_data_offset_;
-    const int64_t row_data_len = block_data.get_buf_size() - header_->row_data_offset_;
+    int64_t hash_index_size = 0;
+    int64_t row_data_len = 0;
 
     if (block_data.type_ == ObMicroBlockData::Type::DATA_BLOCK
         && NULL != block_data.get_extra_buf() && block_data.get_extra_size() > 0) {
@@ -1365,7 +1430,12 @@ int ObMicroBlockDecoder::do_init(const ObMicroBlockData &block_data)
           block_data.get_extra_buf());
     }
 
-    if (header_->row_index_byte_ > 0) {
+    // the hash index is stored after the row index
+    if (OB_FAIL(ObMicroBlockHashIndex::get_hash_index_size(
+        *header_, block_data.get_buf(), block_data.get_buf_size(), hash_index_size))) {
+      LOG_WARN("failed to get hash index size", K(ret), K(block_data));
+    } else if (FALSE_IT(row_data_len = block_data.get_buf_size() - header_->row_data_offset_ - hash_index_size)) {
+    } else if (header_->row_index_byte_ > 0) {
       if (OB_FAIL(var_row_index_.init(row_data_, row_data_len,
                                       header_->row_count_, header_->row_index_byte_))) {
         LOG_WARN("init var row index failed",
@@ -220,6 +220,23 @@ private:
       int64_t &row_len,
       int64_t &row_id,
       bool &found);
+  int locate_row_fast_path(
+      const ObDatumRowkey &rowkey,
+      const ObStorageDatumUtils &datum_utils,
+      const char *&row_data,
+      int64_t &row_len,
+      int64_t &row_id,
+      bool &need_binary_search,
+      bool &found);
+  int compare_rowkey(
+      const ObDatumRowkey &rowkey,
+      const ObStorageDatumUtils &datum_utils,
+      const int64_t row_id,
+      const char *row_data,
+      const int64_t row_len,
+      int32_t &cmp_result);
+private:
+  ObMicroBlockHashIndex hash_index_;
 };
 
 class ObMicroBlockDecoder : public ObIMicroBlockDecoder
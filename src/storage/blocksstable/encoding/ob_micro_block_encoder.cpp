@@ -112,6 +112,8 @@ ObMicroBlockEncoder::ObMicroBlockEncoder() : ctx_(), header_(NULL),
     string_col_cnt_(0), estimate_base_store_size_(0),
     col_ctxs_(OB_MALLOC_NORMAL_BLOCK_SIZE, MICRO_BLOCK_PAGE_ALLOCATOR),
     length_(0),
+    hash_index_buffer_(),
+    hash_index_offset_from_end_(0),
     is_inited_(false)
 {
   encoding_meta_allocator_.set_attr(ObMemAttr(MTL_ID(), "MicroBlkEncoder"));
@@ -238,6 +240,8 @@ void ObMicroBlockEncoder::reset()
   col_ctxs_.reset();
   string_col_cnt_ = 0;
   length_ = 0;
+  hash_index_buffer_.reset();
+  hash_index_offset_from_end_ = 0;
 }
 
 void ObMicroBlockEncoder::reuse()
@@ -268,6 +272,8 @@ void ObMicroBlockEncoder::reuse()
   col_ctxs_.reuse();
   string_col_cnt_ = 0;
   length_ = 0;
+  hash_index_buffer_.reuse();
+  hash_index_offset_from_end_ = 0;
 }
 
 void ObMicroBlockEncoder::dump_diagnose_info() const
@@ -377,6 +383,34 @@ void ObMicroBlockEncoder::update_estimate_size_limit(const ObMicroBlockEncodingC
   LOG_TRACE("estimate size expand percent", K(expand_pct_), K_(estimate_size_limit), K(ctx));
 }
 
+int ObMicroBlockEncoder::append_hash_index(ObMicroBlockHashIndexBuilder& hash_index_builder)
+{
+  int ret = OB_SUCCESS;
+  hash_index_buffer_.reuse();
+  hash_index_offset_from_end_ = 0;
+  if (hash_index_builder.is_valid()) {
+    if (is_contain_uncommitted_row()) {
+      ret = OB_NOT_SUPPORTED;
+    } else if (!hash_index_buffer_.is_inited()
+        && OB_FAIL(hash_index_buffer_.init(DEFAULT_DATA_BUFFER_SIZE, DEFAULT_HASH_INDEX_BUFFER_SIZE))) {
+      LOG_WARN("fail to init hash index buffer", K(ret));
+    } else if (OB_FAIL(hash_index_builder.build_block(hash_index_buffer_))) {
+      if (ret != OB_NOT_SUPPORTED) {
+        LOG_WARN("fail to build hash index", K(ret));
+      }
+      hash_index_buffer_.reuse();
+    } else {
+      hash_index_offset_from_end_ = static_cast<uint16_t>(hash_index_builder.get_offset_from_end());
+    }
+  }
+  return ret;
+}
+
+bool ObMicroBlockEncoder::has_enough_space_for_hash_index(const int64_t hash_index_size) const
+{
+  return estimate_size_ + header_size_ + hash_index_size <= block_size_upper_bound_;
+}
+
 int ObMicroBlockEncoder::try_to_append_row(const int64_t &store_size)
 {
   int ret = OB_SUCCESS;
@@ -649,7 +683,20 @@ int ObMicroBlockEncoder::build_block(char *&buf, int64_t &size)
       }
     }
 
-    // <5> fill header, encoding_meta and fix cols data
+    // <5> fill hash index
+    if (OB_SUCC(ret)) {
+      get_header(data_buffer_)->contains_hash_index_ = 0;
+      if (hash_index_buffer_.length() > 0) {
+        if (OB_FAIL(data_buffer_.write(hash_index_buffer_.data(), hash_index_buffer_.length()))) {
+          LOG_WARN("fail to write hash index", K(ret), K(hash_index_buffer_.length()), K(data_buffer_));
+        } else {
+          get_header(data_buffer_)->contains_hash_index_ = 1;
+          get_header(data_buffer_)->hash_index_offset_from_end_ = hash_index_offset_from_end_;
+        }
+      }
+    }
+
+    // <6> fill header, encoding_meta and fix cols data
     if (OB_SUCC(ret)) {
       get_header(data_buffer_)->row_count_ = static_cast<uint32_t>(datum_rows_.count());
       get_header(data_buffer_)->has_string_out_row_ = has_string_out_row_;
@@ -668,7 +715,7 @@ int ObMicroBlockEncoder::build_block(char *&buf, int64_t &size)
     if (OB_SUCC(ret)) {
       // update encoding context
       ctx_.estimate_block_size_ += estimate_size_;
-      ctx_.real_block_size_ += data_buffer_.length() - encoding_meta_offset;
+      ctx_.real_block_size_ += data_buffer_.length() - encoding_meta_offset - hash_index_buffer_.length();
       ctx_.micro_block_cnt_++;
       ObPreviousEncoding pe;
       for (int64_t idx = 0; OB_SUCC(ret) && idx < encoders_.count(); ++idx) {
@@ -51,6 +51,7 @@ public:
   // ObMicroBlockEncoder, please take a look at method:
   // int ObMacroBlockWriter::get_current_micro_block_buffer(const char *&buf, int64_t &size)
   static const int64_t DEFAULT_DATA_BUFFER_SIZE = common::OB_DEFAULT_MACRO_BLOCK_SIZE;
+  static const int64_t DEFAULT_HASH_INDEX_BUFFER_SIZE = 4 * 1024;
 
   struct CellCopyIndex
   {
@@ -77,6 +78,9 @@ public:
   virtual int64_t get_column_count() const override { return ctx_.column_cnt_;}
   virtual int64_t get_original_size() const override { return estimate_size_; }
   virtual void dump_diagnose_info() const override;
+  // build the hash index of appended rows, it's stored after the row index by build_block()
+  virtual int append_hash_index(ObMicroBlockHashIndexBuilder& hash_index_builder) override;
+  virtual bool has_enough_space_for_hash_index(const int64_t hash_index_size) const override;
 private:
   int inner_init();
   int reserve_header(const ObMicroBlockEncodingCtx &ctx);
@@ -175,6 +179,8 @@ private:
   int64_t estimate_base_store_size_;
   common::ObArray<ObColumnEncodingCtx> col_ctxs_;
   int64_t length_;
+  ObMicroBufferWriter hash_index_buffer_;
+  uint16_t hash_index_offset_from_end_;
   bool is_inited_;
 
   DISALLOW_COPY_AND_ASSIGN(ObMicroBlockEncoder);
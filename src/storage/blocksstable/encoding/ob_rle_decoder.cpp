@@ -476,20 +476,22 @@ int ObRLEDecoder::cmp_ref_and_set_res(
   int64_t next_row_id;
   int64_t ref;
   ObGetFilterCmpRetFunc get_cmp_ret = get_filter_cmp_ret_func(cmp_op);
-  for (int64_t i = 0; OB_SUCC(ret) && i < meta_header_->count_ ; ++i) {
+  const int64_t end_row_id = pd_filter_info.start_ + pd_filter_info.count_;
+  // Only runs overlapped with [start_, start_ + count_) are visited
+  int64_t i = row_ids.upper_bound_(meta_header_->payload_, 0, meta_header_->count_, pd_filter_info.start_);
+  for (i = MAX(i - 1, 0); OB_SUCC(ret) && i < meta_header_->count_; ++i) {
+    row_id = row_ids.at_(meta_header_->payload_, i);
+    if (row_id >= end_row_id) {
+      break;
+    }
     ref = refs.at_(meta_header_->payload_ + ref_offset_, i);
     if (get_cmp_ret(ref - dict_ref)
         && (ref < dict_decoder_.get_dict_header()->count_ || sql::WHITE_OP_EQ == cmp_op)) {
-      row_id = row_ids.at_(meta_header_->payload_, i);
       next_row_id = i != meta_header_->count_ - 1
                           ? row_ids.at_(meta_header_->payload_, i + 1)
                           : col_ctx.micro_block_header_->row_count_;
-      for (int64_t idx = row_id; OB_SUCC(ret) && idx < next_row_id; ++idx) {
-        if (idx >= pd_filter_info.start_ && idx < pd_filter_info.start_ + pd_filter_info.count_
-            && OB_FAIL(result_bitmap.set(idx - pd_filter_info.start_, flag))) {
-          LOG_WARN("Failed to set result_bitmap",
-              K(ret), K(row_id), K(pd_filter_info), K(next_row_id), K(idx));
-        }
+      if (OB_FAIL(set_run_res(row_id, next_row_id, flag, pd_filter_info, result_bitmap))) {
+        LOG_WARN("Failed to set result_bitmap", K(ret), K(row_id), K(pd_filter_info), K(next_row_id));
       }
     }
   }
@@ -510,25 +512,44 @@ int ObRLEDecoder::set_res_with_bitset(
   int64_t row_id;
   int64_t next_row_id;
   int64_t ref;
-  for (int64_t i = 0; OB_SUCC(ret) && i < meta_header_->count_ ; ++i) {
+  const int64_t end_row_id = pd_filter_info.start_ + pd_filter_info.count_;
+  int64_t i = row_ids.upper_bound_(meta_header_->payload_, 0, meta_header_->count_, pd_filter_info.start_);
+  for (i = MAX(i - 1, 0); OB_SUCC(ret) && i < meta_header_->count_; ++i) {
+    row_id = row_ids.at_(meta_header_->payload_, i);
+    if (row_id >= end_row_id) {
+      break;
+    }
     ref = refs.at_(meta_header_->payload_ + ref_offset_, i);
     if (ref_bitset->exist(ref)) {
-      row_id = row_ids.at_(meta_header_->payload_, i);
       next_row_id = i != meta_header_->count_ - 1
                           ? row_ids.at_(meta_header_->payload_, i + 1)
                           : col_ctx.micro_block_header_->row_count_;
-      for (int64_t idx = row_id; OB_SUCC(ret) && idx < next_row_id; ++idx) {
-        if (idx >= pd_filter_info.start_ && idx < pd_filter_info.start_ + pd_filter_info.count_
-            && OB_FAIL(result_bitmap.set(idx - pd_filter_info.start_))) {
-          LOG_WARN("Failed to set result_bitmap",
-              K(ret), K(row_id), K(pd_filter_info), K(next_row_id), K(idx));
-        }
+      if (OB_FAIL(set_run_res(row_id, next_row_id, true, pd_filter_info, result_bitmap))) {
+        LOG_WARN("Failed to set result_bitmap", K(ret), K(row_id), K(pd_filter_info), K(next_row_id));
       }
     }
   }
   return ret;
 }
 
+int ObRLEDecoder::set_run_res(
+    const int64_t row_id,
+    const int64_t next_row_id,
+    const bool flag,
+    const sql::PushdownFilterInfo &pd_filter_info,
+    ObBitmap &result_bitmap) const
+{
+  int ret = OB_SUCCESS;
+  // Fill the whole run clipped by filter range at once
+  const int64_t start = MAX(row_id, pd_filter_info.start_);
+  const int64_t end = MIN(next_row_id, pd_filter_info.start_ + pd_filter_info.count_);
+  if (start < end
+      && OB_FAIL(result_bitmap.set_bitmap_batch(start - pd_filter_info.start_, end - start, flag))) {
+    LOG_WARN("Failed to set result_bitmap in batch", K(ret), K(start), K(end), K(pd_filter_info));
+  }
+  return ret;
+}
+
 template<typename T>
 int ObRLEDecoder::extract_ref_and_null_count(
     const int32_t *row_ids,
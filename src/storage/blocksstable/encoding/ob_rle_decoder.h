@@ -136,6 +136,14 @@ private:
       const sql::PushdownFilterInfo &pd_filter_info,
       ObBitmap &result_bitmap) const;
 
+  // set rows of run [row_id, next_row_id) in filter range to %flag
+  int set_run_res(
+      const int64_t row_id,
+      const int64_t next_row_id,
+      const bool flag,
+      const sql::PushdownFilterInfo &pd_filter_info,
+      ObBitmap &result_bitmap) const;
+
   template <typename T>
   int extract_ref_and_null_count(
       const int32_t *row_ids,
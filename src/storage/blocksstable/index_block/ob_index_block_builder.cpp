@@ -557,6 +557,8 @@ int ObSSTableIndexBuilder::init(const ObDataStoreDesc &data_desc,
     index_store_desc_.get_desc().need_pre_warm_ = true;
     index_store_desc_.get_desc().need_build_hash_index_for_micro_block_ = false;
     container_store_desc_.need_build_hash_index_for_micro_block_ = false;
+    index_store_desc_.get_desc().need_build_bloom_filter_ = false;
+    container_store_desc_.need_build_bloom_filter_ = false;
     if (OB_FAIL(leaf_store_desc_.shallow_copy(index_store_desc_.get_desc()))) {
       STORAGE_LOG(WARN, "fail to assign leaf store desc", K(ret));
     } else if (OB_UNLIKELY(!index_store_desc_.get_desc().is_for_index() ||
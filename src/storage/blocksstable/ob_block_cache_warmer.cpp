@@ -0,0 +1,689 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "storage/blocksstable/ob_block_cache_warmer.h"
+#include "lib/checksum/ob_crc64.h"
+#include "lib/file/file_directory_utils.h"
+#include "lib/file/ob_file.h"
+#include "share/cache/ob_kv_storecache.h"
+#include "share/config/ob_server_config.h"
+#include "share/ob_server_struct.h"
+#include "share/rc/ob_tenant_base.h"
+#include "storage/blocksstable/ob_block_manager.h"
+#include "storage/blocksstable/ob_macro_block_common_header.h"
+#include "storage/blocksstable/ob_macro_block_reader.h"
+#include "storage/blocksstable/ob_micro_block_header.h"
+#include "storage/blocksstable/ob_object_manager.h"
+#include "storage/blocksstable/ob_sstable_macro_block_header.h"
+#include "storage/blocksstable/ob_storage_cache_suite.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace share;
+namespace blocksstable
+{
+
+ObBlockCacheWarmKey::ObBlockCacheWarmKey()
+  : tenant_id_(OB_INVALID_TENANT_ID),
+    macro_id_(),
+    offset_(0),
+    size_(0),
+    get_cnt_(0),
+    is_index_block_(false)
+{
+}
+
+bool ObBlockCacheWarmKey::is_valid() const
+{
+  return is_valid_tenant_id(tenant_id_) && macro_id_.is_valid() && offset_ > 0 && size_ > 0;
+}
+
+OB_SERIALIZE_MEMBER(ObBlockCacheWarmKey, tenant_id_, macro_id_, offset_, size_, get_cnt_, is_index_block_);
+
+OB_SERIALIZE_MEMBER(ObBlockCacheWarmer::SnapshotHeader, magic_, key_cnt_, dump_ts_, body_size_, checksum_);
+
+ObBlockCacheWarmStat::ObBlockCacheWarmStat()
+  : tenant_id_(OB_INVALID_TENANT_ID),
+    status_(WAITING),
+    snapshot_ts_(0),
+    total_cnt_(0),
+    loaded_cnt_(0),
+    skipped_cnt_(0),
+    failed_cnt_(0),
+    loaded_bytes_(0),
+    start_ts_(0),
+    finish_ts_(0)
+{
+}
+
+const char *ObBlockCacheWarmStat::get_status_str(const Status status)
+{
+  static const char *STATUS_STR[] = {"WAITING", "LOADING", "FINISHED", "STOPPED"};
+  STATIC_ASSERT(MAX_STATUS == ARRAYSIZEOF(STATUS_STR), "status str len is mismatch");
+  const char *str = "UNKNOWN";
+  if (status >= WAITING && status < MAX_STATUS) {
+    str = STATUS_STR[status];
+  }
+  return str;
+}
+
+const char *ObBlockCacheWarmer::SNAPSHOT_FILE_NAME = "block_cache_warm.snapshot";
+
+// sort by tenant and block position, so that the blocks of a macro block
+// are reloaded together and read in order
+bool ObBlockCacheWarmer::warm_key_cmp(const ObBlockCacheWarmKey &l, const ObBlockCacheWarmKey &r)
+{
+  bool bret = false;
+  if (l.tenant_id_ != r.tenant_id_) {
+    bret = l.tenant_id_ < r.tenant_id_;
+  } else if (l.macro_id_.first_id() != r.macro_id_.first_id()) {
+    bret = l.macro_id_.first_id() < r.macro_id_.first_id();
+  } else if (l.macro_id_.second_id() != r.macro_id_.second_id()) {
+    bret = l.macro_id_.second_id() < r.macro_id_.second_id();
+  } else if (l.macro_id_.third_id() != r.macro_id_.third_id()) {
+    bret = l.macro_id_.third_id() < r.macro_id_.third_id();
+  } else if (l.macro_id_.fourth_id() != r.macro_id_.fourth_id()) {
+    bret = l.macro_id_.fourth_id() < r.macro_id_.fourth_id();
+  } else {
+    bret = l.offset_ < r.offset_;
+  }
+  return bret;
+}
+
+bool ObBlockCacheWarmer::hot_key_cmp(const ObBlockCacheWarmKey &l, const ObBlockCacheWarmKey &r)
+{
+  return l.get_cnt_ > r.get_cnt_;
+}
+
+ObBlockCacheWarmer &ObBlockCacheWarmer::get_instance()
+{
+  static ObBlockCacheWarmer instance_;
+  return instance_;
+}
+
+ObBlockCacheWarmer::ObBlockCacheWarmer()
+  : is_inited_(false),
+    last_dump_ts_(0),
+    warm_start_ts_(0),
+    warm_bytes_(0),
+    lock_(),
+    stats_()
+{
+  MEMSET(snapshot_path_, 0, sizeof(snapshot_path_));
+}
+
+ObBlockCacheWarmer::~ObBlockCacheWarmer()
+{
+  destroy();
+}
+
+int ObBlockCacheWarmer::init(const char *data_dir)
+{
+  int ret = OB_SUCCESS;
+  int pret = 0;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret));
+  } else if (OB_ISNULL(data_dir) || OB_UNLIKELY(0 == STRLEN(data_dir))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(data_dir));
+  } else if (OB_UNLIKELY((pret = snprintf(snapshot_path_, sizeof(snapshot_path_), "%s/%s",
+                                          data_dir, SNAPSHOT_FILE_NAME)) <= 0
+                         || pret >= sizeof(snapshot_path_))) {
+    ret = OB_BUF_NOT_ENOUGH;
+    LOG_WARN("snapshot path is too long", K(ret), K(data_dir));
+  } else {
+    last_dump_ts_ = ObTimeUtility::current_time();
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+int ObBlockCacheWarmer::start()
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_FAIL(share::ObThreadPool::start())) {
+    LOG_WARN("fail to start block cache warmer thread", K(ret));
+  } else {
+    LOG_INFO("block cache warmer started", KPC(this));
+  }
+  return ret;
+}
+
+void ObBlockCacheWarmer::stop()
+{
+  share::ObThreadPool::stop();
+}
+
+void ObBlockCacheWarmer::wait()
+{
+  share::ObThreadPool::wait();
+}
+
+void ObBlockCacheWarmer::destroy()
+{
+  if (is_inited_) {
+    stop();
+    wait();
+    share::ObThreadPool::destroy();
+    ObSpinLockGuard guard(lock_);
+    stats_.reset();
+    is_inited_ = false;
+  }
+}
+
+bool ObBlockCacheWarmer::is_enabled() const
+{
+  return GCONF._enable_block_cache_warm_restart && !GCTX.is_shared_storage_mode();
+}
+
+void ObBlockCacheWarmer::run1()
+{
+  int ret = OB_SUCCESS;
+  lib::set_thread_name("BlkCacheWarm");
+  bool warmed = false;
+  while (!has_set_stop()) {
+    if (!is_enabled()) {
+      // the snapshot may be stale when the feature is turned on again
+      warmed = true;
+    } else if (!warmed) {
+      // reload after the tenants are ready, so the blocks still in use
+      // can be told from the freed ones
+      if (SS_SERVING == GCTX.status_) {
+        ObArray<ObBlockCacheWarmKey> keys;
+        int64_t snapshot_ts = 0;
+        keys.set_attr(ObMemAttr(OB_SERVER_TENANT_ID, "BlkCacheWarm"));
+        if (OB_FAIL(read_snapshot(keys, snapshot_ts))) {
+          LOG_WARN("fail to read block cache snapshot", K(ret), K_(snapshot_path));
+        } else if (OB_FAIL(warm_up(keys, snapshot_ts))) {
+          LOG_WARN("fail to warm up block cache", K(ret));
+        }
+        warmed = true;
+        last_dump_ts_ = ObTimeUtility::current_time();
+      }
+    } else if (ObTimeUtility::current_time() - last_dump_ts_
+               >= GCONF._block_cache_warm_snapshot_interval) {
+      if (OB_FAIL(dump_snapshot())) {
+        LOG_WARN("fail to dump block cache snapshot", K(ret), K_(snapshot_path));
+      }
+      last_dump_ts_ = ObTimeUtility::current_time();
+    }
+    ob_usleep(CHECK_INTERVAL_US);
+  }
+}
+
+int ObBlockCacheWarmer::collect_hot_keys(const int64_t max_key_cnt, ObIArray<ObBlockCacheWarmKey> &keys)
+{
+  int ret = OB_SUCCESS;
+  const int64_t index_cache_id = OB_STORE_CACHE.get_index_block_cache().get_cache_id();
+  ObSEArray<ObMicroBlockCacheKey, 128> cache_keys;
+  ObSEArray<ObKVCacheKeyStat, 128> key_stats;
+  cache_keys.set_attr(ObMemAttr(OB_SERVER_TENANT_ID, "BlkCacheWarm"));
+  key_stats.set_attr(ObMemAttr(OB_SERVER_TENANT_ID, "BlkCacheWarm"));
+  int64_t start_pos = 0;
+  do {
+    cache_keys.reuse();
+    key_stats.reuse();
+    if (OB_FAIL(ObKVGlobalCache::get_instance().get_batch_block_cache_key_stat(
+                start_pos, cache_keys, key_stats))) {
+      LOG_WARN("fail to get block cache keys", K(ret), K(start_pos));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < cache_keys.count(); i++) {
+      const ObMicroBlockCacheKey &cache_key = cache_keys.at(i);
+      // logical keys are only used in shared storage
+      if (cache_key.is_valid() && !cache_key.is_logic_key()
+          && cache_key.get_micro_block_id().macro_id_.is_id_mode_local()) {
+        ObBlockCacheWarmKey key;
+        key.tenant_id_ = cache_key.get_tenant_id();
+        key.macro_id_ = cache_key.get_micro_block_id().macro_id_;
+        key.offset_ = cache_key.get_micro_block_id().offset_;
+        key.size_ = cache_key.get_micro_block_id().size_;
+        key.get_cnt_ = key_stats.at(i).get_cnt_;
+        key.is_index_block_ = index_cache_id == key_stats.at(i).cache_id_;
+        if (OB_FAIL(keys.push_back(key))) {
+          LOG_WARN("fail to push back key", K(ret), K(key));
+        }
+      }
+    }
+    // keep at most 2 * max_key_cnt keys in memory
+    if (OB_SUCC(ret) && keys.count() >= 2 * max_key_cnt) {
+      ObBlockCacheWarmKey *first = &keys.at(0);
+      lib::ob_sort(first, first + keys.count(), hot_key_cmp);
+      while (keys.count() > max_key_cnt) {
+        keys.pop_back();
+      }
+    }
+  } while (OB_SUCC(ret) && 0 != start_pos && !has_set_stop());
+
+  if (OB_SUCC(ret) && keys.count() > max_key_cnt) {
+    ObBlockCacheWarmKey *first = &keys.at(0);
+    lib::ob_sort(first, first + keys.count(), hot_key_cmp);
+    while (keys.count() > max_key_cnt) {
+      keys.pop_back();
+    }
+  }
+  return ret;
+}
+
+int ObBlockCacheWarmer::dump_snapshot()
+{
+  int ret = OB_SUCCESS;
+  ObArray<ObBlockCacheWarmKey> keys;
+  keys.set_attr(ObMemAttr(OB_SERVER_TENANT_ID, "BlkCacheWarm"));
+  const int64_t start_ts = ObTimeUtility::current_time();
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_FAIL(collect_hot_keys(GCONF._block_cache_warm_snapshot_key_count, keys))) {
+    LOG_WARN("fail to collect hot keys", K(ret));
+  } else if (OB_FAIL(write_snapshot(keys))) {
+    LOG_WARN("fail to write snapshot", K(ret), K_(snapshot_path));
+  } else {
+    LOG_INFO("dump block cache snapshot", K_(snapshot_path), "key_cnt", keys.count(),
+             "cost_us", ObTimeUtility::current_time() - start_ts);
+  }
+  return ret;
+}
+
+int ObBlockCacheWarmer::write_snapshot(const ObIArray<ObBlockCacheWarmKey> &keys)
+{
+  int ret = OB_SUCCESS;
+  SnapshotHeader header;
+  char tmp_path[MAX_PATH_SIZE] = {};
+  char *buf = nullptr;
+  int64_t body_size = 0;
+  for (int64_t i = 0; i < keys.count(); i++) {
+    body_size += keys.at(i).get_serialize_size();
+  }
+  header.key_cnt_ = keys.count();
+  header.dump_ts_ = ObTimeUtility::current_time();
+  header.body_size_ = body_size;
+  const int64_t header_size = header.get_serialize_size();
+  const int64_t buf_size = header_size + body_size;
+  int64_t pos = header_size;
+  int fd = -1;
+  if (OB_UNLIKELY(buf_size > MAX_SNAPSHOT_FILE_SIZE)) {
+    ret = OB_SIZE_OVERFLOW;
+    LOG_WARN("snapshot is too large", K(ret), K(buf_size));
+  } else if (OB_ISNULL(buf = static_cast<char *>(ob_malloc(buf_size,
+                           ObMemAttr(OB_SERVER_TENANT_ID, "BlkCacheWarm"))))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc snapshot buf", K(ret), K(buf_size));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < keys.count(); i++) {
+    if (OB_FAIL(keys.at(i).serialize(buf, buf_size, pos))) {
+      LOG_WARN("fail to serialize key", K(ret), K(i), K(buf_size), K(pos));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    header.checksum_ = static_cast<int64_t>(ob_crc64(buf + header_size, body_size));
+    pos = 0;
+    if (OB_FAIL(header.serialize(buf, header_size, pos))) {
+      LOG_WARN("fail to serialize snapshot header", K(ret), K(header));
+    } else if (OB_UNLIKELY(snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", snapshot_path_)
+                           >= sizeof(tmp_path))) {
+      ret = OB_BUF_NOT_ENOUGH;
+      LOG_WARN("snapshot path is too long", K(ret), K_(snapshot_path));
+    } else if ((fd = ::open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP)) < 0) {
+      ret = OB_IO_ERROR;
+      LOG_WARN("fail to create snapshot file", K(ret), K(tmp_path), KERRMSG);
+    } else {
+      if (buf_size != unintr_write(fd, buf, buf_size)) {
+        ret = OB_IO_ERROR;
+        LOG_WARN("fail to write snapshot file", K(ret), K(tmp_path), K(buf_size), KERRMSG);
+      } else if (0 != ::fsync(fd)) {
+        ret = OB_IO_ERROR;
+        LOG_WARN("fail to sync snapshot file", K(ret), K(tmp_path), KERRMSG);
+      }
+      if (0 != ::close(fd)) {
+        ret = OB_SUCC(ret) ? OB_IO_ERROR : ret;
+        LOG_WARN("fail to close snapshot file", K(ret), K(tmp_path), KERRMSG);
+      }
+      // the old snapshot is replaced atomically
+      if (OB_SUCC(ret) && 0 != ::rename(tmp_path, snapshot_path_)) {
+        ret = OB_ERR_SYS;
+        LOG_WARN("fail to rename snapshot file", K(ret), K(tmp_path), K_(snapshot_path), KERRMSG);
+      }
+    }
+  }
+  if (OB_NOT_NULL(buf)) {
+    ob_free(buf);
+  }
+  return ret;
+}
+
+int ObBlockCacheWarmer::read_snapshot(ObIArray<ObBlockCacheWarmKey> &keys, int64_t &snapshot_ts)
+{
+  int ret = OB_SUCCESS;
+  bool is_exist = false;
+  int64_t file_size = 0;
+  char *buf = nullptr;
+  int fd = -1;
+  snapshot_ts = 0;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_FAIL(FileDirectoryUtils::is_exists(snapshot_path_, is_exist))) {
+    LOG_WARN("fail to check snapshot file", K(ret), K_(snapshot_path));
+  } else if (!is_exist) {
+    LOG_INFO("block cache snapshot not exist", K_(snapshot_path));
+  } else if (OB_FAIL(FileDirectoryUtils::get_file_size(snapshot_path_, file_size))) {
+    LOG_WARN("fail to get snapshot file size", K(ret), K_(snapshot_path));
+  } else if (OB_UNLIKELY(file_size <= 0 || file_size > MAX_SNAPSHOT_FILE_SIZE)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid snapshot file size", K(ret), K(file_size));
+  } else if (OB_ISNULL(buf = static_cast<char *>(ob_malloc(file_size,
+                           ObMemAttr(OB_SERVER_TENANT_ID, "BlkCacheWarm"))))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc snapshot buf", K(ret), K(file_size));
+  } else if ((fd = ::open(snapshot_path_, O_RDONLY)) < 0) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to open snapshot file", K(ret), K_(snapshot_path), KERRMSG);
+  } else {
+    SnapshotHeader header;
+    int64_t pos = 0;
+    if (file_size != unintr_pread(fd, buf, file_size, 0)) {
+      ret = OB_IO_ERROR;
+      LOG_WARN("fail to read snapshot file", K(ret), K_(snapshot_path), K(file_size), KERRMSG);
+    } else if (OB_FAIL(header.deserialize(buf, file_size, pos))) {
+      LOG_WARN("fail to deserialize snapshot header", K(ret), K(file_size));
+    } else if (OB_UNLIKELY(!header.is_valid() || pos + header.body_size_ != file_size)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid snapshot header", K(ret), K(header), K(pos), K(file_size));
+    } else if (OB_UNLIKELY(header.checksum_ != static_cast<int64_t>(ob_crc64(buf + pos, header.body_size_)))) {
+      ret = OB_CHECKSUM_ERROR;
+      LOG_WARN("snapshot checksum mismatch", K(ret), K(header));
+    } else if (OB_FAIL(keys.reserve(header.key_cnt_))) {
+      LOG_WARN("fail to reserve keys", K(ret), K(header));
+    } else {
+      for (int64_t i = 0; OB_SUCC(ret) && i < header.key_cnt_; i++) {
+        ObBlockCacheWarmKey key;
+        if (OB_FAIL(key.deserialize(buf, file_size, pos))) {
+          LOG_WARN("fail to deserialize key", K(ret), K(i), K(pos), K(file_size));
+        } else if (OB_UNLIKELY(!key.is_valid())) {
+          ret = OB_INVALID_DATA;
+          LOG_WARN("invalid key in snapshot", K(ret), K(key));
+        } else if (OB_FAIL(keys.push_back(key))) {
+          LOG_WARN("fail to push back key", K(ret), K(key));
+        }
+      }
+      if (OB_SUCC(ret)) {
+        snapshot_ts = header.dump_ts_;
+        LOG_INFO("read block cache snapshot", K_(snapshot_path), K(header));
+      }
+    }
+    if (0 != ::close(fd)) {
+      LOG_WARN("fail to close snapshot file", K_(snapshot_path), KERRMSG);
+    }
+  }
+  if (OB_NOT_NULL(buf)) {
+    ob_free(buf);
+  }
+  if (OB_FAIL(ret)) {
+    keys.reset();
+  }
+  return ret;
+}
+
+int ObBlockCacheWarmer::warm_up(ObIArray<ObBlockCacheWarmKey> &keys, const int64_t snapshot_ts)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (keys.count() > 0) {
+    ObBlockCacheWarmKey *first = &keys.at(0);
+    lib::ob_sort(first, first + keys.count(), warm_key_cmp);
+    // one stat for each tenant
+    {
+      ObSpinLockGuard guard(lock_);
+      stats_.reset();
+      for (int64_t i = 0; OB_SUCC(ret) && i < keys.count(); i++) {
+        if (0 == i || keys.at(i).tenant_id_ != keys.at(i - 1).tenant_id_) {
+          ObBlockCacheWarmStat stat;
+          stat.tenant_id_ = keys.at(i).tenant_id_;
+          stat.snapshot_ts_ = snapshot_ts;
+          if (OB_FAIL(stats_.push_back(stat))) {
+            LOG_WARN("fail to push back stat", K(ret), K(stat));
+          }
+        }
+        if (OB_SUCC(ret)) {
+          stats_.at(stats_.count() - 1).total_cnt_++;
+        }
+      }
+    }
+    warm_start_ts_ = ObTimeUtility::current_time();
+    warm_bytes_ = 0;
+    int64_t start = 0;
+    for (int64_t stat_idx = 0; OB_SUCC(ret) && stat_idx < stats_.count(); stat_idx++) {
+      const int64_t end = start + stats_.at(stat_idx).total_cnt_;
+      int tmp_ret = OB_SUCCESS;
+      if (need_stop()) {
+        set_stat_status(stat_idx, ObBlockCacheWarmStat::STOPPED);
+      } else if (OB_TMP_FAIL(warm_tenant(keys, start, end, stat_idx))) {
+        LOG_WARN("fail to warm up tenant block cache", K(tmp_ret), "stat", stats_.at(stat_idx));
+      }
+      start = end;
+    }
+    LOG_INFO("finish warming up block cache", K(ret), "key_cnt", keys.count(),
+             "cost_us", ObTimeUtility::current_time() - warm_start_ts_, K_(warm_bytes));
+  }
+  return ret;
+}
+
+int ObBlockCacheWarmer::warm_tenant(
+    const ObIArray<ObBlockCacheWarmKey> &keys,
+    const int64_t start,
+    const int64_t end,
+    const int64_t stat_idx)
+{
+  int ret = OB_SUCCESS;
+  const uint64_t tenant_id = keys.at(start).tenant_id_;
+  set_stat_status(stat_idx, ObBlockCacheWarmStat::LOADING);
+  MTL_SWITCH(tenant_id) {
+    ObArenaAllocator allocator(ObMemAttr(tenant_id, "BlkCacheWarm"));
+    ObMacroBlockReader reader(tenant_id);
+    int64_t macro_start = start;
+    for (int64_t i = start + 1; OB_SUCC(ret) && i <= end && !need_stop(); i++) {
+      if (i == end || !(keys.at(i).macro_id_ == keys.at(macro_start).macro_id_)) {
+        int tmp_ret = OB_SUCCESS;
+        if (OB_TMP_FAIL(warm_macro_block(keys, macro_start, i, stat_idx, reader, allocator))) {
+          LOG_WARN("fail to warm up macro block", K(tmp_ret), "key", keys.at(macro_start));
+          update_stat(stat_idx, 0, 0, i - macro_start, 0);
+        }
+        allocator.reuse();
+        macro_start = i;
+      }
+    }
+  }
+  if (OB_FAIL(ret)) {
+    LOG_WARN("fail to switch tenant", K(ret), K(tenant_id));
+    update_stat(stat_idx, 0, end - start, 0, 0);
+  }
+  set_stat_status(stat_idx, need_stop() ? ObBlockCacheWarmStat::STOPPED : ObBlockCacheWarmStat::FINISHED);
+  return ret;
+}
+
+int ObBlockCacheWarmer::warm_macro_block(
+    const ObIArray<ObBlockCacheWarmKey> &keys,
+    const int64_t start,
+    const int64_t end,
+    const int64_t stat_idx,
+    ObMacroBlockReader &reader,
+    ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  const MacroBlockId &macro_id = keys.at(start).macro_id_;
+  bool is_free = false;
+  const char *header_buf = nullptr;
+  const int64_t header_size = MIN(MACRO_HEADER_READ_SIZE, OB_STORAGE_OBJECT_MGR.get_macro_block_size());
+  ObMacroBlockCommonHeader common_header;
+  ObSSTableMacroBlockHeader macro_header;
+  int64_t pos = 0;
+  if (OB_FAIL(OB_SERVER_BLOCK_MGR.check_macro_block_free(macro_id, is_free))) {
+    LOG_WARN("fail to check macro block free", K(ret), K(macro_id));
+  } else if (is_free) {
+    // the macro block is released by compaction before restart
+    update_stat(stat_idx, 0, end - start, 0, 0);
+  } else if (OB_FAIL(read_block(macro_id, 0, header_size, allocator, header_buf))) {
+    LOG_WARN("fail to read macro header", K(ret), K(macro_id));
+  } else if (OB_FAIL(common_header.deserialize(header_buf, header_size, pos))) {
+    LOG_WARN("fail to deserialize common header", K(ret), K(macro_id));
+  } else if (OB_FAIL(macro_header.deserialize(header_buf, header_size, pos))) {
+    LOG_WARN("fail to deserialize macro header", K(ret), K(macro_id), K(common_header));
+  } else if (OB_UNLIKELY(!macro_header.is_valid())) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid macro header", K(ret), K(macro_id), K(macro_header));
+  } else {
+    ObMicroBlockDesMeta des_meta(macro_header.fixed_header_.compressor_type_,
+                                 static_cast<ObRowStoreType>(macro_header.fixed_header_.row_store_type_),
+                                 macro_header.fixed_header_.encrypt_id_,
+                                 macro_header.fixed_header_.master_key_id_,
+                                 macro_header.fixed_header_.encrypt_key_);
+    for (int64_t i = start; i < end && !need_stop(); i++) {
+      const ObBlockCacheWarmKey &key = keys.at(i);
+      const char *block_buf = nullptr;
+      ObMicroBlockHeader micro_header;
+      ObMicroBlockCacheKey cache_key;
+      const ObMicroBlockCacheValue *micro_block = nullptr;
+      ObKVCacheHandle cache_handle;
+      ObDataMicroBlockCache &cache = OB_STORE_CACHE.get_micro_block_cache(!key.is_index_block_);
+      int tmp_ret = OB_SUCCESS;
+      pos = 0;
+      cache_key.set(key.tenant_id_, key.macro_id_, key.offset_, key.size_);
+      if (OB_TMP_FAIL(read_block(key.macro_id_, key.offset_, key.size_, allocator, block_buf))) {
+        LOG_WARN("fail to read micro block", K(tmp_ret), K(key));
+      } else if (OB_TMP_FAIL(micro_header.deserialize(block_buf, key.size_, pos))) {
+        LOG_WARN("fail to deserialize micro header", K(tmp_ret), K(key));
+      } else if (FALSE_IT(des_meta.row_store_type_ = static_cast<ObRowStoreType>(micro_header.row_store_type_))) {
+      } else if (OB_TMP_FAIL(cache.put_cache_block(des_meta, block_buf, key.size_, cache_key, reader,
+                                                  allocator, micro_block, cache_handle))) {
+        LOG_WARN("fail to put block into cache", K(tmp_ret), K(key));
+      }
+      if (OB_SUCCESS == tmp_ret) {
+        update_stat(stat_idx, 1, 0, 0, key.size_);
+      } else {
+        update_stat(stat_idx, 0, 0, 1, 0);
+      }
+      if (OB_NOT_NULL(block_buf)) {
+        allocator.free(const_cast<char *>(block_buf));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObBlockCacheWarmer::read_block(
+    const MacroBlockId &macro_id,
+    const int64_t offset,
+    const int64_t size,
+    ObIAllocator &allocator,
+    const char *&buf)
+{
+  int ret = OB_SUCCESS;
+  ObStorageObjectHandle read_handle;
+  ObStorageObjectReadInfo read_info;
+  read_info.macro_block_id_ = macro_id;
+  read_info.offset_ = offset;
+  read_info.size_ = size;
+  read_info.io_desc_.set_mode(ObIOMode::READ);
+  read_info.io_desc_.set_wait_event(ObWaitEventIds::DB_FILE_DATA_READ);
+  read_info.io_desc_.set_resource_group_id(THIS_WORKER.get_group_id());
+  read_info.io_desc_.set_sys_module_id(ObIOModule::MICRO_BLOCK_CACHE_IO);
+  read_info.io_timeout_ms_ = std::max(GCONF._data_storage_io_timeout / 1000, DEFAULT_IO_WAIT_TIME_MS);
+  read_info.mtl_tenant_id_ = MTL_ID();
+  buf = nullptr;
+  throttle(size);
+  if (OB_ISNULL(read_info.buf_ = static_cast<char *>(allocator.alloc(size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc read buf", K(ret), K(size));
+  } else if (OB_FAIL(ObObjectManager::async_read_object(read_info, read_handle))) {
+    LOG_WARN("fail to async read block", K(ret), K(read_info));
+  } else if (OB_FAIL(read_handle.wait())) {
+    LOG_WARN("fail to wait io finish", K(ret), K(read_info));
+  } else {
+    buf = read_info.buf_;
+  }
+  if (OB_FAIL(ret) && OB_NOT_NULL(read_info.buf_)) {
+    allocator.free(read_info.buf_);
+  }
+  return ret;
+}
+
+// sleep until the bytes read since the warm up started are within the bandwidth
+void ObBlockCacheWarmer::throttle(const int64_t read_bytes)
+{
+  const int64_t bandwidth = GCONF._block_cache_warm_up_bandwidth;
+  warm_bytes_ += read_bytes;
+  int64_t wait_us = calc_throttle_wait_us(bandwidth, ObTimeUtility::current_time());
+  while (wait_us > 0 && !need_stop()) {
+    ob_usleep(static_cast<uint32_t>(MIN(wait_us, CHECK_INTERVAL_US)));
+    wait_us = calc_throttle_wait_us(bandwidth, ObTimeUtility::current_time());
+  }
+}
+
+int64_t ObBlockCacheWarmer::calc_throttle_wait_us(const int64_t bandwidth, const int64_t now) const
+{
+  const int64_t expect_us = static_cast<int64_t>(
+      static_cast<double>(warm_bytes_) * 1000000 / static_cast<double>(MAX(1, bandwidth)));
+  return MAX(0, warm_start_ts_ + expect_us - now);
+}
+
+void ObBlockCacheWarmer::update_stat(
+    const int64_t stat_idx,
+    const int64_t loaded_cnt,
+    const int64_t skipped_cnt,
+    const int64_t failed_cnt,
+    const int64_t loaded_bytes)
+{
+  ObSpinLockGuard guard(lock_);
+  if (stat_idx >= 0 && stat_idx < stats_.count()) {
+    ObBlockCacheWarmStat &stat = stats_.at(stat_idx);
+    stat.loaded_cnt_ += loaded_cnt;
+    stat.skipped_cnt_ += skipped_cnt;
+    stat.failed_cnt_ += failed_cnt;
+    stat.loaded_bytes_ += loaded_bytes;
+  }
+}
+
+void ObBlockCacheWarmer::set_stat_status(const int64_t stat_idx, const ObBlockCacheWarmStat::Status status)
+{
+  ObSpinLockGuard guard(lock_);
+  if (stat_idx >= 0 && stat_idx < stats_.count()) {
+    ObBlockCacheWarmStat &stat = stats_.at(stat_idx);
+    stat.status_ = status;
+    if (ObBlockCacheWarmStat::LOADING == status) {
+      stat.start_ts_ = ObTimeUtility::current_time();
+    } else if (ObBlockCacheWarmStat::WAITING != status) {
+      stat.finish_ts_ = ObTimeUtility::current_time();
+    }
+  }
+}
+
+int ObBlockCacheWarmer::get_warm_stats(ObIArray<ObBlockCacheWarmStat> &stats)
+{
+  int ret = OB_SUCCESS;
+  ObSpinLockGuard guard(lock_);
+  if (OB_FAIL(stats.assign(stats_))) {
+    LOG_WARN("fail to assign stats", K(ret));
+  }
+  return ret;
+}
+
+} // namespace blocksstable
+} // namespace oceanbase
@@ -0,0 +1,173 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_BLOCKSSTABLE_OB_BLOCK_CACHE_WARMER_H_
+#define OCEANBASE_BLOCKSSTABLE_OB_BLOCK_CACHE_WARMER_H_
+
+#include "lib/container/ob_se_array.h"
+#include "lib/lock/ob_spin_lock.h"
+#include "share/ob_thread_pool.h"
+#include "storage/blocksstable/ob_macro_block_id.h"
+
+#define OB_BLOCK_CACHE_WARMER (oceanbase::blocksstable::ObBlockCacheWarmer::get_instance())
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+class ObMacroBlockReader;
+
+// A persisted hot key of the user block cache or index block cache
+struct ObBlockCacheWarmKey
+{
+  OB_UNIS_VERSION(1);
+public:
+  ObBlockCacheWarmKey();
+  ~ObBlockCacheWarmKey() = default;
+  bool is_valid() const;
+  TO_STRING_KV(K_(tenant_id), K_(macro_id), K_(offset), K_(size), K_(get_cnt), K_(is_index_block));
+public:
+  uint64_t tenant_id_;
+  MacroBlockId macro_id_;
+  int64_t offset_;
+  int64_t size_;
+  int64_t get_cnt_;
+  bool is_index_block_;
+};
+
+struct ObBlockCacheWarmStat
+{
+public:
+  enum Status
+  {
+    WAITING = 0,
+    LOADING,
+    FINISHED,
+    STOPPED,
+    MAX_STATUS
+  };
+  ObBlockCacheWarmStat();
+  ~ObBlockCacheWarmStat() = default;
+  static const char *get_status_str(const Status status);
+  TO_STRING_KV(K_(tenant_id), K_(status), K_(snapshot_ts), K_(total_cnt), K_(loaded_cnt),
+               K_(skipped_cnt), K_(failed_cnt), K_(loaded_bytes), K_(start_ts), K_(finish_ts));
+public:
+  uint64_t tenant_id_;
+  Status status_;
+  int64_t snapshot_ts_;
+  int64_t total_cnt_;
+  int64_t loaded_cnt_;
+  // block is already freed
+  int64_t skipped_cnt_;
+  int64_t failed_cnt_;
+  int64_t loaded_bytes_;
+  int64_t start_ts_;
+  int64_t finish_ts_;
+};
+
+// Warm restart of the block caches.
+//
+// The background thread persists the hottest keys (ranked by the get count of
+// kvcache nodes) of the user block cache and index block cache to a local
+// snapshot file periodically. After the observer restarts and starts serving,
+// it reloads the blocks of the snapshot through the io manager with limited
+// bandwidth, so the point get latency recovers without waiting for the caches
+// to be warmed up by queries. Only blocks on local disk are supported.
+class ObBlockCacheWarmer : public share::ObThreadPool
+{
+public:
+  static const char *SNAPSHOT_FILE_NAME;
+  static ObBlockCacheWarmer &get_instance();
+  int init(const char *data_dir);
+  int start();
+  void stop();
+  void wait();
+  void destroy();
+  virtual void run1() override;
+
+  // Collect hot keys and write them to the snapshot file.
+  int dump_snapshot();
+  int read_snapshot(common::ObIArray<ObBlockCacheWarmKey> &keys, int64_t &snapshot_ts);
+  // Reload the blocks of the keys into the block caches.
+  int warm_up(common::ObIArray<ObBlockCacheWarmKey> &keys, const int64_t snapshot_ts);
+  int get_warm_stats(common::ObIArray<ObBlockCacheWarmStat> &stats);
+  int64_t get_last_dump_ts() const { return last_dump_ts_; }
+  TO_STRING_KV(K_(is_inited), K_(snapshot_path), K_(last_dump_ts), K_(warm_start_ts), K_(warm_bytes));
+private:
+  struct SnapshotHeader
+  {
+    OB_UNIS_VERSION(1);
+  public:
+    SnapshotHeader() : magic_(SNAPSHOT_MAGIC), key_cnt_(0), dump_ts_(0), body_size_(0), checksum_(0) {}
+    bool is_valid() const { return SNAPSHOT_MAGIC == magic_ && key_cnt_ >= 0 && body_size_ >= 0; }
+    TO_STRING_KV(K_(magic), K_(key_cnt), K_(dump_ts), K_(body_size), K_(checksum));
+    int64_t magic_;
+    int64_t key_cnt_;
+    int64_t dump_ts_;
+    int64_t body_size_;
+    int64_t checksum_;
+  };
+  static const int64_t SNAPSHOT_MAGIC = 0x424C4B5741524D31; // "BLKWARM1"
+  static const int64_t MAX_SNAPSHOT_FILE_SIZE = 1L << 30;
+  static const int64_t MACRO_HEADER_READ_SIZE = 16L << 10;
+  static const int64_t CHECK_INTERVAL_US = 1000L * 1000L;
+
+  ObBlockCacheWarmer();
+  virtual ~ObBlockCacheWarmer();
+  // order to reload: by tenant and block position
+  static bool warm_key_cmp(const ObBlockCacheWarmKey &l, const ObBlockCacheWarmKey &r);
+  // order to persist: hottest first
+  static bool hot_key_cmp(const ObBlockCacheWarmKey &l, const ObBlockCacheWarmKey &r);
+  int collect_hot_keys(const int64_t max_key_cnt, common::ObIArray<ObBlockCacheWarmKey> &keys);
+  int write_snapshot(const common::ObIArray<ObBlockCacheWarmKey> &keys);
+  int warm_tenant(const common::ObIArray<ObBlockCacheWarmKey> &keys,
+                  const int64_t start,
+                  const int64_t end,
+                  const int64_t stat_idx);
+  int warm_macro_block(const common::ObIArray<ObBlockCacheWarmKey> &keys,
+                       const int64_t start,
+                       const int64_t end,
+                       const int64_t stat_idx,
+                       ObMacroBlockReader &reader,
+                       common::ObIAllocator &allocator);
+  int read_block(const MacroBlockId &macro_id,
+                 const int64_t offset,
+                 const int64_t size,
+                 common::ObIAllocator &allocator,
+                 const char *&buf);
+  void update_stat(const int64_t stat_idx,
+                   const int64_t loaded_cnt,
+                   const int64_t skipped_cnt,
+                   const int64_t failed_cnt,
+                   const int64_t loaded_bytes);
+  void set_stat_status(const int64_t stat_idx, const ObBlockCacheWarmStat::Status status);
+  void throttle(const int64_t read_bytes);
+  // time to wait for the bytes read since warm_start_ts_ to fit in %bandwidth
+  int64_t calc_throttle_wait_us(const int64_t bandwidth, const int64_t now) const;
+  bool need_stop() const { return has_set_stop() || !is_enabled(); }
+  bool is_enabled() const;
+
+private:
+  bool is_inited_;
+  char snapshot_path_[common::MAX_PATH_SIZE];
+  int64_t last_dump_ts_;
+  int64_t warm_start_ts_;
+  int64_t warm_bytes_;
+  common::ObSpinLock lock_;
+  common::ObSEArray<ObBlockCacheWarmStat, 16> stats_;
+  DISALLOW_COPY_AND_ASSIGN(ObBlockCacheWarmer);
+};
+
+} // namespace blocksstable
+} // namespace oceanbase
+
+#endif // OCEANBASE_BLOCKSSTABLE_OB_BLOCK_CACHE_WARMER_H_
@@ -71,6 +71,7 @@ int ObStaticDataStoreDesc::assign(const ObStaticDataStoreDesc &desc)
   micro_index_clustered_ = desc.micro_index_clustered_;
   need_submit_io_ = desc.need_submit_io_;
   encoding_granularity_ = desc.encoding_granularity_;
+  need_encoding_hash_index_ = desc.need_encoding_hash_index_;
   return ret;
 }
 
@@ -122,7 +123,8 @@ int ObStaticDataStoreDesc::init(
     const compaction::ObExecMode exec_mode,
     const bool micro_index_clustered,
     const bool need_submit_io,
-    const uint64_t encoding_granularity)
+    const uint64_t encoding_granularity,
+    const bool need_encoding_hash_index)
 {
   int ret = OB_SUCCESS;
   const bool is_major = compaction::is_major_or_meta_merge_type(merge_type);
@@ -140,6 +142,7 @@ int ObStaticDataStoreDesc::init(
     tablet_transfer_seq_ = tablet_transfer_seq;
     exec_mode_ = exec_mode;
     encoding_granularity_ = encoding_granularity;
+    need_encoding_hash_index_ = is_major && need_encoding_hash_index;
 
     if (compaction::is_mds_merge(merge_type_)) {
       micro_index_clustered_ = false;
@@ -755,6 +758,16 @@ int ObDataStoreDesc::inner_init(
     } else {
       micro_block_size_ = MAX(merge_schema.get_block_size(), MIN_MICRO_BLOCK_SIZE);
     }
+    need_build_hash_index_for_micro_block_ = is_major
+        && static_desc_->need_encoding_hash_index_
+        && ObStoreFormat::is_row_store_type_with_pax_encoding(row_store_type_);
+    need_build_bloom_filter_ = false;
+    if (!GCTX.is_shared_storage_mode()) {
+      omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+      if (tenant_config.is_valid()) {
+        need_build_bloom_filter_ = tenant_config->_enable_merge_bloom_filter;
+      }
+    }
   }
   return ret;
 }
@@ -830,6 +843,7 @@ void ObDataStoreDesc::reset()
   is_force_flat_store_type_ = false;
   need_pre_warm_ = false;
   need_build_hash_index_for_micro_block_ = false;
+  need_build_bloom_filter_ = false;
   data_store_type_ = ObMacroBlockCommonHeader::SSTableData;
   micro_block_size_ = 0;
 }
@@ -843,6 +857,8 @@ int ObDataStoreDesc::shallow_copy(const ObDataStoreDesc &desc)
   row_store_type_ = desc.get_row_store_type();
   encoder_opt_ = desc.encoder_opt_;
   is_force_flat_store_type_ = desc.is_force_flat_store_type_;
+  need_build_hash_index_for_micro_block_ = desc.need_build_hash_index_for_micro_block_;
+  need_build_bloom_filter_ = desc.need_build_bloom_filter_;
   sstable_index_builder_ = desc.sstable_index_builder_;
   data_store_type_ = desc.data_store_type_;
   return ret;
@@ -62,7 +62,8 @@ public:
     const compaction::ObExecMode exec_mode,
     const bool micro_index_clustered,
     const bool need_submit_io = true,
-    const uint64_t encoding_granularity = 0);
+    const uint64_t encoding_granularity = 0,
+    const bool need_encoding_hash_index = false);
   bool is_valid() const;
   void reset();
   int assign(const ObStaticDataStoreDesc &desc);
@@ -87,7 +88,8 @@ public:
       K_(micro_index_clustered),
       K_(progressive_merge_round),
       K_(need_submit_io),
-      K_(encoding_granularity));
+      K_(encoding_granularity),
+      K_(need_encoding_hash_index));
 private:
   OB_INLINE int init_encryption_info(const share::schema::ObMergeSchema &merge_schema);
   OB_INLINE void init_block_size(const share::schema::ObMergeSchema &merge_schema);
@@ -122,6 +124,8 @@ public:
   // indicate whether to submit io to write maroc block data to disk.
   bool need_submit_io_;
   uint64_t encoding_granularity_;
+  // build hash index for encoded micro blocks of major, decided in medium info
+  bool need_encoding_hash_index_;
 };
 
 // ObColDataStoreDesc is same for every parallel task
@@ -317,6 +321,7 @@ public:
       KP_(sstable_index_builder),
       K_(need_pre_warm),
       K_(need_build_hash_index_for_micro_block),
+      K_(need_build_bloom_filter),
       K_(data_store_type),
       K_(micro_block_size));
 
@@ -340,6 +345,7 @@ public:
   bool need_pre_warm_;
   bool is_force_flat_store_type_;
   bool need_build_hash_index_for_micro_block_;
+  bool need_build_bloom_filter_;
 private:
   DISALLOW_COPY_AND_ASSIGN(ObDataStoreDesc);
 };
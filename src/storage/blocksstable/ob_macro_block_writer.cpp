@@ -32,6 +32,7 @@
 #include "storage/blocksstable/ob_logic_macro_id.h"
 #include "storage/blocksstable/cs_encoding/ob_cs_encoding_util.h"
 #include "storage/blocksstable/ob_sstable_private_object_cleaner.h"
+#include "storage/blocksstable/ob_storage_cache_suite.h"
 #ifdef OB_BUILD_SHARED_STORAGE
 #include "storage/compaction/ob_major_pre_warmer.h"
 #endif
@@ -422,7 +423,10 @@ ObMacroBlockWriter::ObMacroBlockWriter(const bool is_need_macro_buffer)
     allocator_("MaBlkWriter"),
     rowkey_allocator_("MaBlkWriter"),
     macro_reader_(),
+    need_build_bloom_filter_(false),
+    is_macro_rowkey_hashs_complete_(true),
     micro_rowkey_hashs_(),
+    macro_rowkey_hashs_(),
     datum_row_(),
     aggregated_row_(nullptr),
     data_aggregator_(nullptr),
@@ -464,7 +468,10 @@ void ObMacroBlockWriter::reset()
   last_key_.reset();
   last_key_with_L_flag_ = false;
   is_macro_or_micro_block_reused_ = false;
+  need_build_bloom_filter_ = false;
+  is_macro_rowkey_hashs_complete_ = true;
   micro_rowkey_hashs_.reset();
+  macro_rowkey_hashs_.reset();
   datum_row_.reset();
   device_handle_ = nullptr;
   if (OB_NOT_NULL(builder_)) {
@@ -519,6 +526,9 @@ int ObMacroBlockWriter::open(
     if (data_store_desc.is_cg()) {
       last_key_.set_min_rowkey(); // used to protect cg sstable
     }
+    need_build_bloom_filter_ = data_store_desc.need_build_bloom_filter_
+                               && !data_store_desc.is_cg()
+                               && !data_store_desc.is_for_index_or_meta();
 
     if (OB_FAIL(init_macro_seq_generator(macro_seq_param))) {
       LOG_WARN("init macro_seq_param failed", K(ret));
@@ -689,6 +699,8 @@ int ObMacroBlockWriter::append_row(const ObDatumRow &row, const int64_t split_si
       STORAGE_LOG(WARN, "Fail to append row to micro block", K(ret), K(row));
     } else if (OB_FAIL(update_micro_commit_info(*row_to_append))) {
       STORAGE_LOG(WARN, "Fail to update_micro_commit_info", K(ret), K(row));
+    } else if (need_build_bloom_filter_ && OB_FAIL(add_rowkey_hash(*row_to_append))) {
+      STORAGE_LOG(WARN, "Fail to add rowkey hash", K(ret), K(row));
     } else if (OB_FAIL(save_last_key(*row_to_append))) {
       STORAGE_LOG(WARN, "Fail to save last key, ", K(ret), K(row));
     } else if (nullptr != data_aggregator_ && OB_FAIL(data_aggregator_->eval(*row_to_append))) {
@@ -1034,9 +1046,10 @@ int ObMacroBlockWriter::init_hash_index_builder()
 {
   int ret = OB_SUCCESS;
   if (data_store_desc_->get_tablet_id().is_user_tablet()
-      && !data_store_desc_->is_major_or_meta_merge_type()
+      && (!data_store_desc_->is_major_or_meta_merge_type()
+          || data_store_desc_->need_build_hash_index_for_micro_block_)
       && !data_store_desc_->is_for_index_or_meta()) {
-    // only build hash index for data block in minor
+    // only build hash index for data block in minor, or encoded data block in major
     if (OB_FAIL(hash_index_builder_.init_if_needed(data_store_desc_))) {
       STORAGE_LOG(WARN, "Failed to build hash_index builder", K(ret));
     }
@@ -1075,7 +1088,7 @@ int ObMacroBlockWriter::append_row_and_hash_index(const ObDatumRow &row)
       STORAGE_LOG(WARN, "Failed to append row in micro writer", K(ret), K(row));
     }
   } else if (hash_index_builder_.is_valid()) {
-    if (OB_UNLIKELY(FLAT_ROW_STORE != data_store_desc_->get_row_store_type())) {
+    if (OB_UNLIKELY(ObStoreFormat::is_row_store_type_with_cs_encoding(data_store_desc_->get_row_store_type()))) {
       ret = OB_ERR_UNEXPECTED;
       STORAGE_LOG(WARN, "Unexpected row store type", K(ret), K(data_store_desc_->get_row_store_type()));
     } else {
@@ -1244,7 +1257,7 @@ int ObMacroBlockWriter::build_hash_index_block()
 {
   int ret = OB_SUCCESS;
   if (hash_index_builder_.is_valid()) {
-    if (OB_UNLIKELY(FLAT_ROW_STORE != data_store_desc_->get_row_store_type())) {
+    if (OB_UNLIKELY(ObStoreFormat::is_row_store_type_with_cs_encoding(data_store_desc_->get_row_store_type()))) {
       ret = OB_ERR_UNEXPECTED;
       STORAGE_LOG(WARN, "Unexpected row store type", K(ret), K(data_store_desc_->get_row_store_type()));
     } else if (OB_FAIL(micro_writer_->append_hash_index(hash_index_builder_))) {
@@ -1433,6 +1446,9 @@ int ObMacroBlockWriter::write_micro_block(ObMicroBlockDesc &micro_block_desc)
   if (OB_SUCC(ret)) {
     last_micro_size_ = micro_block_desc.data_size_;
     last_micro_expand_pct_ = micro_block_desc.original_size_  * 100 / micro_block_desc.data_size_;
+    if (need_build_bloom_filter_) {
+      add_micro_rowkey_hashs();
+    }
   }
 
   return ret;
@@ -1478,6 +1494,7 @@ int ObMacroBlockWriter::try_active_flush_macro_block()
 int ObMacroBlockWriter::flush_macro_block(ObMacroBlock &macro_block)
 {
   int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
 
   ObStorageObjectHandle &macro_handle = macro_handles_[current_index_];
   ObStorageObjectHandle &prev_handle = macro_handles_[(current_index_ + 1) % 2];
@@ -1505,6 +1522,10 @@ int ObMacroBlockWriter::flush_macro_block(ObMacroBlock &macro_block)
     }
 #endif
   }
+  if (OB_SUCC(ret) && need_build_bloom_filter_
+      && OB_TMP_FAIL(put_bloom_filter(macro_handle.get_macro_id()))) {
+    STORAGE_LOG(WARN, "fail to put bloom filter of macro block", K(tmp_ret), K(macro_handle));
+  }
   if (OB_SUCC(ret)) {
     int64_t current_macro_seq = -1;
     if (OB_FAIL(macro_seq_generator_->get_next(current_macro_seq))) {
@@ -2227,6 +2248,62 @@ bool ObMacroBlockWriter::is_for_index() const
   return OB_NOT_NULL(data_store_desc_) && data_store_desc_->is_for_index();
 }
 
+int ObMacroBlockWriter::add_rowkey_hash(const ObDatumRow &row)
+{
+  int ret = OB_SUCCESS;
+  ObDatumRowkey rowkey;
+  uint64_t hash = 0;
+  if (OB_FAIL(rowkey.assign(row.storage_datums_, data_store_desc_->get_schema_rowkey_col_cnt()))) {
+    STORAGE_LOG(WARN, "Failed to assign rowkey", K(ret), K(row));
+  } else if (OB_FAIL(rowkey.murmurhash(0, data_store_desc_->get_datum_utils(), hash))) {
+    STORAGE_LOG(WARN, "Failed to calc rowkey hash", K(ret), K(rowkey));
+  } else if (!micro_rowkey_hashs_.empty()
+      && micro_rowkey_hashs_.at(micro_rowkey_hashs_.count() - 1) == static_cast<uint32_t>(hash)) {
+    // multi-version rows of the same rowkey
+  } else if (OB_FAIL(micro_rowkey_hashs_.push_back(static_cast<uint32_t>(hash)))) {
+    STORAGE_LOG(WARN, "Failed to push back rowkey hash", K(ret));
+  }
+  return ret;
+}
+
+void ObMacroBlockWriter::add_micro_rowkey_hashs()
+{
+  int ret = OB_SUCCESS;
+  if (micro_rowkey_hashs_.empty()) {
+    // the rows of a reused micro block are not hashed, the bloom filter of the macro block
+    // is left to be built after empty reads
+    is_macro_rowkey_hashs_complete_ = false;
+  } else if (!is_macro_rowkey_hashs_complete_) {
+  } else if (OB_FAIL(macro_rowkey_hashs_.push_back(micro_rowkey_hashs_))) {
+    STORAGE_LOG(WARN, "Failed to push back micro rowkey hashs", K(ret));
+    is_macro_rowkey_hashs_complete_ = false;
+  }
+  micro_rowkey_hashs_.reuse();
+}
+
+int ObMacroBlockWriter::put_bloom_filter(const MacroBlockId &macro_id)
+{
+  int ret = OB_SUCCESS;
+  ObBloomFilterCacheValue bf_value;
+  if (!is_macro_rowkey_hashs_complete_ || macro_rowkey_hashs_.empty()) {
+    // skip
+  } else if (OB_FAIL(bf_value.init(data_store_desc_->get_schema_rowkey_col_cnt(), macro_rowkey_hashs_.count()))) {
+    STORAGE_LOG(WARN, "Failed to init bloom filter", K(ret), K(macro_rowkey_hashs_.count()));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < macro_rowkey_hashs_.count(); ++i) {
+      if (OB_FAIL(bf_value.insert(macro_rowkey_hashs_.at(i)))) {
+        STORAGE_LOG(WARN, "Failed to insert rowkey hash to bloom filter", K(ret), K(i));
+      }
+    }
+    if (FAILEDx(OB_STORE_CACHE.get_bf_cache().put_bloom_filter(MTL_ID(), macro_id, bf_value))) {
+      STORAGE_LOG(WARN, "Failed to put bloom filter to cache", K(ret), K(macro_id), K(bf_value));
+    }
+  }
+  macro_rowkey_hashs_.reuse();
+  is_macro_rowkey_hashs_complete_ = true;
+  return ret;
+}
+
 void ObMacroBlockWriter::gen_logic_macro_id(ObLogicMacroBlockId &logic_macro_id)
 {
   logic_macro_id.logic_version_ = data_store_desc_->get_logical_version();
@@ -241,6 +241,9 @@ private:
   int create_pre_warmer(const share::ObPreWarmerType pre_warmer_type,
                         const share::ObPreWarmerParam &pre_warm_param);
   bool is_for_index() const;
+  int add_rowkey_hash(const ObDatumRow &row);
+  void add_micro_rowkey_hashs();
+  int put_bloom_filter(const MacroBlockId &macro_id);
 public:
   static const int64_t DEFAULT_MACRO_BLOCK_REWRTIE_THRESHOLD = 30;
 private:
@@ -269,7 +272,12 @@ private:
   compaction::ObLocalArena allocator_;
   compaction::ObLocalArena rowkey_allocator_;
   blocksstable::ObMacroBlockReader macro_reader_;
+  // rowkey hashes of the rows in the micro block writer and in the current macro block,
+  // to put the bloom filter of the macro block into cache when it's flushed
+  bool need_build_bloom_filter_;
+  bool is_macro_rowkey_hashs_complete_;
   common::ObArray<uint32_t> micro_rowkey_hashs_;
+  common::ObArray<uint32_t> macro_rowkey_hashs_;
   blocksstable::ObDatumRow datum_row_;
   blocksstable::ObDatumRow *aggregated_row_;
   ObSkipIndexAggregator *data_aggregator_;
@@ -18,6 +18,7 @@
 #include "storage/blocksstable/ob_macro_block_handle.h"
 #include "storage/blocksstable/ob_shared_macro_block_manager.h"
 #include "storage/blocksstable/cs_encoding/ob_cs_micro_block_transformer.h"
+#include "storage/blocksstable/ob_storage_cache_suite.h"
 
 namespace oceanbase
 {
@@ -481,6 +482,11 @@ int ObIMicroBlockIOCallback::process_block(
       } else if (OB_FAIL(cache_->put_cache_block(
           block_des_meta_, buffer, size, key, *reader, *allocator_, micro_block, cache_handle, rowkey_col_descs_))) {
         LOG_WARN("Failed to put block to cache", K(ret));
+      } else if (ObMicroBlockData::DATA_BLOCK == cache_->get_type() && ObCompressedMicroBlockCache::is_enabled()) {
+        int tmp_ret = OB_SUCCESS;
+        if (OB_TMP_FAIL(OB_STORE_CACHE.get_compressed_block_cache().put_block(key, buffer, size))) {
+          LOG_WARN("Failed to put block to compressed block cache", K(tmp_ret), K(key));
+        }
       }
     }
 
@@ -907,6 +913,61 @@ int ObIMicroBlockCache::get_cache_block(
   return ret;
 }
 
+int ObIMicroBlockCache::get_cache_block(
+    const ObMicroBlockCacheKey &key,
+    const ObMicroBlockDesMeta &des_meta,
+    ObMicroBlockBufferHandle &handle)
+{
+  int ret = OB_SUCCESS;
+  if (OB_SUCC(get_cache_block(key, handle))) {
+    if (ObMicroBlockData::DATA_BLOCK == get_type() && ObCompressedMicroBlockCache::is_enabled()) {
+      OB_STORE_CACHE.get_compressed_block_cache().touch_block(key);
+    }
+  } else {
+    int tmp_ret = OB_SUCCESS;
+    if (OB_ENTRY_NOT_EXIST != ret
+        || ObMicroBlockData::DATA_BLOCK != get_type()
+        || !ObCompressedMicroBlockCache::is_enabled()) {
+    } else if (OB_TMP_FAIL(promote_compressed_block(key, des_meta, handle))) {
+      if (OB_ENTRY_NOT_EXIST != tmp_ret) {
+        STORAGE_LOG(WARN, "Fail to promote micro block from compressed block cache", K(tmp_ret), K(key));
+      }
+    } else {
+      ret = OB_SUCCESS;
+    }
+  }
+  return ret;
+}
+
+int ObIMicroBlockCache::promote_compressed_block(
+    const ObMicroBlockCacheKey &key,
+    const ObMicroBlockDesMeta &des_meta,
+    ObMicroBlockBufferHandle &handle)
+{
+  int ret = OB_SUCCESS;
+  const ObCompressedMicroBlockCacheValue *compressed_block = nullptr;
+  ObKVCacheHandle compressed_handle;
+  ObIAllocator *allocator = nullptr;
+  if (OB_UNLIKELY(!des_meta.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid arguments", K(ret), K(des_meta));
+  } else if (OB_FAIL(OB_STORE_CACHE.get_compressed_block_cache().get_block(
+      key, compressed_block, compressed_handle))) {
+    if (OB_ENTRY_NOT_EXIST != ret) {
+      STORAGE_LOG(WARN, "Fail to get micro block from compressed block cache", K(ret), K(key));
+    }
+  } else if (OB_FAIL(get_allocator(allocator))) {
+    STORAGE_LOG(WARN, "Fail to get allocator", K(ret));
+  } else {
+    ObMacroBlockReader reader(key.get_tenant_id());
+    if (OB_FAIL(put_cache_block(des_meta, compressed_block->get_buf(), compressed_block->get_size(), key,
+        reader, *allocator, handle.micro_block_, handle.handle_))) {
+      STORAGE_LOG(WARN, "Fail to put decompressed micro block to cache", K(ret), K(key));
+    }
+  }
+  return ret;
+}
+
 int ObIMicroBlockCache::prefetch(
     const uint64_t tenant_id,
     const MacroBlockId &macro_id,
@@ -1510,6 +1571,85 @@ void ObDataMicroBlockCache::cache_miss(int64_t &miss_cnt)
   EVENT_INC(ObStatEventIds::DATA_BLOCK_READ_CNT);
 }
 
+/*---------------------------------ObCompressedMicroBlockCache-----------------------------------*/
+int ObCompressedMicroBlockCacheValue::deep_copy(char *buf, const int64_t buf_len, ObIKVCacheValue *&value) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(NULL == buf || buf_len < size())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument", K(ret), KP(buf), K(buf_len), K(size()));
+  } else if (OB_UNLIKELY(NULL == buf_ || size_ <= 0)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("The compressed micro block cache value is not valid", K(ret), K(*this));
+  } else {
+    char *new_buf = buf + sizeof(ObCompressedMicroBlockCacheValue);
+    MEMCPY(new_buf, buf_, size_);
+    value = new (buf) ObCompressedMicroBlockCacheValue(new_buf, size_);
+  }
+  return ret;
+}
+
+bool ObCompressedMicroBlockCache::is_enabled()
+{
+  return GCONF._enable_compressed_block_cache;
+}
+
+int ObCompressedMicroBlockCache::put_block(
+    const ObMicroBlockCacheKey &key,
+    const char *raw_block_buf,
+    const int64_t buf_size)
+{
+  int ret = OB_SUCCESS;
+  ObMicroBlockHeader header;
+  int64_t pos = 0;
+  if (OB_UNLIKELY(!key.is_valid() || NULL == raw_block_buf || buf_size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument", K(ret), K(key), KP(raw_block_buf), K(buf_size));
+  } else if (OB_FAIL(header.deserialize(raw_block_buf, buf_size, pos))) {
+    LOG_WARN("Fail to deserialize micro block header", K(ret), K(key));
+  } else if (!header.is_compressed_data()) {
+    // decompressing costs nothing, the user block cache is as small as this one
+  } else {
+    ObCompressedMicroBlockCacheValue value(raw_block_buf, buf_size);
+    if (OB_FAIL(put(key, value, false /* overwrite */))) {
+      if (OB_ENTRY_EXIST != ret) {
+        LOG_WARN("Fail to put compressed micro block", K(ret), K(key));
+      } else {
+        ret = OB_SUCCESS;
+      }
+    }
+  }
+  return ret;
+}
+
+void ObCompressedMicroBlockCache::touch_block(const ObMicroBlockCacheKey &key)
+{
+  int64_t &hit_cnt = get_thread_hit_cnt();
+  if (0 == (++hit_cnt % TOUCH_SAMPLE_RATIO)) {
+    const ObCompressedMicroBlockCacheValue *value = nullptr;
+    ObKVCacheHandle handle;
+    // only counts a get for the memblock holding the block, a missing block is fine
+    (void) get(key, value, handle);
+  }
+}
+
+int ObCompressedMicroBlockCache::get_block(
+    const ObMicroBlockCacheKey &key,
+    const ObCompressedMicroBlockCacheValue *&value,
+    ObKVCacheHandle &handle)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!key.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument", K(ret), K(key));
+  } else if (OB_FAIL(get(key, value, handle))) {
+    if (OB_ENTRY_NOT_EXIST != ret) {
+      LOG_WARN("Fail to get compressed micro block", K(ret), K(key));
+    }
+  }
+  return ret;
+}
+
 /*-------------------------------------ObIndexMicroBlockCache-------------------------------------*/
 ObIndexMicroBlockCache::ObIndexMicroBlockCache()
   : ObDataMicroBlockCache()
@@ -117,6 +117,25 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ObMicroBlockCacheValue);
 };
 
+// The raw micro block read from disk, i.e. the micro block header and the compressed payload.
+class ObCompressedMicroBlockCacheValue : public common::ObIKVCacheValue
+{
+public:
+  ObCompressedMicroBlockCacheValue() : buf_(nullptr), size_(0) {}
+  ObCompressedMicroBlockCacheValue(const char *buf, const int64_t size) : buf_(buf), size_(size) {}
+  virtual ~ObCompressedMicroBlockCacheValue() {}
+  virtual int64_t size() const override { return sizeof(ObCompressedMicroBlockCacheValue) + size_; }
+  virtual int deep_copy(char *buf, const int64_t buf_len, ObIKVCacheValue *&value) const override;
+  inline const char *get_buf() const { return buf_; }
+  inline int64_t get_size() const { return size_; }
+  TO_STRING_KV(KP_(buf), K_(size));
+private:
+  const char *buf_;
+  int64_t size_;
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObCompressedMicroBlockCacheValue);
+};
+
 class ObIMicroBlockCache;
 
 class ObMicroBlockBufferHandle
@@ -386,6 +405,12 @@ public:
   int get_cache_block(
       const ObMicroBlockCacheKey &key,
       ObMicroBlockBufferHandle &handle);
+  // same as above, but a data block missing in the cache is promoted from the
+  // compressed block cache if it's cached there
+  int get_cache_block(
+      const ObMicroBlockCacheKey &key,
+      const ObMicroBlockDesMeta &des_meta,
+      ObMicroBlockBufferHandle &handle);
   int prefetch(
       const uint64_t tenant_id,
       const MacroBlockId &macro_id,
@@ -443,6 +468,10 @@ protected:
       ObStorageObjectHandle &macro_handle,
       ObIMicroBlockIOCallback &callback);
 private:
+  int promote_compressed_block(
+      const ObMicroBlockCacheKey &key,
+      const ObMicroBlockDesMeta &des_meta,
+      ObMicroBlockBufferHandle &handle);
   OB_INLINE virtual void inc_cache_miss() = 0;
 };
 
@@ -548,6 +577,46 @@ private:
   OB_INLINE void inc_cache_miss() override { EVENT_INC(ObStatEventIds::INDEX_BLOCK_CACHE_MISS); }
 };
 
+// The compressed tier of the user block cache.
+//
+// A data micro block is cached decompressed in the user block cache, which is
+// several times the size of its compressed copy on disk. If enabled by
+// _enable_compressed_block_cache, the raw micro block is also cached here when
+// it's read from disk, so a block washed out of the user block cache is
+// decompressed from memory instead of being read again.
+//
+// Both caches live in the same kvcache store and are washed by the memblock score,
+// which only grows with the gets of the memblock. A block hit in the user block
+// cache isn't read from here, so every TOUCH_SAMPLE_RATIO-th hit of the user block
+// cache in a thread touches the compressed copy, and the priority of this cache is
+// TOUCH_SAMPLE_RATIO times the user block cache priority. A compressed copy then
+// scores like its decompressed copy, while a memblock here holds several times
+// more blocks, so the compressed copies outlive the decompressed ones.
+class ObCompressedMicroBlockCache
+  : public common::ObKVCache<ObMicroBlockCacheKey, ObCompressedMicroBlockCacheValue>
+{
+public:
+  static const int64_t TOUCH_SAMPLE_RATIO = 16;
+  ObCompressedMicroBlockCache() {}
+  virtual ~ObCompressedMicroBlockCache() {}
+  static bool is_enabled();
+  // put the raw micro block into the cache, the block isn't cached if not compressed
+  int put_block(const ObMicroBlockCacheKey &key, const char *raw_block_buf, const int64_t buf_size);
+  int get_block(
+      const ObMicroBlockCacheKey &key,
+      const ObCompressedMicroBlockCacheValue *&value,
+      common::ObKVCacheHandle &handle);
+  // called on a hit of the user block cache, see the comment of the class
+  void touch_block(const ObMicroBlockCacheKey &key);
+private:
+  static int64_t &get_thread_hit_cnt()
+  {
+    RLOCAL_INLINE(int64_t, hit_cnt);
+    return hit_cnt;
+  }
+  DISALLOW_COPY_AND_ASSIGN(ObCompressedMicroBlockCache);
+};
+
 
 }//end namespace blocksstable
 }//end namespace oceanbase
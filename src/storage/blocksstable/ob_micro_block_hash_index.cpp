@@ -104,48 +104,70 @@ int ObMicroBlockHashIndexBuilder::build_block(ObMicroBufferWriter &buffer)
 {
   int ret = OB_SUCCESS;
   // ObMicroBlockHashIndexBuilder must be valid when call build_block.
+  const bool is_wide_format = is_wide();
+  const uint32_t max_bucket_number = is_wide_format ? ObMicroBlockHashIndex::MAX_WIDE_BUCKET_NUMBER
+                                                    : ObMicroBlockHashIndex::MAX_BUCKET_NUMBER;
   if (OB_UNLIKELY(count_ <= ObMicroBlockHashIndex::MIN_ROWS_BUILD_HASH_INDEX)) {
     ret = OB_NOT_SUPPORTED;
   } else {
-    uint16_t num_buckets = caculate_bucket_number(count_);
-    if (OB_UNLIKELY(num_buckets > ObMicroBlockHashIndex::MAX_BUCKET_NUMBER)) {
+    const uint32_t num_buckets = caculate_bucket_number(count_);
+    if (OB_UNLIKELY(num_buckets > max_bucket_number)) {
       ret = OB_ERR_UNEXPECTED;
-      STORAGE_LOG(WARN, "Too much buckets ", K(ret), K(num_buckets));
+      STORAGE_LOG(WARN, "Too much buckets ", K(ret), K(num_buckets), K(is_wide_format));
+    } else if (OB_FAIL(buckets_.prepare_allocate(num_buckets))) {
+      STORAGE_LOG(WARN, "Failed to allocate hash index buckets", K(ret), K(num_buckets));
     } else {
-      const uint8_t no_entry = ObMicroBlockHashIndex::NO_ENTRY;
-      MEMSET(buckets_, no_entry, num_buckets);
+      for (uint32_t i = 0; i < num_buckets; ++i) {
+        buckets_.at(i) = ObMicroBlockHashIndex::WIDE_NO_ENTRY;
+      }
       uint32_t collision_count = 0;
       // Write the row_index array
       for (int i = 0; i < count_; ++i) {
-        const uint64_t hash_value = hash_values_[i];
-        const uint8_t row_index = row_indexes_[i];
+        const uint64_t hash_value = hash_values_.at(i);
+        const uint16_t row_index = row_indexes_.at(i);
         const uint16_t buck_idx = static_cast<uint16_t>(hash_value % num_buckets);
-        if (buckets_[buck_idx] == ObMicroBlockHashIndex::NO_ENTRY) {
-          buckets_[buck_idx] = row_index;
-        } else if (buckets_[buck_idx] != ObMicroBlockHashIndex::COLLISION) {
+        if (buckets_.at(buck_idx) == ObMicroBlockHashIndex::WIDE_NO_ENTRY) {
+          buckets_.at(buck_idx) = row_index;
+        } else if (buckets_.at(buck_idx) != ObMicroBlockHashIndex::WIDE_COLLISION) {
           // Same bucket cannot store two different offset, mark collision.
-          buckets_[buck_idx] = ObMicroBlockHashIndex::COLLISION;
+          buckets_.at(buck_idx) = ObMicroBlockHashIndex::WIDE_COLLISION;
           collision_count += 2;
         } else {
           ++collision_count;
         }
       }
 
-      if ((collision_count * ObMicroBlockHashIndex::MAX_COLLISION_RATIO) <= count_) {
+      if ((collision_count * ObMicroBlockHashIndex::MAX_COLLISION_RATIO) > count_) {
+        ret = OB_NOT_SUPPORTED;
+      } else if (is_wide_format) {
+        const uint8_t version = ObMicroBlockHashIndex::WIDE_VERSION;
+        const uint16_t bucket_cnt = static_cast<uint16_t>(num_buckets);
+        if (OB_FAIL(buffer.write(reinterpret_cast<const void *>(&buckets_.at(0)), num_buckets * sizeof(uint16_t)))) {
+          STORAGE_LOG(WARN, "Data buffer fail to write hash index buckets", K(ret), K(num_buckets), K(count_));
+        } else if (OB_FAIL(buffer.write(version))) {
+          STORAGE_LOG(WARN, "Data buffer fail to write hash index version", K(ret), K(num_buckets), K(count_));
+        } else if (OB_FAIL(buffer.write(bucket_cnt))) {
+          STORAGE_LOG(WARN, "Data buffer fail to write hash index buckets number", K(ret), K(num_buckets), K(count_));
+        }
+      } else {
         const uint8_t reserved_byte = ObMicroBlockHashIndex::RESERVED_BYTE;
+        const uint16_t bucket_cnt = static_cast<uint16_t>(num_buckets);
         if (OB_FAIL(buffer.write(reserved_byte))) {
           STORAGE_LOG(WARN, "Data buffer fail to write reserved byte", K(ret), K(num_buckets), K(count_), K(reserved_byte));
-        } else if (OB_FAIL(buffer.write(num_buckets))) {
+        } else if (OB_FAIL(buffer.write(bucket_cnt))) {
           STORAGE_LOG(WARN, "Data buffer fail to write hash index buckets number", K(ret), K(num_buckets), K(count_));
-        } else if (OB_FAIL(buffer.write(reinterpret_cast<const void *>(buckets_), num_buckets))) {
-          STORAGE_LOG(WARN, "Data buffer fail to write hash index buckets", K(ret), K(num_buckets), K(count_));
         }
-      } else {
-        ret = OB_NOT_SUPPORTED;
+        for (uint32_t i = 0; OB_SUCC(ret) && i < num_buckets; ++i) {
+          // narrow entries, NO_ENTRY and COLLISION are the low bytes of the wide ones
+          const uint8_t bucket = static_cast<uint8_t>(buckets_.at(i));
+          if (OB_FAIL(buffer.write(bucket))) {
+            STORAGE_LOG(WARN, "Data buffer fail to write hash index buckets", K(ret), K(num_buckets), K(count_));
+          }
+        }
       }
     }
   }
-  STORAGE_LOG(DEBUG, "Build hash index block", K(count_), K(ret));
+  STORAGE_LOG(DEBUG, "Build hash index block", K(count_), K(is_wide_format), K(ret));
   return ret;
 }
 
@@ -160,15 +182,18 @@ OB_INLINE bool ObMicroBlockHashIndexBuilder::can_be_added_to_hash_index(const Ob
 int ObMicroBlockHashIndexBuilder::internal_add(const uint64_t hash_value, const uint32_t row_index)
 {
   int ret = OB_SUCCESS;
-  if (row_index >= ObMicroBlockHashIndex::MAX_OFFSET_SUPPORTED) {
+  if (row_index >= ObMicroBlockHashIndex::MAX_WIDE_OFFSET_SUPPORTED) {
     ret = OB_NOT_SUPPORTED;
-  } else if (OB_UNLIKELY(!is_empty() && row_index <= row_indexes_[count_ - 1])) {
+  } else if (OB_UNLIKELY(!is_empty() && row_index <= row_indexes_.at(count_ - 1))) {
     ret = OB_ERR_UNEXPECTED;
-    const uint32_t front_row_index = row_indexes_[count_ - 1];
+    const uint32_t front_row_index = row_indexes_.at(count_ - 1);
     STORAGE_LOG(WARN, "Unexpected row_index ", K(ret), K(row_index), K(front_row_index), K(count_));
+  } else if (OB_FAIL(hash_values_.push_back(static_cast<uint32_t>(hash_value)))) {
+    STORAGE_LOG(WARN, "Failed to push back hash value", K(ret), K(row_index), K(count_));
+  } else if (OB_FAIL(row_indexes_.push_back(static_cast<uint16_t>(row_index)))) {
+    STORAGE_LOG(WARN, "Failed to push back row index", K(ret), K(row_index), K(count_));
+    hash_values_.pop_back();
   } else {
-    hash_values_[count_] = static_cast<uint32_t>(hash_value);
-    row_indexes_[count_] = static_cast<uint8_t>(row_index);
     count_++;
   }
   return ret;
@@ -177,6 +202,32 @@ int ObMicroBlockHashIndexBuilder::internal_add(const uint64_t hash_value, const
 /**
  * -------------------------------------------------------------------ObMicroBlockHashIndex-----------------------------------------------------------------
  */
+int ObMicroBlockHashIndex::get_hash_index_size(
+    const ObMicroBlockHeader &micro_block_header,
+    const char *buf,
+    const int64_t buf_size,
+    int64_t &size)
+{
+  int ret = OB_SUCCESS;
+  size = 0;
+  if (micro_block_header.is_contain_hash_index()) {
+    const uint32_t hash_index_offset_from_end = micro_block_header.hash_index_offset_from_end_;
+    if (OB_UNLIKELY(nullptr == buf || hash_index_offset_from_end < get_fixed_header_size()
+        || hash_index_offset_from_end + micro_block_header.header_size_ > buf_size)) {
+      ret = OB_INVALID_DATA;
+      STORAGE_LOG(WARN, "Invalid hash index offset", K(ret), KP(buf), K(buf_size),
+                  K(hash_index_offset_from_end), K(micro_block_header));
+    } else {
+      size = hash_index_size(buf + buf_size - hash_index_offset_from_end);
+      if (OB_UNLIKELY(size + micro_block_header.header_size_ > buf_size)) {
+        ret = OB_INVALID_DATA;
+        STORAGE_LOG(WARN, "Invalid hash index size", K(ret), K(size), K(buf_size), K(micro_block_header));
+      }
+    }
+  }
+  return ret;
+}
+
 int ObMicroBlockHashIndex::init(const ObMicroBlockData &micro_block_data)
 {
   int ret = OB_SUCCESS;
@@ -190,12 +241,23 @@ int ObMicroBlockHashIndex::init(const ObMicroBlockData &micro_block_data)
     const char* start_data = micro_block_data.get_buf() + micro_block_data.get_buf_size()
                                  - hash_index_offset_from_end;
     const uint8 reserved_byte = reinterpret_cast<const uint8_t *>(start_data)[0];
-    bucket_table_ = reinterpret_cast<const uint8_t *>(start_data + get_fixed_header_size());
     num_buckets_ = reinterpret_cast<const uint16_t *>(start_data + 1)[0];
+    is_wide_ = WIDE_VERSION == reserved_byte;
+    bool is_valid = false;
+    if (is_wide_) {
+      // the fixed part is the footer, buckets are in front of it
+      bucket_table_ = reinterpret_cast<const uint8_t *>(start_data) - sizeof(uint16_t) * num_buckets_;
+      is_valid = num_buckets_ != 0
+                     && get_fixed_header_size() == hash_index_offset_from_end
+                     && get_serialize_size(num_buckets_, true) + micro_block_header->header_size_
+                            <= micro_block_data.get_buf_size();
+    } else {
+      bucket_table_ = reinterpret_cast<const uint8_t *>(start_data + get_fixed_header_size());
+      is_valid = num_buckets_ != 0 && num_buckets_ <= MAX_BUCKET_NUMBER
+                     && reserved_byte == RESERVED_BYTE
+                     && get_serialize_size(num_buckets_) == hash_index_offset_from_end;
+    }
     STORAGE_LOG(DEBUG, "ObMicroBlockHashIndex init", K(num_buckets_), K(reserved_byte));
-    bool is_valid = num_buckets_ != 0 && num_buckets_ <= MAX_BUCKET_NUMBER
-                        && reserved_byte == RESERVED_BYTE
-                        && get_serialize_size(num_buckets_) == hash_index_offset_from_end;
     if (OB_UNLIKELY(!is_valid)) {
       ret = OB_ERR_UNEXPECTED;
       STORAGE_LOG(WARN, "Unexpected hash index in data micro block", K_(num_buckets),
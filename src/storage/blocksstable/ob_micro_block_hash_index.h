@@ -12,6 +12,7 @@
 #define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_HASH_INDEX_H_
 
 #include "lib/oblog/ob_log_module.h"
+#include "lib/container/ob_se_array.h"
 #include "ob_data_buffer.h"
 
 namespace oceanbase
@@ -27,7 +28,17 @@ namespace blocksstable
 {
 struct ObDataStoreDesc;
 struct ObMicroBlockData;
+struct ObMicroBlockHeader;
 class ObMicroBufferWriter;
+// Point lookup index of a data micro block, maps the hash of a rowkey to its row index.
+//
+// Two formats are supported, both stored at the end of the micro block:
+//  - narrow: reserved byte(0) + num_buckets(uint16) + uint8 buckets, for blocks
+//    whose indexed rows are all below MAX_OFFSET_SUPPORTED.
+//  - wide: uint16 buckets + WIDE_VERSION(uint8) + num_buckets(uint16), for larger
+//    blocks. The fixed part is a footer so that hash_index_offset_from_end_ in
+//    the micro block header (10 bits) only needs to cover the fixed part, older
+//    readers see an unknown reserved byte and fall back to binary search.
 class ObMicroBlockHashIndex
 {
 public:
@@ -35,24 +46,42 @@ public:
   static const uint8_t COLLISION = 254;
   static const uint8_t MAX_OFFSET_SUPPORTED = 253;
   static const uint8_t RESERVED_BYTE = 0;
+  static const uint8_t WIDE_VERSION = 1;
+  static const uint16_t WIDE_NO_ENTRY = UINT16_MAX;
+  static const uint16_t WIDE_COLLISION = UINT16_MAX - 1;
   static constexpr double DEFAULT_UTIL_RATIO = 0.75;
   static constexpr double BUCKET_PER_KEY = 1 / DEFAULT_UTIL_RATIO;
   static const uint32_t MAX_BUCKET_NUMBER = static_cast<uint32_t>(BUCKET_PER_KEY * MAX_OFFSET_SUPPORTED) | 1;
+  // keep the bucket number of wide format in uint16
+  static const uint32_t MAX_WIDE_OFFSET_SUPPORTED = static_cast<uint32_t>(UINT16_MAX * DEFAULT_UTIL_RATIO);
+  static const uint32_t MAX_WIDE_BUCKET_NUMBER = UINT16_MAX;
   static constexpr double MAX_COLLISION_RATIO = 1.5;
   static const uint32_t MIN_ROWS_BUILD_HASH_INDEX = 16;
   static const uint32_t MIN_INT_COLUMNS_NEEDED = 3;
 public:
   ObMicroBlockHashIndex()
     : is_inited_(false),
+      is_wide_(false),
       num_buckets_(0),
       bucket_table_(nullptr)
   {
   }
-  OB_INLINE uint8_t find(const uint64_t hash_value) const
+  // Return the row index, WIDE_NO_ENTRY or WIDE_COLLISION for both formats.
+  OB_INLINE uint16_t find(const uint64_t hash_value) const
   {
     const uint16_t idx = static_cast<uint16_t>(
                              static_cast<uint32_t>(hash_value) % num_buckets_);
-    return bucket_table_[idx];
+    uint16_t row_idx = 0;
+    if (is_wide_) {
+      row_idx = reinterpret_cast<const uint16_t *>(bucket_table_)[idx];
+    } else {
+      row_idx = bucket_table_[idx];
+      if (row_idx >= COLLISION) {
+        // NO_ENTRY -> WIDE_NO_ENTRY, COLLISION -> WIDE_COLLISION
+        row_idx |= 0xFF00;
+      }
+    }
+    return row_idx;
   }
   OB_INLINE bool is_inited()
   {
@@ -61,14 +90,15 @@ public:
   OB_INLINE void reset()
   {
     is_inited_ = false;
+    is_wide_ = false;
   }
   OB_INLINE void reuse()
   {
     reset();
   }
-  OB_INLINE static uint32_t get_serialize_size(uint32_t num_bucket)
+  OB_INLINE static uint32_t get_serialize_size(uint32_t num_bucket, const bool is_wide = false)
   {
-    return sizeof(uint8_t) * num_bucket + get_fixed_header_size();
+    return (is_wide ? sizeof(uint16_t) : sizeof(uint8_t)) * num_bucket + get_fixed_header_size();
   }
   OB_INLINE static uint32_t get_fixed_header_size()
   {
@@ -78,11 +108,18 @@ public:
   OB_INLINE static uint32_t hash_index_size(const char *data)
   {
     uint32_t num_bucket = reinterpret_cast<const uint16_t *>(data + 1)[0];
-    return get_serialize_size(num_bucket);
+    return get_serialize_size(num_bucket, WIDE_VERSION == reinterpret_cast<const uint8_t *>(data)[0]);
   }
+  // Size of the hash index at the end of the micro block, 0 if there is none.
+  static int get_hash_index_size(
+      const ObMicroBlockHeader &micro_block_header,
+      const char *buf,
+      const int64_t buf_size,
+      int64_t &size);
   int init(const ObMicroBlockData &micro_block_data);
 public:
   bool is_inited_;
+  bool is_wide_;
   uint16_t num_buckets_;
   const uint8_t *bucket_table_;
 };
@@ -95,7 +132,10 @@ public:
       row_index_(0),
       last_key_with_L_flag_(false),
       data_store_desc_(nullptr),
-      is_inited_(false)
+      is_inited_(false),
+      buckets_("MicroHashIndex", OB_MALLOC_NORMAL_BLOCK_SIZE),
+      row_indexes_("MicroHashIndex", OB_MALLOC_NORMAL_BLOCK_SIZE),
+      hash_values_("MicroHashIndex", OB_MALLOC_NORMAL_BLOCK_SIZE)
   {
   }
   ~ObMicroBlockHashIndexBuilder() {}
@@ -107,33 +147,50 @@ public:
     count_ = 0;
     last_key_with_L_flag_ = false;
     is_inited_ = false;
+    buckets_.reuse();
+    row_indexes_.reuse();
+    hash_values_.reuse();
   }
   OB_INLINE bool is_empty() const { return 0 == count_; }
-  OB_INLINE uint16_t caculate_bucket_number(uint32_t count) const
+  OB_INLINE uint32_t caculate_bucket_number(uint32_t count) const
   {
-    uint16_t estimated_num_buckets =
-                 static_cast<uint16_t>(count * ObMicroBlockHashIndex::BUCKET_PER_KEY);
+    uint32_t estimated_num_buckets =
+                 static_cast<uint32_t>(count * ObMicroBlockHashIndex::BUCKET_PER_KEY);
     estimated_num_buckets |= 1;
     return estimated_num_buckets;
   }
+  // The wide format is needed once any indexed row is beyond MAX_OFFSET_SUPPORTED.
+  OB_INLINE bool is_wide(bool plus_one = false) const
+  {
+    const uint32_t max_row_index = plus_one ? row_index_ : (is_empty() ? 0 : row_indexes_.at(count_ - 1));
+    return max_row_index >= ObMicroBlockHashIndex::MAX_OFFSET_SUPPORTED;
+  }
   OB_INLINE int64_t estimate_size(bool plus_one = false) const
   {
     int64_t size = 0;
     if (is_valid()) {
       const uint32_t count = plus_one ? (count_ + 1) : count_;
       if (count > ObMicroBlockHashIndex::MIN_ROWS_BUILD_HASH_INDEX) {
-        uint16_t estimated_num_buckets = caculate_bucket_number(count);
-        size = ObMicroBlockHashIndex::get_serialize_size(estimated_num_buckets);
+        uint32_t estimated_num_buckets = caculate_bucket_number(count);
+        size = ObMicroBlockHashIndex::get_serialize_size(estimated_num_buckets, is_wide(plus_one));
       }
     }
     return size;
   }
+  // Value of hash_index_offset_from_end_ in the micro block header after build_block.
+  OB_INLINE int64_t get_offset_from_end() const
+  {
+    return is_wide() ? ObMicroBlockHashIndex::get_fixed_header_size() : estimate_size();
+  }
   OB_INLINE void reuse()
   {
     row_index_ = 0;
     count_ = 0;
     last_key_with_L_flag_ = false;
     is_inited_ = true;
+    buckets_.reuse();
+    row_indexes_.reuse();
+    hash_values_.reuse();
   }
   int add(const ObDatumRow &row);
   int build_block(ObMicroBufferWriter &buffer);
@@ -147,9 +204,9 @@ private:
   bool last_key_with_L_flag_;
   const ObDataStoreDesc *data_store_desc_;
   bool is_inited_;
-  uint8_t buckets_[ObMicroBlockHashIndex::MAX_BUCKET_NUMBER];
-  uint8_t row_indexes_[ObMicroBlockHashIndex::MAX_OFFSET_SUPPORTED];
-  uint32_t hash_values_[ObMicroBlockHashIndex::MAX_OFFSET_SUPPORTED];
+  common::ObSEArray<uint16_t, ObMicroBlockHashIndex::MAX_BUCKET_NUMBER> buckets_;
+  common::ObSEArray<uint16_t, ObMicroBlockHashIndex::MAX_OFFSET_SUPPORTED> row_indexes_;
+  common::ObSEArray<uint32_t, ObMicroBlockHashIndex::MAX_OFFSET_SUPPORTED> hash_values_;
 };
 
 } // end namespace blocksstable
@@ -294,11 +294,11 @@ int ObMicroBlockGetReader::locate_rowkey_fast_path(const ObDatumRowkey &rowkey,
     if (OB_FAIL(rowkey.murmurhash(0, datum_utils, hash_value))) {
       LOG_WARN("Failed to calc rowkey hash", K(ret), K(rowkey), K(datum_utils));
     } else  {
-      const uint8_t tmp_row_idx = hash_index_.find(hash_value);
-      if (tmp_row_idx == ObMicroBlockHashIndex::NO_ENTRY) {
+      const uint16_t tmp_row_idx = hash_index_.find(hash_value);
+      if (tmp_row_idx == ObMicroBlockHashIndex::WIDE_NO_ENTRY) {
         row_idx = ObIMicroBlockReaderInfo::INVALID_ROW_INDEX;
         found = false;
-      } else if (tmp_row_idx == ObMicroBlockHashIndex::COLLISION) {
+      } else if (tmp_row_idx == ObMicroBlockHashIndex::WIDE_COLLISION) {
         need_binary_search = true;
       } else {
         int32_t compare_result = 0;
@@ -261,7 +261,7 @@ int ObMicroBlockWriter::append_hash_index(ObMicroBlockHashIndexBuilder& hash_ind
       }
     } else {
       get_header(data_buffer_)->contains_hash_index_ = 1;
-      get_header(data_buffer_)->hash_index_offset_from_end_ = hash_index_builder.estimate_size();
+      get_header(data_buffer_)->hash_index_offset_from_end_ = hash_index_builder.get_offset_from_end();
     }
   }
   return ret;
@@ -25,6 +25,7 @@ ObStorageCacheSuite::ObStorageCacheSuite()
     bf_cache_(),
     fuse_row_cache_(),
     storage_meta_cache_(),
+    compressed_block_cache_(),
     is_inited_(false)
 {
 }
@@ -67,6 +68,9 @@ int ObStorageCacheSuite::init(
     STORAGE_LOG(ERROR, "fail to init fuse row cache", K(ret));
   } else if (OB_FAIL(storage_meta_cache_.init("storage_meta_cache", storage_meta_cache_priority))) {
     STORAGE_LOG(ERROR, "fail to init storage meta cache", K(ret), K(storage_meta_cache_priority));
+  } else if (OB_FAIL(compressed_block_cache_.init("compressed_block_cache",
+      user_block_cache_priority * ObCompressedMicroBlockCache::TOUCH_SAMPLE_RATIO))) {
+    STORAGE_LOG(ERROR, "fail to init compressed block cache", K(ret), K(user_block_cache_priority));
   } else {
     is_inited_ = true;
   }
@@ -102,6 +106,9 @@ int ObStorageCacheSuite::reset_priority(
     STORAGE_LOG(ERROR, "fail to set priority for fuse row cache", K(ret));
   } else if (OB_FAIL(storage_meta_cache_.set_priority(storage_meta_cache_priority))) {
     STORAGE_LOG(ERROR, "fail to set priority for storage cache", K(ret), K(storage_meta_cache_priority));
+  } else if (OB_FAIL(compressed_block_cache_.set_priority(
+      user_block_cache_priority * ObCompressedMicroBlockCache::TOUCH_SAMPLE_RATIO))) {
+    STORAGE_LOG(ERROR, "fail to set priority for compressed block cache", K(ret), K(user_block_cache_priority));
   }
   return ret;
 }
@@ -123,6 +130,7 @@ void ObStorageCacheSuite::destroy()
   bf_cache_.destroy();
   fuse_row_cache_.destroy();
   storage_meta_cache_.destory();
+  compressed_block_cache_.destroy();
   is_inited_ = false;
 }
 
@@ -97,6 +97,7 @@ ObStorageDatumUtils::ObStorageDatumUtils()
     cmp_funcs_(),
     hash_funcs_(),
     ext_hash_func_(),
+    norm_key_type_(NORM_KEY_NONE),
     is_oracle_mode_(false),
     is_inited_(false)
 {}
@@ -104,6 +105,36 @@ ObStorageDatumUtils::ObStorageDatumUtils()
 ObStorageDatumUtils::~ObStorageDatumUtils()
 {}
 
+ObStorageDatumUtils::NormKeyType ObStorageDatumUtils::get_norm_key_type(const ObObjMeta &col_type)
+{
+  NormKeyType type = NORM_KEY_NONE;
+  switch (col_type.get_type_class()) {
+    case ObIntTC:
+    case ObDateTimeTC:
+    case ObTimeTC:
+      type = NORM_KEY_INT;
+      break;
+    case ObUIntTC:
+      type = NORM_KEY_UINT;
+      break;
+    case ObDateTC:
+      type = NORM_KEY_INT32;
+      break;
+    case ObYearTC:
+      type = NORM_KEY_UINT8;
+      break;
+    case ObStringTC:
+      // other collations are not memcmp ordered or pad spaces
+      if (CS_TYPE_BINARY == col_type.get_collation_type()) {
+        type = NORM_KEY_BINARY;
+      }
+      break;
+    default:
+      break;
+  }
+  return type;
+}
+
 int ObStorageDatumUtils::transform_multi_version_col_desc(const ObIArray<share::schema::ObColDesc> &col_descs,
                                                           const int64_t schema_rowkey_cnt,
                                                           ObIArray<share::schema::ObColDesc> &mv_col_descs)
@@ -257,6 +288,7 @@ int ObStorageDatumUtils::inner_init(
       STORAGE_LOG(ERROR, "Unexpected null basic funcs for extend type", K(ret));
     } else {
       ext_hash_func_.hash_func_ = basic_funcs->murmur_hash_;
+      norm_key_type_ = mv_rowkey_col_cnt > 0 ? get_norm_key_type(mv_col_descs.at(0).col_type_) : NORM_KEY_NONE;
       rowkey_cnt_ = mv_rowkey_col_cnt;
       is_inited_ = true;
     }
@@ -276,6 +308,7 @@ int ObStorageDatumUtils::assign(const ObStorageDatumUtils &other_utils, ObIAlloc
     rowkey_cnt_ = other_utils.get_rowkey_count();
     is_oracle_mode_ = other_utils.is_oracle_mode();
     ext_hash_func_ = other_utils.get_ext_hash_funcs();
+    norm_key_type_ = other_utils.norm_key_type_;
     if (OB_FAIL(cmp_funcs_.init_and_assign(other_utils.get_cmp_funcs(), allocator))) {
       STORAGE_LOG(WARN, "Failed to assign cmp func array", K(ret));
     } else if (OB_FAIL(hash_funcs_.init_and_assign(other_utils.get_hash_funcs(), allocator))) {
@@ -294,6 +327,7 @@ void ObStorageDatumUtils::reset()
   cmp_funcs_.reset();
   hash_funcs_.reset();
   ext_hash_func_.hash_func_ = nullptr;
+  norm_key_type_ = NORM_KEY_NONE;
   is_inited_ = false;
 }
 
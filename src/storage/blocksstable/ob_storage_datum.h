@@ -117,8 +117,27 @@ public:
   OB_INLINE const ObStoreCmpFuncs &get_cmp_funcs() const { return cmp_funcs_; }
   OB_INLINE const ObStoreHashFuncs &get_hash_funcs() const { return hash_funcs_; }
   OB_INLINE const common::ObHashFunc &get_ext_hash_funcs() const { return ext_hash_func_; }
+  OB_INLINE bool has_norm_key() const { return NORM_KEY_NONE != norm_key_type_; }
+  // Compare the normalized keys of the first rowkey column, return false if the
+  // order can't be decided by them and the full rowkey comparison is needed.
+  OB_INLINE bool compare_norm_key(const ObStorageDatum &left, const ObStorageDatum &right, int &cmp_ret) const;
   int64_t get_deep_copy_size() const;
-  TO_STRING_KV(K_(is_oracle_mode), K_(rowkey_cnt), K_(is_inited), K_(is_oracle_mode));
+  TO_STRING_KV(K_(is_oracle_mode), K_(rowkey_cnt), K_(norm_key_type), K_(is_inited), K_(is_oracle_mode));
+private:
+  // The normalized key is an order preserving uint64 prefix of the first rowkey
+  // column, left < right implies norm(left) <= norm(right), so comparing them
+  // decides most duels of the merge loser trees without the cmp funcs.
+  enum NormKeyType : uint8_t
+  {
+    NORM_KEY_NONE = 0,
+    NORM_KEY_INT,     // int64 datum
+    NORM_KEY_UINT,    // uint64 datum
+    NORM_KEY_INT32,   // date
+    NORM_KEY_UINT8,   // year
+    NORM_KEY_BINARY,  // first 8 bytes of binary collation string
+  };
+  static NormKeyType get_norm_key_type(const common::ObObjMeta &col_type);
+  OB_INLINE uint64_t get_norm_key(const ObStorageDatum &datum) const;
 private:
   //TODO to be removed by @hanhui
   int transform_multi_version_col_desc(const common::ObIArray<share::schema::ObColDesc> &col_descs,
@@ -133,11 +152,57 @@ private:
   ObStoreCmpFuncs cmp_funcs_; // multi version rowkey cmp funcs
   ObStoreHashFuncs hash_funcs_;  // multi version rowkey cmp funcs
   common::ObHashFunc ext_hash_func_;
+  NormKeyType norm_key_type_;
   bool is_oracle_mode_;
   bool is_inited_;
   DISALLOW_COPY_AND_ASSIGN(ObStorageDatumUtils);
 };
 
+OB_INLINE uint64_t ObStorageDatumUtils::get_norm_key(const ObStorageDatum &datum) const
+{
+  uint64_t norm_key = 0;
+  switch (norm_key_type_) {
+    case NORM_KEY_INT:
+      norm_key = static_cast<uint64_t>(datum.get_int()) ^ (1ULL << 63);
+      break;
+    case NORM_KEY_UINT:
+      norm_key = datum.get_uint64();
+      break;
+    case NORM_KEY_INT32:
+      norm_key = static_cast<uint64_t>(static_cast<int64_t>(datum.get_date())) ^ (1ULL << 63);
+      break;
+    case NORM_KEY_UINT8:
+      norm_key = datum.get_year();
+      break;
+    case NORM_KEY_BINARY:
+      // zero padded big endian prefix, keeps the memcmp order of binary collation
+      MEMCPY(&norm_key, datum.ptr_, MIN(static_cast<int64_t>(datum.len_), static_cast<int64_t>(sizeof(norm_key))));
+      norm_key = __builtin_bswap64(norm_key);
+      break;
+    default:
+      break;
+  }
+  return norm_key;
+}
+
+OB_INLINE bool ObStorageDatumUtils::compare_norm_key(
+    const ObStorageDatum &left,
+    const ObStorageDatum &right,
+    int &cmp_ret) const
+{
+  bool decided = false;
+  if (NORM_KEY_NONE != norm_key_type_
+      && !left.is_null() && !left.is_ext() && !right.is_null() && !right.is_ext()) {
+    const uint64_t left_key = get_norm_key(left);
+    const uint64_t right_key = get_norm_key(right);
+    if (left_key != right_key) {
+      cmp_ret = left_key < right_key ? -1 : 1;
+      decided = true;
+    }
+  }
+  return decided;
+}
+
 struct ObStorageDatumBuffer
 {
 public:
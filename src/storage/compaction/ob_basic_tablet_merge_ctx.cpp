@@ -42,6 +42,7 @@ ObStaticMergeParam::ObStaticMergeParam(ObTabletMergeDagParam &dag_param)
     is_tenant_major_merge_(false),
     is_cs_replica_(false),
     is_backfill_(false),
+    need_encoding_hash_index_(false),
     merge_level_(MICRO_BLOCK_MERGE_LEVEL),
     merge_reason_(ObAdaptiveMergePolicy::AdaptiveMergeReason::NONE),
     co_major_merge_type_(ObCOMajorMergePolicy::INVALID_CO_MAJOR_MERGE_TYPE),
@@ -87,6 +88,7 @@ void ObStaticMergeParam::reset()
   tx_id_ = 0;
   tablet_schema_guard_.reset();
   encoding_granularity_ = 0;
+  need_encoding_hash_index_ = false;
   tablet_transfer_seq_ = ObStorageObjectOpt::INVALID_TABLET_TRANSFER_SEQ;
 }
 
@@ -839,7 +841,8 @@ int ObBasicTabletMergeCtx::init_static_param_and_desc()
                                 static_param_.get_exec_mode(),
                                 get_tablet()->get_tablet_meta().micro_index_clustered_,
                                 true,
-                                static_param_.encoding_granularity_))) {
+                                static_param_.encoding_granularity_,
+                                static_param_.need_encoding_hash_index_))) {
     LOG_WARN("failed to init static desc", KR(ret), KPC(this));
   } else {
     LOG_INFO("[SharedStorage] success to set exec mode", KR(ret), "exec_mode", exec_mode_to_str(static_desc_.exec_mode_));
@@ -1206,6 +1209,7 @@ int ObBasicTabletMergeCtx::get_medium_compaction_info()
       static_param_.is_schema_changed_ = medium_info->is_schema_changed_;
     }
     static_param_.encoding_granularity_ = medium_info->encoding_granularity_;
+    static_param_.need_encoding_hash_index_ = medium_info->need_encoding_hash_index_;
     static_param_.merge_reason_ = (ObAdaptiveMergePolicy::AdaptiveMergeReason)medium_info->medium_merge_reason_;
     if (!static_param_.is_cs_replica_) {
       static_param_.co_major_merge_type_ = static_cast<ObCOMajorMergePolicy::ObCOMajorMergeType>(medium_info->co_major_merge_type_);
@@ -795,6 +795,7 @@ int ObMediumCompactionScheduleFunc::init_parallel_range_and_schema_changed_and_c
     if (OB_FAIL(ret)) {
     } else if (expected_task_count <= 1) {
       medium_info.clear_parallel_range();
+      init_dirty_aware_parallel_range(result, medium_info);
     } else {
       ObTableStoreIterator table_iter;
       ObArrayArray<ObStoreRange> range_array;
@@ -858,6 +859,47 @@ int ObMediumCompactionScheduleFunc::init_parallel_range_and_schema_changed_and_c
   return ret;
 }
 
+// the dirty aware ranges depend on the incremental sstables of the leader, record them in medium info
+// so that every replica merges the same ranges. best effort, fall back to the uniform ranges on failure
+void ObMediumCompactionScheduleFunc::init_dirty_aware_parallel_range(
+    const ObGetMergeTablesResult &result,
+    ObMediumCompactionInfo &medium_info)
+{
+  int tmp_ret = OB_SUCCESS;
+  bool enable_dirty_aware = false;
+  ObTablet *tablet = tablet_handle_.get_obj();
+  if (result.handle_.get_count() > 1 && OB_NOT_NULL(tablet)) {
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+    if (tenant_config.is_valid()) {
+      enable_dirty_aware = tenant_config->_enable_dirty_aware_major_range_split;
+    }
+  }
+  if (enable_dirty_aware) {
+    ObSEArray<ObStoreRange, 16> store_ranges;
+    ObArrayArray<ObStoreRange> range_array;
+    lib::CompatModeGuard guard(tablet->get_tablet_meta().compat_mode_);
+    if (OB_TMP_FAIL(ObParallelMergeCtx::get_dirty_aware_major_ranges(result.handle_,
+        medium_info.storage_schema_.get_tablet_size(), tablet->get_rowkey_read_info(), allocator_, store_ranges))) {
+      LOG_WARN_RET(tmp_ret, "failed to get dirty aware major ranges", K(tmp_ret), K(result));
+    } else if (store_ranges.count() <= 1) {
+      // serial merge
+    } else if (OB_TMP_FAIL(range_array.push_back(store_ranges))) {
+      LOG_WARN_RET(tmp_ret, "failed to push back ranges", K(tmp_ret), K(store_ranges));
+    } else if (OB_TMP_FAIL(medium_info.gene_parallel_info(allocator_, range_array))) {
+      LOG_WARN_RET(tmp_ret, "failed to gene parallel info", K(tmp_ret), K(range_array));
+    } else if (ObTabletMediumCompactionInfoRecorder::cal_buf_len(tablet->get_tablet_meta().tablet_id_,
+        medium_info, nullptr/*log_header*/) >= common::OB_MAX_LOG_ALLOWED_SIZE) {
+      LOG_INFO("dirty aware ranges are too large for medium info, use uniform ranges", K(store_ranges.count()));
+      medium_info.clear_parallel_range();
+    } else {
+      LOG_TRACE("success to split dirty aware ranges", K(medium_info.parallel_merge_info_), K(store_ranges));
+    }
+    if (OB_SUCCESS != tmp_ret) {
+      medium_info.clear_parallel_range();
+    }
+  }
+}
+
 int ObMediumCompactionScheduleFunc::init_co_major_merge_type(
     const ObGetMergeTablesResult &result,
     ObMediumCompactionInfo &medium_info)
@@ -997,6 +1039,7 @@ int ObMediumCompactionScheduleFunc::prepare_medium_info(
   } else if (OB_FAIL(choose_encoding_limit(medium_info))) {
     STORAGE_LOG(WARN, "Failed to choose encoding rows limit", K(ret), K(medium_info));
   } else {
+    choose_encoding_hash_index(medium_info);
     medium_info.last_medium_snapshot_ = result.handle_.get_table(0)->get_snapshot_version();
     LOG_TRACE("success to prepare medium info", K(ret), K(medium_info));
   }
@@ -1019,6 +1062,19 @@ int ObMediumCompactionScheduleFunc::choose_encoding_limit(ObMediumCompactionInfo
   return ret;
 }
 
+// the hash index changes the layout of encoded micro blocks, decide it once on the leader and
+// record it in medium info, so that every replica writes the same major sstable
+void ObMediumCompactionScheduleFunc::choose_encoding_hash_index(ObMediumCompactionInfo &medium_info)
+{
+  medium_info.need_encoding_hash_index_ = false;
+  if (medium_info.data_version_ >= DATA_VERSION_4_3_4_0) {
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+    if (tenant_config.is_valid()) {
+      medium_info.need_encoding_hash_index_ = tenant_config->_enable_encoding_micro_block_hash_index;
+    }
+  }
+}
+
 int ObMediumCompactionScheduleFunc::get_table_id(
     ObMultiVersionSchemaService &schema_service,
     const ObTabletID &tablet_id,
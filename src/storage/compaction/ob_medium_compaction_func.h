@@ -136,9 +136,13 @@ protected:
     const int64_t schema_version,
     ObMediumCompactionInfo &medium_info);
   int choose_encoding_limit(ObMediumCompactionInfo &medium_info);
+  void choose_encoding_hash_index(ObMediumCompactionInfo &medium_info);
   int init_parallel_range_and_schema_changed_and_co_merge_type(
       const ObGetMergeTablesResult &result,
       ObMediumCompactionInfo &medium_info);
+  void init_dirty_aware_parallel_range(
+      const ObGetMergeTablesResult &result,
+      ObMediumCompactionInfo &medium_info);
   int check_if_schema_changed(ObMediumCompactionInfo &medium_info);
   int init_co_major_merge_type(
       const ObGetMergeTablesResult &result,
@@ -371,6 +371,7 @@ ObMediumCompactionInfo::ObMediumCompactionInfo()
     tenant_id_(0),
     co_major_merge_type_(ObCOMajorMergePolicy::INVALID_CO_MAJOR_MERGE_TYPE),
     is_skip_tenant_major_(false),
+    need_encoding_hash_index_(false),
     reserved_(0),
     cluster_id_(0),
     data_version_(0),
@@ -464,6 +465,7 @@ void ObMediumCompactionInfo::reset()
   medium_merge_reason_ = ObAdaptiveMergePolicy::NONE;
   is_schema_changed_ = false;
   co_major_merge_type_ = ObCOMajorMergePolicy::INVALID_CO_MAJOR_MERGE_TYPE;
+  need_encoding_hash_index_ = false;
   tenant_id_ = 0;
   cluster_id_ = 0;
   medium_snapshot_ = 0;
@@ -642,7 +644,8 @@ int64_t ObMediumCompactionInfo::to_string(char* buf, const int64_t buf_len) cons
       K_(medium_snapshot), K_(last_medium_snapshot), K_(tenant_id), K_(cluster_id),
       K_(medium_compat_version), K_(data_version), K_(is_schema_changed), K_(storage_schema),
       "co_major_merge_type", ObCOMajorMergePolicy::co_major_merge_type_to_str(static_cast<ObCOMajorMergePolicy::ObCOMajorMergeType>(co_major_merge_type_)),
-      K_(is_skip_tenant_major), K_(contain_parallel_range), K_(parallel_merge_info), K_(encoding_granularity));
+      K_(is_skip_tenant_major), K_(contain_parallel_range), K_(parallel_merge_info), K_(encoding_granularity),
+      K_(need_encoding_hash_index));
     J_OBJ_END();
   }
   return pos;
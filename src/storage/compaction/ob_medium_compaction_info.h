@@ -251,7 +251,7 @@ public:
   static const int64_t MEDIUM_COMPAT_VERSION_LATEST = MEDIUM_COMPAT_VERSION_V5;
 private:
   static const int32_t SCS_ONE_BIT = 1;
-  static const int32_t SCS_RESERVED_BITS = 27;
+  static const int32_t SCS_RESERVED_BITS = 26;
 
 public:
   union {
@@ -265,6 +265,7 @@ public:
       uint64_t tenant_id_                       : 16; // record tenant_id of ls primary_leader, just for throw medium
       uint64_t co_major_merge_type_             : 4;
       uint64_t is_skip_tenant_major_            : SCS_ONE_BIT;
+      uint64_t need_encoding_hash_index_        : SCS_ONE_BIT; // decided by ls leader, same for all replicas
       uint64_t reserved_                        : SCS_RESERVED_BITS;
     };
   };
@@ -241,6 +241,8 @@ int ObParallelMergeCtx::init_parallel_major_merge(compaction::ObBasicTabletMerge
     const int64_t tablet_size = merge_ctx.get_schema()->get_tablet_size();
     const ObSSTable *first_sstable = static_cast<const ObSSTable *>(first_table);
     const int64_t macro_block_cnt = first_sstable->get_data_macro_block_count();
+    // the incremental sstables differ between replicas, the ranges split by them are only
+    // decided by the ls leader and recorded in medium info, see get_dirty_aware_major_ranges
     if (OB_FAIL(get_concurrent_cnt(tablet_size, macro_block_cnt, concurrent_cnt_))) {
       STORAGE_LOG(WARN, "failed to get concurrent cnt", K(ret), K(tablet_size), K(concurrent_cnt_),
         KPC(first_sstable));
@@ -249,7 +251,7 @@ int ObParallelMergeCtx::init_parallel_major_merge(compaction::ObBasicTabletMerge
         STORAGE_LOG(WARN, "failed to init serial merge", K(ret), KPC(first_sstable));
       }
     } else if (OB_FAIL(get_major_parallel_ranges(
-        first_sstable, tablet_size, merge_ctx.get_tablet()->get_rowkey_read_info()))) {
+        first_sstable, nullptr/*inc_tables_handle*/, tablet_size, merge_ctx.get_tablet()->get_rowkey_read_info()))) {
       STORAGE_LOG(WARN, "Failed to get concurrent cnt from first sstable",
           K(ret), K(tablet_size), K_(concurrent_cnt));
       CTX_SET_DIAGNOSE_LOCATION(merge_ctx);
@@ -443,8 +445,78 @@ int ObParallelMergeCtx::get_concurrent_cnt(
   return ret;
 }
 
+int ObParallelMergeCtx::get_dirty_aware_major_ranges(
+    const ObTablesHandleArray &tables_handle,
+    const int64_t tablet_size,
+    const ObITableReadInfo &rowkey_read_info,
+    ObIAllocator &allocator,
+    ObIArray<ObStoreRange> &store_ranges)
+{
+  int ret = OB_SUCCESS;
+  const ObITable *first_table = tables_handle.get_table(0);
+  ObParallelMergeCtx paral_ctx(allocator);
+  store_ranges.reset();
+  if (OB_UNLIKELY(tables_handle.get_count() <= 1 || nullptr == first_table || !first_table->is_sstable())) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument to get dirty aware major ranges", K(ret), K(tables_handle));
+  } else {
+    const ObSSTable *first_sstable = static_cast<const ObSSTable *>(first_table);
+    if (OB_FAIL(get_concurrent_cnt(tablet_size, first_sstable->get_data_macro_block_count(),
+        paral_ctx.concurrent_cnt_))) {
+      STORAGE_LOG(WARN, "failed to get concurrent cnt", K(ret), K(tablet_size), KPC(first_sstable));
+    } else if (paral_ctx.concurrent_cnt_ <= 1) {
+      // serial merge
+    } else if (OB_FAIL(paral_ctx.get_major_parallel_ranges(first_sstable, &tables_handle, tablet_size,
+        rowkey_read_info))) {
+      STORAGE_LOG(WARN, "failed to get major parallel ranges", K(ret), K(tablet_size), KPC(first_sstable));
+    } else if (OB_FAIL(paral_ctx.get_schema_rowkey_store_ranges(rowkey_read_info.get_columns_desc(),
+        allocator, store_ranges))) {
+      STORAGE_LOG(WARN, "failed to get store ranges", K(ret), K(paral_ctx));
+    }
+  }
+  return ret;
+}
+
+// Medium info only records the schema rowkeys of the range ends, which are turned
+// back into multi-version ranges by init(medium_info).
+int ObParallelMergeCtx::get_schema_rowkey_store_ranges(
+    const ObIArray<ObColDesc> &col_descs,
+    ObIAllocator &allocator,
+    ObIArray<ObStoreRange> &store_ranges) const
+{
+  int ret = OB_SUCCESS;
+  ObStoreRange store_range;
+  store_range.set_start_key(ObStoreRowkey::MIN_STORE_ROWKEY);
+  store_range.set_left_open();
+  store_range.set_right_closed();
+  store_ranges.reset();
+  for (int64_t i = 0; OB_SUCC(ret) && i < range_array_.count(); ++i) {
+    const ObDatumRowkey &end_key = range_array_.at(i).get_end_key();
+    ObDatumRowkey schema_endkey;
+    if (i > 0) {
+      store_range.set_start_key(store_range.get_end_key());
+    }
+    if (end_key.is_max_rowkey()) {
+      store_range.set_end_key(ObStoreRowkey::MAX_STORE_ROWKEY);
+      store_range.set_right_open();
+    } else if (OB_UNLIKELY(end_key.datum_cnt_ <= 1)) {
+      ret = OB_ERR_UNEXPECTED;
+      STORAGE_LOG(WARN, "unexpected multi version end key", K(ret), K(i), K(end_key));
+    } else if (OB_FAIL(schema_endkey.assign(end_key.datums_, end_key.datum_cnt_ - 1))) {
+      STORAGE_LOG(WARN, "failed to assign schema end key", K(ret), K(end_key));
+    } else if (OB_FAIL(schema_endkey.to_store_rowkey(col_descs, allocator, store_range.get_end_key()))) {
+      STORAGE_LOG(WARN, "failed to transfer to store rowkey", K(ret), K(schema_endkey));
+    }
+    if (FAILEDx(store_ranges.push_back(store_range))) {
+      STORAGE_LOG(WARN, "failed to push back store range", K(ret), K(store_range));
+    }
+  }
+  return ret;
+}
+
 int ObParallelMergeCtx::get_major_parallel_ranges(
     const blocksstable::ObSSTable *first_major_sstable,
+    const ObTablesHandleArray *inc_tables_handle,
     const int64_t tablet_size,
     const ObITableReadInfo &rowkey_read_info)
 {
@@ -458,7 +530,7 @@ int ObParallelMergeCtx::get_major_parallel_ranges(
     STORAGE_LOG(WARN, "concurrent cnt is invalid", K(ret), K_(concurrent_cnt));
   } else {
     const int64_t macro_block_cnt = first_major_sstable->get_data_macro_block_count();
-    const int64_t macro_block_cnt_per_range = (macro_block_cnt + concurrent_cnt_ - 1) / concurrent_cnt_;
+    ObSEArray<int64_t, MAX_MERGE_THREAD> range_last_idxs;
 
     ObSSTableMetaHandle sstable_meta_handle;
     ObDatumRowkeyHelper rowkey_helper;
@@ -484,11 +556,20 @@ int ObParallelMergeCtx::get_major_parallel_ranges(
       STORAGE_LOG(WARN, "Failed to ", K(ret), K(schema_rowkey_cnt));
     } else if (OB_FAIL(multi_version_endkey.assign(rowkey_helper.get_datums(), schema_rowkey_cnt + 1))) {
       STORAGE_LOG(WARN, "Failed to assign datums", K(ret), K(schema_rowkey_cnt));
+    } else if (nullptr == inc_tables_handle) {
+      if (OB_FAIL(get_uniform_range_last_idxs(macro_block_cnt, range_last_idxs))) {
+        STORAGE_LOG(WARN, "Failed to get uniform range last idxs", K(ret), K(macro_block_cnt));
+      }
+    } else if (OB_FAIL(get_dirty_aware_range_last_idxs(*first_major_sstable, *inc_tables_handle,
+        rowkey_read_info, schema_rowkey_cnt, range_last_idxs))) {
+      STORAGE_LOG(WARN, "Failed to get dirty aware range last idxs", K(ret), K(macro_block_cnt));
+    } else {
+      // the heavy ranges may be less than the expected concurrent cnt
+      concurrent_cnt_ = range_last_idxs.count();
     }
     // generate ranges
-    for (int64_t i = 0; OB_SUCC(ret) && i < macro_block_cnt;) {
-      int64_t last = i + macro_block_cnt_per_range - 1;
-      last = (last < macro_block_cnt ? last : macro_block_cnt - 1);
+    for (int64_t i = 0, range_idx = 0; OB_SUCC(ret) && i < macro_block_cnt; ++range_idx) {
+      const int64_t last = range_last_idxs.at(range_idx);
       // locate to the last macro-block meta in current range
       while (OB_SUCC(meta_iter->get_next(blk_meta)) && i++ < last);
       if (OB_FAIL(ret)) {
@@ -539,6 +620,231 @@ int ObParallelMergeCtx::get_major_parallel_ranges(
   return ret;
 }
 
+int ObParallelMergeCtx::get_uniform_range_last_idxs(
+    const int64_t macro_block_cnt,
+    ObIArray<int64_t> &range_last_idxs)
+{
+  int ret = OB_SUCCESS;
+  const int64_t macro_block_cnt_per_range = (macro_block_cnt + concurrent_cnt_ - 1) / concurrent_cnt_;
+  range_last_idxs.reset();
+  for (int64_t i = 0; OB_SUCC(ret) && i < macro_block_cnt; i += macro_block_cnt_per_range) {
+    const int64_t last = MIN(i + macro_block_cnt_per_range - 1, macro_block_cnt - 1);
+    if (OB_FAIL(range_last_idxs.push_back(last))) {
+      STORAGE_LOG(WARN, "Failed to push back range last idx", K(ret), K(last));
+    }
+  }
+  return ret;
+}
+
+// The incremental sstables only hold the data modified since the last major. An
+// incremental macro block covers the keys after the end key of the previous one
+// in the same sstable up to its own end key, and each base macro block is weighted
+// by the incremental macro blocks overlapping it. The ranges are split by weight:
+// the dirty key ranges are spread to more tasks, while the clean base macro blocks
+// are gathered into a few ranges, whose clean macro blocks are reused without
+// iterating any row.
+int ObParallelMergeCtx::get_dirty_aware_range_last_idxs(
+    const ObSSTable &first_major_sstable,
+    const ObTablesHandleArray &inc_tables_handle,
+    const ObITableReadInfo &rowkey_read_info,
+    const int64_t schema_rowkey_cnt,
+    ObIArray<int64_t> &range_last_idxs)
+{
+  int ret = OB_SUCCESS;
+  ObArenaAllocator tmp_allocator("ParalDirtyRg", OB_MALLOC_NORMAL_BLOCK_SIZE, MTL_ID());
+  ObArray<ObDatumRowkey> inc_endkeys;
+  ObSEArray<int64_t, 16> cursors; // the first macro block of each incremental sstable not before the base macro block
+  ObSEArray<int64_t, 16> counted_idxs; // the end of the counted macro blocks of each incremental sstable
+  ObSEArray<int64_t, 16> end_idxs; // the end of the end keys of each incremental sstable
+  ObArray<int64_t> macro_weights;
+  const ObStorageDatumUtils &datum_utils = rowkey_read_info.get_datum_utils();
+  ObDataMacroBlockMeta blk_meta;
+  ObDatumRowkey macro_endkey;
+  ObDatumRowkey schema_endkey;
+  ObDatumRowkey inc_endkey;
+  ObDatumRange query_range;
+  query_range.set_whole_range();
+  inc_endkeys.set_attr(ObMemAttr(MTL_ID(), "ParalDirtyRg"));
+  macro_weights.set_attr(ObMemAttr(MTL_ID(), "ParalDirtyRg"));
+  range_last_idxs.reset();
+
+  // the first table is the base major sstable
+  for (int64_t i = 1; OB_SUCC(ret) && i < inc_tables_handle.get_count(); ++i) {
+    const ObITable *table = inc_tables_handle.get_table(i);
+    const int64_t start_idx = inc_endkeys.count();
+    ObSSTableSecMetaIterator *meta_iter = nullptr;
+    if (OB_ISNULL(table) || !table->is_sstable() || static_cast<const ObSSTable *>(table)->is_empty()) {
+    } else if (OB_FAIL(static_cast<const ObSSTable *>(table)->scan_secondary_meta(tmp_allocator,
+        query_range, rowkey_read_info, DATA_BLOCK_META, meta_iter))) {
+      STORAGE_LOG(WARN, "Failed to scan secondary meta", K(ret), KPC(table));
+    } else {
+      while (OB_SUCC(ret) && OB_SUCC(meta_iter->get_next(blk_meta))) {
+        if (OB_FAIL(blk_meta.get_rowkey(macro_endkey))) {
+          STORAGE_LOG(WARN, "Failed to get rowkey", K(ret), K(blk_meta));
+        } else if (OB_FAIL(schema_endkey.assign(const_cast<ObStorageDatum *>(macro_endkey.datums_),
+            MIN(macro_endkey.datum_cnt_, schema_rowkey_cnt)))) {
+          STORAGE_LOG(WARN, "Failed to assign schema endkey", K(ret), K(macro_endkey));
+        } else if (OB_FAIL(schema_endkey.deep_copy(inc_endkey, tmp_allocator))) {
+          STORAGE_LOG(WARN, "Failed to deep copy endkey", K(ret), K(schema_endkey));
+        } else if (OB_FAIL(inc_endkeys.push_back(inc_endkey))) {
+          STORAGE_LOG(WARN, "Failed to push back endkey", K(ret), K(inc_endkey));
+        }
+      }
+      if (OB_ITER_END == ret) {
+        ret = OB_SUCCESS;
+      }
+      if (FAILEDx(cursors.push_back(start_idx))) {
+        STORAGE_LOG(WARN, "Failed to push back cursor", K(ret), K(start_idx));
+      } else if (OB_FAIL(counted_idxs.push_back(start_idx))) {
+        STORAGE_LOG(WARN, "Failed to push back counted idx", K(ret), K(start_idx));
+      } else if (OB_FAIL(end_idxs.push_back(inc_endkeys.count()))) {
+        STORAGE_LOG(WARN, "Failed to push back end idx", K(ret), K(inc_endkeys.count()));
+      }
+    }
+    if (OB_NOT_NULL(meta_iter)) {
+      meta_iter->~ObSSTableSecMetaIterator();
+      tmp_allocator.free(meta_iter);
+    }
+  }
+
+  if (OB_FAIL(ret)) {
+  } else if (inc_endkeys.empty()) {
+    if (OB_FAIL(get_uniform_range_last_idxs(first_major_sstable.get_data_macro_block_count(), range_last_idxs))) {
+      STORAGE_LOG(WARN, "Failed to get uniform range last idxs", K(ret), K(first_major_sstable));
+    }
+  } else {
+    ObSSTableSecMetaIterator *meta_iter = nullptr;
+    if (OB_FAIL(first_major_sstable.scan_secondary_meta(tmp_allocator, query_range,
+        rowkey_read_info, DATA_BLOCK_META, meta_iter))) {
+      STORAGE_LOG(WARN, "Failed to scan secondary meta", K(ret), K(first_major_sstable));
+    } else {
+      while (OB_SUCC(ret) && OB_SUCC(meta_iter->get_next(blk_meta))) {
+        int64_t inc_macro_cnt = 0;
+        if (OB_FAIL(blk_meta.get_rowkey(macro_endkey))) {
+          STORAGE_LOG(WARN, "Failed to get rowkey", K(ret), K(blk_meta));
+        } else if (OB_FAIL(count_overlapped_inc_macros(macro_endkey, inc_endkeys, end_idxs,
+            datum_utils, cursors, counted_idxs, inc_macro_cnt))) {
+          STORAGE_LOG(WARN, "Failed to count overlapped inc macros", K(ret), K(macro_endkey));
+        } else if (OB_FAIL(macro_weights.push_back(inc_macro_cnt))) {
+          STORAGE_LOG(WARN, "Failed to push back macro weight", K(ret), K(inc_macro_cnt));
+        }
+      }
+      if (OB_ITER_END == ret) {
+        ret = OB_SUCCESS;
+      }
+    }
+    if (OB_NOT_NULL(meta_iter)) {
+      meta_iter->~ObSSTableSecMetaIterator();
+      tmp_allocator.free(meta_iter);
+    }
+
+    if (OB_FAIL(ret)) {
+    } else if (OB_UNLIKELY(macro_weights.empty()
+        || macro_weights.count() != first_major_sstable.get_data_macro_block_count())) {
+      ret = OB_ERR_UNEXPECTED;
+      STORAGE_LOG(WARN, "unexpected base macro block count", K(ret), K(macro_weights.count()), K(first_major_sstable));
+    } else {
+      // the macro blocks beyond the base sstable belong to the last range
+      int64_t &last_weight = macro_weights.at(macro_weights.count() - 1);
+      for (int64_t j = 0; j < counted_idxs.count(); ++j) {
+        last_weight += end_idxs.at(j) - counted_idxs.at(j);
+      }
+      if (OB_FAIL(get_weighted_range_last_idxs(macro_weights, range_last_idxs))) {
+        STORAGE_LOG(WARN, "Failed to get weighted range last idxs", K(ret));
+      } else {
+        STORAGE_LOG(INFO, "split major ranges by dirty macro blocks", K(ret),
+            "base_macro_cnt", macro_weights.count(), "inc_macro_cnt", inc_endkeys.count(),
+            K_(concurrent_cnt), "range_cnt", range_last_idxs.count());
+      }
+    }
+  }
+  return ret;
+}
+
+// The incremental macro block k of an sstable covers (endkey[k-1], endkey[k]].
+// cursors[j] is the first macro block of sstable j ending after the previous base
+// macro block, so it starts before base_endkey and overlaps the base macro block,
+// and so do the following ones until one ends at or after base_endkey.
+int ObParallelMergeCtx::count_overlapped_inc_macros(
+    const ObDatumRowkey &base_endkey,
+    const ObIArray<ObDatumRowkey> &inc_endkeys,
+    const ObIArray<int64_t> &end_idxs,
+    const ObStorageDatumUtils &datum_utils,
+    ObIArray<int64_t> &cursors,
+    ObIArray<int64_t> &counted_idxs,
+    int64_t &inc_macro_cnt)
+{
+  int ret = OB_SUCCESS;
+  inc_macro_cnt = 0;
+  if (OB_UNLIKELY(cursors.count() != end_idxs.count() || counted_idxs.count() != end_idxs.count())) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), K(cursors), K(counted_idxs), K(end_idxs));
+  }
+  for (int64_t j = 0; OB_SUCC(ret) && j < end_idxs.count(); ++j) {
+    int64_t &cursor = cursors.at(j);
+    bool reach_base_end = false;
+    while (OB_SUCC(ret) && !reach_base_end && cursor < end_idxs.at(j)) {
+      int cmp_ret = 0;
+      if (OB_FAIL(inc_endkeys.at(cursor).compare(base_endkey, datum_utils, cmp_ret,
+          false/*compare_datum_cnt*/))) {
+        STORAGE_LOG(WARN, "Failed to compare endkey", K(ret), K(base_endkey));
+      } else {
+        ++inc_macro_cnt;
+        counted_idxs.at(j) = cursor + 1;
+        if (cmp_ret > 0) {
+          // overlaps the next base macro block too
+          reach_base_end = true;
+        } else {
+          reach_base_end = (0 == cmp_ret);
+          ++cursor;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+// A base macro block overlapped by incremental macro blocks is rewritten, which
+// costs much more than reusing a clean one.
+int ObParallelMergeCtx::get_weighted_range_last_idxs(
+    ObIArray<int64_t> &macro_weights,
+    ObIArray<int64_t> &range_last_idxs)
+{
+  int ret = OB_SUCCESS;
+  int64_t dirty_macro_cnt = 0;
+  int64_t total_weight = 0;
+  range_last_idxs.reset();
+  if (OB_UNLIKELY(macro_weights.empty() || concurrent_cnt_ <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), K(macro_weights.count()), K_(concurrent_cnt));
+  } else {
+    for (int64_t i = 0; i < macro_weights.count(); ++i) {
+      int64_t &weight = macro_weights.at(i);
+      if (weight > 0) {
+        weight = (weight + 1) * REWRITE_MACRO_BLOCK_WEIGHT;
+        ++dirty_macro_cnt;
+      } else {
+        weight = 1;
+      }
+      total_weight += weight;
+    }
+    const int64_t range_weight = (total_weight + concurrent_cnt_ - 1) / concurrent_cnt_;
+    int64_t cur_weight = 0;
+    for (int64_t i = 0; OB_SUCC(ret) && i < macro_weights.count(); ++i) {
+      cur_weight += macro_weights.at(i);
+      if (cur_weight < range_weight && i < macro_weights.count() - 1) {
+      } else if (OB_FAIL(range_last_idxs.push_back(i))) {
+        STORAGE_LOG(WARN, "Failed to push back range last idx", K(ret), K(i));
+      } else {
+        cur_weight = 0;
+      }
+    }
+    STORAGE_LOG(DEBUG, "get weighted range last idxs", K(ret), K(dirty_macro_cnt), K(total_weight),
+        K_(concurrent_cnt), K(range_last_idxs));
+  }
+  return ret;
+}
+
 int64_t ObParallelMergeCtx::to_string(char* buf, const int64_t buf_len) const
 {
   int64_t pos = 0;
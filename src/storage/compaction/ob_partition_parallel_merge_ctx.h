@@ -34,6 +34,7 @@ class ObSSTable;
 
 namespace storage
 {
+class ObTablesHandleArray;
 
 class ObParallelMergeCtx
 {
@@ -58,11 +59,21 @@ public:
       const int64_t tablet_size,
       const int64_t macro_block_cnt,
       int64_t &concurrent_cnt);
+  // split the major ranges by the incremental sstables in %tables_handle, only called by
+  // the ls leader, the ranges are recorded in medium info and merged by all replicas
+  static int get_dirty_aware_major_ranges(
+      const ObTablesHandleArray &tables_handle,
+      const int64_t tablet_size,
+      const ObITableReadInfo &rowkey_read_info,
+      common::ObIAllocator &allocator,
+      common::ObIArray<common::ObStoreRange> &store_ranges);
   DECLARE_TO_STRING;
 private:
   static const int64_t MIN_PARALLEL_MINOR_MERGE_THREASHOLD = 2;
   static const int64_t MIN_PARALLEL_MERGE_BLOCKS = 32;
   static const int64_t PARALLEL_MERGE_TARGET_TASK_CNT = 20;
+  // rewriting a base macro block costs much more than reusing it
+  static const int64_t REWRITE_MACRO_BLOCK_WEIGHT = 16;
 
   //TODO @hanhui parallel in ai
   int init_serial_merge();
@@ -77,8 +88,33 @@ private:
 
   int get_major_parallel_ranges(
       const blocksstable::ObSSTable *first_major_sstable,
+      const ObTablesHandleArray *inc_tables_handle,
       const int64_t tablet_size,
       const ObITableReadInfo &rowkey_read_info);
+  int get_uniform_range_last_idxs(
+      const int64_t macro_block_cnt,
+      common::ObIArray<int64_t> &range_last_idxs);
+  int get_dirty_aware_range_last_idxs(
+      const blocksstable::ObSSTable &first_major_sstable,
+      const ObTablesHandleArray &inc_tables_handle,
+      const ObITableReadInfo &rowkey_read_info,
+      const int64_t schema_rowkey_cnt,
+      common::ObIArray<int64_t> &range_last_idxs);
+  static int count_overlapped_inc_macros(
+      const blocksstable::ObDatumRowkey &base_endkey,
+      const common::ObIArray<blocksstable::ObDatumRowkey> &inc_endkeys,
+      const common::ObIArray<int64_t> &end_idxs,
+      const blocksstable::ObStorageDatumUtils &datum_utils,
+      common::ObIArray<int64_t> &cursors,
+      common::ObIArray<int64_t> &counted_idxs,
+      int64_t &inc_macro_cnt);
+  int get_weighted_range_last_idxs(
+      common::ObIArray<int64_t> &macro_weights,
+      common::ObIArray<int64_t> &range_last_idxs);
+  int get_schema_rowkey_store_ranges(
+      const common::ObIArray<share::schema::ObColDesc> &col_descs,
+      common::ObIAllocator &allocator,
+      common::ObIArray<common::ObStoreRange> &store_ranges) const;
 private:
   common::ObIAllocator &allocator_;
   common::ObSEArray<blocksstable::ObDatumRange, 16, common::ObIAllocator&> range_array_;
@@ -116,6 +116,10 @@ int ObPartitionMergeLoserTreeCmp::compare_rowkey(const ObDatumRow &l_row,
                          r_row.get_column_count() < rowkey_size_)) {
     ret = OB_ERR_UNEXPECTED;
     STORAGE_LOG(WARN, "Unexpected row column cnt", K(ret), K(l_row), K(r_row), K_(rowkey_size));
+  } else if (rowkey_size_ > 0
+             && datum_utils_.compare_norm_key(l_row.storage_datums_[0], r_row.storage_datums_[0], temp_cmp_ret)) {
+    // decided by the normalized keys of the first rowkey column
+    cmp_result = temp_cmp_ret;
   } else {
     ObDatumRowkey l_key;
     ObDatumRowkey r_key;
@@ -537,6 +537,69 @@ void WriteHandle<BtreeKey, BtreeVal>::retire(const int btree_err)
   }
 }
 
+template<typename BtreeKey, typename BtreeVal>
+int WriteHandle<BtreeKey, BtreeVal>::find_path_with_hint(BtreeNode *root, BtreeKey key)
+{
+  int ret = OB_SUCCESS;
+  int cmp = -1;
+  int pos = -1;
+  bool is_found = false;
+  BtreeNode *node = nullptr;
+  MultibitSet *index = &this->index_;
+  if (!hint_path_.is_empty()
+      && OB_SUCC(hint_path_.get(0, node, pos)) && node == root
+      && OB_SUCC(this->get_comp().compare(key, hint_last_key_, cmp)) && cmp > 0
+      && (!has_hint_upper_key_
+          || (OB_SUCC(this->get_comp().compare(key, hint_upper_key_, cmp)) && cmp < 0))) {
+    // the key is in the range of the last leaf, only search in the leaf.
+    path_ = hint_path_;
+    index->reset();
+    if (OB_FAIL(path_.pop(node, pos))) {
+      // do nothing
+    } else if (OB_FAIL(node->find_pos(this->get_comp(), key, is_found, pos, index))) {
+      // do nothing
+    } else if (OB_FAIL(path_.push(node, pos))) {
+      // do nothing
+    } else {
+      path_.set_is_found(is_found);
+    }
+  } else if (OB_FAIL(find_path(root, key))) {
+    // do nothing
+  } else {
+    // the leaf covers keys up to the first right sibling key of the lowest level
+    hint_path_ = path_;
+    has_hint_upper_key_ = false;
+    for (int64_t level = path_.get_root_level() - 2; !has_hint_upper_key_ && level >= 0; level--) {
+      if (OB_SUCC(path_.get(level, node, pos)) && std::max(pos, 0) + 1 < node->size()) {
+        hint_upper_key_ = node->get_key(std::max(pos, 0) + 1);
+        has_hint_upper_key_ = true;
+      }
+    }
+    ret = OB_SUCCESS;
+  }
+  return ret;
+}
+
+template<typename BtreeKey, typename BtreeVal>
+void WriteHandle<BtreeKey, BtreeVal>::finish_batch_insert(const BtreeKey key, const int btree_err)
+{
+  if (OB_SUCCESS != btree_err) {
+    free_list();
+    reset_hint();
+  } else {
+    // the leaf is replaced if any node is copied, search from root next time
+    if (retire_list_.size() > 0) {
+      reset_hint();
+    } else {
+      hint_last_key_ = key;
+    }
+    retire_list_.move_to(batch_retire_list_);
+    while (OB_NOT_NULL(alloc_list_.pop()));
+  }
+  // the path can only be reused by retrying the same key in find_path()
+  path_.reset();
+}
+
 template<typename BtreeKey, typename BtreeVal>
 int WriteHandle<BtreeKey, BtreeVal>::insert_and_split_upward(BtreeKey key, BtreeVal &val, BtreeNode *&new_root)
 {
@@ -1520,6 +1583,58 @@ int ObKeyBtree<BtreeKey, BtreeVal>::insert(const BtreeKey key, BtreeVal &value)
   return ret;
 }
 
+template<typename BtreeKey, typename BtreeVal>
+int ObKeyBtree<BtreeKey, BtreeVal>::begin_batch_insert(WriteHandle &handle)
+{
+  int ret = OB_SUCCESS;
+  handle.get_is_in_delete() = false;
+  handle.reset_hint();
+  if (OB_FAIL(handle.acquire_ref())) {
+    OB_LOG(ERROR, "acquire_ref fail", K(ret));
+  }
+  return ret;
+}
+
+template<typename BtreeKey, typename BtreeVal>
+int ObKeyBtree<BtreeKey, BtreeVal>::insert(const BtreeKey key, BtreeVal &value, WriteHandle &handle)
+{
+  int ret = OB_EAGAIN;
+  BtreeNode *old_root = nullptr;
+  BtreeNode *new_root = nullptr;
+  BTREE_ASSERT(((uint64_t)value & 7ULL) == 0);
+  while (OB_EAGAIN == ret) {
+    if (OB_FAIL(handle.find_path_with_hint(old_root = ATOMIC_LOAD(&root_), key))) {
+      OB_LOG(ERROR, "path.search error", K(root_), K(ret));
+    } else if (OB_FAIL(handle.insert_and_split_upward(key, value, new_root = old_root))) {
+      // do nothing
+    } else if (old_root != new_root) {
+      if (!ATOMIC_BCAS(&root_, old_root, new_root)) {
+        ret = OB_EAGAIN;
+      }
+    }
+    if (OB_EAGAIN == ret) {
+      handle.free_list();
+      handle.reset_hint();
+    }
+  }
+  handle.finish_batch_insert(key, ret);
+  if (OB_SUCC(ret)) {
+    size_.inc(1);
+  } else if (OB_ALLOCATE_MEMORY_FAILED == ret) {
+    OB_LOG(WARN, "btree.set(key) error", KR(ret), K(key), K(value));
+  } else {
+    OB_LOG(ERROR, "btree.set(key) error", KR(ret), K(key), K(value));
+  }
+  return ret;
+}
+
+template<typename BtreeKey, typename BtreeVal>
+void ObKeyBtree<BtreeKey, BtreeVal>::end_batch_insert(WriteHandle &handle)
+{
+  handle.release_ref();
+  handle.retire_batch();
+}
+
 template<typename BtreeKey, typename BtreeVal>
 int ObKeyBtree<BtreeKey, BtreeVal>::get(const BtreeKey key, BtreeVal &value)
 {
@@ -257,11 +257,12 @@ private:
   typedef Iterator<BtreeKey, BtreeVal> Iterator;
   typedef BtreeNodeAllocator<BtreeKey, BtreeVal> BtreeNodeAllocator;
   typedef BtreeNode<BtreeKey, BtreeVal> BtreeNode;
-  typedef WriteHandle<BtreeKey, BtreeVal> WriteHandle;
   typedef ScanHandle<BtreeKey, BtreeVal> ScanHandle;
   typedef GetHandle<BtreeKey, BtreeVal> GetHandle;
 
 public:
+  typedef WriteHandle<BtreeKey, BtreeVal> WriteHandle;
+
   ObKeyBtree(BtreeNodeAllocator &node_allocator)
     : split_info_(0),
       size_(),
@@ -277,6 +278,13 @@ public:
   // ===================== Ob Btree Operator  =====================
   int insert(const BtreeKey key, BtreeVal &value);
   int get(const BtreeKey key, BtreeVal &value);
+  // Batch insert: keys are inserted in ascending order through the same
+  // handle between begin_batch_insert() and end_batch_insert(). A key falling
+  // into the leaf of the previous key skips the search from root, so sorted
+  // rows(e.g. appending to the tail of the tree) share one descent per leaf.
+  int begin_batch_insert(WriteHandle &handle);
+  int insert(const BtreeKey key, BtreeVal &value, WriteHandle &handle);
+  void end_batch_insert(WriteHandle &handle);
   int set_key_range(BtreeIterator &iter, const BtreeKey min_key, const bool start_exclude,
                     const BtreeKey max_key, const bool end_exclude) const;
   int set_key_range(BtreeRawIterator &handle, const BtreeKey min_key, const bool start_exclude,
@@ -494,8 +494,19 @@ private:
   // free(not need to retire them because of no visible pointer) them under
   // failure
   HazardList alloc_list_;
+  // For batch insert(keys in ascending order through one handle), path of the
+  // last inserted key and the key range of its leaf. The next key falling into
+  // the range reuses the path instead of searching from root, the leaf is
+  // validated by try_wrlock and the index snapshot as usual.
+  Path hint_path_;
+  BtreeKey hint_last_key_;
+  BtreeKey hint_upper_key_;
+  bool has_hint_upper_key_;
+  // old nodes of the whole batch, retired after leaving the critical section
+  HazardList batch_retire_list_;
 public:
-  explicit WriteHandle(ObKeyBtree &tree): BaseHandle(tree.get_qclock()), base_(tree) {}
+  explicit WriteHandle(ObKeyBtree &tree)
+    : BaseHandle(tree.get_qclock()), base_(tree), has_hint_upper_key_(false) {}
   ~WriteHandle() {}
   OB_INLINE bool &get_is_in_delete()
   {
@@ -555,6 +566,16 @@ public:
     }
     return ret;
   }
+  int find_path_with_hint(BtreeNode *root, BtreeKey key);
+  void reset_hint()
+  {
+    hint_path_.reset();
+    has_hint_upper_key_ = false;
+  }
+  // called after each key of the batch is inserted
+  void finish_batch_insert(const BtreeKey key, const int btree_err);
+  // retire the nodes of the whole batch, must be called out of the critical section
+  void retire_batch() { base_.retire(batch_retire_list_); }
 public:
   int insert_and_split_upward(BtreeKey key, BtreeVal &val, BtreeNode *&new_root);
 private:
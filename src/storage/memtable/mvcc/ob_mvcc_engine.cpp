@@ -429,6 +429,44 @@ int ObMvccEngine::ensure_kv(const ObMemtableKey *stored_key,
   return ret;
 }
 
+int ObMvccEngine::ensure_kvs(const ObIArray<const ObMemtableKey *> &stored_keys,
+                             ObMvccRowAndWriteResults &results)
+{
+  int ret = OB_SUCCESS;
+
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    TRANS_LOG(WARN, "mvcc_engine not init", K(this));
+  } else if (OB_UNLIKELY(stored_keys.count() != results.count())) {
+    ret = OB_INVALID_ARGUMENT;
+    TRANS_LOG(WARN, "invalid argument", K(ret), K(stored_keys.count()), K(results.count()));
+  } else {
+    ObQueryEngine::EnsureBatchHandle handle(*query_engine_);
+    for (int64_t i = 0; OB_SUCC(ret) && i < results.count(); i++) {
+      ObMvccRow *value = results[i].mvcc_row_;
+      if (OB_ISNULL(value)) {
+        ret = OB_ERR_UNEXPECTED;
+        TRANS_LOG(WARN, "mvcc row is null", K(ret), K(i));
+      } else if (value->is_btree_indexed()) {
+        // do nothing
+      } else if (value->latch_.try_lock()) {
+        if (OB_FAIL(query_engine_->ensure(stored_keys.at(i), value, handle))) {
+          TRANS_LOG(WARN, "ensure_row fail", K(ret), K(i));
+        }
+        value->latch_.unlock();
+      } else {
+        // The latch holder may be waiting for the critical section of the batch
+        // to retire btree nodes, so we leave the batch before waiting for it.
+        handle.end();
+        if (OB_FAIL(ensure_kv(stored_keys.at(i), value))) {
+          TRANS_LOG(WARN, "ensure_row fail", K(ret), K(i));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
 void ObMvccEngine::mvcc_undo(ObMvccRow *value)
 {
   value->mvcc_undo();
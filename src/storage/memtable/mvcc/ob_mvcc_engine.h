@@ -93,6 +93,10 @@ public:
   // row.
   int ensure_kv(const ObMemtableKey *stored_key,
                 ObMvccRow *value);
+  // ensure_kv for rows sorted by rowkey, %stored_keys[i] is the key of
+  // %results[i]. Rows are inserted into the b-tree in one batch.
+  int ensure_kvs(const common::ObIArray<const ObMemtableKey *> &stored_keys,
+                 ObMvccRowAndWriteResults &results);
 
   // finish_kv is used to make tx_node visible to outer read
   void finish_kv(ObMvccWriteResult& res);
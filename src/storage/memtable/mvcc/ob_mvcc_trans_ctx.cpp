@@ -788,6 +788,7 @@ int ObTransCallbackMgr::get_log_guard(const transaction::ObTxSEQ &write_seq,
     int64_t min_epoch = 0;
     int min_epoch_idx =-1;
     bool pending_too_large = false;
+    bool need_help_min_epoch = false;
     common::ObByteLock *log_lock = NULL;
     if (my_epoch == INT64_MAX) {
       ret = OB_ENTRY_NOT_EXIST;
@@ -795,9 +796,8 @@ int ObTransCallbackMgr::get_log_guard(const transaction::ObTxSEQ &write_seq,
       ret = OB_BLOCK_FROZEN;
     } else if (OB_ISNULL(log_lock = list->try_lock_log())) {
       ret = OB_NEED_RETRY;
-      // if current list pending size too large, try to submit the min_epoch list
     } else if (FALSE_IT(pending_too_large = list->pending_log_too_large(GCONF._private_buffer_size * 10))) {
-    } else if (!check_list_has_min_epoch_(list_idx, my_epoch, pending_too_large, min_epoch, min_epoch_idx)) {
+    } else if (!check_list_has_min_epoch_(list_idx, my_epoch, true, min_epoch, min_epoch_idx)) {
       ret = OB_EAGAIN;
       storage::ObIMemtable *to_log_memtable = list->get_log_cursor()->get_memtable();
       if (TC_REACH_TIME_INTERVAL(1_s)) {
@@ -811,9 +811,18 @@ int ObTransCallbackMgr::get_log_guard(const transaction::ObTxSEQ &write_seq,
     if (OB_FAIL(ret) && log_lock) {
       log_lock->unlock();
     }
-    if (OB_EAGAIN == ret && OB_UNLIKELY(pending_too_large)) {
+    // the list with min_epoch blocks others, if it has enough pending redo, help to
+    // flush it, thus the lists are serialized by writers in parallel instead of
+    // being left to the single thread which submits all redo at commit time
+    if (OB_EAGAIN == ret) {
       ObTxCallbackList *min_epoch_list = get_callback_list_(min_epoch_idx, false);
-      if (OB_ISNULL(log_lock = min_epoch_list->try_lock_log())) {
+      // if current list pending size too large, try to submit the min_epoch list
+      // even if the min_epoch list has a little pending
+      need_help_min_epoch = pending_too_large
+        || min_epoch_list->pending_log_too_large(GCONF._private_buffer_size);
+      if (!need_help_min_epoch) {
+        // leave it to the writer of the min_epoch list
+      } else if (OB_ISNULL(log_lock = min_epoch_list->try_lock_log())) {
         // lock conflict, acquired by others
       } else {
         if (REACH_TIME_INTERVAL(1_s)) {
@@ -118,6 +118,11 @@ int ObQueryEngine::dump_keyhash(FILE *fd) const
   } else if (OB_ISNULL(fd)) {
     ret = OB_INVALID_ARGUMENT;
     TRANS_LOG(WARN, "invalid param", KP(fd));
+  } else if (use_tag_hash_) {
+    tag_keyhash_.dump_hash(fd,
+                           print_bucket_node,
+                           print_row_value,
+                           print_row_value_verbose);
   } else {
     keyhash_.dump_hash(fd,
                        print_bucket_node,
@@ -136,13 +141,13 @@ int ObQueryEngine::dump_keybtree(FILE* fd)
 
 int64_t ObQueryEngine::hash_size() const
 {
-  int64_t arr_size = keyhash_.get_arr_size();
+  int64_t arr_size = use_tag_hash_ ? tag_keyhash_.get_arr_size() : keyhash_.get_arr_size();
   return arr_size;
 }
 
 int64_t ObQueryEngine::hash_alloc_memory() const
 {
-  int64_t alloc_mem = keyhash_.get_alloc_memory();
+  int64_t alloc_mem = use_tag_hash_ ? tag_keyhash_.get_alloc_memory() : keyhash_.get_alloc_memory();
   return alloc_mem;
 }
 
@@ -159,7 +164,7 @@ int64_t ObQueryEngine::btree_alloc_memory() const
   return alloc_mem;
 }
 
-int ObQueryEngine::init()
+int ObQueryEngine::init(const bool use_tag_hash)
 {
   int ret = OB_SUCCESS;
   if (OB_UNLIKELY(is_inited_)) {
@@ -168,6 +173,7 @@ int ObQueryEngine::init()
   } else if (OB_FAIL(keybtree_.init())) {
     TRANS_LOG(WARN, "keybtree init fail", KR(ret));
   } else {
+    use_tag_hash_ = use_tag_hash;
     is_inited_ = true;
   }
   if (OB_FAIL(ret)) {
@@ -181,12 +187,15 @@ void ObQueryEngine::destroy()
   keybtree_.destroy(true /*is_batch_destroy*/);
   btree_allocator_.reset();
   keyhash_.destroy();
+  tag_keyhash_.destroy();
+  use_tag_hash_ = false;
   is_inited_ = false;
 }
 
 void ObQueryEngine::pre_batch_destroy_keybtree()
 {
   (void)keybtree_.pre_batch_destroy();
+  tag_keyhash_.pre_batch_destroy();
 }
 
 // The hashmap is thread safe and only one of concurrency inserts will succeed.
@@ -204,7 +213,12 @@ int ObQueryEngine::set(const ObMemtableKey *key, ObMvccRow *value)
               KR(ret), KP(key), KP(value));
   } else {
     ObStoreRowkeyWrapper key_wrapper(key->get_rowkey());
-    if (OB_FAIL(keyhash_.insert(&key_wrapper, value))) {
+    if (use_tag_hash_) {
+      ret = tag_keyhash_.insert(&key_wrapper, value);
+    } else {
+      ret = keyhash_.insert(&key_wrapper, value);
+    }
+    if (OB_FAIL(ret)) {
       if (OB_ENTRY_EXIST != ret) {
         TRANS_LOG(WARN, "put to keyhash fail", K(ret),
                   KPC(key), KPC(value));
@@ -236,7 +250,12 @@ int ObQueryEngine::get(const ObMemtableKey *parameter_key,
     const ObStoreRowkeyWrapper parameter_key_wrapper(parameter_key->get_rowkey());
     const ObStoreRowkeyWrapper *copy_inner_key_wrapper = nullptr;
 
-    if (OB_FAIL(keyhash_.get(&parameter_key_wrapper, row, copy_inner_key_wrapper))) {
+    if (use_tag_hash_) {
+      ret = tag_keyhash_.get(&parameter_key_wrapper, row, copy_inner_key_wrapper);
+    } else {
+      ret = keyhash_.get(&parameter_key_wrapper, row, copy_inner_key_wrapper);
+    }
+    if (OB_FAIL(ret)) {
       if (OB_ENTRY_NOT_EXIST != ret) {
         TRANS_LOG(WARN, "get from keyhash fail", KR(ret), KPC(parameter_key));
       }
@@ -284,6 +303,64 @@ int ObQueryEngine::ensure(const ObMemtableKey *key, ObMvccRow *value)
   return ret;
 }
 
+int ObQueryEngine::EnsureBatchHandle::begin()
+{
+  int ret = OB_SUCCESS;
+  if (!in_batch_) {
+    if (OB_FAIL(keybtree_.begin_batch_insert(handle_))) {
+      TRANS_LOG(WARN, "begin batch insert fail", KR(ret));
+    } else {
+      ensure_count_ = 0;
+      in_batch_ = true;
+    }
+  }
+  return ret;
+}
+
+void ObQueryEngine::EnsureBatchHandle::end()
+{
+  if (in_batch_) {
+    keybtree_.end_batch_insert(handle_);
+    in_batch_ = false;
+  }
+}
+
+int ObQueryEngine::ensure(const ObMemtableKey *key, ObMvccRow *value, EnsureBatchHandle &handle)
+{
+  int ret = OB_SUCCESS;
+
+  if (IS_NOT_INIT) {
+    TRANS_LOG(WARN, "not init", "this", this);
+    ret = OB_NOT_INIT;
+  } else if (OB_ISNULL(key) || OB_ISNULL(value)) {
+    ret = OB_INVALID_ARGUMENT;
+    TRANS_LOG(WARN, "query_engine ensure error, invalid param", KR(ret), KP(key), KP(value));
+  } else if (value->is_btree_indexed()) {
+    // do nothing
+  } else {
+    ObStoreRowkeyWrapper key_wrapper(key->get_rowkey());
+    if (handle.ensure_count_ >= MAX_BATCH_ENSURE_COUNT) {
+      // leave the critical section from time to time, so that the retired
+      // nodes can be reclaimed
+      handle.end();
+    }
+    if (OB_FAIL(handle.begin())) {
+      TRANS_LOG(WARN, "begin ensure batch fail", KR(ret), K(*key));
+    } else if (OB_FAIL(keybtree_.insert(key_wrapper, value, handle.handle_))) {
+      if (OB_ENTRY_EXIST == ret) {
+        TRANS_LOG(ERROR, "ensure keybtree fail", KR(ret), K(*key));
+      } else {
+        TRANS_LOG(WARN, "ensure keybtree fail", KR(ret), K(*key));
+      }
+    } else {
+      handle.ensure_count_++;
+      value->set_btree_indexed();
+    }
+  }
+
+  return ret;
+}
+
 int ObQueryEngine::scan(const ObMemtableKey *start_key,
                         const bool start_exclude,
                         const ObMemtableKey *end_key,
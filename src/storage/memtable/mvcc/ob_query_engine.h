@@ -19,6 +19,7 @@
 #include "storage/memtable/mvcc/ob_keybtree.h"
 #include "storage/memtable/ob_memtable_key.h"
 #include "storage/memtable/ob_mt_hash.h"
+#include "storage/memtable/ob_mt_tag_hash.h"
 
 namespace oceanbase
 {
@@ -73,6 +74,8 @@ public:
   typedef keybtree::BtreeRawIterator<ObStoreRowkeyWrapper, ObMvccRow *> BtreeRawIterator;
   // hashtable for point select
   typedef ObMtHash KeyHash;
+  // hashtable for point select, probing tags of cache line buckets
+  typedef ObMtTagHash KeyTagHash;
 
   // ObQueryEngine Iterator implements the iterator interface
   template <typename BtreeIterator>
@@ -140,11 +143,37 @@ public:
     DISALLOW_COPY_AND_ASSIGN(IteratorAlloc);
   };
 
+  // Handle to ensure rows sorted by key into the btree in one batch insert,
+  // rows falling into the same leaf share one descent of the btree. Nodes on
+  // the path are protected by the critical section of the btree, so the batch
+  // is restarted every MAX_BATCH_ENSURE_COUNT rows, and the user must not wait
+  // for anything(e.g. row latch) while the handle is in batch.
+  class EnsureBatchHandle
+  {
+    friend class ObQueryEngine;
+  public:
+    explicit EnsureBatchHandle(ObQueryEngine &query_engine)
+      : keybtree_(query_engine.keybtree_),
+        handle_(query_engine.keybtree_),
+        ensure_count_(0),
+        in_batch_(false) {}
+    ~EnsureBatchHandle() { end(); }
+    int begin();
+    void end();
+  private:
+    KeyBtree &keybtree_;
+    KeyBtree::WriteHandle handle_;
+    int64_t ensure_count_;
+    bool in_batch_;
+    DISALLOW_COPY_AND_ASSIGN(EnsureBatchHandle);
+  };
+
 public:
   enum {
     MAX_SAMPLE_ROW_COUNT = 500,
     ESTIMATE_CHILD_COUNT_THRESHOLD = 1024,
-    MAX_RANGE_SPLIT_COUNT = 1024 * 1024
+    MAX_RANGE_SPLIT_COUNT = 1024 * 1024,
+    MAX_BATCH_ENSURE_COUNT = 256
   };
 
   explicit ObQueryEngine(ObIAllocator &memstore_allocator)
@@ -152,9 +181,12 @@ public:
     memstore_allocator_(memstore_allocator),
     btree_allocator_(memstore_allocator_),
     keybtree_(btree_allocator_),
-    keyhash_(memstore_allocator_) {}
+    keyhash_(memstore_allocator_),
+    tag_keyhash_(memstore_allocator_),
+    use_tag_hash_(false) {}
   ~ObQueryEngine() { destroy(); }
-  int init();
+  // use_tag_hash chooses ObMtTagHash instead of ObMtHash for point select
+  int init(const bool use_tag_hash = false);
   void destroy();
   void pre_batch_destroy_keybtree();
 
@@ -167,6 +199,8 @@ public:
   //    btree to support the efficient range query(through ensure())
   int set(const ObMemtableKey *key, ObMvccRow *value);
   int ensure(const ObMemtableKey *key, ObMvccRow *value);
+  // ensure() through the batch handle, keys must be in ascending order
+  int ensure(const ObMemtableKey *key, ObMvccRow *value, EnsureBatchHandle &handle);
   // get() will use the hashtable to support fast point select
   int get(const ObMemtableKey *parameter_key, ObMvccRow *&row, ObMemtableKey *returned_key);
   // scan() will use the btree to support fast range query
@@ -250,6 +284,9 @@ private:
   KeyBtree keybtree_;
   // The hashtable optimized for fast point select
   KeyHash keyhash_;
+  KeyTagHash tag_keyhash_;
+  // only one of keyhash_ and tag_keyhash_ is used, decided at init
+  bool use_tag_hash_;
   // Iterator allocator for read and estimation
   IteratorAlloc<BtreeIterator> iter_alloc_;
   IteratorAlloc<BtreeRawIterator> raw_iter_alloc_;
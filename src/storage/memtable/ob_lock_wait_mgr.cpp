@@ -18,6 +18,7 @@
 #include "lib/rowid/ob_urowid.h"
 #include "lib/utility/ob_macro_utils.h"
 #include "observer/ob_server.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 #include "share/deadlock/ob_deadlock_detector_mgr.h"
 #include "lib/function/ob_function.h"
 #include "lib/hash/ob_linear_hash_map.h"
@@ -96,7 +97,8 @@ ObLockWaitMgr::ObLockWaitMgr()
       hash_(hash_buf_, sizeof(hash_buf_)),
       deadlocked_sessions_lock_(common::ObLatchIds::DEADLOCK_DETECT_LOCK),
       deadlocked_sessions_index_(0),
-      total_wait_node_(0)
+      total_wait_node_(0),
+      enable_hand_off_(false)
 {
   memset(sequence_, 0, sizeof(sequence_));
 }
@@ -120,6 +122,7 @@ int ObLockWaitMgr::init()
     share::ObThreadPool::set_run_wrapper(MTL_CTX());
     last_check_session_idle_ts_ = ObClockGenerator::getClock();
     total_wait_node_ = 0;
+    enable_hand_off_ = false;
     is_inited_ = true;
   }
   TRANS_LOG(INFO, "LockWaitMgr.init", K(ret));
@@ -140,6 +143,7 @@ void ObLockWaitMgr::destroy() {
   is_inited_ = false;
   total_wait_node_ = 0;
   deadlocked_sessions_index_ = 0;
+  enable_hand_off_ = false;
 }
 
 void RowHolderMapper::set_hash_holder(const ObTabletID &tablet_id,
@@ -190,6 +194,7 @@ int RowHolderMapper::get_rowkey_holder(const ObTabletID &tablet_id,
 void ObLockWaitMgr::run1()
 {
   int64_t last_dump_ts = 0;
+  int64_t last_refresh_config_ts = 0;
   int64_t now = 0;
   lib::set_thread_name("LockWaitMgr");
   while(!has_set_stop() || !is_hash_empty()) {
@@ -208,10 +213,40 @@ void ObLockWaitMgr::run1()
         row_holder_mapper_.clear();
       }
     }
+    if (now - last_refresh_config_ts > 1_s) {
+      last_refresh_config_ts = now;
+      refresh_config_();
+    }
     ob_usleep(10000);
   }
 }
 
+void ObLockWaitMgr::refresh_config_()
+{
+  omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+  if (tenant_config.is_valid()) {
+    ATOMIC_STORE(&enable_hand_off_, tenant_config->_enable_lock_wait_hand_off);
+  }
+}
+
+void ObLockWaitMgr::set_hash_holder(const ObTabletID &tablet_id,
+                                    const Key &key,
+                                    const ObTransID &tx_id)
+{
+  uint64_t &hold_key = get_thread_hold_key();
+  // The request was woken up for the row and has locked it now. Waking up the
+  // next waiter when the request ends would only make it conflict again, so
+  // leave it to the commit or abort of this row, which wakes up the head of
+  // the waiters (ordered by their receive time) once the row is released.
+  if (0 != hold_key
+      && ATOMIC_LOAD(&enable_hand_off_)
+      && hold_key == LockHashHelper::hash_rowkey(tablet_id, key)) {
+    TRANS_LOG(DEBUG, "LockWaitMgr.hand_off", K(hold_key), K(tablet_id), K(tx_id));
+    hold_key = 0;
+  }
+  row_holder_mapper_.set_hash_holder(tablet_id, key, tx_id);
+}
+
 int64_t ObLockWaitMgr::get_wait_lock_timeout(int64_t timeout)
 {
   int64_t new_timeout = timeout;
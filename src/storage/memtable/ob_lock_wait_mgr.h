@@ -268,8 +268,13 @@ public:
   void wakeup(const transaction::ObTransID &tx_id);
   // wakeup the request waiting on the tablelock.
   void wakeup(const transaction::tablelock::ObLockID &lock_id);
+  // record the row is held by the transaction. With hand off enabled, the
+  // request woken up for the row takes over waking up the next waiter when it
+  // locks the row, the next waiter is woken up once the row is released.
+  void set_hash_holder(const ObTabletID &tablet_id,
+                       const Key &key,
+                       const transaction::ObTransID &tx_id);
   // for deadlock
-  DELEGATE_WITH_RET(row_holder_mapper_, set_hash_holder, void);
   DELEGATE_WITH_RET(row_holder_mapper_, get_hash_holder, int);
   DELEGATE_WITH_RET(row_holder_mapper_, reset_hash_holder, void);
   DELEGATE_WITH_RET(row_holder_mapper_, get_rowkey_holder, int);
@@ -295,6 +300,7 @@ protected:
 
 private:
   int64_t get_wait_lock_timeout(int64_t timeout);
+  void refresh_config_();
   bool wait(Node* node);
   Node* get(uint64_t hash);
   void wakeup(uint64_t hash);
@@ -364,6 +370,7 @@ private:
 private:
   RowHolderMapper row_holder_mapper_;
   int64_t total_wait_node_;
+  bool enable_hand_off_;
 };
 
 class LockHashHelper {
@@ -55,6 +55,7 @@
 #include "storage/ddl/ob_tablet_ddl_kv.h"
 
 #include "logservice/ob_log_service.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 
 namespace oceanbase
 {
@@ -189,7 +190,7 @@ int ObMemtable::init(const ObITable::TableKey &table_key,
     TRANS_LOG(WARN, "fail to set freezer", K(ret), KP(freezer));
   } else if (OB_FAIL(local_allocator_.init())) {
     TRANS_LOG(WARN, "fail to init memstore allocator", K(ret), "tenant id", MTL_ID());
-  } else if (OB_FAIL(query_engine_.init())) {
+  } else if (OB_FAIL(query_engine_.init(use_tag_hash_index_()))) {
     TRANS_LOG(WARN, "query_engine.init fail", K(ret), "tenant_id", MTL_ID());
   } else if (OB_FAIL(mvcc_engine_.init(&local_allocator_,
                                        &kv_builder_,
@@ -2553,7 +2554,10 @@ int ObMemtable::multi_set_(
       }
     }
   }
-  if (OB_SUCC(ret)) {
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(ensure_kvs_(rows_info, memtable_key_buffer, mvcc_rows))) {
+    TRANS_LOG(WARN, "Failed to ensure rows", K(ret));
+  } else {
     for (int64_t i = 0 ; i < row_count; ++i) {
       ObMvccRowAndWriteResult &result = mvcc_rows[i];
       if (result.write_result_.lock_state_.row_exist_decided()) {
@@ -2614,6 +2618,33 @@ int ObMemtable::multi_set_(
   return ret;
 }
 
+// Insert the rows written by multi_set_ into the btree in rowkey order, so
+// that rows falling into the same leaf share one descent.
+int ObMemtable::ensure_kvs_(
+    storage::ObRowsInfo &rows_info,
+    const ObMemtableKeyGenerator::ObMemtableKeyBuffer &memtable_key_buffer,
+    ObMvccRowAndWriteResults &mvcc_rows)
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_count = mvcc_rows.count();
+  ObSEArray<const ObMemtableKey *, 16> stored_keys;
+  if (OB_UNLIKELY(memtable_key_buffer.count() != row_count)) {
+    ret = OB_ERR_UNEXPECTED;
+    TRANS_LOG(WARN, "unexpected key count", K(ret), K(memtable_key_buffer.count()), K(row_count));
+  } else if (OB_FAIL(stored_keys.prepare_allocate(row_count))) {
+    TRANS_LOG(WARN, "Failed to prepare allocate stored keys", K(ret), K(row_count));
+  } else {
+    // keys are buffered in the order of rows, mvcc_rows are in rowkey order
+    for (int64_t i = 0; i < row_count; ++i) {
+      stored_keys.at(rows_info.get_permutation_idx(i)) = &memtable_key_buffer.at(i);
+    }
+    if (OB_FAIL(mvcc_engine_.ensure_kvs(stored_keys, mvcc_rows))) {
+      TRANS_LOG(WARN, "ensure kvs fail", K(ret));
+    }
+  }
+  return ret;
+}
+
 int ObMemtable::set_(
     const storage::ObTableIterParam &param,
     const common::ObIArray<share::schema::ObColDesc> &columns,
@@ -2891,7 +2922,8 @@ int ObMemtable::mvcc_write_(
       (void)mvcc_engine_.mvcc_undo(value);
       res.is_mvcc_undo_ = true;
     }
-  } else if (OB_FAIL(mvcc_engine_.ensure_kv(&stored_key, value))) {
+  } else if (nullptr == mvcc_row && OB_FAIL(mvcc_engine_.ensure_kv(&stored_key, value))) {
+    // rows of multi_set are ensured in batch after all of them are written
     if (res.has_insert()) {
       (void)mvcc_engine_.mvcc_undo(value);
       res.is_mvcc_undo_ = true;
@@ -3220,5 +3252,15 @@ int ObMemtable::report_residual_dml_stat_()
   return ret;
 }
 
+bool ObMemtable::use_tag_hash_index_() const
+{
+  bool bool_ret = false;
+  omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+  if (tenant_config.is_valid()) {
+    bool_ret = tenant_config->_enable_memtable_tag_hash_index;
+  }
+  return bool_ret;
+}
+
 } // namespace memtable
 } // namespace ocenabase
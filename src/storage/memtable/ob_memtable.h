@@ -560,6 +560,10 @@ private:
       const bool check_exist,
       storage::ObTableAccessContext &context,
       storage::ObRowsInfo &rows_info);
+  int ensure_kvs_(
+      storage::ObRowsInfo &rows_info,
+      const ObMemtableKeyGenerator::ObMemtableKeyBuffer &memtable_key_buffer,
+      ObMvccRowAndWriteResults &mvcc_rows);
   int lock_(
       const storage::ObTableIterParam &param,
       storage::ObTableAccessContext &context,
@@ -578,6 +582,8 @@ private:
                                       ObIArray<blocksstable::ObDatumRange> &sample_memtable_ranges);
   int try_report_dml_stat_(const int64_t table_id);
   int report_residual_dml_stat_();
+  // point select index of the query engine is decided when memtable is created
+  bool use_tag_hash_index_() const;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ObMemtable);
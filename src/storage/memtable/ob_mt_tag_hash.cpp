@@ -0,0 +1,505 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "storage/memtable/ob_mt_tag_hash.h"
+
+#include "lib/allocator/ob_qsync.h"
+#include "lib/allocator/ob_retire_station.h"
+#include "storage/memtable/mvcc/ob_mvcc_row.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace memtable
+{
+
+ObMtTagHash::ObMtTagHash(ObIAllocator &allocator)
+  : allocator_(allocator),
+    dir_lock_(),
+    dir_(NULL),
+    seg_cnt_(0),
+    alloc_memory_(0),
+    retire_cnt_(0)
+{
+}
+
+void ObMtTagHash::destroy()
+{
+  free_dir();
+  if (ATOMIC_LOAD(&retire_cnt_) > 0) {
+    purge();
+    retire_cnt_ = 0;
+  }
+}
+
+void ObMtTagHash::pre_batch_destroy()
+{
+  free_dir();
+  // retired blocks are reclaimed by the following batch_destroy()
+  retire_cnt_ = 0;
+}
+
+void ObMtTagHash::batch_destroy()
+{
+  purge();
+}
+
+void ObMtTagHash::free_dir()
+{
+  Directory *dir = dir_;
+  dir_ = NULL;
+  if (OB_NOT_NULL(dir)) {
+    const int64_t dir_size = 1L << dir->global_depth_;
+    int64_t idx = 0;
+    // a segment of local depth d is referenced by 2^(global_depth - d)
+    // consecutive entries of the directory
+    while (idx < dir_size) {
+      Segment *seg = dir->segs_[idx];
+      idx += 1L << (dir->global_depth_ - seg->local_depth_);
+      free_block(seg);
+    }
+    free_block(dir);
+  }
+  seg_cnt_ = 0;
+  alloc_memory_ = 0;
+}
+
+int ObMtTagHash::get(const ObStoreRowkeyWrapper *query_key,
+                     ObMvccRow *&ret_value,
+                     const ObStoreRowkeyWrapper *&copy_inner_key)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(query_key)) {
+    ret = OB_INVALID_ARGUMENT;
+    TRANS_LOG(WARN, "invalid argument", K(ret), KP(query_key));
+  } else if (OB_ISNULL(ATOMIC_LOAD(&dir_))) {
+    // nothing inserted, keep empty memtable free of any hash memory
+    ret = OB_ENTRY_NOT_EXIST;
+  } else {
+    const uint64_t hash = query_key->hash();
+    ObMtTagHashNode *node = NULL;
+    QClockGuard guard(get_qclock());
+    const Directory *dir = ATOMIC_LOAD(&dir_);
+    const Segment *seg = ATOMIC_LOAD(&dir->segs_[get_dir_idx(hash, dir->global_depth_)]);
+    if (OB_FAIL(find_in_seg(*seg, *query_key, hash, node))) {
+      TRANS_LOG(WARN, "find in segment failed", K(ret), KPC(query_key));
+    } else if (OB_ISNULL(node)) {
+      ret = OB_ENTRY_NOT_EXIST;
+    } else {
+      ret_value = node->value_;
+      copy_inner_key = &node->key_;
+    }
+  }
+  return ret;
+}
+
+int ObMtTagHash::get(const ObStoreRowkeyWrapper *query_key, ObMvccRow *&ret_value)
+{
+  const ObStoreRowkeyWrapper *trival_copy_inner_key = NULL;
+  return get(query_key, ret_value, trival_copy_inner_key);
+}
+
+int ObMtTagHash::insert(const ObStoreRowkeyWrapper *insert_key, const ObMvccRow *insert_value)
+{
+  int ret = OB_SUCCESS;
+  ObMtTagHashNode *new_node = NULL; // allocate at most once no matter how many times repeated
+  bool is_done = false;
+  if (OB_ISNULL(insert_key)) {
+    ret = OB_INVALID_ARGUMENT;
+    TRANS_LOG(WARN, "invalid argument", K(ret), KP(insert_key));
+  } else if (OB_FAIL(ensure_dir())) {
+    TRANS_LOG(WARN, "init directory failed", K(ret));
+  }
+  const uint64_t hash = OB_SUCC(ret) ? insert_key->hash() : 0;
+  while (OB_SUCC(ret) && !is_done) {
+    int64_t split_depth = -1;
+    {
+      QClockGuard guard(get_qclock());
+      Directory *dir = ATOMIC_LOAD(&dir_);
+      Segment *seg = ATOMIC_LOAD(&dir->segs_[get_dir_idx(hash, dir->global_depth_)]);
+      ObMtTagHashNode *exist_node = NULL;
+      ObByteLockGuard seg_guard(seg->lock_);
+      if (seg->retired_) {
+        // split by others after we load the directory, retry
+      } else if (OB_FAIL(find_in_seg(*seg, *insert_key, hash, exist_node))) {
+        TRANS_LOG(WARN, "find in segment failed", K(ret), KPC(insert_key));
+      } else if (OB_NOT_NULL(exist_node)) {
+        ret = OB_ENTRY_EXIST;
+      } else if (OB_ISNULL(new_node)) {
+        void *buf = NULL;
+        if (OB_ISNULL(buf = allocator_.alloc(sizeof(ObMtTagHashNode)))) {
+          ret = OB_ALLOCATE_MEMORY_FAILED;
+          TRANS_LOG(WARN, "alloc hash node failed", K(ret));
+        } else {
+          new_node = new (buf) ObMtTagHashNode(*insert_key, insert_value, hash);
+          ATOMIC_FAA(&alloc_memory_, sizeof(ObMtTagHashNode));
+        }
+      }
+      if (OB_FAIL(ret) || seg->retired_) {
+      } else {
+        const uint8_t tag = get_tag(hash);
+        const int64_t idx = get_bucket_idx(hash);
+        if (add_to_bucket(seg->buckets_[idx], new_node)
+            || add_to_bucket(seg->buckets_[get_alt_bucket_idx(idx, tag)], new_node)) {
+          is_done = true;
+        } else if (seg->local_depth_ >= MAX_GLOBAL_DEPTH
+                   || (is_same_hash(seg->buckets_[idx], hash)
+                       && is_same_hash(seg->buckets_[get_alt_bucket_idx(idx, tag)], hash))) {
+          // keys of the same hash can not be separated by split
+          new_node->next_ = seg->overflow_;
+          ATOMIC_STORE(&seg->overflow_, new_node);
+          is_done = true;
+        } else {
+          split_depth = seg->local_depth_;
+        }
+      }
+    }
+    if (split_depth >= 0 && OB_FAIL(split_seg(hash, split_depth))) {
+      TRANS_LOG(WARN, "split segment failed", K(ret), K(split_depth));
+    }
+  }
+  if (OB_FAIL(ret) && OB_NOT_NULL(new_node)) {
+    new_node->~ObMtTagHashNode();
+    allocator_.free(new_node);
+    ATOMIC_SAF(&alloc_memory_, sizeof(ObMtTagHashNode));
+  }
+  return ret;
+}
+
+int64_t ObMtTagHash::get_arr_size() const
+{
+  return ATOMIC_LOAD(&seg_cnt_) * SEG_BUCKET_CNT * BUCKET_SLOT_CNT;
+}
+
+int ObMtTagHash::find_in_bucket(const Bucket &bucket,
+                                const ObStoreRowkeyWrapper &key,
+                                const uint64_t hash,
+                                ObMtTagHashNode *&node) const
+{
+  int ret = OB_SUCCESS;
+  uint64_t match = match_tag(ATOMIC_LOAD(&bucket.meta_), get_tag(hash));
+  while (OB_SUCC(ret) && 0 != match && OB_ISNULL(node)) {
+    const int64_t slot = __builtin_ctzll(match) >> 3;
+    ObMtTagHashNode *cur = ATOMIC_LOAD(&bucket.slots_[slot]);
+    bool is_equal = false;
+    if (cur->hash_ != hash) {
+    } else if (OB_FAIL(cur->key_.equal(key, is_equal))) {
+      TRANS_LOG(WARN, "compare key failed", K(ret), K(key));
+    } else if (is_equal) {
+      node = cur;
+    }
+    match &= match - 1;
+  }
+  return ret;
+}
+
+int ObMtTagHash::find_in_seg(const Segment &seg,
+                             const ObStoreRowkeyWrapper &key,
+                             const uint64_t hash,
+                             ObMtTagHashNode *&node) const
+{
+  int ret = OB_SUCCESS;
+  const int64_t idx = get_bucket_idx(hash);
+  node = NULL;
+  if (OB_FAIL(find_in_bucket(seg.buckets_[idx], key, hash, node))) {
+  } else if (OB_NOT_NULL(node)) {
+  } else if (OB_FAIL(find_in_bucket(seg.buckets_[get_alt_bucket_idx(idx, get_tag(hash))], key, hash, node))) {
+  } else {
+    ObMtTagHashNode *cur = ATOMIC_LOAD(&seg.overflow_);
+    while (OB_SUCC(ret) && OB_ISNULL(node) && OB_NOT_NULL(cur)) {
+      bool is_equal = false;
+      if (cur->hash_ != hash) {
+      } else if (OB_FAIL(cur->key_.equal(key, is_equal))) {
+        TRANS_LOG(WARN, "compare key failed", K(ret), K(key));
+      } else if (is_equal) {
+        node = cur;
+      }
+      cur = cur->next_;
+    }
+  }
+  return ret;
+}
+
+bool ObMtTagHash::is_same_hash(const Bucket &bucket, const uint64_t hash)
+{
+  bool bret = true;
+  const int64_t cnt = bucket.meta_ >> 56;
+  for (int64_t i = 0; bret && i < cnt; i++) {
+    bret = (bucket.slots_[i]->hash_ == hash);
+  }
+  return bret;
+}
+
+// caller holds the lock of segment or the segment is not published yet
+bool ObMtTagHash::add_to_bucket(Bucket &bucket, ObMtTagHashNode *node)
+{
+  bool bret = false;
+  const uint64_t meta = bucket.meta_;
+  const uint64_t cnt = meta >> 56;
+  if (cnt < BUCKET_SLOT_CNT) {
+    const uint64_t tag = get_tag(node->hash_);
+    ATOMIC_STORE(&bucket.slots_[cnt], node);
+    ATOMIC_STORE(&bucket.meta_,
+                 ((meta & ((1ULL << 56) - 1)) | (tag << (cnt * 8)) | ((cnt + 1) << 56)));
+    bret = true;
+  }
+  return bret;
+}
+
+int ObMtTagHash::ensure_dir()
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(ATOMIC_LOAD(&dir_))) {
+    ObByteLockGuard dir_guard(dir_lock_);
+    Directory *dir = NULL;
+    Segment *seg = NULL;
+    if (OB_NOT_NULL(dir_)) {
+      // created by others
+    } else if (OB_FAIL(alloc_seg(0, seg))) {
+      TRANS_LOG(WARN, "alloc segment failed", K(ret));
+    } else if (OB_FAIL(alloc_dir(0, dir))) {
+      TRANS_LOG(WARN, "alloc directory failed", K(ret));
+      free_block(seg);
+    } else {
+      dir->segs_[0] = seg;
+      ATOMIC_STORE(&seg_cnt_, 1);
+      ATOMIC_STORE(&dir_, dir);
+    }
+  }
+  return ret;
+}
+
+int ObMtTagHash::split_seg(const uint64_t hash, const int64_t local_depth)
+{
+  int ret = OB_SUCCESS;
+  HazardList retire_list;
+  {
+    ObByteLockGuard dir_guard(dir_lock_);
+    Directory *dir = dir_;
+    Segment *seg = dir->segs_[get_dir_idx(hash, dir->global_depth_)];
+    Directory *new_dir = NULL;
+    Segment *children[2] = {NULL, NULL};
+    if (seg->local_depth_ != local_depth) {
+      // split by others
+    } else if (OB_FAIL(alloc_seg(local_depth + 1, children[0]))) {
+      TRANS_LOG(WARN, "alloc segment failed", K(ret));
+    } else if (OB_FAIL(alloc_seg(local_depth + 1, children[1]))) {
+      TRANS_LOG(WARN, "alloc segment failed", K(ret));
+    } else if (local_depth == dir->global_depth_
+               && OB_FAIL(alloc_dir(dir->global_depth_ + 1, new_dir))) {
+      TRANS_LOG(WARN, "alloc directory failed", K(ret));
+    } else {
+      ObByteLockGuard seg_guard(seg->lock_);
+      const int64_t child_bit = 63 - local_depth;
+      // every node stays in the same bucket of the child, so it never overflows.
+      // The overflow list is only prepended to and readers may still walk it, so
+      // instead of being relinked it is shared by both children, whose lookups
+      // skip the nodes of the other child by the hash
+      children[0]->overflow_ = seg->overflow_;
+      children[1]->overflow_ = seg->overflow_;
+      for (int64_t i = 0; i < SEG_BUCKET_CNT; i++) {
+        const Bucket &bucket = seg->buckets_[i];
+        const int64_t cnt = bucket.meta_ >> 56;
+        for (int64_t j = 0; j < cnt; j++) {
+          ObMtTagHashNode *node = bucket.slots_[j];
+          (void)add_to_bucket(children[(node->hash_ >> child_bit) & 1]->buckets_[i], node);
+        }
+      }
+      if (OB_NOT_NULL(new_dir)) {
+        const int64_t dir_size = 1L << dir->global_depth_;
+        for (int64_t i = 0; i < dir_size; i++) {
+          new_dir->segs_[2 * i] = dir->segs_[i];
+          new_dir->segs_[2 * i + 1] = dir->segs_[i];
+        }
+      }
+      Directory *target_dir = OB_NOT_NULL(new_dir) ? new_dir : dir;
+      const int64_t span = 1L << (target_dir->global_depth_ - local_depth);
+      const int64_t start = get_dir_idx(hash, local_depth) * span;
+      for (int64_t i = 0; i < span; i++) {
+        ATOMIC_STORE(&target_dir->segs_[start + i], children[(i < span / 2) ? 0 : 1]);
+      }
+      if (OB_NOT_NULL(new_dir)) {
+        ATOMIC_STORE(&dir_, new_dir);
+        retire_list.push(dir);
+      }
+      seg->retired_ = true;
+      retire_list.push(seg);
+      ATOMIC_INC(&seg_cnt_);
+      children[0] = NULL;
+      children[1] = NULL;
+      new_dir = NULL;
+    }
+    free_block(children[0]);
+    free_block(children[1]);
+    free_block(new_dir);
+  }
+  retire(retire_list);
+  return ret;
+}
+
+int ObMtTagHash::alloc_seg(const int64_t local_depth, Segment *&seg)
+{
+  int ret = OB_SUCCESS;
+  void *ptr = NULL;
+  void *buf = NULL;
+  if (OB_FAIL(alloc_block(sizeof(Segment), ptr, buf))) {
+  } else {
+    MEMSET(ptr, 0, sizeof(Segment));
+    seg = new (ptr) Segment();
+    seg->host_ = this;
+    seg->buf_ = buf;
+    seg->size_ = sizeof(Segment);
+    seg->local_depth_ = local_depth;
+  }
+  return ret;
+}
+
+int ObMtTagHash::alloc_dir(const int64_t global_depth, Directory *&dir)
+{
+  int ret = OB_SUCCESS;
+  void *ptr = NULL;
+  void *buf = NULL;
+  const int64_t size = sizeof(Directory) + sizeof(Segment *) * (1L << global_depth);
+  if (OB_FAIL(alloc_block(size, ptr, buf))) {
+  } else {
+    MEMSET(ptr, 0, size);
+    dir = new (ptr) Directory();
+    dir->host_ = this;
+    dir->buf_ = buf;
+    dir->size_ = size;
+    dir->global_depth_ = global_depth;
+  }
+  return ret;
+}
+
+int ObMtTagHash::alloc_block(const int64_t size, void *&ptr, void *&buf)
+{
+  int ret = OB_SUCCESS;
+  const int64_t alloc_size = size + CACHE_ALIGN_SIZE;
+  if (OB_ISNULL(buf = allocator_.alloc(alloc_size))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    TRANS_LOG(WARN, "alloc memory failed", K(ret), K(alloc_size));
+  } else {
+    ptr = reinterpret_cast<void *>(
+        (reinterpret_cast<uint64_t>(buf) + CACHE_ALIGN_SIZE - 1) & ~(CACHE_ALIGN_SIZE - 1));
+    ATOMIC_FAA(&alloc_memory_, alloc_size);
+  }
+  return ret;
+}
+
+void ObMtTagHash::free_block(Block *block)
+{
+  if (OB_NOT_NULL(block) && OB_NOT_NULL(block->host_)) {
+    ObMtTagHash *host = block->host_;
+    void *buf = block->buf_;
+    ATOMIC_SAF(&host->alloc_memory_, block->size_ + CACHE_ALIGN_SIZE);
+    host->allocator_.free(buf);
+  }
+}
+
+void ObMtTagHash::retire(HazardList &retire_list)
+{
+  HazardList reclaim_list;
+  Block *p = NULL;
+  ATOMIC_AAF(&retire_cnt_, retire_list.size());
+  CriticalGuard(get_qsync());
+  get_retire_station().retire(reclaim_list, retire_list);
+  while (OB_NOT_NULL(p = static_cast<Block *>(reclaim_list.pop()))) {
+    free_block(p);
+    p = NULL;
+  }
+}
+
+void ObMtTagHash::purge()
+{
+  {
+    HazardList reclaim_list;
+    Block *p = NULL;
+    CriticalGuard(get_qsync());
+    get_retire_station().purge(reclaim_list);
+    while (OB_NOT_NULL(p = static_cast<Block *>(reclaim_list.pop()))) {
+      free_block(p);
+      p = NULL;
+    }
+  }
+  WaitQuiescent(get_qsync());
+}
+
+void ObMtTagHash::dump_hash(FILE *fd,
+                            const bool print_bucket,
+                            const bool print_row_value,
+                            const bool print_row_value_verbose) const
+{
+  int ret = OB_SUCCESS;
+  const int64_t DUMP_BUF_LEN = 16 * 1024;
+  QClockGuard guard(get_qclock());
+  const Directory *dir = ATOMIC_LOAD(&dir_);
+  if (OB_ISNULL(dir)) {
+    fprintf(fd, "empty tag hash, alloc_memory_=%ld\n", get_alloc_memory());
+  } else {
+    HEAP_VAR(char[DUMP_BUF_LEN], buf)
+    {
+      const int64_t dir_size = 1L << dir->global_depth_;
+      int64_t node_count = 0;
+      fprintf(fd, "dir_=%p, global_depth_=%ld, seg_cnt_=%ld, alloc_memory_=%ld\n",
+              dir, dir->global_depth_, ATOMIC_LOAD(&seg_cnt_), get_alloc_memory());
+      int64_t idx = 0;
+      while (idx < dir_size) {
+        const Segment *seg = ATOMIC_LOAD(&dir->segs_[idx]);
+        fprintf(fd, "[%8ld] | segment | addr=%14p | local_depth_=%ld | overflow_=%p\n",
+                idx, seg, seg->local_depth_, seg->overflow_);
+        idx += 1L << (dir->global_depth_ - seg->local_depth_);
+        for (int64_t i = 0; i < SEG_BUCKET_CNT; i++) {
+          const Bucket &bucket = seg->buckets_[i];
+          const uint64_t meta = ATOMIC_LOAD(&bucket.meta_);
+          const int64_t cnt = meta >> 56;
+          if (print_bucket) {
+            fprintf(fd, "  bucket[%2ld] | meta_=%16lx | cnt=%ld\n", i, meta, cnt);
+          }
+          for (int64_t j = 0; j < cnt; j++) {
+            const ObMtTagHashNode *node = ATOMIC_LOAD(&bucket.slots_[j]);
+            int64_t pos = node->key_.to_string(buf, DUMP_BUF_LEN);
+            if (pos < DUMP_BUF_LEN) {
+              pos += snprintf(buf + pos, DUMP_BUF_LEN - pos, " | mvcc_row_addr=%p, ", node->value_);
+              if (NULL != node->value_ && print_row_value && pos < DUMP_BUF_LEN) {
+                pos += node->value_->to_string(buf + pos, DUMP_BUF_LEN - pos, print_row_value_verbose);
+              }
+            }
+            fprintf(fd, "    [%12ld] | addr=%14p | hash_=%16lx | %s\n", node_count++, node, node->hash_, buf);
+          }
+        }
+      }
+      fprintf(fd, "SUCCESS dump tag hash finish, node_count=%ld\n", node_count);
+    }
+  }
+}
+
+RetireStation &ObMtTagHash::get_retire_station()
+{
+  static RetireStation retire_station_(get_qclock(), RETIRE_LIMIT);
+  return retire_station_;
+}
+
+QClock &ObMtTagHash::get_qclock()
+{
+  static QClock qclock_;
+  return qclock_;
+}
+
+ObQSync &ObMtTagHash::get_qsync()
+{
+  static ObQSync qsync;
+  return qsync;
+}
+
+} // namespace memtable
+} // namespace oceanbase
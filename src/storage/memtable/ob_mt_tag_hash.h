@@ -0,0 +1,189 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STRORAGE_MEMTABLE_OB_MT_TAG_HASH_
+#define OCEANBASE_STRORAGE_MEMTABLE_OB_MT_TAG_HASH_
+
+#include "lib/allocator/ob_allocator.h"
+#include "lib/lock/ob_small_spin_lock.h"
+#include "lib/queue/ob_link.h"
+#include "storage/memtable/ob_memtable_key.h"
+
+namespace oceanbase
+{
+namespace common
+{
+class QClock;
+class HazardList;
+class RetireStation;
+class ObQSync;
+}
+namespace memtable
+{
+class ObMvccRow;
+class ObMtTagHash;
+
+// Hash index for point select of memtable rows, an alternative of ObMtHash.
+//
+// It is an extendible hash: the directory is indexed by the highest
+// global_depth bits of the key hash and points to segments, each segment has
+// SEG_BUCKET_CNT buckets of one cache line. A bucket holds up to
+// BUCKET_SLOT_CNT node pointers and one meta word with one tag byte per slot,
+// so a probe compares all tags of the bucket in a few instructions(SWAR) and
+// touches the nodes only for matched tags. A key may live in one of its two
+// candidate buckets, a segment is split when both of them are full. Keys of the
+// same hash filling both buckets, which no split separates, and keys of segments
+// of MAX_GLOBAL_DEPTH are linked to the overflow list of the segment.
+//
+// Readers are lock-free, they only enter the critical section of the QClock.
+// Writers are serialized per segment, splitting a segment replaces it with two
+// new ones in the directory(and doubles the directory if needed) and retires
+// the old segment and directory to the RetireStation, so concurrent readers
+// can still finish probing on them.
+//
+// As ObMtHash, nodes are never freed before the memtable is released.
+struct ObMtTagHashNode
+{
+  ObMtTagHashNode(const ObStoreRowkeyWrapper &key, const ObMvccRow *value, const uint64_t hash)
+    : key_(key), value_(const_cast<ObMvccRow *>(value)), hash_(hash), next_(NULL) {}
+  ~ObMtTagHashNode() { value_ = NULL; }
+
+  ObStoreRowkeyWrapper key_;
+  ObMvccRow *value_;
+  uint64_t hash_;
+  // only used in the overflow list of segment, never changed once the node is
+  // published, so the tail of a list can be shared by several segments
+  ObMtTagHashNode *next_;
+};
+
+class ObMtTagHash
+{
+public:
+  static const int64_t BUCKET_SLOT_CNT = 7;
+  static const int64_t SEG_BUCKET_CNT = 64;
+  static const int64_t MAX_GLOBAL_DEPTH = 24;
+private:
+  // memory retired to RetireStation, freed by the host hash when reclaimed
+  struct Block : public common::ObLink
+  {
+    ObMtTagHash *host_;
+    void *buf_;
+    int64_t size_;
+  };
+  // low 7 bytes of meta_ are tags, the highest byte is the count of slots in
+  // use. The slot is filled before the meta is published.
+  struct Bucket
+  {
+    uint64_t meta_;
+    ObMtTagHashNode *slots_[BUCKET_SLOT_CNT];
+  };
+  struct Segment : public Block
+  {
+    int64_t local_depth_;
+    bool retired_;
+    common::ObByteLock lock_;
+    ObMtTagHashNode *overflow_;
+    Bucket buckets_[SEG_BUCKET_CNT] CACHE_ALIGNED;
+  };
+  struct Directory : public Block
+  {
+    int64_t global_depth_;
+    Segment *segs_[0];
+  };
+public:
+  explicit ObMtTagHash(common::ObIAllocator &allocator);
+  ~ObMtTagHash() { destroy(); }
+  // Only waits for the readers when blocks of this hash may still be in the
+  // RetireStation
+  void destroy();
+  // Batch gc of memtables frees the index of every memtable first and then
+  // purges the RetireStation only once by batch_destroy()
+  void pre_batch_destroy();
+  static void batch_destroy();
+
+  // same interface as ObMtHash
+  int get(const ObStoreRowkeyWrapper *query_key,
+          ObMvccRow *&ret_value,
+          const ObStoreRowkeyWrapper *&copy_inner_key);
+  int get(const ObStoreRowkeyWrapper *query_key, ObMvccRow *&ret_value);
+  int insert(const ObStoreRowkeyWrapper *insert_key, const ObMvccRow *insert_value);
+
+  int64_t get_arr_size() const;
+  int64_t get_alloc_memory() const { return sizeof(*this) + ATOMIC_LOAD(&alloc_memory_); }
+  void dump_hash(FILE *fd,
+                 const bool print_bucket,
+                 const bool print_row_value,
+                 const bool print_row_value_verbose) const;
+
+private:
+  OB_INLINE static uint8_t get_tag(const uint64_t hash) { return static_cast<uint8_t>(hash >> 24); }
+  OB_INLINE static int64_t get_bucket_idx(const uint64_t hash) { return hash & (SEG_BUCKET_CNT - 1); }
+  // never equal to the first bucket and symmetric, so either bucket can find the other
+  OB_INLINE static int64_t get_alt_bucket_idx(const int64_t idx, const uint8_t tag)
+  {
+    return idx ^ (1 + tag % (SEG_BUCKET_CNT - 1));
+  }
+  OB_INLINE static int64_t get_dir_idx(const uint64_t hash, const int64_t depth)
+  {
+    return 0 == depth ? 0 : static_cast<int64_t>(hash >> (64 - depth));
+  }
+  // Return one 0x80 byte for each slot whose tag equals to %tag
+  OB_INLINE static uint64_t match_tag(const uint64_t meta, const uint8_t tag)
+  {
+    static const uint64_t LOW_BITS = 0x7F7F7F7F7F7F7F7FULL;
+    const uint64_t cnt = meta >> 56;
+    const uint64_t x = meta ^ (0x0101010101010101ULL * tag);
+    const uint64_t zero = ~(((x & LOW_BITS) + LOW_BITS) | x | LOW_BITS);
+    return zero & ((1ULL << (cnt * 8)) - 1);
+  }
+
+  int find_in_bucket(const Bucket &bucket,
+                     const ObStoreRowkeyWrapper &key,
+                     const uint64_t hash,
+                     ObMtTagHashNode *&node) const;
+  int find_in_seg(const Segment &seg,
+                  const ObStoreRowkeyWrapper &key,
+                  const uint64_t hash,
+                  ObMtTagHashNode *&node) const;
+  static bool add_to_bucket(Bucket &bucket, ObMtTagHashNode *node);
+  static bool is_same_hash(const Bucket &bucket, const uint64_t hash);
+  int ensure_dir();
+  int split_seg(const uint64_t hash, const int64_t local_depth);
+  int alloc_seg(const int64_t local_depth, Segment *&seg);
+  int alloc_dir(const int64_t global_depth, Directory *&dir);
+  int alloc_block(const int64_t size, void *&ptr, void *&buf);
+  static void free_block(Block *block);
+  void free_dir();
+  void retire(common::HazardList &retire_list);
+  static void purge();
+
+  static common::RetireStation &get_retire_station();
+  static common::QClock &get_qclock();
+  static common::ObQSync &get_qsync();
+
+private:
+  static const int64_t RETIRE_LIMIT = 1024;
+  common::ObIAllocator &allocator_;
+  // serialize split and directory update
+  common::ObByteLock dir_lock_;
+  Directory *dir_;
+  int64_t seg_cnt_;
+  int64_t alloc_memory_;
+  // blocks retired since the last purge, upper bound of those still in the RetireStation
+  int64_t retire_cnt_;
+  DISALLOW_COPY_AND_ASSIGN(ObMtTagHash);
+};
+
+} // namespace memtable
+} // namespace oceanbase
+
+#endif
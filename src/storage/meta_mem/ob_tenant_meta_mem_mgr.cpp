@@ -624,6 +624,7 @@ void ObTenantMetaMemMgr::batch_destroy_memtable_(memtable::ObMemtableSet *memtab
     (void)(((memtable::ObMemtable *)set_iter->first)->pre_batch_destroy_keybtree());
   }
   memtable::ObMemtableKeyBtree::batch_destroy();
+  memtable::ObMtTagHash::batch_destroy();
 }
 
 void ObTenantMetaMemMgr::batch_gc_memtable_()
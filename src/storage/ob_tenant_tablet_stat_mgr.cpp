@@ -22,6 +22,7 @@
 #include "observer/ob_server_struct.h"
 #include "src/storage/tablet/ob_tablet.h"
 #include "observer/ob_server.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 #include <sys/sysinfo.h>
 
 using namespace oceanbase;
@@ -564,6 +565,7 @@ void ObTenantSysLoadShedder::reset()
 {
   MEMSET(this, 0, sizeof(ObTenantSysLoadShedder));
   load_shedding_factor_ = 1;
+  latency_shedding_factor_ = 1;
 }
 
 void ObTenantSysLoadShedder::refresh_sys_load()
@@ -626,6 +628,106 @@ int ObTenantSysLoadShedder::refresh_cpu_utility()
   return ret;
 }
 
+// Called every second by the dag scheduler. The compaction tasks are throttled at
+// once when the p99 query response time exceeds the target, and get back the idle
+// capacity step by step when the queries are fast again.
+void ObTenantSysLoadShedder::refresh_query_latency()
+{
+  int tmp_ret = OB_SUCCESS;
+  const int64_t curr_time = ObTimeUtility::fast_current_time();
+  if (curr_time < last_latency_sample_time_ + LATENCY_SAMPLING_INTERVAL) {
+    // do nothing
+  } else {
+    int64_t latency_target = 0;
+    observer::ObRSTTimeCollector *collector = nullptr;
+    last_latency_sample_time_ = curr_time;
+    {
+      omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+      if (tenant_config.is_valid()) {
+        latency_target = tenant_config->_compaction_query_latency_target;
+      }
+    }
+    if (latency_target <= 0) {
+    } else if (OB_TMP_FAIL(observer::ObRSTCollector::get_instance().collector_map_.get_refactored(MTL_ID(), collector))) {
+      // query_response_time_stats is turned off if not exist
+      if (OB_HASH_NOT_EXIST != tmp_ret) {
+        LOG_WARN_RET(tmp_ret, "failed to get query response time collector", "tenant_id", MTL_ID());
+      }
+      collector = nullptr;
+    }
+    update_latency_shedding_factor(latency_target, collector);
+  }
+}
+
+void ObTenantSysLoadShedder::update_latency_shedding_factor(
+    const int64_t latency_target,
+    observer::ObRSTTimeCollector *collector)
+{
+  int64_t query_cnt = 0;
+  int64_t p99_latency = 0;
+  const int64_t old_factor = ATOMIC_LOAD(&latency_shedding_factor_);
+  int64_t new_factor = old_factor;
+
+  if (latency_target <= 0 || nullptr == collector) {
+    new_factor = 1;
+    is_latency_sampled_ = false;
+  } else {
+    sample_p99_query_latency(*collector, query_cnt, p99_latency);
+    if (query_cnt >= MIN_LATENCY_SAMPLE_QUERY_CNT && p99_latency > latency_target) {
+      new_factor = MIN(old_factor * 2, MAX_LATENCY_SHEDDING_FACTOR);
+    } else if (old_factor > 1) {
+      --new_factor;
+    }
+  }
+  p99_query_latency_ = p99_latency;
+
+  if (new_factor != old_factor) {
+    ATOMIC_STORE(&latency_shedding_factor_, new_factor);
+    FLOG_INFO("[ADAPTIVE_SCHED] refresh latency shedding factor", K(old_factor), K(new_factor),
+        K(p99_latency), K(latency_target), K(query_cnt));
+  }
+}
+
+void ObTenantSysLoadShedder::sample_p99_query_latency(
+    observer::ObRSTTimeCollector &collector,
+    int64_t &query_cnt,
+    int64_t &p99_latency)
+{
+  uint32_t interval_cnts[observer::OB_QRT_OVERALL_COUNT];
+  query_cnt = 0;
+  p99_latency = 0;
+
+  const int64_t bound_cnt = MIN(static_cast<int64_t>(collector.bound_count()),
+                                static_cast<int64_t>(observer::OB_QRT_OVERALL_COUNT));
+  for (int64_t i = 0; i < bound_cnt; ++i) {
+    const uint32_t curr_cnt = ATOMIC_LOAD(&collector.count_[i]);
+    // the counts restart from 0 after query_response_time_flush
+    interval_cnts[i] = curr_cnt >= last_query_cnts_[i] ? curr_cnt - last_query_cnts_[i] : curr_cnt;
+    last_query_cnts_[i] = curr_cnt;
+    query_cnt += interval_cnts[i];
+  }
+  if (!is_latency_sampled_) {
+    // the counts of the first sample are not of the latest second
+    is_latency_sampled_ = true;
+    query_cnt = 0;
+  }
+  // the bucket i holds the latencies in [bound(i-1), bound(i)), which are a power
+  // of the base apart, so the p99 is interpolated by its rank in the bucket
+  const int64_t p99_rank = (query_cnt * 99 + 99) / 100;
+  int64_t accum_cnt = 0;
+  bool found = false;
+  for (int64_t i = 0; !found && query_cnt > 0 && i < bound_cnt; ++i) {
+    if (interval_cnts[i] > 0 && accum_cnt + interval_cnts[i] >= p99_rank) {
+      const uint64_t lower = 0 == i ? 0 : collector.bound(i - 1);
+      const uint64_t upper = collector.bound(i);
+      p99_latency = lower + static_cast<int64_t>(
+          static_cast<double>(upper - lower) * (p99_rank - accum_cnt) / interval_cnts[i]);
+      found = true;
+    }
+    accum_cnt += interval_cnts[i];
+  }
+}
+
 /************************************* ObTenantTabletStatMgr *************************************/
 ObTenantTabletStatMgr::ObTenantTabletStatMgr()
   : report_stat_task_(*this),
@@ -25,6 +25,7 @@
 #include "lib/queue/ob_fixed_queue.h"
 #include "lib/list/ob_dlist.h"
 #include "lib/literals/ob_literals.h"
+#include "observer/mysql/ob_query_response_time.h"
 
 namespace oceanbase
 {
@@ -355,17 +356,25 @@ public:
   ~ObTenantSysLoadShedder() = default;
   void reset();
   void refresh_sys_load();
+  void refresh_query_latency();
   int64_t get_load_shedding_factor() const { return ATOMIC_LOAD(&load_shedding_factor_); }
+  int64_t get_latency_shedding_factor() const { return ATOMIC_LOAD(&latency_shedding_factor_); }
 
-  TO_STRING_KV(K_(load_shedding_factor), K_(last_cpu_time), K_(cpu_usage), K_(min_cpu_cnt), K_(max_cpu_cnt), K_(effect_time));
+  TO_STRING_KV(K_(load_shedding_factor), K_(last_cpu_time), K_(cpu_usage), K_(min_cpu_cnt), K_(max_cpu_cnt), K_(effect_time),
+               K_(latency_shedding_factor), K_(p99_query_latency));
 private:
   int refresh_cpu_utility();
+  void update_latency_shedding_factor(const int64_t latency_target, observer::ObRSTTimeCollector *collector);
+  void sample_p99_query_latency(observer::ObRSTTimeCollector &collector, int64_t &query_cnt, int64_t &p99_latency);
 
 public:
   static const int64_t DEFAULT_LOAD_SHEDDING_FACTOR = 2;
   static const int64_t CPU_TIME_SAMPLING_INTERVAL = 20_s; //20 * 1000 * 1000 us
   static constexpr double CPU_TIME_THRESHOLD = 0.8; // 80%
   static const int64_t SHEDDER_EXPIRE_TIME = 2_min;
+  static const int64_t LATENCY_SAMPLING_INTERVAL = 1_s;
+  static const int64_t MIN_LATENCY_SAMPLE_QUERY_CNT = 100;
+  static const int64_t MAX_LATENCY_SHEDDING_FACTOR = 16;
 private:
   int64_t effect_time_;
   int64_t last_sample_time_;
@@ -374,6 +383,12 @@ private:
   double cpu_usage_;
   double min_cpu_cnt_;
   double max_cpu_cnt_;
+  // driven by the p99 query response time of the latest second
+  int64_t last_latency_sample_time_;
+  int64_t latency_shedding_factor_;
+  int64_t p99_query_latency_;
+  bool is_latency_sampled_;
+  uint32_t last_query_cnts_[observer::OB_QRT_OVERALL_COUNT];
 };
 
 
@@ -426,7 +441,9 @@ public:
   int64_t get_last_update_time() { return report_stat_task_.last_update_time_; }
   bool is_high_tenant_cpu_load() const { return get_load_shedding_factor() >= ObTenantSysLoadShedder::DEFAULT_LOAD_SHEDDING_FACTOR; }
   int64_t get_load_shedding_factor() const { return load_shedder_.get_load_shedding_factor(); }
+  int64_t get_latency_shedding_factor() const { return load_shedder_.get_latency_shedding_factor(); }
   void refresh_sys_stat();
+  void refresh_query_latency() { load_shedder_.refresh_query_latency(); }
 private:
   class TabletStatUpdater : public common::ObTimerTask
   {
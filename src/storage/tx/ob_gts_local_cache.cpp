@@ -27,6 +27,7 @@ void ObGTSLocalCache::reset()
   gts_ = 0;
   latest_srr_.reset();
   receive_gts_ts_.reset();
+  deferred_stc_.reset();
 }
 
 //Due to network and other factors, it is impossible to guarantee that srr and gts maintain partial order,
@@ -159,5 +160,19 @@ int ObGTSLocalCache::update_latest_srr(const MonotonicTs latest_srr)
   return ret;
 }
 
+int ObGTSLocalCache::update_deferred_stc(const MonotonicTs stc)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_UNLIKELY(!stc.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    TRANS_LOG(WARN, "invalid argument", KR(ret), K(stc));
+  } else {
+    (void)atomic_update(&deferred_stc_.mts_, stc.mts_);
+  }
+
+  return ret;
+}
+
 } // transaction
 } // oceanbase
@@ -46,8 +46,11 @@ public:
   int get_srr_and_gts_safe(MonotonicTs &srr, int64_t &gts, MonotonicTs &receive_gts_ts) const;
   int update_latest_srr(const MonotonicTs latest_srr);
   bool no_rpc_on_road() const { return ATOMIC_LOAD(&latest_srr_.mts_) == ATOMIC_LOAD(&srr_.mts_); }
+  int update_deferred_stc(const MonotonicTs stc);
+  // some request is waiting for a gts newer than the local one without rpc on road for it
+  bool has_deferred_request() const { return ATOMIC_LOAD(&deferred_stc_.mts_) > ATOMIC_LOAD(&srr_.mts_); }
 
-  TO_STRING_KV(K_(srr), K_(gts), K_(latest_srr));
+  TO_STRING_KV(K_(srr), K_(gts), K_(latest_srr), K_(deferred_stc));
 private:
   // send rpc request timestamp
   MonotonicTs srr_;
@@ -56,6 +59,8 @@ private:
   MonotonicTs latest_srr_;
   // receive gts
   MonotonicTs receive_gts_ts_;
+  // the max stc of the requests which wait for the rpc on road instead of sending a new one
+  MonotonicTs deferred_stc_;
 };
 
 } // transaction
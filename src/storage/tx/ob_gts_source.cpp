@@ -35,6 +35,7 @@ void ObGtsStatistics::reset()
   tenant_id_ = 0;
   last_stat_ts_ = 0;
   gts_rpc_cnt_ = 0;
+  deferred_gts_rpc_cnt_ = 0;
   get_gts_cache_cnt_ = 0;
   get_gts_with_stc_cnt_ = 0;
   try_get_gts_cache_cnt_ = 0;
@@ -62,6 +63,7 @@ void ObGtsStatistics::statistics()
       TRANS_LOG(INFO, "gts statistics",
                       K_(tenant_id),
                       "gts_rpc_cnt", ATOMIC_LOAD(&gts_rpc_cnt_),
+                      "deferred_gts_rpc_cnt", ATOMIC_LOAD(&deferred_gts_rpc_cnt_),
                       "get_gts_cache_cnt", ATOMIC_LOAD(&get_gts_cache_cnt_),
                       "get_gts_with_stc_cnt", ATOMIC_LOAD(&get_gts_with_stc_cnt_),
                       "try_get_gts_cache_cnt", ATOMIC_LOAD(&try_get_gts_cache_cnt_),
@@ -69,6 +71,7 @@ void ObGtsStatistics::statistics()
                       "wait_gts_elapse_cnt", ATOMIC_LOAD(&wait_gts_elapse_cnt_),
                       "try_wait_gts_elapse_cnt", ATOMIC_LOAD(&try_wait_gts_elapse_cnt_));
       ATOMIC_STORE(&gts_rpc_cnt_, 0);
+      ATOMIC_STORE(&deferred_gts_rpc_cnt_, 0);
       ATOMIC_STORE(&get_gts_cache_cnt_, 0);
       ATOMIC_STORE(&get_gts_with_stc_cnt_, 0);
       ATOMIC_STORE(&try_get_gts_cache_cnt_, 0);
@@ -246,7 +249,7 @@ int ObGtsSource::get_gts(const MonotonicTs stc,
       }
     } else {
       // If not in local, refresh gts
-      if (need_send_rpc) {
+      if (need_send_rpc && !need_defer_query_gts_(stc)) {
         if (OB_SUCCESS != (tmp_ret = query_gts_(leader))) {
           TRANS_LOG(WARN, "query gts fail", K(tmp_ret), K(leader));
         }
@@ -572,6 +575,31 @@ int ObGtsSource::query_gts_(const ObAddr &leader)
   return ret;
 }
 
+// Every get_gts with a stc newer than the latest rpc sends a new rpc, so under high
+// request rate there is nearly one rpc per request. With _gts_request_batch_interval,
+// a request arriving when an rpc sent within the interval is on the road waits for
+// the response of that rpc instead, and handle_gts_result sends one rpc for all the
+// deferred requests. The rpc sent after stc is still required, so the gts is
+// external consistent as before.
+bool ObGtsSource::need_defer_query_gts_(const MonotonicTs stc)
+{
+  bool bool_ret = false;
+  const int64_t batch_interval = GCONF._gts_request_batch_interval;
+  if (batch_interval > 0 && !gts_local_cache_.no_rpc_on_road()) {
+    const MonotonicTs latest_srr = gts_local_cache_.get_latest_srr();
+    if (MonotonicTs::current_time().mts_ - latest_srr.mts_ < batch_interval
+        && OB_SUCCESS == gts_local_cache_.update_deferred_stc(stc)) {
+      // check again after publishing stc, otherwise the response may has been
+      // handled without seeing it
+      bool_ret = !gts_local_cache_.no_rpc_on_road();
+    }
+  }
+  if (bool_ret) {
+    gts_statistics_.inc_deferred_gts_rpc_cnt();
+  }
+  return bool_ret;
+}
+
 int ObGtsSource::refresh_gts_location_()
 {
   int ret = OB_SUCCESS;
@@ -671,18 +699,23 @@ int ObGtsSource::handle_gts_result(const uint64_t tenant_id, const int64_t queue
     TRANS_LOG(WARN, "get srr and gts failed", KR(ret));
   } else {
     ObGTSTaskQueue *queue = &(queue_[queue_index]);
+    bool need_refresh = false;
     if (OB_FAIL(queue->foreach_task(srr, gts, receive_gts_ts))) {
       if (OB_EAGAIN == ret) {
         ret = OB_SUCCESS;
-        if (gts_local_cache_.no_rpc_on_road()) {
-          int tmp_ret = OB_SUCCESS;
-          if (OB_SUCCESS != (tmp_ret = refresh_gts_(false))) {
-            TRANS_LOG(WARN, "refresh gts failed", K(tmp_ret));
-          }
-        }
+        need_refresh = true;
       } else {
         TRANS_LOG(WARN, "iterate task failed", KR(ret), K(queue_index));
       }
+    } else {
+      // the requests deferred by need_defer_query_gts_ may not be in the queue
+      need_refresh = gts_local_cache_.has_deferred_request();
+    }
+    if (need_refresh && gts_local_cache_.no_rpc_on_road()) {
+      int tmp_ret = OB_SUCCESS;
+      if (OB_SUCCESS != (tmp_ret = refresh_gts_(false))) {
+        TRANS_LOG(WARN, "refresh gts failed", K(tmp_ret));
+      }
     }
   }
   return ret;
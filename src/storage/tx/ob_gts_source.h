@@ -45,6 +45,7 @@ public:
   int init(const uint64_t tenant_id);
   void reset();
   void inc_gts_rpc_cnt() { ATOMIC_INC(&gts_rpc_cnt_); }
+  void inc_deferred_gts_rpc_cnt() { ATOMIC_INC(&deferred_gts_rpc_cnt_); }
   void inc_get_gts_cache_cnt() { ATOMIC_INC(&get_gts_cache_cnt_); }
   void inc_get_gts_with_stc_cnt() { ATOMIC_INC(&get_gts_with_stc_cnt_); }
   void inc_try_get_gts_cache_cnt() { ATOMIC_INC(&try_get_gts_cache_cnt_); }
@@ -56,6 +57,7 @@ private:
   uint64_t tenant_id_;
   int64_t last_stat_ts_;
   int64_t gts_rpc_cnt_;
+  int64_t deferred_gts_rpc_cnt_;
 
   int64_t get_gts_cache_cnt_;
   int64_t get_gts_with_stc_cnt_;
@@ -98,6 +100,7 @@ private:
   int refresh_gts_location_();
   int refresh_gts_(const bool need_refresh);
   int query_gts_(const common::ObAddr &leader);
+  bool need_defer_query_gts_(const MonotonicTs stc);
   void statistics_();
   int get_gts_from_local_timestamp_service_(common::ObAddr &leader,
                                             int64_t &gts,
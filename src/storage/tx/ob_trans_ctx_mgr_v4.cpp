@@ -229,8 +229,8 @@ void ObLSTxCtxMgr::reset()
   ls_id_.reset();
   tx_table_ = NULL;
   lock_table_ = NULL;
-  total_tx_ctx_count_ = 0;
-  active_tx_count_ = 0;
+  total_tx_ctx_count_.reset();
+  active_tx_count_.reset();
   total_active_readonly_request_count_ = 0;
   total_request_by_transfer_dest_ = 0;
   leader_takeover_ts_.reset();
@@ -1109,7 +1109,7 @@ int ObLSTxCtxMgr::get_ls_min_uncommit_tx_prepare_version(SCN &min_prepare_versio
 {
   int ret = OB_SUCCESS;
 
-  if (ATOMIC_LOAD(&total_tx_ctx_count_) > 0 || ls_tx_ctx_map_.count() > 0) {
+  if (get_tx_ctx_count_() > 0 || ls_tx_ctx_map_.count() > 0) {
     IterateMinPrepareVersionFunctor fn;
     if (OB_FAIL(ls_tx_ctx_map_.for_each(fn))) {
       TRANS_LOG(WARN, "for each transaction context error", KR(ret), "manager", *this);
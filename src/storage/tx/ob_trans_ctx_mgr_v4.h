@@ -17,6 +17,7 @@
 #include "ob_tx_stat.h"
 #include "storage/tx_table/ob_tx_table_define.h"
 #include "common/ob_simple_iterator.h"
+#include "lib/metrics/ob_counter.h"
 #include "storage/tx/ob_trans_ctx.h"
 #include "storage/tx/ob_tx_ls_log_writer.h"
 #include "storage/tx/ob_tx_ls_state_mgr.h"
@@ -312,7 +313,7 @@ public:
   int64_t get_tx_ctx_count() const { return get_tx_ctx_count_(); }
 
   // Get the count of active transactions which have not been committed or aborted
-  int64_t get_active_tx_count() const { return ATOMIC_LOAD(&active_tx_count_); }
+  int64_t get_active_tx_count() const { return active_tx_count_.value(); }
 
   // Check all active and not "for_replay" tx_ctx in this ObLSTxCtxMgr
   // whether all the transactions that modify the specified tablet before
@@ -382,16 +383,16 @@ public:
 
 public:
   // Increase this ObLSTxCtxMgr's total_tx_ctx_count
-  void inc_total_tx_ctx_count() { (void)ATOMIC_AAF(&total_tx_ctx_count_, 1); }
+  void inc_total_tx_ctx_count() { total_tx_ctx_count_.inc(); }
 
   // Decrease this ObLSTxCtxMgr's total_tx_ctx_count
-  void dec_total_tx_ctx_count() { (void)ATOMIC_AAF(&total_tx_ctx_count_, -1); }
+  void dec_total_tx_ctx_count() { total_tx_ctx_count_.dec(); }
 
   // Increase active trx count in this ls
-  void inc_active_tx_count() { (void)ATOMIC_AAF(&active_tx_count_, 1); }
+  void inc_active_tx_count() { active_tx_count_.inc(); }
 
   // Decrease active trx count in this ls
-  void dec_active_tx_count() { (void)ATOMIC_AAF(&active_tx_count_, -1); }
+  void dec_active_tx_count() { active_tx_count_.dec(); }
 
   void inc_total_active_readonly_request_count()
   {
@@ -583,8 +584,8 @@ public:
                K_(ls_id),
                K_(tenant_id),
                K_(tx_ls_state_mgr),
-               K_(total_tx_ctx_count),
-               K_(active_tx_count),
+               "total_tx_ctx_count", get_tx_ctx_count_(),
+               "active_tx_count", get_active_tx_count(),
                K_(ls_retain_ctx_mgr),
                K_(aggre_rec_scn),
                K_(prev_aggre_rec_scn),
@@ -602,7 +603,7 @@ private:
 private:
   int process_callback_(ObTxCommitCallback *&cb_list) const;
   void print_all_tx_ctx_(const int64_t max_print, const bool verbose);
-  int64_t get_tx_ctx_count_() const { return ATOMIC_LOAD(&total_tx_ctx_count_); }
+  int64_t get_tx_ctx_count_() const { return total_tx_ctx_count_.value(); }
   int create_tx_ctx_(const ObTxCreateArg &arg,
                      bool &existed,
                      ObPartTransCtx *&ctx);
@@ -683,12 +684,16 @@ private:
   //                     rwlock_ -> minor_merge_lock_
   mutable RWLock minor_merge_lock_;
 
-  // Total TxCtx count in this ObLSTxCtxMgr
-  int64_t total_tx_ctx_count_ CACHE_ALIGNED;
+  // Total TxCtx count in this ObLSTxCtxMgr.
+  // Both counters are written by every ctx create and destroy, so they are per-cpu
+  // (the entry count of ls_tx_ctx_map_ is striped by bucket for the same reason)
+  // and these writes don't bounce one cache line. The sum is exact once creating
+  // new ctx is blocked.
+  common::ObPCCounter total_tx_ctx_count_;
 
   int64_t total_active_readonly_request_count_ CACHE_ALIGNED;
 
-  int64_t active_tx_count_;
+  common::ObPCCounter active_tx_count_;
 
   // for transfer dest_ls depend src_ls
   int64_t total_request_by_transfer_dest_;
@@ -721,7 +721,7 @@ public:
                                           is_stopped,
                                           mgr_state,
                                           state_str,
-                                          ls_tx_ctx_mgr->total_tx_ctx_count_,
+                                          ls_tx_ctx_mgr->get_tx_ctx_count(),
                                           (int64_t)(&(*ls_tx_ctx_mgr)));
         if (OB_SUCCESS != tmp_ret) {
           TRANS_LOG_RET(WARN, tmp_ret, "ObLSTxCtxMgrStat init error", K_(addr), "ls_tx_ctx_mgr", *ls_tx_ctx_mgr);
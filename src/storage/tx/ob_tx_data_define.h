@@ -417,21 +417,55 @@ class ObTxDataMiniCache
 private:
   static const int32_t TX_DATA_MINI_LRU_ITEM_CNT = 1 << 2; /* 4 */
   static const int32_t MINI_LRU_CONCURRENCY_MOD_MASK = TX_DATA_MINI_LRU_ITEM_CNT - 1;
+  // every item caches the tx data of a few transactions, a reader scanning
+  // rows written by interleaved transactions would thrash a single entry
+  static const int32_t TX_DATA_MINI_LRU_WAY_CNT = 1 << 2; /* 4 */
 
   struct CacheItem {
-    ObTxCommitData tx_data_;
-    bool is_valid_;
+    // tx ids are packed together so that the lookup compares all of them
+    // without branches
+    int64_t tx_ids_[TX_DATA_MINI_LRU_WAY_CNT];
+    ObTxCommitData tx_data_[TX_DATA_MINI_LRU_WAY_CNT];
+    int64_t victim_;
     common::SpinRWLock lock_;
 
-    CacheItem() : tx_data_(), is_valid_(false) {}
+    CacheItem() : victim_(0) { reset(); }
 
     void reset()
     {
-      tx_data_.reset();
-      is_valid_ = false;
+      for (int32_t i = 0; i < TX_DATA_MINI_LRU_WAY_CNT; i++) {
+        tx_ids_[i] = 0;
+        tx_data_[i].reset();
+      }
+      victim_ = 0;
     }
 
-    TO_STRING_KV(K_(tx_data), K_(is_valid));
+    int64_t find(const transaction::ObTransID tx_id) const
+    {
+      const int64_t id = tx_id.get_id();
+      int64_t idx = -1;
+      for (int32_t i = 0; i < TX_DATA_MINI_LRU_WAY_CNT; i++) {
+        idx = (tx_ids_[i] == id) ? i : idx;
+      }
+      return idx;
+    }
+
+    int64_t to_string(char *buf, const int64_t buf_len) const
+    {
+      int64_t pos = 0;
+      int64_t cnt = 0;
+      J_ARRAY_START();
+      for (int32_t i = 0; i < TX_DATA_MINI_LRU_WAY_CNT; i++) {
+        if (0 != tx_ids_[i]) {
+          if (cnt++ > 0) {
+            J_COMMA();
+          }
+          databuff_print_obj(buf, buf_len, pos, tx_data_[i]);
+        }
+      }
+      J_ARRAY_END();
+      return pos;
+    }
   };
 
 public:
@@ -439,13 +473,11 @@ public:
   {
     int ret = OB_SUCCESS;
     int64_t thread_idx = get_itid() & MINI_LRU_CONCURRENCY_MOD_MASK;
-    SpinRLockGuard guard(cache_items_[thread_idx].lock_);
-    if (cache_items_[thread_idx].is_valid_) {
-      if (tx_id == cache_items_[thread_idx].tx_data_.tx_id_) {
-        tx_commit_data = cache_items_[thread_idx].tx_data_;
-      } else {
-        ret = OB_TRANS_CTX_NOT_EXIST;
-      }
+    CacheItem &item = cache_items_[thread_idx];
+    SpinRLockGuard guard(item.lock_);
+    const int64_t idx = tx_id.is_valid() ? item.find(tx_id) : -1;
+    if (idx >= 0) {
+      tx_commit_data = item.tx_data_[idx];
     } else {
       ret = OB_TRANS_CTX_NOT_EXIST;
     }
@@ -455,10 +487,13 @@ public:
   void set(const ObTxCommitData &tx_commit_data)
   {
     int64_t thread_idx = get_itid() & MINI_LRU_CONCURRENCY_MOD_MASK;
-    SpinWLockGuard guard(cache_items_[thread_idx].lock_);
-    if (cache_items_[thread_idx].tx_data_.tx_id_ != tx_commit_data.tx_id_) {
-      cache_items_[thread_idx].tx_data_ = tx_commit_data;
-      cache_items_[thread_idx].is_valid_ = true;
+    CacheItem &item = cache_items_[thread_idx];
+    SpinWLockGuard guard(item.lock_);
+    if (tx_commit_data.tx_id_.is_valid() && item.find(tx_commit_data.tx_id_) < 0) {
+      const int64_t idx = item.victim_;
+      item.tx_ids_[idx] = tx_commit_data.tx_id_.get_id();
+      item.tx_data_[idx] = tx_commit_data;
+      item.victim_ = (idx + 1) % TX_DATA_MINI_LRU_WAY_CNT;
     }
   }
 
@@ -478,12 +513,7 @@ public:
       } else {
         databuff_printf(buf, buf_len, pos, ", %d:", i);
       }
-
-      if (OB_UNLIKELY(cache_items_[i].is_valid_)) {
-        databuff_print_obj(buf, buf_len, pos, cache_items_[i]);
-      } else {
-        databuff_printf(buf, buf_len, pos, "{}");
-      }
+      databuff_print_obj(buf, buf_len, pos, cache_items_[i]);
     }
     J_ARRAY_END();
     return pos;
@@ -0,0 +1,361 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_UNITTEST_LOGSERVICE_MOCK_CONTAINER_PALF_ENV_IMPL_
+#define OCEANBASE_UNITTEST_LOGSERVICE_MOCK_CONTAINER_PALF_ENV_IMPL_
+
+#include "logservice/palf/palf_env_impl.h"
+#include "logservice/palf/palf_handle_impl.h"
+
+namespace oceanbase
+{
+namespace palf
+{
+
+// Do-nothing IPalfEnvImpl, tests override the methods they depend on.
+class MockPalfEnvImpl : public IPalfEnvImpl
+{
+public:
+  MockPalfEnvImpl() {}
+  virtual ~MockPalfEnvImpl() {}
+  int get_palf_handle_impl(const int64_t palf_id,
+                           IPalfHandleImplGuard &palf_handle_impl) override { return OB_SUCCESS; }
+  int get_palf_handle_impl(const int64_t palf_id,
+                           IPalfHandleImpl *&palf_handle_impl) override { return OB_SUCCESS; }
+  int create_palf_handle_impl(const int64_t palf_id,
+                              const AccessMode &access_mode,
+                              const PalfBaseInfo &base_info,
+                              IPalfHandleImpl *&palf_handle_impl) override { return OB_SUCCESS; }
+  int remove_palf_handle_impl(const int64_t palf_id) override { return OB_SUCCESS; }
+  void revert_palf_handle_impl(IPalfHandleImpl *palf_handle_impl) override {}
+  common::ObILogAllocator *get_log_allocator() override { return NULL; }
+  int for_each(const common::ObFunction<int(IPalfHandleImpl *ipalf_handle_impl)> &func) override
+  { return OB_SUCCESS; }
+  int create_directory(const char *base_dir) override { return OB_SUCCESS; }
+  int remove_directory(const char *base_dir) override { return OB_SUCCESS; }
+  bool check_disk_space_enough() override { return false; }
+  int64_t get_rebuild_replica_log_lag_threshold() const override { return 0; }
+  int get_io_start_time(int64_t &last_working_time) override { return OB_SUCCESS; }
+  int64_t get_tenant_id() override { return 0; }
+  int update_replayable_point(const SCN &replayable_scn) override { return OB_SUCCESS; }
+  int get_throttling_options(PalfThrottleOptions &option) override { return OB_SUCCESS; }
+  void period_calc_disk_usage() override {}
+  LogSharedQueueTh *get_log_shared_queue_thread() override { return NULL; }
+  int get_options(PalfOptions &options) override { return OB_SUCCESS; }
+};
+
+// Do-nothing IPalfHandleImpl, tests override the methods they depend on.
+class MockPalfHandleImpl : public IPalfHandleImpl
+{
+public:
+  MockPalfHandleImpl() : mock_lsn_() {}
+  virtual ~MockPalfHandleImpl() {}
+  bool check_can_be_used() const override { return false; }
+  int set_initial_member_list(const common::ObMemberList &member_list,
+                              const int64_t paxos_replica_num,
+                              const common::GlobalLearnerList &learner_list) override
+  { return OB_SUCCESS; }
+#ifdef OB_BUILD_ARBITRATION
+  int set_initial_member_list(const common::ObMemberList &member_list,
+                              const common::ObMember &arb_member,
+                              const int64_t paxos_replica_num,
+                              const common::GlobalLearnerList &learner_list) override
+  { return OB_SUCCESS; }
+  int get_remote_arb_member_info(ArbMemberInfo &arb_member_info) override { return OB_SUCCESS; }
+  int get_arb_member_info(ArbMemberInfo &arb_member_info) const override { return OB_SUCCESS; }
+  int get_arbitration_member(common::ObMember &arb_member) const override { return OB_SUCCESS; }
+#endif
+  int submit_log(const PalfAppendOptions &opts,
+                 const char *buf,
+                 const int64_t buf_len,
+                 const share::SCN &ref_scn,
+                 LSN &lsn,
+                 share::SCN &scn) override { return OB_SUCCESS; }
+  int submit_group_log(const PalfAppendOptions &opts,
+                       const LSN &lsn,
+                       const char *buf,
+                       const int64_t buf_len) override { return OB_SUCCESS; }
+  int get_role(common::ObRole &role,
+               int64_t &proposal_id,
+               bool &is_pending_state) const override { return OB_SUCCESS; }
+  int get_palf_id(int64_t &palf_id) const override { return OB_SUCCESS; }
+  int change_leader_to(const common::ObAddr &dest_addr) override { return OB_SUCCESS; }
+  int get_global_learner_list(common::GlobalLearnerList &learner_list) const override
+  { return OB_SUCCESS; }
+  int get_paxos_member_list(common::ObMemberList &member_list,
+                            int64_t &paxos_replica_num) const override { return OB_SUCCESS; }
+  int get_config_version(LogConfigVersion &config_version) const override { return OB_SUCCESS; }
+  int get_paxos_member_list_and_learner_list(common::ObMemberList &member_list,
+                                             int64_t &paxos_replica_num,
+                                             common::GlobalLearnerList &learner_list) const override
+  { return OB_SUCCESS; }
+  int get_election_leader(common::ObAddr &addr) const override { return OB_SUCCESS; }
+  int get_parent(common::ObAddr &parent) const override { return OB_SUCCESS; }
+  int change_replica_num(const common::ObMemberList &member_list,
+                         const int64_t curr_replica_num,
+                         const int64_t new_replica_num,
+                         const int64_t timeout_us) override { return OB_SUCCESS; }
+  int force_set_as_single_replica() override { return OB_SUCCESS; }
+  int add_member(const common::ObMember &member,
+                 const int64_t new_replica_num,
+                 const LogConfigVersion &config_version,
+                 const int64_t timeout_us) override { return OB_SUCCESS; }
+  int remove_member(const common::ObMember &member,
+                    const int64_t new_replica_num,
+                    const int64_t timeout_us) override { return OB_SUCCESS; }
+  int replace_member(const common::ObMember &added_member,
+                     const common::ObMember &removed_member,
+                     const LogConfigVersion &config_version,
+                     const int64_t timeout_us) override { return OB_SUCCESS; }
+  int add_learner(const common::ObMember &added_learner,
+                  const int64_t timeout_us) override { return OB_SUCCESS; }
+  int remove_learner(const common::ObMember &removed_learner,
+                     const int64_t timeout_us) override { return OB_SUCCESS; }
+  int switch_learner_to_acceptor(const common::ObMember &learner,
+                                 const int64_t new_replica_num,
+                                 const LogConfigVersion &config_version,
+                                 const int64_t timeout_us) override { return OB_SUCCESS; }
+  int switch_acceptor_to_learner(const common::ObMember &member,
+                                 const int64_t new_replica_num,
+                                 const int64_t timeout_us) override { return OB_SUCCESS; }
+  int replace_learners(const common::ObMemberList &added_learners,
+                       const common::ObMemberList &removed_learners,
+                       const int64_t timeout_us) override { return OB_SUCCESS; }
+  int replace_member_with_learner(const common::ObMember &added_member,
+                                  const common::ObMember &removed_member,
+                                  const LogConfigVersion &config_version,
+                                  const int64_t timeout_us) override { return OB_SUCCESS; }
+#ifdef OB_BUILD_ARBITRATION
+  int add_arb_member(const common::ObMember &added_member,
+                     const int64_t timeout_us) override { return OB_SUCCESS; }
+  int remove_arb_member(const common::ObMember &arb_member,
+                        const int64_t timeout_us) override { return OB_SUCCESS; }
+  int degrade_acceptor_to_learner(const LogMemberAckInfoList &degrade_servers,
+                                  const int64_t timeout_us) override { return OB_SUCCESS; }
+  int upgrade_learner_to_acceptor(const LogMemberAckInfoList &upgrade_servers,
+                                  const int64_t timeout_us) override { return OB_SUCCESS; }
+#endif
+  int set_base_lsn(const LSN &lsn) override { return OB_SUCCESS; }
+  int enable_sync() override { return OB_SUCCESS; }
+  int disable_sync() override { return OB_SUCCESS; }
+  void set_deleted() override {}
+  bool is_sync_enabled() const override { return false; }
+  int advance_base_info(const PalfBaseInfo &palf_base_info,
+                        const bool is_rebuild) override { return OB_SUCCESS; }
+  int locate_by_scn_coarsely(const share::SCN &scn, LSN &result_lsn) override { return OB_SUCCESS; }
+  int locate_by_lsn_coarsely(const LSN &lsn, share::SCN &result_scn) override { return OB_SUCCESS; }
+  int get_begin_lsn(LSN &lsn) const override { return OB_SUCCESS; }
+  int get_begin_scn(share::SCN &scn) override { return OB_SUCCESS; }
+  int get_base_lsn(LSN &lsn) const override { return OB_SUCCESS; }
+  int get_base_info(const LSN &base_lsn, PalfBaseInfo &base_info) override { return OB_SUCCESS; }
+  int get_min_block_info_for_gc(block_id_t &min_block_id,
+                                share::SCN &max_scn) override { return OB_SUCCESS; }
+  const LSN get_end_lsn() const override { return LSN(); }
+  LSN get_max_lsn() const override { return LSN(); }
+  const share::SCN get_max_scn() const override { return share::SCN(); }
+  const share::SCN get_end_scn() const override { return share::SCN(); }
+  int get_last_rebuild_lsn(LSN &last_rebuild_lsn) const override { return OB_SUCCESS; }
+  const LSN get_readable_end_lsn() const override { return LSN(); }
+  int get_total_used_disk_space(int64_t &total_used_disk_space,
+                                int64_t &unrecyclable_disk_space) const override
+  { return OB_SUCCESS; }
+  const LSN &get_base_lsn_used_for_block_gc() const override { return mock_lsn_; }
+  int get_ack_info_array(LogMemberAckInfoList &ack_info_array,
+                         common::GlobalLearnerList &degraded_list) const override
+  { return OB_SUCCESS; }
+  int delete_block(const block_id_t &block_id) override { return OB_SUCCESS; }
+  int inner_after_flush_log(const FlushLogCbCtx &flush_log_cb_ctx) override { return OB_SUCCESS; }
+  int inner_after_truncate_log(const TruncateLogCbCtx &truncate_log_cb_ctx) override
+  { return OB_SUCCESS; }
+  int inner_after_flush_meta(const FlushMetaCbCtx &flush_meta_cb_ctx) override
+  { return OB_SUCCESS; }
+  int inner_after_truncate_prefix_blocks(const TruncatePrefixBlocksCbCtx &truncate_prefix_cb_ctx) override
+  { return OB_SUCCESS; }
+  int advance_reuse_lsn(const LSN &flush_log_end_lsn) override { return OB_SUCCESS; }
+  int inner_after_flashback(const FlashbackCbCtx &flashback_ctx) override { return OB_SUCCESS; }
+  int inner_append_log(const LSN &lsn,
+                       const LogWriteBuf &write_buf,
+                       const share::SCN &scn) override { return OB_SUCCESS; }
+  int inner_append_log(const LSNArray &lsn_array,
+                       const LogWriteBufArray &write_buf_array,
+                       const SCNArray &scn_array) override { return OB_SUCCESS; }
+  int inner_append_meta(const char *buf, const int64_t buf_len) override { return OB_SUCCESS; }
+  int inner_truncate_log(const LSN &lsn) override { return OB_SUCCESS; }
+  int inner_truncate_prefix_blocks(const LSN &lsn) override { return OB_SUCCESS; }
+  int inner_flashback(const share::SCN &flashback_scn) override { return OB_SUCCESS; }
+  int check_and_switch_state() override { return OB_SUCCESS; }
+  int check_and_switch_freeze_mode() override { return OB_SUCCESS; }
+  bool is_in_period_freeze_mode() const override { return false; }
+  int period_freeze_last_log() override { return OB_SUCCESS; }
+  int handle_prepare_request(const common::ObAddr &server,
+                             const int64_t &proposal_id) override { return OB_SUCCESS; }
+  int handle_prepare_response(const common::ObAddr &server,
+                              const int64_t &proposal_id,
+                              const bool vote_granted,
+                              const int64_t &accept_proposal_id,
+                              const LSN &last_lsn,
+                              const LSN &committed_end_lsn,
+                              const LogModeMeta &log_mode_meta) override { return OB_SUCCESS; }
+  int handle_election_message(const election::ElectionPrepareRequestMsg &msg) override
+  { return OB_SUCCESS; }
+  int handle_election_message(const election::ElectionPrepareResponseMsg &msg) override
+  { return OB_SUCCESS; }
+  int handle_election_message(const election::ElectionAcceptRequestMsg &msg) override
+  { return OB_SUCCESS; }
+  int handle_election_message(const election::ElectionAcceptResponseMsg &msg) override
+  { return OB_SUCCESS; }
+  int handle_election_message(const election::ElectionChangeLeaderMsg &msg) override
+  { return OB_SUCCESS; }
+  int receive_log(const common::ObAddr &server,
+                  const PushLogType push_log_type,
+                  const int64_t &proposal_id,
+                  const LSN &prev_lsn,
+                  const int64_t &prev_proposal_id,
+                  const LSN &lsn,
+                  const char *buf,
+                  const int64_t buf_len) override { return OB_SUCCESS; }
+  int receive_batch_log(const common::ObAddr &server,
+                        const int64_t msg_proposal_id,
+                        const int64_t prev_log_proposal_id,
+                        const LSN &prev_lsn,
+                        const LSN &curr_lsn,
+                        const char *buf,
+                        const int64_t buf_len) override { return OB_SUCCESS; }
+  int ack_log(const common::ObAddr &server,
+              const int64_t &proposal_id,
+              const LSN &log_end_lsn) override { return OB_SUCCESS; }
+  int get_log(const common::ObAddr &server,
+              const FetchLogType fetch_type,
+              const int64_t msg_proposal_id,
+              const LSN &prev_lsn,
+              const LSN &start_lsn,
+              const int64_t fetch_log_size,
+              const int64_t fetch_log_count,
+              const int64_t accepted_mode_pid) override { return OB_SUCCESS; }
+  int fetch_log_from_storage(const common::ObAddr &server,
+                             const FetchLogType fetch_type,
+                             const int64_t &req_proposal_id,
+                             const LSN &prev_log_offset,
+                             const LSN &log_offset,
+                             const int64_t fetch_log_size,
+                             const int64_t fetch_log_count,
+                             const int64_t accepted_mode_pid,
+                             const SCN &replayable_point,
+                             FetchLogStat &fetch_stat) override { return OB_SUCCESS; }
+  int receive_config_log(const common::ObAddr &server,
+                         const int64_t &msg_proposal_id,
+                         const int64_t &prev_log_proposal_id,
+                         const LSN &prev_lsn,
+                         const int64_t &prev_mode_pid,
+                         const LogConfigMeta &meta) override { return OB_SUCCESS; }
+  int ack_config_log(const common::ObAddr &server,
+                     const int64_t proposal_id,
+                     const LogConfigVersion &config_version) override { return OB_SUCCESS; }
+  int receive_mode_meta(const common::ObAddr &server,
+                        const int64_t msg_proposal_id,
+                        const bool is_applied_mode_meta,
+                        const LogModeMeta &meta) override { return OB_SUCCESS; }
+  int ack_mode_meta(const common::ObAddr &server,
+                    const int64_t proposal_id) override { return OB_SUCCESS; }
+  int handle_notify_fetch_log_req(const common::ObAddr &server) override { return OB_SUCCESS; }
+  int handle_notify_rebuild_req(const common::ObAddr &server,
+                                const LSN &base_lsn,
+                                const LogInfo &base_prev_log_info) override { return OB_SUCCESS; }
+  int handle_config_change_pre_check(const ObAddr &server,
+                                     const LogGetMCStReq &req,
+                                     LogGetMCStResp &resp) override { return OB_SUCCESS; }
+  int handle_register_parent_req(const LogLearner &child,
+                                 const bool is_to_leader) override { return OB_SUCCESS; }
+  int handle_register_parent_resp(const LogLearner &server,
+                                  const LogCandidateList &candidate_list,
+                                  const RegisterReturn reg_ret) override { return OB_SUCCESS; }
+  int handle_learner_req(const LogLearner &server,
+                         const LogLearnerReqType req_type) override { return OB_SUCCESS; }
+  int set_scan_disk_log_finished() override { return OB_SUCCESS; }
+  int change_access_mode(const int64_t proposal_id,
+                         const int64_t mode_version,
+                         const AccessMode &access_mode,
+                         const share::SCN &ref_scn) override { return OB_SUCCESS; }
+  int get_access_mode(int64_t &mode_version,
+                      AccessMode &access_mode) const override { return OB_SUCCESS; }
+  int get_access_mode(AccessMode &access_mode) const override { return OB_SUCCESS; }
+  int get_access_mode_version(int64_t &mode_version) const override { return OB_SUCCESS; }
+  int get_access_mode_ref_scn(int64_t &mode_version,
+                              AccessMode &access_mode,
+                              SCN &ref_scn) const override { return OB_SUCCESS; }
+  int handle_committed_info(const common::ObAddr &server,
+                            const int64_t &msg_proposal_id,
+                            const int64_t prev_log_id,
+                            const int64_t &prev_log_proposal_id,
+                            const LSN &committed_end_lsn) override { return OB_SUCCESS; }
+  bool is_vote_enabled() const override { return false; }
+  int disable_vote(const bool need_check_log_missing) override { return OB_SUCCESS; }
+  int enable_vote() override { return OB_SUCCESS; }
+  int alloc_palf_buffer_iterator(const LSN &offset,
+                                 PalfBufferIterator &iterator) override { return OB_SUCCESS; }
+  int alloc_palf_buffer_iterator(const SCN &scn,
+                                 PalfBufferIterator &iterator) override { return OB_SUCCESS; }
+  int alloc_palf_group_buffer_iterator(const LSN &offset,
+                                       PalfGroupBufferIterator &iterator) override
+  { return OB_SUCCESS; }
+  int alloc_palf_group_buffer_iterator(const share::SCN &scn,
+                                       PalfGroupBufferIterator &iterator) override
+  { return OB_SUCCESS; }
+  int register_file_size_cb(palf::PalfFSCbNode *fs_cb) override { return OB_SUCCESS; }
+  int unregister_file_size_cb(palf::PalfFSCbNode *fs_cb) override { return OB_SUCCESS; }
+  int register_role_change_cb(palf::PalfRoleChangeCbNode *role_change_cb) override
+  { return OB_SUCCESS; }
+  int unregister_role_change_cb(palf::PalfRoleChangeCbNode *role_change_cb) override
+  { return OB_SUCCESS; }
+  int register_rebuild_cb(palf::PalfRebuildCbNode *rebuild_cb) override { return OB_SUCCESS; }
+  int unregister_rebuild_cb(palf::PalfRebuildCbNode *rebuild_cb) override { return OB_SUCCESS; }
+  int set_location_cache_cb(PalfLocationCacheCb *lc_cb) override { return OB_SUCCESS; }
+  int reset_location_cache_cb() override { return OB_SUCCESS; }
+  int set_election_priority(election::ElectionPriority *priority) override { return OB_SUCCESS; }
+  int reset_election_priority() override { return OB_SUCCESS; }
+  int set_locality_cb(palf::PalfLocalityInfoCb *locality_cb) override { return OB_SUCCESS; }
+  int reset_locality_cb() override { return OB_SUCCESS; }
+  int advance_election_epoch_and_downgrade_priority(const int64_t proposal_id,
+                                                    const int64_t downgrade_priority_time_us,
+                                                    const char *reason) override
+  { return OB_SUCCESS; }
+  int flashback(const int64_t mode_version,
+                const share::SCN &flashback_scn,
+                const int64_t timeout_us) override { return OB_SUCCESS; }
+  int stat(PalfStat &palf_stat) override { return OB_SUCCESS; }
+  int get_palf_epoch(int64_t &palf_epoch) const override { return OB_SUCCESS; }
+  int try_lock_config_change(int64_t lock_owner, int64_t timeout_us) override { return OB_SUCCESS; }
+  int unlock_config_change(int64_t lock_owner, int64_t timeout_us) override { return OB_SUCCESS; }
+  int get_config_change_lock_stat(int64_t &lock_owner,
+                                  bool &is_locked) override { return OB_SUCCESS; }
+  int diagnose(PalfDiagnoseInfo &diagnose_info) const override { return OB_SUCCESS; }
+  int update_palf_stat() override { return OB_SUCCESS; }
+  int read_data_from_buffer(const LSN &read_begin_lsn,
+                            const int64_t in_read_size,
+                            char *buf,
+                            int64_t &out_read_size) const override { return OB_SUCCESS; }
+  int raw_read(const palf::LSN &lsn,
+               char *read_buf,
+               const int64_t nbytes,
+               int64_t &read_size,
+               palf::LogIOContext &io_ctx) override { return OB_SUCCESS; }
+  int try_handle_next_submit_log() override { return OB_SUCCESS; }
+  int fill_cache_when_slide(const LSN &read_begin_lsn,
+                            const int64_t in_read_size) override { return OB_SUCCESS; }
+protected:
+  LSN mock_lsn_;
+};
+
+} // end namespace palf
+} // end namespace oceanbase
+
+#endif
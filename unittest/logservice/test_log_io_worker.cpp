@@ -0,0 +1,330 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "lib/ob_errno.h"
+#include "lib/allocator/page_arena.h"
+#include "lib/alloc/ob_malloc_allocator.h"
+#define protected public
+#define private public
+#include "logservice/palf/log_io_worker.h"
+#include "logservice/palf/log_io_task.h"
+#include "logservice/palf/log_io_task_cb_thread_pool.h"
+#include "share/allocator/ob_tenant_mutil_allocator.h"
+#undef private
+#undef protected
+#include "mock_logservice_container/mock_palf_env_impl.h"
+#include "share/rc/ob_tenant_base.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace share;
+using namespace palf;
+
+namespace unittest
+{
+const static uint64_t TENANT_ID = 1001;
+const static int64_t PALF_EPOCH = 1;
+const static int64_t LOG_SIZE = 4096;
+const static int64_t PALF_NUM = 8;
+const static int64_t BATCH_DEPTH = 4;
+
+// counters shared by all palf instances of a test
+struct FlushStat
+{
+  FlushStat() : flying_append_cnt_(0), max_flying_append_cnt_(0), flushed_cnt_(0) {}
+  int64_t flying_append_cnt_;
+  int64_t max_flying_append_cnt_;
+  int64_t flushed_cnt_;
+};
+
+class TestPalfHandleImpl : public MockPalfHandleImpl
+{
+public:
+  TestPalfHandleImpl()
+    : stat_(NULL), append_ret_(OB_SUCCESS), append_sleep_us_(0), reuse_lsn_()
+  {}
+  int get_palf_epoch(int64_t &palf_epoch) const override
+  {
+    palf_epoch = PALF_EPOCH;
+    return OB_SUCCESS;
+  }
+  int inner_append_log(const LSNArray &lsn_array,
+                       const LogWriteBufArray &write_buf_array,
+                       const SCNArray &scn_array) override
+  {
+    int ret = append_ret_;
+    const int64_t flying_cnt = ATOMIC_AAF(&stat_->flying_append_cnt_, 1);
+    int64_t max_cnt = ATOMIC_LOAD(&stat_->max_flying_append_cnt_);
+    while (flying_cnt > max_cnt
+           && max_cnt != ATOMIC_VCAS(&stat_->max_flying_append_cnt_, max_cnt, flying_cnt)) {
+      max_cnt = ATOMIC_LOAD(&stat_->max_flying_append_cnt_);
+    }
+    // the sync latency of O_DIRECT | O_SYNC write
+    if (append_sleep_us_ > 0) {
+      ob_usleep(append_sleep_us_);
+    }
+    if (OB_SUCC(ret)) {
+      for (int64_t i = 0; i < lsn_array.count(); i++) {
+        appended_lsns_.push_back(lsn_array[i]);
+      }
+    }
+    ATOMIC_DEC(&stat_->flying_append_cnt_);
+    return ret;
+  }
+  int advance_reuse_lsn(const LSN &flush_log_end_lsn) override
+  {
+    reuse_lsn_ = flush_log_end_lsn;
+    return OB_SUCCESS;
+  }
+  int inner_after_flush_log(const FlushLogCbCtx &flush_log_cb_ctx) override
+  {
+    flushed_lsns_.push_back(flush_log_cb_ctx.lsn_);
+    ATOMIC_INC(&stat_->flushed_cnt_);
+    return OB_SUCCESS;
+  }
+  void reuse()
+  {
+    append_ret_ = OB_SUCCESS;
+    reuse_lsn_.reset();
+    appended_lsns_.clear();
+    flushed_lsns_.clear();
+  }
+public:
+  FlushStat *stat_;
+  int append_ret_;
+  int64_t append_sleep_us_;
+  LSN reuse_lsn_;
+  std::vector<LSN> appended_lsns_;
+  // written by the single callback thread
+  std::vector<LSN> flushed_lsns_;
+};
+
+class TestPalfEnvImpl : public MockPalfEnvImpl
+{
+public:
+  TestPalfEnvImpl() : alloc_mgr_(NULL) {}
+  int get_palf_handle_impl(const int64_t palf_id, IPalfHandleImplGuard &guard) override
+  {
+    int ret = OB_SUCCESS;
+    if (palf_id < 0 || palf_id >= PALF_NUM) {
+      ret = OB_ENTRY_NOT_EXIST;
+    } else {
+      guard.palf_id_ = palf_id;
+      guard.palf_handle_impl_ = &handles_[palf_id];
+      guard.palf_env_impl_ = this;
+    }
+    return ret;
+  }
+  common::ObILogAllocator *get_log_allocator() override { return alloc_mgr_; }
+public:
+  common::ObTenantMutilAllocator *alloc_mgr_;
+  TestPalfHandleImpl handles_[PALF_NUM];
+};
+
+class TestLogIOWorker : public ::testing::Test
+{
+public:
+  TestLogIOWorker()
+    : tenant_base_(TENANT_ID),
+      wait_cost_stat_("[TEST IO TASK IN QUEUE TIME]", 1000 * 1000)
+  {}
+  void SetUp() override
+  {
+    ObTenantEnv::set_tenant(&tenant_base_);
+    ObMemAttr attr(TENANT_ID, ObModIds::OB_TENANT_MUTIL_ALLOCATOR);
+    void *buf = ob_malloc(sizeof(common::ObTenantMutilAllocator), attr);
+    ASSERT_TRUE(NULL != buf);
+    env_.alloc_mgr_ = new (buf) common::ObTenantMutilAllocator(TENANT_ID);
+    for (int64_t i = 0; i < PALF_NUM; i++) {
+      env_.handles_[i].stat_ = &stat_;
+    }
+    MEMSET(log_buf_, 'a', sizeof(log_buf_));
+    ASSERT_EQ(OB_SUCCESS, cb_pool_.init(LogIOTaskCbThreadPool::MAX_LOG_IO_CB_TASK_NUM, &env_));
+    ASSERT_EQ(OB_SUCCESS, cb_pool_.start());
+    ASSERT_EQ(OB_SUCCESS, mgr_.init(PALF_NUM, BATCH_DEPTH, &allocator_,
+                                    &wait_cost_stat_));
+  }
+  void TearDown() override
+  {
+    mgr_.destroy();
+    cb_pool_.destroy();
+    env_.alloc_mgr_->~ObTenantMutilAllocator();
+    ob_free(env_.alloc_mgr_);
+    env_.alloc_mgr_ = NULL;
+  }
+  // insert BATCH_DEPTH logs of each palf instance, interleaved by palf
+  void insert_tasks()
+  {
+    for (int64_t d = 0; d < BATCH_DEPTH; d++) {
+      for (int64_t palf_id = 0; palf_id < PALF_NUM; palf_id++) {
+        LogIOFlushLogTask *task = env_.alloc_mgr_->alloc_log_io_flush_log_task(palf_id, PALF_EPOCH);
+        ASSERT_TRUE(NULL != task);
+        SCN scn;
+        ASSERT_EQ(OB_SUCCESS, scn.convert_for_logservice(d + 1));
+        FlushLogCbCtx cb_ctx(d, scn, LSN(d * LOG_SIZE), 1, LOG_SIZE, 1,
+                             ObTimeUtility::current_time());
+        LogWriteBuf write_buf;
+        ASSERT_EQ(OB_SUCCESS, write_buf.push_back(log_buf_, LOG_SIZE));
+        ASSERT_EQ(OB_SUCCESS, task->init(cb_ctx, write_buf));
+        ASSERT_EQ(OB_SUCCESS, mgr_.insert(task));
+      }
+    }
+    ASSERT_FALSE(mgr_.empty());
+  }
+  void wait_flushed(const int64_t expected_cnt)
+  {
+    const int64_t start_ts = ObTimeUtility::current_time();
+    while (ATOMIC_LOAD(&stat_.flushed_cnt_) < expected_cnt
+           && ObTimeUtility::current_time() - start_ts < 10 * 1000 * 1000) {
+      ob_usleep(1000);
+    }
+    ASSERT_EQ(expected_cnt, ATOMIC_LOAD(&stat_.flushed_cnt_));
+  }
+  // logs of each palf instance are appended and called back in lsn order
+  void check_palf(const int64_t palf_id)
+  {
+    const TestPalfHandleImpl &handle = env_.handles_[palf_id];
+    ASSERT_EQ(BATCH_DEPTH, static_cast<int64_t>(handle.appended_lsns_.size()));
+    ASSERT_EQ(BATCH_DEPTH, static_cast<int64_t>(handle.flushed_lsns_.size()));
+    for (int64_t d = 0; d < BATCH_DEPTH; d++) {
+      ASSERT_EQ(LSN(d * LOG_SIZE), handle.appended_lsns_[d]) << "palf_id=" << palf_id;
+      ASSERT_EQ(LSN(d * LOG_SIZE), handle.flushed_lsns_[d]) << "palf_id=" << palf_id;
+    }
+    ASSERT_EQ(LSN(BATCH_DEPTH * LOG_SIZE), handle.reuse_lsn_);
+  }
+  void reuse()
+  {
+    stat_.max_flying_append_cnt_ = 0;
+    stat_.flushed_cnt_ = 0;
+    for (int64_t i = 0; i < PALF_NUM; i++) {
+      env_.handles_[i].reuse();
+    }
+  }
+protected:
+  ObTenantBase tenant_base_;
+  ObArenaAllocator allocator_;
+  ObMiniStat::ObStatItem wait_cost_stat_;
+  FlushStat stat_;
+  TestPalfEnvImpl env_;
+  LogIOTaskCbThreadPool cb_pool_;
+  LogIOWorker::BatchLogIOFlushLogTaskMgr mgr_;
+  char log_buf_[LOG_SIZE];
+};
+
+TEST_F(TestLogIOWorker, serial_flush)
+{
+  for (int64_t i = 0; i < PALF_NUM; i++) {
+    env_.handles_[i].append_sleep_us_ = 1000;
+  }
+  insert_tasks();
+  ASSERT_EQ(OB_SUCCESS, mgr_.handle(cb_pool_.get_tg_id(), &env_, NULL));
+  ASSERT_TRUE(mgr_.empty());
+  wait_flushed(PALF_NUM * BATCH_DEPTH);
+  for (int64_t i = 0; i < PALF_NUM; i++) {
+    check_palf(i);
+  }
+  ASSERT_EQ(1, stat_.max_flying_append_cnt_);
+  ASSERT_EQ(0, ATOMIC_LOAD(&env_.alloc_mgr_->flying_log_task_));
+}
+
+TEST_F(TestLogIOWorker, parallel_flush)
+{
+  LogIOWorker::ParallelFlushHelper helper;
+  // helpers are not started, the LogIOWorker thread does all tasks
+  ASSERT_EQ(OB_SUCCESS, helper.init(3));
+  insert_tasks();
+  ASSERT_EQ(OB_SUCCESS, mgr_.handle(cb_pool_.get_tg_id(), &env_, &helper));
+  wait_flushed(PALF_NUM * BATCH_DEPTH);
+  for (int64_t i = 0; i < PALF_NUM; i++) {
+    check_palf(i);
+  }
+
+  // the writes of different palf instances overlap, for several rounds
+  ASSERT_EQ(OB_SUCCESS, helper.start());
+  for (int64_t i = 0; i < PALF_NUM; i++) {
+    env_.handles_[i].append_sleep_us_ = 20 * 1000;
+  }
+  for (int64_t round = 0; round < 5; round++) {
+    reuse();
+    insert_tasks();
+    ASSERT_EQ(OB_SUCCESS, mgr_.handle(cb_pool_.get_tg_id(), &env_, &helper));
+    ASSERT_TRUE(mgr_.empty());
+    // handle returns after all palf instances are appended
+    for (int64_t i = 0; i < PALF_NUM; i++) {
+      ASSERT_EQ(BATCH_DEPTH, static_cast<int64_t>(env_.handles_[i].appended_lsns_.size()));
+    }
+    wait_flushed(PALF_NUM * BATCH_DEPTH);
+    for (int64_t i = 0; i < PALF_NUM; i++) {
+      check_palf(i);
+    }
+    ASSERT_LT(1, stat_.max_flying_append_cnt_) << "round=" << round;
+    ASSERT_GE(4, stat_.max_flying_append_cnt_) << "round=" << round;
+  }
+  ASSERT_EQ(0, ATOMIC_LOAD(&env_.alloc_mgr_->flying_log_task_));
+  helper.destroy();
+}
+
+TEST_F(TestLogIOWorker, parallel_flush_failed)
+{
+  LogIOWorker::ParallelFlushHelper helper;
+  const int64_t failed_palf_id = 3;
+  ASSERT_EQ(OB_SUCCESS, helper.init(3));
+  ASSERT_EQ(OB_SUCCESS, helper.start());
+  for (int64_t i = 0; i < PALF_NUM; i++) {
+    env_.handles_[i].append_sleep_us_ = 1000;
+  }
+  env_.handles_[failed_palf_id].append_ret_ = OB_IO_ERROR;
+  insert_tasks();
+  // the failure is reported and the other palf instances are still flushed
+  ASSERT_EQ(OB_IO_ERROR, mgr_.handle(cb_pool_.get_tg_id(), &env_, &helper));
+  ASSERT_TRUE(mgr_.empty());
+  wait_flushed((PALF_NUM - 1) * BATCH_DEPTH);
+  for (int64_t i = 0; i < PALF_NUM; i++) {
+    if (failed_palf_id == i) {
+      ASSERT_TRUE(env_.handles_[i].appended_lsns_.empty());
+      ASSERT_TRUE(env_.handles_[i].flushed_lsns_.empty());
+    } else {
+      check_palf(i);
+    }
+  }
+  // tasks of the failed palf instance are freed too
+  ASSERT_EQ(0, ATOMIC_LOAD(&env_.alloc_mgr_->flying_log_task_));
+
+  // next batch is not affected
+  reuse();
+  insert_tasks();
+  ASSERT_EQ(OB_SUCCESS, mgr_.handle(cb_pool_.get_tg_id(), &env_, &helper));
+  wait_flushed(PALF_NUM * BATCH_DEPTH);
+  for (int64_t i = 0; i < PALF_NUM; i++) {
+    check_palf(i);
+  }
+  helper.destroy();
+}
+
+} // end namespace unittest
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f ./test_log_io_worker.log*");
+  OB_LOGGER.set_file_name("test_log_io_worker.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  PALF_LOG(INFO, "begin unittest::test_log_io_worker");
+  int ret = oceanbase::lib::ObMallocAllocator::get_instance()->create_and_add_tenant_allocator(
+      oceanbase::unittest::TENANT_ID);
+  OB_ASSERT(oceanbase::common::OB_SUCCESS == ret);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,622 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <map>
+#define private public
+#define protected public
+#include "sql/engine/expr/ob_expr_jit_filter.h"
+#include "sql/engine/expr/ob_expr_cmp_func.h"
+#include "sql/engine/expr/ob_expr_add.h"
+#include "sql/engine/expr/ob_expr_minus.h"
+#include "sql/engine/expr/ob_expr_mul.h"
+#include "sql/engine/expr/ob_expr_not.h"
+#include "sql/engine/expr/ob_expr_case.h"
+#include "sql/engine/expr/ob_expr_null_safe_equal.h"
+#include "sql/engine/ob_exec_context.h"
+#include "objit/ob_llvm_helper.h"
+#include "lib/allocator/page_arena.h"
+#include "lib/random/ob_random.h"
+#include "share/rc/ob_tenant_base.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace share;
+namespace sql
+{
+// eval functions of AND/OR, defined in ob_expr_and.cpp and ob_expr_or.cpp
+int calc_and_exprN(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &res_datum);
+int calc_or_exprN(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &res_datum);
+
+// Compare the compiled filter kernels of both leaf layouts with a row by row
+// evaluation of the same expression tree which follows the semantics of the
+// interpreted expressions: three-valued AND/OR/NOT, NULL propagation of
+// comparisons and arithmetic, NULL-safe <=>, first matched CASE branch.
+// Filters without unary minus and cast are also evaluated by the eval
+// functions of the interpreter, which the kernels must agree with.
+class TestExprJitFilter : public ::testing::Test
+{
+public:
+  static const int64_t ROW_CNT = 200;
+  static const int64_t COL_CNT = 3;
+  struct RowVal
+  {
+    int64_t val_;
+    bool null_;
+    bool overflow_;
+  };
+
+  TestExprJitFilter() : alloc_("TestExprJit") {}
+  static void SetUpTestCase()
+  {
+    static ObTenantBase tenant_ctx(OB_SYS_TENANT_ID);
+    ObTenantEnv::set_tenant(&tenant_ctx);
+    ASSERT_EQ(OB_SUCCESS, jit::ObLLVMHelper::initialize());
+  }
+  virtual void SetUp() override
+  {
+    for (int64_t c = 0; c < COL_CNT; c++) {
+      cols_[c] = new_expr(T_REF_COLUMN, ObIntType, 0);
+    }
+    param_ = new_expr(T_QUESTIONMARK, ObIntType, 0);
+    gen_data(10, 20);
+  }
+  virtual void TearDown() override
+  {
+    alloc_.reset();
+  }
+
+  ObExpr *new_expr(const ObExprOperatorType type, const ObObjType res_type, const int64_t arg_cnt)
+  {
+    ObExpr *e = OB_NEWx(ObExpr, (&alloc_));
+    e->type_ = type;
+    e->datum_meta_.type_ = res_type;
+    e->arg_cnt_ = static_cast<uint32_t>(arg_cnt);
+    if (arg_cnt > 0) {
+      e->args_ = static_cast<ObExpr **>(alloc_.alloc(sizeof(ObExpr *) * arg_cnt));
+    }
+    return e;
+  }
+  ObExpr *op(const ObExprOperatorType type, ObExpr *l, ObExpr *r = NULL)
+  {
+    const bool is_bool = (T_OP_ADD != type && T_OP_MINUS != type && T_OP_MUL != type && T_OP_NEG != type);
+    ObExpr *e = new_expr(type, is_bool ? ObInt32Type : ObIntType, NULL == r ? 1 : 2);
+    e->args_[0] = l;
+    if (NULL != r) {
+      e->args_[1] = r;
+    }
+    return e;
+  }
+  ObExpr *nary(const ObExprOperatorType type, const ObObjType res_type, ObExpr **args, const int64_t cnt)
+  {
+    ObExpr *e = new_expr(type, res_type, cnt);
+    for (int64_t i = 0; i < cnt; i++) {
+      e->args_[i] = args[i];
+    }
+    return e;
+  }
+  ObExpr *int_const(const int64_t v)
+  {
+    ObExpr *e = new_expr(T_INT, ObIntType, 0);
+    consts_[e] = v;
+    return e;
+  }
+
+  // column values in [-range, range], about one of null_mod rows is null
+  void gen_data(const int64_t range, const int64_t null_mod)
+  {
+    for (int64_t c = 0; c < COL_CNT; c++) {
+      for (int64_t r = 0; r < ROW_CNT; r++) {
+        data_[c][r] = ObRandom::rand(-range, range);
+        nulls_[c][r] = (0 == ObRandom::rand(0, null_mod - 1));
+      }
+    }
+    param_val_ = 3;
+    param_null_ = false;
+  }
+
+  RowVal eval(const ObExpr &e, const int64_t r)
+  {
+    RowVal res = {0, false, false};
+    if (T_REF_COLUMN == e.type_) {
+      for (int64_t c = 0; c < COL_CNT; c++) {
+        if (&e == cols_[c]) {
+          res.val_ = data_[c][r];
+          res.null_ = nulls_[c][r];
+        }
+      }
+    } else if (T_QUESTIONMARK == e.type_) {
+      res.val_ = param_val_;
+      res.null_ = param_null_;
+    } else if (T_INT == e.type_) {
+      res.val_ = consts_[&e];
+    } else if (T_OP_AND == e.type_ || T_OP_OR == e.type_) {
+      const bool is_and = (T_OP_AND == e.type_);
+      bool decided = false;
+      bool any_null = false;
+      for (int64_t i = 0; i < e.arg_cnt_; i++) {
+        // every argument is evaluated as the kernel does, only for the overflow check
+        const RowVal v = eval(*e.args_[i], r);
+        res.overflow_ |= v.overflow_;
+        any_null |= v.null_;
+        decided |= (!v.null_ && (is_and ? 0 == v.val_ : 0 != v.val_));
+      }
+      res.null_ = !decided && any_null;
+      res.val_ = is_and ? (!decided && !any_null) : decided;
+    } else if (T_OP_NOT == e.type_) {
+      const RowVal v = eval(*e.args_[0], r);
+      res.overflow_ = v.overflow_;
+      res.null_ = v.null_;
+      res.val_ = (0 == v.val_);
+    } else if (T_OP_CASE == e.type_) {
+      const bool has_else = (e.arg_cnt_ % 2 != 0);
+      bool matched = false;
+      res.null_ = true;
+      for (int64_t i = 0; i + 1 < e.arg_cnt_; i += 2) {
+        const RowVal when = eval(*e.args_[i], r);
+        const RowVal then = eval(*e.args_[i + 1], r);
+        res.overflow_ |= when.overflow_ | then.overflow_;
+        if (!matched && !when.null_ && 0 != when.val_) {
+          matched = true;
+          res.val_ = then.val_;
+          res.null_ = then.null_;
+        }
+      }
+      if (has_else) {
+        const RowVal v = eval(*e.args_[e.arg_cnt_ - 1], r);
+        res.overflow_ |= v.overflow_;
+        if (!matched) {
+          res.val_ = v.val_;
+          res.null_ = v.null_;
+        }
+      }
+    } else if (T_FUN_SYS_CAST == e.type_) {
+      res = eval(*e.args_[0], r);
+    } else {
+      RowVal l = {0, false, false};
+      RowVal rv = {0, false, false};
+      if (T_OP_NEG == e.type_) {
+        rv = eval(*e.args_[0], r);
+      } else {
+        l = eval(*e.args_[0], r);
+        rv = eval(*e.args_[1], r);
+      }
+      res.overflow_ = l.overflow_ | rv.overflow_;
+      res.null_ = l.null_ || rv.null_;
+      bool overflow = false;
+      switch (e.type_) {
+        case T_OP_EQ: res.val_ = l.val_ == rv.val_; break;
+        case T_OP_NE: res.val_ = l.val_ != rv.val_; break;
+        case T_OP_LT: res.val_ = l.val_ < rv.val_; break;
+        case T_OP_LE: res.val_ = l.val_ <= rv.val_; break;
+        case T_OP_GT: res.val_ = l.val_ > rv.val_; break;
+        case T_OP_GE: res.val_ = l.val_ >= rv.val_; break;
+        case T_OP_NSEQ: {
+          res.val_ = (l.null_ && rv.null_) || (!l.null_ && !rv.null_ && l.val_ == rv.val_);
+          res.null_ = false;
+          break;
+        }
+        case T_OP_ADD: overflow = __builtin_add_overflow(l.val_, rv.val_, &res.val_); break;
+        case T_OP_MINUS:
+        case T_OP_NEG: overflow = __builtin_sub_overflow(l.val_, rv.val_, &res.val_); break;
+        case T_OP_MUL: overflow = __builtin_mul_overflow(l.val_, rv.val_, &res.val_); break;
+        default: break;
+      }
+      // overflow of a null result is not an error
+      res.overflow_ |= (overflow && !res.null_);
+    }
+    return res;
+  }
+
+  // Bind the eval functions the code generator chooses for bigint arguments
+  // and give every expression a datum in the frame. Return false if some
+  // expression is not bound here, i.e. unary minus or cast.
+  bool bind_interpreter(ObExpr &e, std::map<const ObExpr *, int64_t> &slots)
+  {
+    bool bound = true;
+    if (slots.count(&e) > 0) {
+      // shared sub expression
+    } else {
+      const int64_t slot_size = sizeof(ObDatum) + sizeof(ObEvalInfo) + sizeof(int64_t);
+      const int64_t idx = static_cast<int64_t>(slots.size());
+      slots[&e] = idx;
+      e.frame_idx_ = 0;
+      e.datum_off_ = static_cast<uint32_t>(slot_size * idx);
+      e.eval_info_off_ = static_cast<uint32_t>(e.datum_off_ + sizeof(ObDatum));
+      e.res_buf_off_ = static_cast<uint32_t>(e.eval_info_off_ + sizeof(ObEvalInfo));
+      e.res_buf_len_ = sizeof(int64_t);
+      e.batch_result_ = false;
+      ObCmpOp cmp_op = CO_MAX;
+      switch (e.type_) {
+        case T_REF_COLUMN:
+        case T_QUESTIONMARK:
+        case T_INT: e.eval_func_ = NULL; break;
+        case T_OP_AND: e.eval_func_ = calc_and_exprN; break;
+        case T_OP_OR: e.eval_func_ = calc_or_exprN; break;
+        case T_OP_NOT: e.eval_func_ = ObExprNot::eval_not; break;
+        case T_OP_CASE: e.eval_func_ = ObExprCase::calc_case_expr; break;
+        case T_OP_ADD: e.eval_func_ = ObExprAdd::add_int_int; break;
+        case T_OP_MINUS: e.eval_func_ = ObExprMinus::minus_int_int; break;
+        case T_OP_MUL: e.eval_func_ = ObExprMul::mul_int_int; break;
+        case T_OP_EQ: cmp_op = CO_EQ; break;
+        case T_OP_NE: cmp_op = CO_NE; break;
+        case T_OP_LT: cmp_op = CO_LT; break;
+        case T_OP_LE: cmp_op = CO_LE; break;
+        case T_OP_GT: cmp_op = CO_GT; break;
+        case T_OP_GE: cmp_op = CO_GE; break;
+        case T_OP_NSEQ: {
+          void **funcs = static_cast<void **>(alloc_.alloc(sizeof(void *)));
+          funcs[0] = reinterpret_cast<void *>(ObExprCmpFuncsHelper::get_datum_expr_cmp_func(
+              ObIntType, ObIntType, 0, 0, 0, 0, false, CS_TYPE_BINARY, false));
+          e.inner_functions_ = funcs;
+          e.inner_func_cnt_ = 1;
+          e.eval_func_ = ObExprNullSafeEqual::ns_equal_eval;
+          break;
+        }
+        default: bound = false; break;
+      }
+      if (CO_MAX != cmp_op) {
+        e.eval_func_ = ObExprCmpFuncsHelper::get_eval_expr_cmp_func(
+            ObIntType, ObIntType, 0, 0, 0, 0, cmp_op, false, CS_TYPE_BINARY, false);
+      }
+      for (int64_t i = 0; bound && i < e.arg_cnt_; i++) {
+        bound = bind_interpreter(*e.args_[i], slots);
+      }
+    }
+    return bound;
+  }
+
+  // Evaluate %filters row by row with the interpreter, as filter_rows() does
+  // a filter is not evaluated for rows filtered by the filters before it.
+  // Return false if the interpreter failed on some row.
+  bool interpret(ObExpr **filters,
+                 const int64_t filter_cnt,
+                 const uint64_t *skip,
+                 std::map<const ObExpr *, int64_t> &slots,
+                 bool *pass)
+  {
+    bool succ = true;
+    ObArenaAllocator exec_alloc("TestExprJit");
+    ObExecContext exec_ctx(exec_alloc);
+    ObEvalCtx eval_ctx(exec_ctx);
+    const int64_t slot_size = sizeof(ObDatum) + sizeof(ObEvalInfo) + sizeof(int64_t);
+    char *frame = static_cast<char *>(alloc_.alloc(slot_size * slots.size()));
+    char *frames[] = {frame};
+    eval_ctx.frames_ = frames;
+    for (int64_t r = 0; r < ROW_CNT; r++) {
+      pass[r] = false;
+      if (0 != (skip[r / 64] & (1ULL << (r % 64)))) {
+        continue;
+      }
+      MEMSET(frame, 0, slot_size * slots.size());
+      for (std::map<const ObExpr *, int64_t>::const_iterator it = slots.begin(); it != slots.end(); ++it) {
+        const ObExpr &e = *it->first;
+        if (NULL == e.eval_func_) {
+          ObDatum &d = *reinterpret_cast<ObDatum *>(frame + e.datum_off_);
+          const RowVal v = eval(e, r);
+          d.ptr_ = frame + e.res_buf_off_;
+          if (v.null_) {
+            d.set_null();
+          } else {
+            d.set_int(v.val_);
+          }
+        }
+      }
+      pass[r] = true;
+      for (int64_t i = 0; succ && pass[r] && i < filter_cnt; i++) {
+        ObDatum *d = NULL;
+        if (OB_SUCCESS != filters[i]->eval(eval_ctx, d)) {
+          succ = false;
+        } else {
+          pass[r] = d->is_true();
+        }
+      }
+    }
+    return succ;
+  }
+
+  void fill_leaves(const ObExprJitFilter &f, const ObExprJitFilter::LeafLayout layout, ObExprJitLeafParam *params)
+  {
+    for (int64_t i = 0; i < f.leaves_.count(); i++) {
+      const ObExpr *e = f.leaves_.at(i);
+      ObExprJitLeafParam &p = params[i];
+      MEMSET(&p, 0, sizeof(p));
+      int64_t col = -1;
+      for (int64_t c = 0; c < COL_CNT; c++) {
+        if (e == cols_[c]) {
+          col = c;
+        }
+      }
+      if (col >= 0) {
+        p.stride_ = 1;
+        if (ObExprJitFilter::FIXED_LAYOUT == layout) {
+          MEMSET(fixed_nulls_[col], 0, sizeof(fixed_nulls_[col]));
+          for (int64_t r = 0; r < ROW_CNT; r++) {
+            if (nulls_[col][r]) {
+              fixed_nulls_[col][r / 64] |= (1ULL << (r % 64));
+            }
+          }
+          p.data_ = reinterpret_cast<const char *>(data_[col]);
+          p.nulls_ = fixed_nulls_[col];
+        } else {
+          for (int64_t r = 0; r < ROW_CNT; r++) {
+            ObDatum &d = datums_[col][r];
+            if (nulls_[col][r]) {
+              // the pointer of a null datum must not be read
+              d.ptr_ = NULL;
+              d.set_null();
+            } else {
+              d.ptr_ = reinterpret_cast<const char *>(&data_[col][r]);
+              d.pack_ = sizeof(int64_t);
+            }
+          }
+          p.data_ = reinterpret_cast<const char *>(datums_[col]);
+        }
+      } else {
+        // scalar leaf, as prepare_leaves() sets them up
+        int64_t v = 0;
+        bool is_null = false;
+        if (e == param_) {
+          v = param_val_;
+          is_null = param_null_;
+        } else {
+          v = consts_[e];
+        }
+        scalar_vals_[i] = v;
+        if (ObExprJitFilter::FIXED_LAYOUT == layout) {
+          p.scalar_val_ = is_null ? 0 : v;
+          p.scalar_null_ = is_null ? 1 : 0;
+          p.data_ = reinterpret_cast<const char *>(&p.scalar_val_);
+          p.nulls_ = &p.scalar_null_;
+        } else {
+          ObDatum &d = scalar_datums_[i];
+          if (is_null) {
+            d.ptr_ = NULL;
+            d.set_null();
+          } else {
+            d.ptr_ = reinterpret_cast<const char *>(&scalar_vals_[i]);
+            d.pack_ = sizeof(int64_t);
+          }
+          p.data_ = reinterpret_cast<const char *>(&d);
+        }
+      }
+    }
+  }
+
+  // Compile %filters and check both kernels against eval(), every %skip_mod-th
+  // row is skipped before filtering. %expect_bail: some row overflows.
+  void check(ObExpr **filters, const int64_t filter_cnt, const int64_t skip_mod, const bool expect_bail)
+  {
+    ObArenaAllocator plan_alloc("TestExprJit");
+    ObExprJitCompiler compiler(plan_alloc);
+    ObSEArray<ObExpr *, 4> filter_arr;
+    ObSEArray<ObExpr *, 4> input_exprs;
+    ObExprJitFilter *jit_filter = NULL;
+    for (int64_t i = 0; i < filter_cnt; i++) {
+      ASSERT_EQ(OB_SUCCESS, filter_arr.push_back(filters[i]));
+    }
+    ASSERT_EQ(OB_SUCCESS, compiler.add_filter(filter_arr, input_exprs, jit_filter));
+    ASSERT_TRUE(NULL != jit_filter);
+    ASSERT_EQ(OB_SUCCESS, compiler.compile());
+    ASSERT_TRUE(jit_filter->is_compiled());
+
+    // expected result of the interpreter
+    uint64_t init_skip[ROW_CNT / 64 + 1];
+    bool expected_pass[ROW_CNT];
+    bool has_overflow = false;
+    int64_t expected_output = 0;
+    int64_t expected_filtered = 0;
+    MEMSET(init_skip, 0, sizeof(init_skip));
+    for (int64_t r = 0; r < ROW_CNT; r++) {
+      expected_pass[r] = false;
+      if (skip_mod > 0 && 0 == r % skip_mod) {
+        init_skip[r / 64] |= (1ULL << (r % 64));
+      } else {
+        bool pass = true;
+        for (int64_t i = 0; i < filter_cnt; i++) {
+          const RowVal v = eval(*filters[i], r);
+          has_overflow |= v.overflow_;
+          pass = pass && !v.null_ && 0 != v.val_;
+        }
+        expected_pass[r] = pass;
+        expected_output += pass;
+        expected_filtered += !pass;
+      }
+    }
+    ASSERT_EQ(expect_bail, has_overflow);
+
+    // result of the eval functions of the interpreter
+    std::map<const ObExpr *, int64_t> slots;
+    bool interpretable = true;
+    bool interpreted_pass[ROW_CNT];
+    for (int64_t i = 0; interpretable && i < filter_cnt; i++) {
+      interpretable = bind_interpreter(*filters[i], slots);
+    }
+    if (interpretable) {
+      if (!interpret(filters, filter_cnt, init_skip, slots, interpreted_pass)) {
+        // an error raised by the interpreter is never hidden by the kernel
+        ASSERT_TRUE(has_overflow);
+      } else if (!has_overflow) {
+        for (int64_t r = 0; r < ROW_CNT; r++) {
+          ASSERT_EQ(expected_pass[r], interpreted_pass[r]) << "row " << r;
+        }
+      }
+    }
+
+    for (int64_t l = 0; l < ObExprJitFilter::MAX_LAYOUT; l++) {
+      const ObExprJitFilter::LeafLayout layout = static_cast<ObExprJitFilter::LeafLayout>(l);
+      ObExprJitLeafParam params[ObExprJitFilter::MAX_LEAF_CNT];
+      uint64_t skip[ROW_CNT / 64 + 1];
+      int64_t filtered_cnt = 0;
+      MEMCPY(skip, init_skip, sizeof(skip));
+      fill_leaves(*jit_filter, layout, params);
+      const int64_t output = jit_filter->funcs_[layout](params, skip, ROW_CNT, &filtered_cnt);
+      if (has_overflow) {
+        // the interpreter evaluates the batch and raises the error
+        ASSERT_EQ(-1, output) << "layout " << l;
+      } else {
+        ASSERT_EQ(expected_output, output) << "layout " << l;
+        ASSERT_EQ(expected_filtered, filtered_cnt) << "layout " << l;
+        for (int64_t r = 0; r < ROW_CNT; r++) {
+          const bool is_skipped = 0 != (skip[r / 64] & (1ULL << (r % 64)));
+          ASSERT_EQ(!expected_pass[r], is_skipped) << "layout " << l << " row " << r;
+        }
+      }
+    }
+  }
+
+public:
+  ObArenaAllocator alloc_;
+  ObExpr *cols_[COL_CNT];
+  ObExpr *param_;
+  int64_t param_val_;
+  bool param_null_;
+  std::map<const ObExpr *, int64_t> consts_;
+  int64_t data_[COL_CNT][ROW_CNT];
+  bool nulls_[COL_CNT][ROW_CNT];
+  uint64_t fixed_nulls_[COL_CNT][ROW_CNT / 64 + 1];
+  ObDatum datums_[COL_CNT][ROW_CNT];
+  int64_t scalar_vals_[ObExprJitFilter::MAX_LEAF_CNT];
+  ObDatum scalar_datums_[ObExprJitFilter::MAX_LEAF_CNT];
+};
+
+TEST_F(TestExprJitFilter, null_under_logic)
+{
+  // NOT (c0 > c1 AND c2 < ?) OR c1 = c2
+  ObExpr *and_args[] = {op(T_OP_GT, cols_[0], cols_[1]), op(T_OP_LT, cols_[2], param_)};
+  ObExpr *or_args[] = {op(T_OP_NOT, nary(T_OP_AND, ObInt32Type, and_args, 2)), op(T_OP_EQ, cols_[1], cols_[2])};
+  ObExpr *f1 = nary(T_OP_OR, ObInt32Type, or_args, 2);
+  // c0 <> 0 AND (c1 >= c0 OR c2 <= 1 OR c0 = c2)
+  ObExpr *or3_args[] = {op(T_OP_GE, cols_[1], cols_[0]), op(T_OP_LE, cols_[2], int_const(1)),
+                        op(T_OP_EQ, cols_[0], cols_[2])};
+  ObExpr *and2_args[] = {op(T_OP_NE, cols_[0], int_const(0)), nary(T_OP_OR, ObInt32Type, or3_args, 3)};
+  ObExpr *f2 = nary(T_OP_AND, ObInt32Type, and2_args, 2);
+  ObExpr *filters[] = {f1, f2};
+  for (int64_t null_mod = 1; null_mod <= 8; null_mod *= 2) {
+    gen_data(4, null_mod);
+    check(filters, 1, 0, false);
+    check(&filters[1], 1, 7, false);
+    check(filters, 2, 3, false);
+    // null param
+    param_null_ = true;
+    check(filters, 2, 0, false);
+  }
+}
+
+TEST_F(TestExprJitFilter, case_when)
+{
+  // CASE WHEN c0 > 0 THEN c1 WHEN c0 < -2 THEN c2 ELSE ? END > 1
+  ObExpr *case_args[] = {op(T_OP_GT, cols_[0], int_const(0)), cols_[1],
+                         op(T_OP_LT, cols_[0], int_const(-2)), cols_[2], param_};
+  ObExpr *f1 = op(T_OP_GT, nary(T_OP_CASE, ObIntType, case_args, 5), int_const(1));
+  // CASE WHEN c2 = 1 THEN c0 WHEN c2 >= 1 THEN c1 END <= 0, no else is null
+  ObExpr *case2_args[] = {op(T_OP_EQ, cols_[2], int_const(1)), cols_[0],
+                          op(T_OP_GE, cols_[2], int_const(1)), cols_[1]};
+  ObExpr *f2 = op(T_OP_LE, nary(T_OP_CASE, ObIntType, case2_args, 4), int_const(0));
+  ObExpr *filters[] = {f1, f2};
+  for (int64_t null_mod = 1; null_mod <= 8; null_mod *= 2) {
+    gen_data(5, null_mod);
+    check(filters, 1, 0, false);
+    check(&filters[1], 1, 5, false);
+    param_null_ = true;
+    check(filters, 1, 0, false);
+  }
+}
+
+TEST_F(TestExprJitFilter, null_safe_equal)
+{
+  // c0 <=> c1, NOT (c1 <=> ?)
+  ObExpr *filters[] = {op(T_OP_NSEQ, cols_[0], cols_[1]), op(T_OP_NOT, op(T_OP_NSEQ, cols_[1], param_))};
+  for (int64_t null_mod = 1; null_mod <= 8; null_mod *= 2) {
+    gen_data(2, null_mod);
+    check(filters, 1, 0, false);
+    check(&filters[1], 1, 0, false);
+    param_null_ = true;
+    check(filters, 2, 4, false);
+  }
+}
+
+TEST_F(TestExprJitFilter, arithmetic_overflow)
+{
+  // c0 * c1 + (-c2) > ?, CAST(c0 - c1) < 100
+  ObExpr *cast = new_expr(T_FUN_SYS_CAST, ObIntType, 2);
+  cast->args_[0] = op(T_OP_MINUS, cols_[0], cols_[1]);
+  cast->args_[1] = int_const(0);
+  ObExpr *filters[] = {op(T_OP_GT, op(T_OP_ADD, op(T_OP_MUL, cols_[0], cols_[1]), op(T_OP_NEG, cols_[2])), param_),
+                       op(T_OP_LT, cast, int_const(100))};
+  gen_data(1000, 4);
+  check(filters, 2, 0, false);
+
+  // overflow of a row makes the kernel bail out
+  gen_data(1000, 1000000);
+  data_[0][17] = INT64_MAX / 2;
+  data_[1][17] = 3;
+  check(filters, 1, 0, true);
+  // ... unless the row is skipped
+  check(filters, 1, 17, false);
+  // ... or the result is null
+  nulls_[1][17] = true;
+  check(filters, 1, 0, false);
+  // the interpreter raises the overflow the kernel bails out for
+  ObExpr *g = op(T_OP_LE, op(T_OP_ADD, op(T_OP_MUL, cols_[0], cols_[1]), cols_[2]), param_);
+  gen_data(1000, 1000000);
+  check(&g, 1, 0, false);
+  data_[0][17] = INT64_MAX / 2;
+  data_[1][17] = 3;
+  check(&g, 1, 0, true);
+  check(&g, 1, 17, false);
+  // an overflow in the branch not taken bails out too, the interpreter decides
+  gen_data(1000, 1000000);
+  data_[2][5] = INT64_MIN;
+  ObExpr *or_args[] = {op(T_OP_GE, cols_[0], int_const(-1000)), op(T_OP_GT, op(T_OP_NEG, cols_[2]), int_const(0))};
+  ObExpr *f = nary(T_OP_OR, ObInt32Type, or_args, 2);
+  check(&f, 1, 0, true);
+}
+
+TEST_F(TestExprJitFilter, unsupported)
+{
+  ObArenaAllocator plan_alloc("TestExprJit");
+  ObExprJitCompiler compiler(plan_alloc);
+  ObSEArray<ObExpr *, 4> filters;
+  ObSEArray<ObExpr *, 4> input_exprs;
+  ObExprJitFilter *jit_filter = NULL;
+  // non integer column
+  ObExpr *dbl = new_expr(T_REF_COLUMN, ObDoubleType, 0);
+  ASSERT_EQ(OB_SUCCESS, filters.push_back(op(T_OP_GT, dbl, cols_[0])));
+  ASSERT_EQ(OB_SUCCESS, compiler.add_filter(filters, input_exprs, jit_filter));
+  ASSERT_TRUE(NULL == jit_filter);
+  // unsupported operator
+  filters.reset();
+  ASSERT_EQ(OB_SUCCESS, filters.push_back(op(T_OP_DIV, cols_[0], cols_[1])));
+  ASSERT_EQ(OB_SUCCESS, compiler.add_filter(filters, input_exprs, jit_filter));
+  ASSERT_TRUE(NULL == jit_filter);
+  // ... unless computed by the child operator
+  ASSERT_EQ(OB_SUCCESS, input_exprs.push_back(filters.at(0)));
+  ASSERT_EQ(OB_SUCCESS, compiler.add_filter(filters, input_exprs, jit_filter));
+  ASSERT_TRUE(NULL != jit_filter);
+  ASSERT_EQ(1, jit_filter->leaves_.count());
+  ASSERT_EQ(OB_SUCCESS, compiler.compile());
+  ASSERT_TRUE(jit_filter->is_compiled());
+}
+
+} // end namespace sql
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_expr_jit_filter.log*");
+  OB_LOGGER.set_file_name("test_expr_jit_filter.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,402 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#include "sql/engine/join/hash_join/ob_hj_radix_partitioner.h"
+#include "sql/engine/join/hash_join/join_hash_table.h"
+#undef private
+#include "lib/allocator/page_arena.h"
+#include "lib/hash_func/murmur_hash.h"
+#include "lib/oblog/ob_log.h"
+#include "lib/time/ob_time_utility.h"
+#include <algorithm>
+#include <vector>
+
+namespace oceanbase
+{
+namespace unittest
+{
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+// max build size(MB) of the perf test, set by the first argument
+static int64_t max_build_mb = 1024;
+
+static uint64_t hash_of(const uint64_t key)
+{
+  return murmurhash64A(&key, sizeof(key), 0);
+}
+
+static ObHJStoredRow *row_of(const uint64_t key)
+{
+  return reinterpret_cast<ObHJStoredRow *>(key + 1);
+}
+
+TEST(TestHJRadixPartitioner, calc_radix_bits)
+{
+  const int64_t bucket_size = 16;
+  ASSERT_EQ(0, ObHJRadixPartitioner::calc_radix_bits(0, bucket_size));
+  ASSERT_EQ(0, ObHJRadixPartitioner::calc_radix_bits(1L << 10, bucket_size));
+  ASSERT_EQ(0, ObHJRadixPartitioner::calc_radix_bits(1L << 22, bucket_size));
+  // 128MB table, 4MB per partition
+  ASSERT_EQ(5, ObHJRadixPartitioner::calc_radix_bits(1L << 23, bucket_size));
+  // 1GB table, one pass
+  ASSERT_EQ(8, ObHJRadixPartitioner::calc_radix_bits(1L << 26, bucket_size));
+  // 4GB table, two passes
+  ASSERT_EQ(10, ObHJRadixPartitioner::calc_radix_bits(1L << 28, bucket_size));
+  // capped by MAX_RADIX_BITS
+  ASSERT_EQ(ObHJRadixPartitioner::MAX_RADIX_BITS,
+            ObHJRadixPartitioner::calc_radix_bits(1L << 40, bucket_size));
+}
+
+TEST(TestHJRadixPartitioner, partition)
+{
+  const int64_t COUNT = 100000;
+  const int64_t nbuckets = 1L << 20;
+  const int64_t bucket_bits = 20;
+  ObArenaAllocator alloc;
+  ObHJRadixPartitioner partitioner;
+  ASSERT_EQ(OB_NOT_INIT, partitioner.partition(nbuckets, 8));
+  ASSERT_EQ(OB_SUCCESS, partitioner.init(alloc, COUNT));
+  ASSERT_EQ(OB_INIT_TWICE, partitioner.init(alloc, COUNT));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, partitioner.partition(nbuckets - 1, 8));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, partitioner.partition(nbuckets, 0));
+  ASSERT_EQ(OB_INVALID_ARGUMENT,
+            partitioner.partition(nbuckets, ObHJRadixPartitioner::MAX_RADIX_BITS + 1));
+
+  const int64_t bits_list[] = {1, 5, 8, 9, 13, 16};
+  for (int64_t b = 0; b < ARRAYSIZEOF(bits_list); b++) {
+    const int64_t bits = bits_list[b];
+    partitioner.reuse();
+    for (int64_t i = 0; i < COUNT; i++) {
+      partitioner.add(hash_of(i), row_of(i));
+    }
+    ASSERT_EQ(0, partitioner.remain());
+    ASSERT_EQ(OB_SUCCESS, partitioner.partition(nbuckets, bits));
+    ASSERT_EQ(COUNT, partitioner.count());
+    const ObHJRadixItem *items = partitioner.items();
+    std::vector<uint64_t> keys;
+    uint64_t last_part = 0;
+    for (int64_t i = 0; i < COUNT; i++) {
+      const uint64_t key = reinterpret_cast<uint64_t>(items[i].row_) - 1;
+      ASSERT_EQ(hash_of(key), items[i].hash_);
+      const uint64_t part = (items[i].hash_ & (nbuckets - 1)) >> (bucket_bits - bits);
+      ASSERT_LE(last_part, part) << "bits=" << bits << " i=" << i;
+      last_part = part;
+      keys.push_back(key);
+    }
+    std::sort(keys.begin(), keys.end());
+    for (int64_t i = 0; i < COUNT; i++) {
+      ASSERT_EQ(i, keys[i]);
+    }
+  }
+  partitioner.destroy();
+  ASSERT_EQ(0, partitioner.count());
+}
+
+// Hash table only records the inserted rows
+class ObMockHashTable : public IHashTable
+{
+public:
+  ObMockHashTable(const int64_t row_count, const int64_t nbuckets)
+    : row_count_(row_count), nbuckets_(nbuckets), insert_cnt_(0)
+  {}
+  int init(ObIAllocator &alloc, const int64_t max_batch_size) override { return OB_SUCCESS; }
+  int build_prepare(int64_t row_count, int64_t bucket_count) override { return OB_SUCCESS; }
+  int insert_batch(JoinTableCtx &ctx,
+                   ObHJStoredRow **stored_rows,
+                   const int64_t size,
+                   int64_t &used_buckets,
+                   int64_t &collisions) override
+  {
+    int ret = OB_SUCCESS;
+    if (size <= 0 || size > ctx.max_batch_size_) {
+      ret = OB_INVALID_ARGUMENT;
+    } else {
+      for (int64_t i = 0; i < size; i++) {
+        rows_.push_back(stored_rows[i]);
+      }
+      used_buckets += size;
+      insert_cnt_++;
+    }
+    return ret;
+  }
+  int probe_prepare(JoinTableCtx &ctx, OutputInfo &output_info) override { return OB_SUCCESS; }
+  int probe_batch(JoinTableCtx &ctx, OutputInfo &output_info) override { return OB_SUCCESS; }
+  int project_matched_rows(JoinTableCtx &ctx, OutputInfo &output_info) override
+  {
+    return OB_SUCCESS;
+  }
+  int get_unmatched_rows(JoinTableCtx &ctx, OutputInfo &output_info) override
+  {
+    return OB_SUCCESS;
+  }
+  void reset() override { rows_.clear(); }
+  void free(ObIAllocator *alloc) override {}
+  int64_t get_row_count() const override { return row_count_; }
+  int64_t get_used_buckets() const override { return rows_.size(); }
+  int64_t get_nbuckets() const override { return nbuckets_; }
+  int64_t get_collisions() const override { return 0; }
+  int64_t get_mem_used() const override { return 0; }
+  int64_t get_one_bucket_size() const override { return 16; }
+  int64_t get_normalized_key_size() const override { return 0; }
+  void set_diag_info(int64_t used_buckets, int64_t collisions) override {}
+public:
+  int64_t row_count_;
+  int64_t nbuckets_;
+  int64_t insert_cnt_;
+  std::vector<ObHJStoredRow *> rows_;
+};
+
+// Feed rows batch by batch like build_with_radix_partition, every row should be
+// inserted once and each flushed chunk should be in partition order.
+TEST(TestHJRadixPartitioner, join_hash_table_radix_build)
+{
+  const int64_t ROW_CNT = 10007;
+  const int64_t BATCH_SIZE = 256;
+  const int64_t CAPACITY = 1000;
+  const int64_t nbuckets = 1L << 26;
+  const int64_t bucket_bits = 26;
+  const int64_t row_size = sizeof(ObHJStoredRow) + sizeof(uint64_t);
+  ObArenaAllocator alloc;
+  ObMockHashTable mock_table(ROW_CNT, nbuckets);
+  JoinHashTable join_table;
+  join_table.hash_table_ = &mock_table;
+  join_table.allocator_ = &alloc;
+  JoinTableCtx ctx;
+  ctx.max_batch_size_ = BATCH_SIZE;
+  const ObHJStoredRow *batch[BATCH_SIZE];
+  ctx.stored_rows_ = batch;
+
+  // radix build is off by default and for the shared hash table
+  ASSERT_EQ(0, join_table.get_radix_bits(ctx));
+  ctx.enable_radix_build_ = true;
+  ctx.is_shared_ = true;
+  ASSERT_EQ(0, join_table.get_radix_bits(ctx));
+  ctx.is_shared_ = false;
+  const int64_t radix_bits = join_table.get_radix_bits(ctx);
+  ASSERT_EQ(ObHJRadixPartitioner::calc_radix_bits(nbuckets, 16), radix_bits);
+  ASSERT_GT(radix_bits, 0);
+
+  // hash value is stored in the extra payload at offset 0 of the default row meta
+  char *buf = static_cast<char *>(alloc.alloc(ROW_CNT * row_size));
+  ASSERT_TRUE(NULL != buf);
+  std::vector<ObHJStoredRow *> rows(ROW_CNT);
+  for (int64_t i = 0; i < ROW_CNT; i++) {
+    rows[i] = reinterpret_cast<ObHJStoredRow *>(buf + i * row_size);
+    rows[i]->set_hash_value(ctx.build_row_meta_, hash_of(i));
+  }
+
+  ObHJRadixPartitioner partitioner;
+  ASSERT_EQ(OB_SUCCESS, partitioner.init(alloc, CAPACITY));
+  ASSERT_EQ(ObHJRadixPartitioner::calc_mem_size(CAPACITY), partitioner.get_mem_size());
+  int64_t used_buckets = 0;
+  int64_t collisions = 0;
+  int64_t flush_cnt = 0;
+  int64_t pos = 0;
+  bool is_last = false;
+  while (!is_last) {
+    const int64_t size = MIN(BATCH_SIZE, ROW_CNT - pos);
+    for (int64_t i = 0; i < size; i++) {
+      batch[i] = rows[pos + i];
+    }
+    pos += size;
+    is_last = (0 == size);
+    const int64_t inserted = static_cast<int64_t>(mock_table.rows_.size());
+    ASSERT_EQ(OB_SUCCESS, join_table.add_to_radix_chunk(ctx, partitioner, size, is_last,
+                                                        radix_bits, used_buckets, collisions));
+    if (inserted != static_cast<int64_t>(mock_table.rows_.size())) {
+      flush_cnt++;
+      ASSERT_EQ(0, partitioner.count());
+      uint64_t last_part = 0;
+      for (int64_t i = inserted; i < static_cast<int64_t>(mock_table.rows_.size()); i++) {
+        const uint64_t hash = mock_table.rows_[i]->get_hash_value(ctx.build_row_meta_);
+        const uint64_t part = (hash & (nbuckets - 1)) >> (bucket_bits - radix_bits);
+        ASSERT_LE(last_part, part) << "i=" << i;
+        last_part = part;
+      }
+    } else {
+      // chunk is flushed once it can not hold another batch
+      ASSERT_GE(partitioner.remain(), BATCH_SIZE);
+    }
+  }
+  // 3 batches per chunk
+  ASSERT_EQ((ROW_CNT + 3 * BATCH_SIZE - 1) / (3 * BATCH_SIZE), flush_cnt);
+  ASSERT_EQ(ROW_CNT, static_cast<int64_t>(mock_table.rows_.size()));
+  ASSERT_EQ(ROW_CNT, used_buckets);
+  std::vector<ObHJStoredRow *> inserted_rows(mock_table.rows_);
+  std::sort(inserted_rows.begin(), inserted_rows.end());
+  for (int64_t i = 0; i < ROW_CNT; i++) {
+    ASSERT_EQ(rows[i], inserted_rows[i]);
+  }
+
+  // overflow of the chunk is rejected
+  partitioner.reuse();
+  for (int64_t i = 0; i < CAPACITY - 1; i++) {
+    partitioner.add(hash_of(i), rows[i]);
+  }
+  ASSERT_EQ(OB_SIZE_OVERFLOW, join_table.add_to_radix_chunk(ctx, partitioner, 2, false,
+                                                            radix_bits, used_buckets, collisions));
+  join_table.hash_table_ = NULL;
+}
+
+// Linear probing table of 16 bytes buckets, same as the bucket array of
+// the non-shared hash join table.
+class ObTestBucketTable
+{
+public:
+  struct Bucket
+  {
+    uint64_t hash_;
+    ObHJStoredRow *row_;
+  };
+  explicit ObTestBucketTable(const int64_t nbuckets) : buckets_(nbuckets), mask_(nbuckets - 1)
+  {
+    MEMSET(&buckets_[0], 0, nbuckets * sizeof(Bucket));
+  }
+  OB_INLINE void prefetch(const uint64_t hash) const
+  {
+    __builtin_prefetch(&buckets_[hash & mask_], 1, 3);
+  }
+  OB_INLINE void set(const uint64_t hash, ObHJStoredRow *row)
+  {
+    uint64_t pos = hash & mask_;
+    while (NULL != buckets_[pos].row_) {
+      pos = (pos + 1) & mask_;
+    }
+    buckets_[pos].hash_ = hash;
+    buckets_[pos].row_ = row;
+  }
+  OB_INLINE ObHJStoredRow *get(const uint64_t hash) const
+  {
+    ObHJStoredRow *row = NULL;
+    for (uint64_t pos = hash & mask_; NULL != buckets_[pos].row_; pos = (pos + 1) & mask_) {
+      if (buckets_[pos].hash_ == hash) {
+        row = buckets_[pos].row_;
+        break;
+      }
+    }
+    return row;
+  }
+  // insert with the batch prefetch of hash join
+  void insert_batch(const ObHJRadixItem *items, const int64_t count)
+  {
+    for (int64_t i = 0; i < count; i++) {
+      prefetch(items[i].hash_);
+    }
+    for (int64_t i = 0; i < count; i++) {
+      set(items[i].hash_, items[i].row_);
+    }
+  }
+private:
+  std::vector<Bucket> buckets_;
+  uint64_t mask_;
+};
+
+// Build a table of %build_size bytes directly and with radix partition, then
+// probe it with the group prefetch of hash join, report the throughput.
+void run_perf(const int64_t build_size)
+{
+  const int64_t BATCH_SIZE = 256;
+  const int64_t nbuckets = build_size / sizeof(ObTestBucketTable::Bucket);
+  const int64_t row_count = nbuckets / 2;
+  const int64_t radix_bits = ObHJRadixPartitioner::calc_radix_bits(
+      nbuckets, sizeof(ObTestBucketTable::Bucket));
+  std::vector<ObHJRadixItem> input(row_count);
+  for (int64_t i = 0; i < row_count; i++) {
+    input[i].hash_ = hash_of(i);
+    input[i].row_ = row_of(i);
+  }
+
+  // direct build
+  int64_t direct_us = 0;
+  {
+    ObTestBucketTable table(nbuckets);
+    const int64_t start_ts = ObTimeUtility::current_time();
+    for (int64_t i = 0; i < row_count; i += BATCH_SIZE) {
+      table.insert_batch(&input[i], MIN(BATCH_SIZE, row_count - i));
+    }
+    direct_us = ObTimeUtility::current_time() - start_ts;
+  }
+
+  // radix build
+  ObArenaAllocator alloc;
+  ObHJRadixPartitioner partitioner;
+  ObTestBucketTable table(nbuckets);
+  const int64_t capacity = MIN(row_count, ObHJRadixPartitioner::MAX_CHUNK_ITEM_CNT);
+  ASSERT_EQ(OB_SUCCESS, partitioner.init(alloc, capacity));
+  int64_t start_ts = ObTimeUtility::current_time();
+  for (int64_t i = 0; i < row_count; i += capacity) {
+    const int64_t cnt = MIN(capacity, row_count - i);
+    partitioner.reuse();
+    for (int64_t j = i; j < i + cnt; j++) {
+      partitioner.add(input[j].hash_, input[j].row_);
+    }
+    if (radix_bits > 0) {
+      ASSERT_EQ(OB_SUCCESS, partitioner.partition(nbuckets, radix_bits));
+    }
+    const ObHJRadixItem *items = partitioner.items();
+    for (int64_t j = 0; j < cnt; j += BATCH_SIZE) {
+      table.insert_batch(items + j, MIN(BATCH_SIZE, cnt - j));
+    }
+  }
+  const int64_t radix_us = ObTimeUtility::current_time() - start_ts;
+
+  // probe all keys in random order with group prefetch
+  std::vector<uint64_t> probe_hashes(row_count);
+  for (int64_t i = 0; i < row_count; i++) {
+    probe_hashes[i] = hash_of((i * 7919) % row_count);
+  }
+  int64_t matched = 0;
+  start_ts = ObTimeUtility::current_time();
+  for (int64_t i = 0; i < row_count; i += BATCH_SIZE) {
+    const int64_t cnt = MIN(BATCH_SIZE, row_count - i);
+    for (int64_t j = i; j < i + cnt; j++) {
+      table.prefetch(probe_hashes[j]);
+    }
+    for (int64_t j = i; j < i + cnt; j++) {
+      matched += (NULL != table.get(probe_hashes[j]));
+    }
+  }
+  const int64_t probe_us = ObTimeUtility::current_time() - start_ts;
+  ASSERT_EQ(row_count, matched);
+  fprintf(stdout, "build_size=%6ldMB rows=%10ld radix_bits=%2ld "
+          "direct build: %8.3f Mrows/s, radix build: %8.3f Mrows/s, probe: %8.3f Mrows/s\n",
+          build_size >> 20, row_count, radix_bits,
+          static_cast<double>(row_count) / static_cast<double>(MAX(direct_us, 1)),
+          static_cast<double>(row_count) / static_cast<double>(MAX(radix_us, 1)),
+          static_cast<double>(row_count) / static_cast<double>(MAX(probe_us, 1)));
+}
+
+TEST(TestHJRadixPartitioner, DISABLED_perf_test)
+{
+  for (int64_t mb = 1; mb <= max_build_mb; mb *= 4) {
+    run_perf(mb << 20);
+  }
+}
+
+} // namespace unittest
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_file_name("test_hj_radix_partitioner.log", true);
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  // e.g. ./test_hj_radix_partitioner --gtest_also_run_disabled_tests 4096
+  // to test up to 4GB build side
+  if (argc > 1) {
+    oceanbase::unittest::max_build_mb = atol(argv[1]);
+  }
+  return RUN_ALL_TESTS();
+}
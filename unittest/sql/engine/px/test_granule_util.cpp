@@ -0,0 +1,75 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_EXE
+#include <gtest/gtest.h>
+
+#include "sql/engine/px/ob_granule_util.h"
+#include "sql/das/ob_das_define.h"
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+class ObGranuleUtilTest : public ::testing::Test
+{
+public:
+  ObGranuleUtilTest() = default;
+  virtual ~ObGranuleUtilTest() = default;
+  virtual void SetUp() {};
+  virtual void TearDown() {};
+};
+
+// the larger tablets first, the tablets of the same size keep their order
+TEST_F(ObGranuleUtilTest, sort_tablets_by_size)
+{
+  ObDASTabletLoc locs[5];
+  ObSEArray<ObDASTabletLoc*, 8> tablets;
+  ObSEArray<int64_t, 8> sizes;
+  const int64_t tablet_sizes[] = {10, 30, 20, 30, 0};
+  for (int64_t i = 0; i < ARRAYSIZEOF(tablet_sizes); i++) {
+    ASSERT_EQ(OB_SUCCESS, tablets.push_back(&locs[i]));
+    ASSERT_EQ(OB_SUCCESS, sizes.push_back(tablet_sizes[i]));
+  }
+  ASSERT_EQ(OB_SUCCESS, ObGranuleUtil::sort_tablets_by_size(sizes, tablets));
+  const int64_t expected[] = {1, 3, 2, 0, 4};
+  for (int64_t i = 0; i < ARRAYSIZEOF(expected); i++) {
+    ASSERT_EQ(&locs[expected[i]], tablets.at(i));
+  }
+}
+
+// the tablets are not changed if the sizes don't match
+TEST_F(ObGranuleUtilTest, sort_tablets_size_mismatch)
+{
+  ObDASTabletLoc locs[3];
+  ObSEArray<ObDASTabletLoc*, 8> tablets;
+  ObSEArray<int64_t, 8> sizes;
+  for (int64_t i = 0; i < ARRAYSIZEOF(locs); i++) {
+    ASSERT_EQ(OB_SUCCESS, tablets.push_back(&locs[i]));
+  }
+  ASSERT_EQ(OB_SUCCESS, sizes.push_back(1));
+  ASSERT_EQ(OB_SUCCESS, sizes.push_back(2));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, ObGranuleUtil::sort_tablets_by_size(sizes, tablets));
+  for (int64_t i = 0; i < ARRAYSIZEOF(locs); i++) {
+    ASSERT_EQ(&locs[i], tablets.at(i));
+  }
+  sizes.reuse();
+  tablets.reuse();
+  ASSERT_EQ(OB_SUCCESS, ObGranuleUtil::sort_tablets_by_size(sizes, tablets));
+}
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
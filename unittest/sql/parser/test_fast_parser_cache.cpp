@@ -0,0 +1,217 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "lib/worker.h"
+#include "lib/allocator/page_arena.h"
+#include "lib/time/ob_time_utility.h"
+#include "sql/parser/parse_node.h"
+#include "sql/plan_cache/ob_fast_parser_cache.h"
+#include "sql/plan_cache/ob_sql_parameterization.h"
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+namespace test
+{
+// CPU per query of getting the parameterized sql and raw params of a
+// sysbench-like statement mix, by the fast parser and through ObFastParserCache.
+// The literals are picked from 'distinct_ids' values, the less distinct sql
+// texts, the more hits of the cache. distinct_ids=0 makes every sql text
+// distinct, which shows the overhead of the cache when it's never hit.
+//
+// ./test_fast_parser_cache [query_cnt]
+int64_t query_cnt = 200000;
+
+class TestFastParserCache : public ::testing::Test
+{
+public:
+  TestFastParserCache() : allocator_(ObModIds::TEST) {}
+  void gen_sqls(const int64_t distinct_ids, std::vector<std::string> &sqls)
+  {
+    const char *fmts[] = {
+      "SELECT c FROM sbtest1 WHERE id=%ld",
+      "SELECT c FROM sbtest1 WHERE id BETWEEN %ld AND %ld",
+      "SELECT SUM(k) FROM sbtest1 WHERE id BETWEEN %ld AND %ld",
+      "SELECT DISTINCT c FROM sbtest1 WHERE id BETWEEN %ld AND %ld ORDER BY c",
+      "UPDATE sbtest1 SET k=k+1 WHERE id=%ld",
+      "UPDATE sbtest1 SET c='%ld-68487932199-96439406143-93774651418-41631865787' WHERE id=%ld",
+      "DELETE FROM sbtest1 WHERE id=%ld",
+      "INSERT INTO sbtest1 (id, k, c, pad) VALUES (%ld, %ld, "
+      "'83868641912-28773972837-60736120486-75162659906', '67847967377-48000963322')",
+    };
+    char buf[512];
+    sqls.clear();
+    for (int64_t i = 0; i < query_cnt; i++) {
+      const int64_t id = distinct_ids > 0 ? (i * 7919) % distinct_ids + 1 : i + 1;
+      snprintf(buf, sizeof(buf), fmts[i % ARRAYSIZEOF(fmts)], id, id + 99);
+      sqls.push_back(buf);
+    }
+  }
+  void parse(const std::vector<std::string> &sqls,
+             ObFastParserCache *cache,
+             int64_t &ns_per_query)
+  {
+    FPContext fp_ctx;
+    fp_ctx.sql_mode_ = SMO_DEFAULT;
+    const int64_t start_ts = ObTimeUtility::current_time_ns();
+    for (int64_t i = 0; i < sqls.size(); i++) {
+      ObFastParserResult fp_result;
+      ObString sql(sqls[i].length(), sqls[i].c_str());
+      int ret = OB_HASH_NOT_EXIST;
+      if (NULL != cache) {
+        ret = cache->get(fp_ctx, sql, allocator_, fp_result);
+      }
+      if (OB_HASH_NOT_EXIST == ret) {
+        ASSERT_EQ(OB_SUCCESS, ObSqlParameterization::fast_parser(allocator_, fp_ctx, sql, fp_result));
+        if (NULL != cache) {
+          ASSERT_EQ(OB_SUCCESS, cache->put(fp_ctx, sql, fp_result, ObFastParserCache::MAX_CACHE_SIZE));
+        }
+      } else {
+        ASSERT_EQ(OB_SUCCESS, ret);
+      }
+      allocator_.reuse();
+    }
+    ns_per_query = (ObTimeUtility::current_time_ns() - start_ts) / sqls.size();
+  }
+public:
+  ObArenaAllocator allocator_;
+};
+
+// the cached result is the same as the fast parser's
+TEST_F(TestFastParserCache, same_result)
+{
+  FPContext fp_ctx;
+  fp_ctx.sql_mode_ = SMO_DEFAULT;
+  ObFastParserCache cache;
+  ObString sql = ObString::make_string("UPDATE sbtest1 SET c='a\\'b', pad='', k=-3 WHERE id=100 AND pad = 1.5");
+  ObFastParserResult expected;
+  ObFastParserResult result;
+  ASSERT_EQ(OB_SUCCESS, ObSqlParameterization::fast_parser(allocator_, fp_ctx, sql, expected));
+  ASSERT_EQ(OB_HASH_NOT_EXIST, cache.get(fp_ctx, sql, allocator_, result));
+  // cached when it's put the second time
+  ASSERT_EQ(OB_SUCCESS, cache.put(fp_ctx, sql, expected, 4));
+  ASSERT_EQ(OB_HASH_NOT_EXIST, cache.get(fp_ctx, sql, allocator_, result));
+  ASSERT_EQ(0, cache.get_insert_count());
+  ASSERT_EQ(OB_SUCCESS, cache.put(fp_ctx, sql, expected, 4));
+  ASSERT_EQ(1, cache.get_insert_count());
+  ASSERT_EQ(OB_SUCCESS, cache.get(fp_ctx, sql, allocator_, result));
+  ASSERT_TRUE(expected.pc_key_.name_ == result.pc_key_.name_);
+  ASSERT_EQ(expected.raw_params_.count(), result.raw_params_.count());
+  for (int64_t i = 0; i < expected.raw_params_.count(); i++) {
+    const ParseNode *e = expected.raw_params_.at(i)->node_;
+    const ParseNode *r = result.raw_params_.at(i)->node_;
+    ASSERT_NE(e, r);
+    ASSERT_EQ(e->type_, r->type_);
+    ASSERT_EQ(e->value_, r->value_);
+    ASSERT_EQ(e->pos_, r->pos_);
+    ASSERT_EQ(e->flag_, r->flag_);
+    ASSERT_EQ(NULL == e->str_value_, NULL == r->str_value_);
+    ASSERT_TRUE(ObString(e->str_len_, e->str_value_) == ObString(r->str_len_, r->str_value_));
+    ASSERT_TRUE(ObString(e->text_len_, e->raw_text_) == ObString(r->text_len_, r->raw_text_));
+  }
+  // another sql mode is another entry
+  FPContext ansi_ctx = fp_ctx;
+  ansi_ctx.sql_mode_ = SMO_ANSI_QUOTES;
+  ASSERT_EQ(OB_HASH_NOT_EXIST, cache.get(ansi_ctx, sql, allocator_, result));
+  // the least recently used entry is replaced
+  char buf[64];
+  for (int64_t i = 0; i < 4; i++) {
+    snprintf(buf, sizeof(buf), "SELECT c FROM sbtest1 WHERE id=%ld", i);
+    ObString other(strlen(buf), buf);
+    ASSERT_EQ(OB_SUCCESS, ObSqlParameterization::fast_parser(allocator_, fp_ctx, other, result));
+    ASSERT_EQ(OB_SUCCESS, cache.put(fp_ctx, other, result, 4));
+    ASSERT_EQ(OB_SUCCESS, cache.put(fp_ctx, other, result, 4));
+  }
+  ASSERT_EQ(OB_HASH_NOT_EXIST, cache.get(fp_ctx, sql, allocator_, result));
+}
+
+// the empty string literal is copied as a valid empty string
+TEST_F(TestFastParserCache, empty_string_param)
+{
+  FPContext fp_ctx;
+  fp_ctx.sql_mode_ = SMO_DEFAULT;
+  ObFastParserCache cache;
+  ObString sql = ObString::make_string("SELECT c FROM sbtest1 WHERE c = '' AND pad = ''");
+  ObFastParserResult expected;
+  ObFastParserResult result;
+  ASSERT_EQ(OB_SUCCESS, ObSqlParameterization::fast_parser(allocator_, fp_ctx, sql, expected));
+  ASSERT_EQ(OB_SUCCESS, cache.put(fp_ctx, sql, expected, 4));
+  ASSERT_EQ(OB_SUCCESS, cache.put(fp_ctx, sql, expected, 4));
+  ASSERT_EQ(OB_SUCCESS, cache.get(fp_ctx, sql, allocator_, result));
+  ASSERT_EQ(2, result.raw_params_.count());
+  for (int64_t i = 0; i < result.raw_params_.count(); i++) {
+    const ParseNode *r = result.raw_params_.at(i)->node_;
+    ASSERT_TRUE(NULL != r->str_value_);
+    ASSERT_EQ(0, r->str_len_);
+  }
+}
+
+// the sql texts put once are not cached, and don't replace the cached ones
+TEST_F(TestFastParserCache, high_cardinality_not_cached)
+{
+  FPContext fp_ctx;
+  fp_ctx.sql_mode_ = SMO_DEFAULT;
+  ObFastParserCache cache;
+  ObFastParserResult result;
+  ObString hot = ObString::make_string("SELECT c FROM sbtest1 WHERE id=1");
+  ASSERT_EQ(OB_SUCCESS, ObSqlParameterization::fast_parser(allocator_, fp_ctx, hot, result));
+  ASSERT_EQ(OB_SUCCESS, cache.put(fp_ctx, hot, result, 1));
+  ASSERT_EQ(OB_SUCCESS, cache.put(fp_ctx, hot, result, 1));
+  char buf[64];
+  for (int64_t i = 0; i < 10 * ObFastParserCache::SEEN_HASH_CNT; i++) {
+    snprintf(buf, sizeof(buf), "SELECT c FROM sbtest1 WHERE id=%ld", i + 2);
+    ObString other(strlen(buf), buf);
+    ASSERT_EQ(OB_HASH_NOT_EXIST, cache.get(fp_ctx, other, allocator_, result));
+    ASSERT_EQ(OB_SUCCESS, ObSqlParameterization::fast_parser(allocator_, fp_ctx, other, result));
+    ASSERT_EQ(OB_SUCCESS, cache.put(fp_ctx, other, result, 1));
+  }
+  ASSERT_EQ(1, cache.get_insert_count());
+  ASSERT_EQ(OB_SUCCESS, cache.get(fp_ctx, hot, allocator_, result));
+}
+
+TEST_F(TestFastParserCache, DISABLED_sysbench_mix)
+{
+  const int64_t distinct_ids[] = {1, 8, 100000, 0};
+  std::vector<std::string> sqls;
+  for (int64_t i = 0; i < ARRAYSIZEOF(distinct_ids); i++) {
+    gen_sqls(distinct_ids[i], sqls);
+    int64_t fast_parser_ns = 0;
+    int64_t cache_ns = 0;
+    ObFastParserCache cache;
+    parse(sqls, NULL, fast_parser_ns);
+    parse(sqls, &cache, cache_ns);
+    const int64_t total = cache.get_hit_count() + cache.get_miss_count();
+    fprintf(stdout, "distinct_ids=%6ld fast_parser=%5ldns/query cache=%5ldns/query hit_ratio=%.3f "
+            "insert_cnt=%ld\n",
+            distinct_ids[i], fast_parser_ns, cache_ns,
+            total > 0 ? (double)cache.get_hit_count() / (double)total : 0,
+            cache.get_insert_count());
+  }
+}
+
+} // namespace test
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("ERROR");
+  OB_LOGGER.set_file_name("test_fast_parser_cache.log", true);
+  set_compat_mode(lib::Worker::CompatMode::MYSQL);
+  ::testing::InitGoogleTest(&argc, argv);
+  if (argc > 1) {
+    test::query_cnt = strtol(argv[1], NULL, 10);
+  }
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,182 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#define private public
+#include "lib/allocator/ob_qsync.h"
+#include "lib/oblog/ob_log.h"
+#include "lib/time/ob_time_utility.h"
+#include "sql/plan_cache/ob_i_lib_cache_node.h"
+#include "sql/plan_cache/ob_lib_cache_node_factory.h"
+#include "sql/plan_cache/ob_plan_cache.h"
+#include "sql/plan_cache/ob_plan_cache_callback.h"
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+namespace test
+{
+// Throughput of reading the cache node of the same sql from 1 to 128 threads,
+// the way ObPlanCache::get_cache_obj did (reference count of the node) and does
+// (critical section of ObPlanCache::node_qsync_).
+//
+// ./test_lib_cache_node_read [duration_ms]
+int64_t duration_ms = 500;
+int64_t destroyed_node_cnt = 0;
+
+class MockCacheNode : public ObILibCacheNode
+{
+public:
+  MockCacheNode(ObPlanCache *lib_cache, lib::MemoryContext &mem_context)
+    : ObILibCacheNode(lib_cache, mem_context)
+  {
+  }
+  virtual ~MockCacheNode() { destroyed_node_cnt++; }
+  virtual int inner_get_cache_obj(ObILibCacheCtx &, ObILibCacheKey *, ObILibCacheObject *&)
+  {
+    return OB_NOT_SUPPORTED;
+  }
+  virtual int inner_add_cache_obj(ObILibCacheCtx &, ObILibCacheKey *, ObILibCacheObject *)
+  {
+    return OB_NOT_SUPPORTED;
+  }
+};
+
+class TestLibCacheNodeRead : public ::testing::Test
+{
+public:
+  typedef hash::HashMapPair<ObILibCacheKey*, ObILibCacheNode*> LibCacheKV;
+  virtual void SetUp() override
+  {
+    lib::ContextParam param;
+    param.set_properties(lib::ADD_CHILD_THREAD_SAFE | lib::ALLOC_THREAD_SAFE)
+      .set_mem_attr(OB_SERVER_TENANT_ID, "TestLCNode");
+    ASSERT_EQ(OB_SUCCESS, ROOT_CONTEXT->CREATE_CONTEXT(mem_context_, param));
+  }
+  virtual void TearDown() override
+  {
+    DESTROY_CONTEXT(mem_context_);
+  }
+  int64_t run(const int64_t thread_cnt, const bool use_qsync)
+  {
+    MockCacheNode node(NULL, mem_context_);
+    // the reference of cache_key_node_map_
+    node.inc_ref_count(LC_NODE_HANDLE);
+    LibCacheKV kv;
+    kv.second = &node;
+    ObQSync qsync;
+    int64_t read_cnt = 0;
+    std::vector<std::thread> threads;
+    const int64_t end_ts = ObTimeUtility::current_time() + duration_ms * 1000;
+    for (int64_t i = 0; i < thread_cnt; i++) {
+      threads.emplace_back([&]() {
+        int64_t cnt = 0;
+        while (0 != (cnt & 0xff) || ObTimeUtility::current_time() < end_ts) {
+          ObILibCacheNode *cache_node = NULL;
+          if (use_qsync) {
+            CriticalGuard(qsync);
+            ObLibCacheRlock r_lock(LC_NODE_RD_HANDLE);
+            r_lock(kv);
+            ASSERT_EQ(OB_SUCCESS, r_lock.get_value(cache_node));
+            (void)cache_node->unlock();
+          } else {
+            ObLibCacheRlockAndRef r_ref_lock(LC_NODE_RD_HANDLE);
+            r_ref_lock(kv);
+            ASSERT_EQ(OB_SUCCESS, r_ref_lock.get_value(cache_node));
+            (void)cache_node->unlock();
+            (void)cache_node->dec_ref_count(LC_NODE_RD_HANDLE);
+          }
+          cnt++;
+        }
+        ATOMIC_AAF(&read_cnt, cnt);
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    EXPECT_EQ(1, node.get_ref_count());
+    return read_cnt * 1000 / duration_ms;
+  }
+public:
+  lib::MemoryContext mem_context_;
+};
+
+TEST_F(TestLibCacheNodeRead, DISABLED_same_node)
+{
+  const int64_t thread_cnts[] = {1, 2, 4, 8, 16, 32, 64, 128};
+  for (int64_t i = 0; i < ARRAYSIZEOF(thread_cnts); i++) {
+    const int64_t ref_rps = run(thread_cnts[i], false);
+    const int64_t qsync_rps = run(thread_cnts[i], true);
+    fprintf(stdout, "threads=%3ld ref_count=%10ld reads/s qsync=%10ld reads/s\n",
+            thread_cnts[i], ref_rps, qsync_rps);
+  }
+}
+
+// a cache node released in the critical section of node_qsync_, e.g. by the
+// evict callback holding a bucket lock, is retired instead of waiting for the
+// readers, and destroyed after they leave
+TEST_F(TestLibCacheNodeRead, retire_in_critical_section)
+{
+  ObPlanCache plan_cache;
+  lib::MemoryContext entity = NULL;
+  ObILibCacheNode *node = NULL;
+  ASSERT_EQ(OB_SUCCESS, mem_context_->CREATE_CONTEXT(entity,
+      lib::ContextParam().set_mem_attr(OB_SERVER_TENANT_ID, "TestLCNode")));
+  ASSERT_EQ(OB_SUCCESS, ObLCNodeFactory::create<MockCacheNode>(entity, node, &plan_cache));
+  node->inc_ref_count(LC_NODE_HANDLE);
+  destroyed_node_cnt = 0;
+  {
+    CriticalGuard(plan_cache.get_node_qsync());
+    ASSERT_EQ(0, node->dec_ref_count(LC_NODE_HANDLE));
+    ASSERT_EQ(0, destroyed_node_cnt);
+    ASSERT_TRUE(node == plan_cache.retired_nodes_);
+    // the reader is still in the critical section
+    plan_cache.destroy_retired_cache_nodes();
+    ASSERT_EQ(0, destroyed_node_cnt);
+    ASSERT_TRUE(node == plan_cache.retired_nodes_);
+  }
+  plan_cache.destroy_retired_cache_nodes();
+  ASSERT_EQ(1, destroyed_node_cnt);
+  ASSERT_TRUE(NULL == plan_cache.retired_nodes_);
+}
+
+// a cache node released without readers is destroyed at once
+TEST_F(TestLibCacheNodeRead, destroy_without_reader)
+{
+  ObPlanCache plan_cache;
+  lib::MemoryContext entity = NULL;
+  ObILibCacheNode *node = NULL;
+  ASSERT_EQ(OB_SUCCESS, mem_context_->CREATE_CONTEXT(entity,
+      lib::ContextParam().set_mem_attr(OB_SERVER_TENANT_ID, "TestLCNode")));
+  ASSERT_EQ(OB_SUCCESS, ObLCNodeFactory::create<MockCacheNode>(entity, node, &plan_cache));
+  node->inc_ref_count(LC_NODE_HANDLE);
+  destroyed_node_cnt = 0;
+  ASSERT_EQ(0, node->dec_ref_count(LC_NODE_HANDLE));
+  ASSERT_EQ(1, destroyed_node_cnt);
+  ASSERT_TRUE(NULL == plan_cache.retired_nodes_);
+}
+
+} // namespace test
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("ERROR");
+  OB_LOGGER.set_file_name("test_lib_cache_node_read.log", true);
+  ::testing::InitGoogleTest(&argc, argv);
+  if (argc > 1) {
+    test::duration_ms = strtol(argv[1], NULL, 10);
+  }
+  return RUN_ALL_TESTS();
+}
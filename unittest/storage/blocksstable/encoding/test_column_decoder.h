@@ -142,7 +142,8 @@ public:
         ObMicroBlockDecoder& decoder,
         sql::ObPushdownWhiteFilterNode &filter_node,
         common::ObBitmap &result_bitmap,
-        common::ObFixedArray<ObObj, ObIAllocator> &objs);
+        common::ObFixedArray<ObObj, ObIAllocator> &objs,
+        const sql::ObPushdownFilterExecutor *parent = nullptr);
 
   void basic_filter_pushdown_in_op_test();
 
@@ -627,7 +628,8 @@ int TestColumnDecoder::test_filter_pushdown_with_pd_info(
     ObMicroBlockDecoder& decoder,
     sql::ObPushdownWhiteFilterNode &filter_node,
     common::ObBitmap &result_bitmap,
-    common::ObFixedArray<ObObj, ObIAllocator> &objs)
+    common::ObFixedArray<ObObj, ObIAllocator> &objs,
+    const sql::ObPushdownFilterExecutor *parent)
 {
   int ret = OB_SUCCESS;
   sql::PushdownFilterInfo pd_filter_info;
@@ -674,9 +676,9 @@ int TestColumnDecoder::test_filter_pushdown_with_pd_info(
     LOG_WARN("Unexpected filter expr", K(ret), K(filter.filter_.expr_->arg_cnt_));
   } else {
     if (is_retro) {
-      ret = decoder.filter_pushdown_retro(nullptr, filter, pd_filter_info, col_idx, filter.col_params_.at(0), pd_filter_info.datum_buf_[0], result_bitmap);
+      ret = decoder.filter_pushdown_retro(parent, filter, pd_filter_info, col_idx, filter.col_params_.at(0), pd_filter_info.datum_buf_[0], result_bitmap);
     } else {
-      ret = decoder.filter_pushdown_filter(nullptr, filter, pd_filter_info, result_bitmap);
+      ret = decoder.filter_pushdown_filter(parent, filter, pd_filter_info, result_bitmap);
     }
   }
   if (nullptr != storage_datum_buf) {
@@ -46,6 +46,13 @@ public:
   virtual ~TestRLEDecoder() {}
 };
 
+class TestConstDecoder : public TestColumnDecoder
+{
+public:
+  TestConstDecoder() : TestColumnDecoder(ObColumnHeader::Type::CONST) {}
+  virtual ~TestConstDecoder() {}
+};
+
 class TestIntBaseDiffDecoder : public TestColumnDecoder
 {
 public:
@@ -100,6 +107,225 @@ TEST_F(TestIntBaseDiffDecoder, filter_pushdown_comaprison_neg_test)
   filter_pushdown_comaprison_neg_test();
 }
 
+TEST_F(TestIntBaseDiffDecoder, batch_filter_multi_batch_test)
+{
+  // Spans several FILTER_BATCH_SIZE batches with a partial tail, every 13th row is null
+  const int64_t row_cnt = 600;
+  int64_t row_seeds[row_cnt];
+  ObDatumRow row;
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator_, full_column_cnt_));
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    if (0 == i % 13) {
+      row_seeds[i] = 0;
+      for (int64_t j = 0; j < full_column_cnt_; ++j) {
+        row.storage_datums_[j].set_null();
+      }
+    } else {
+      row_seeds[i] = i % 7 + 1;
+      ASSERT_EQ(OB_SUCCESS, row_generate_.get_next_row(row_seeds[i], row));
+    }
+    ASSERT_EQ(OB_SUCCESS, encoder_.append_row(row)) << "i: " << i << std::endl;
+  }
+  char *buf = NULL;
+  int64_t size = 0;
+  ASSERT_EQ(OB_SUCCESS, encoder_.build_block(buf, size));
+  ObMicroBlockDecoder decoder;
+  ObMicroBlockData data(encoder_.data_buffer_.data(), encoder_.data_buffer_.length());
+  ASSERT_EQ(OB_SUCCESS, decoder.init(data, read_info_));
+
+  // Parent AND filter rejects the whole first batch and a few rows of the second one
+  const int64_t parent_skip_end = 256 + 10;
+  // released by the parent executor
+  ObBitmap *parent_bitmap = OB_NEWx(ObBitmap, &allocator_, allocator_);
+  ASSERT_TRUE(nullptr != parent_bitmap);
+  ASSERT_EQ(OB_SUCCESS, parent_bitmap->init(row_cnt, true));
+  for (int64_t i = 0; i < parent_skip_end; ++i) {
+    ASSERT_EQ(OB_SUCCESS, parent_bitmap->set(i, false));
+  }
+  sql::ObExecContext exec_ctx(allocator_);
+  sql::ObEvalCtx eval_ctx(exec_ctx);
+  sql::ObPushdownExprSpec expr_spec(allocator_);
+  sql::ObPushdownOperator op(eval_ctx, expr_spec);
+  sql::ObPushdownAndFilterNode and_node(allocator_);
+  sql::ObAndFilterExecutor parent(allocator_, and_node, op);
+  parent.filter_bitmap_ = parent_bitmap;
+  parent.need_check_row_filter_ = true;
+
+  auto expect_cnt = [&](const int64_t start, const int64_t end, const int64_t skip_end,
+                        bool (*match)(int64_t)) {
+    int64_t cnt = 0;
+    for (int64_t i = start; i < end; ++i) {
+      cnt += (i - start >= skip_end || 0 == row_seeds[i] || !match(row_seeds[i])) ? 0 : 1;
+    }
+    return cnt;
+  };
+  auto in_bt = [](int64_t seed) { return seed >= 2 && seed <= 5; };
+  auto in_set = [](int64_t seed) { return 1 == seed || 3 == seed; };
+
+  for (int64_t i = 0; i < full_column_cnt_; ++i) {
+    const ObObjType type = col_descs_.at(i).col_type_.get_type();
+    if ((i >= rowkey_cnt_ && i < read_info_.get_rowkey_count())
+        || !(ob_is_int_tc(type) || ob_is_uint_tc(type))) {
+      continue;
+    }
+    ObMalloc mallocer;
+    mallocer.set_label("ColumnDecoder");
+    ObFixedArray<ObObj, ObIAllocator> objs(mallocer, 3);
+    ObObj ref_obj;
+
+    // BETWEEN seed 2 and seed 5
+    sql::ObPushdownWhiteFilterNode bt_filter(allocator_);
+    bt_filter.op_type_ = sql::WHITE_OP_BT;
+    objs.init(2);
+    setup_obj(ref_obj, i, 2);
+    objs.push_back(ref_obj);
+    setup_obj(ref_obj, i, 5);
+    objs.push_back(ref_obj);
+    ObBitmap result_bitmap(allocator_);
+    result_bitmap.init(row_cnt);
+    ASSERT_EQ(OB_SUCCESS, test_filter_pushdown(i, is_retro_, decoder, bt_filter, result_bitmap, objs));
+    ASSERT_EQ(expect_cnt(0, row_cnt, 0, in_bt), result_bitmap.popcnt()) << "col: " << i;
+    ObBitmap pd_result_bitmap(allocator_);
+    pd_result_bitmap.init(450);
+    ASSERT_EQ(OB_SUCCESS, test_filter_pushdown_with_pd_info(100, 550, i, is_retro_, decoder, bt_filter, pd_result_bitmap, objs));
+    ASSERT_EQ(expect_cnt(100, 550, 0, in_bt), pd_result_bitmap.popcnt()) << "col: " << i;
+    result_bitmap.reuse();
+    ASSERT_EQ(OB_SUCCESS, test_filter_pushdown_with_pd_info(0, row_cnt, i, is_retro_, decoder, bt_filter, result_bitmap, objs, &parent));
+    ASSERT_EQ(expect_cnt(0, row_cnt, parent_skip_end, in_bt), result_bitmap.popcnt()) << "col: " << i;
+
+    // IN (seed 1, seed 3, absent seed 9)
+    sql::ObPushdownWhiteFilterNode in_filter(allocator_);
+    in_filter.op_type_ = sql::WHITE_OP_IN;
+    objs.reuse();
+    objs.init(3);
+    setup_obj(ref_obj, i, 1);
+    objs.push_back(ref_obj);
+    setup_obj(ref_obj, i, 3);
+    objs.push_back(ref_obj);
+    setup_obj(ref_obj, i, 9);
+    objs.push_back(ref_obj);
+    result_bitmap.reuse();
+    ASSERT_EQ(OB_SUCCESS, test_filter_pushdown(i, is_retro_, decoder, in_filter, result_bitmap, objs));
+    ASSERT_EQ(expect_cnt(0, row_cnt, 0, in_set), result_bitmap.popcnt()) << "col: " << i;
+    pd_result_bitmap.reuse();
+    ASSERT_EQ(OB_SUCCESS, test_filter_pushdown_with_pd_info(100, 550, i, is_retro_, decoder, in_filter, pd_result_bitmap, objs));
+    ASSERT_EQ(expect_cnt(100, 550, 0, in_set), pd_result_bitmap.popcnt()) << "col: " << i;
+    result_bitmap.reuse();
+    ASSERT_EQ(OB_SUCCESS, test_filter_pushdown_with_pd_info(0, row_cnt, i, is_retro_, decoder, in_filter, result_bitmap, objs, &parent));
+    ASSERT_EQ(expect_cnt(0, row_cnt, parent_skip_end, in_set), result_bitmap.popcnt()) << "col: " << i;
+    for (int64_t j = 0; j < 256; ++j) {
+      ASSERT_FALSE(result_bitmap.test(j)) << "col: " << i << " row: " << j;
+    }
+    objs.reuse();
+  }
+}
+
+TEST_F(TestRLEDecoder, set_run_res_test)
+{
+  ObRLEDecoder rle_decoder;
+  sql::PushdownFilterInfo pd_filter_info;
+  pd_filter_info.start_ = 10;
+  pd_filter_info.count_ = 20;
+  ObBitmap result_bitmap(allocator_);
+  ASSERT_EQ(OB_SUCCESS, result_bitmap.init(pd_filter_info.count_));
+
+  // run ends before the filter range
+  ASSERT_EQ(OB_SUCCESS, rle_decoder.set_run_res(0, 10, true, pd_filter_info, result_bitmap));
+  ASSERT_EQ(0, result_bitmap.popcnt());
+  // run starts after the filter range
+  ASSERT_EQ(OB_SUCCESS, rle_decoder.set_run_res(30, 64, true, pd_filter_info, result_bitmap));
+  ASSERT_EQ(0, result_bitmap.popcnt());
+  // run crossing the range begin, rows 10-14
+  ASSERT_EQ(OB_SUCCESS, rle_decoder.set_run_res(0, 15, true, pd_filter_info, result_bitmap));
+  ASSERT_EQ(5, result_bitmap.popcnt());
+  ASSERT_TRUE(result_bitmap.test(0));
+  ASSERT_TRUE(result_bitmap.test(4));
+  ASSERT_FALSE(result_bitmap.test(5));
+  // run crossing the range end, rows 25-29
+  ASSERT_EQ(OB_SUCCESS, rle_decoder.set_run_res(25, 40, true, pd_filter_info, result_bitmap));
+  ASSERT_EQ(10, result_bitmap.popcnt());
+  ASSERT_FALSE(result_bitmap.test(14));
+  ASSERT_TRUE(result_bitmap.test(15));
+  ASSERT_TRUE(result_bitmap.test(19));
+  // run covering the whole range and clear it
+  ASSERT_EQ(OB_SUCCESS, rle_decoder.set_run_res(0, 64, true, pd_filter_info, result_bitmap));
+  ASSERT_EQ(20, result_bitmap.popcnt());
+  ASSERT_EQ(OB_SUCCESS, rle_decoder.set_run_res(12, 14, false, pd_filter_info, result_bitmap));
+  ASSERT_EQ(18, result_bitmap.popcnt());
+  ASSERT_FALSE(result_bitmap.test(2));
+  ASSERT_FALSE(result_bitmap.test(3));
+  ASSERT_TRUE(result_bitmap.test(4));
+}
+
+TEST_F(TestConstDecoder, except_pos_range_test)
+{
+  // Exceptions at rows 5, 70, 71 and 150, null at row 180
+  const int64_t row_cnt = 200;
+  const int64_t seed0 = 10000;
+  const int64_t seed1 = 10001;
+  ObDatumRow row;
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator_, full_column_cnt_));
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    if (180 == i) {
+      for (int64_t j = 0; j < full_column_cnt_; ++j) {
+        row.storage_datums_[j].set_null();
+      }
+    } else {
+      const bool is_except = 5 == i || 70 == i || 71 == i || 150 == i;
+      ASSERT_EQ(OB_SUCCESS, row_generate_.get_next_row(is_except ? seed1 : seed0, row));
+    }
+    ASSERT_EQ(OB_SUCCESS, encoder_.append_row(row)) << "i: " << i << std::endl;
+  }
+  char *buf = NULL;
+  int64_t size = 0;
+  ASSERT_EQ(OB_SUCCESS, encoder_.build_block(buf, size));
+  ObMicroBlockDecoder decoder;
+  ObMicroBlockData data(encoder_.data_buffer_.data(), encoder_.data_buffer_.length());
+  ASSERT_EQ(OB_SUCCESS, decoder.init(data, read_info_));
+
+  struct { int64_t start_; int64_t end_; int64_t eq_cnt_; int64_t null_cnt_; } cases[] = {
+    {0, row_cnt, 4, 1},
+    {60, 160, 3, 0},
+    {72, 150, 0, 0},
+    {150, 151, 1, 0},
+    {151, row_cnt, 0, 1},
+    {0, 5, 0, 0},
+  };
+  for (int64_t i = 0; i < full_column_cnt_; ++i) {
+    if (i >= rowkey_cnt_ && i < read_info_.get_rowkey_count()) {
+      continue;
+    }
+    ObMalloc mallocer;
+    mallocer.set_label("ColumnDecoder");
+    ObFixedArray<ObObj, ObIAllocator> objs(mallocer, 1);
+    objs.init(1);
+    ObObj ref_obj;
+    setup_obj(ref_obj, i, seed1);
+    objs.push_back(ref_obj);
+    for (int64_t k = 0; k < ARRAYSIZEOF(cases); ++k) {
+      const int64_t count = cases[k].end_ - cases[k].start_;
+      sql::ObPushdownWhiteFilterNode eq_filter(allocator_);
+      eq_filter.op_type_ = sql::WHITE_OP_EQ;
+      ObBitmap result_bitmap(allocator_);
+      result_bitmap.init(count);
+      ASSERT_EQ(OB_SUCCESS, test_filter_pushdown_with_pd_info(cases[k].start_, cases[k].end_, i, is_retro_, decoder, eq_filter, result_bitmap, objs));
+      ASSERT_EQ(cases[k].eq_cnt_, result_bitmap.popcnt()) << "col: " << i << " case: " << k;
+
+      sql::ObPushdownWhiteFilterNode nu_filter(allocator_);
+      nu_filter.op_type_ = sql::WHITE_OP_NU;
+      result_bitmap.reuse();
+      ASSERT_EQ(OB_SUCCESS, test_filter_pushdown_with_pd_info(cases[k].start_, cases[k].end_, i, is_retro_, decoder, nu_filter, result_bitmap, objs));
+      ASSERT_EQ(cases[k].null_cnt_, result_bitmap.popcnt()) << "col: " << i << " case: " << k;
+
+      sql::ObPushdownWhiteFilterNode nn_filter(allocator_);
+      nn_filter.op_type_ = sql::WHITE_OP_NN;
+      result_bitmap.reuse();
+      ASSERT_EQ(OB_SUCCESS, test_filter_pushdown_with_pd_info(cases[k].start_, cases[k].end_, i, is_retro_, decoder, nn_filter, result_bitmap, objs));
+      ASSERT_EQ(count - cases[k].null_cnt_, result_bitmap.popcnt()) << "col: " << i << " case: " << k;
+    }
+  }
+}
+
 PUSHDOWN_GENERAL_TEST(TestRetroPDDecoder);
 PUSHDOWN_GENERAL_TEST(TestDictDecoder);
 PUSHDOWN_GENERAL_TEST(TestRLEDecoder);
@@ -17,6 +17,8 @@
 #define private public
 #include "storage/blocksstable/encoding/ob_micro_block_encoder.h"
 #include "storage/blocksstable/encoding/ob_micro_block_decoder.h"
+#include "storage/blocksstable/ob_micro_block_hash_index.h"
+#include "storage/access/ob_table_read_info.h"
 #include "storage/ob_i_store.h"
 #include "lib/string/ob_sql_string.h"
 #include "../ob_row_generate.h"
@@ -52,6 +54,13 @@ public:
   virtual void TearDown() {}
 
 protected:
+  void build_block(
+      const int64_t row_cnt,
+      const bool with_hash_index,
+      ObMicroBlockEncoder &encoder,
+      ObMicroBlockData &block_data);
+  void get_rowkey(const int64_t seed, ObDatumRow &row, ObDatumRowkey &rowkey);
+
   ObRowGenerate row_generate_;
   ObMicroBlockEncodingCtx ctx_;
   common::ObArray<share::schema::ObColDesc> col_descs_;
@@ -60,6 +69,7 @@ protected:
   ObObjType *col_obj_types_;
   share::ObTenantBase tenant_ctx_;
   ObDecodeResourcePool *decode_res_pool_;
+  ObRowkeyReadInfo read_info_;
   int64_t extra_rowkey_cnt_;
   int64_t column_cnt_;
   int64_t full_column_cnt_;
@@ -147,6 +157,11 @@ void TestMicroBlockDecoder::SetUp()
   }
   ASSERT_EQ(OB_SUCCESS, row_generate_.init(table, true/*multi_version*/));
   ASSERT_EQ(OB_SUCCESS, table.get_multi_version_column_descs(col_descs_));
+  ASSERT_EQ(OB_SUCCESS, read_info_.init(allocator_,
+                                        table.get_column_count(),
+                                        table.get_rowkey_column_num(),
+                                        lib::is_oracle_mode(),
+                                        col_descs_));
 
   ctx_.micro_block_size_ = 64L << 11;
   ctx_.macro_block_size_ = 2L << 20;
@@ -159,6 +174,46 @@ void TestMicroBlockDecoder::SetUp()
   ASSERT_EQ(OB_SUCCESS, encoder_.init(ctx_));
 }
 
+void TestMicroBlockDecoder::get_rowkey(const int64_t seed, ObDatumRow &row, ObDatumRowkey &rowkey)
+{
+  ASSERT_EQ(OB_SUCCESS, row_generate_.get_next_row(seed, row));
+  ASSERT_EQ(OB_SUCCESS, rowkey.assign(row.storage_datums_, rowkey_cnt_));
+}
+
+void TestMicroBlockDecoder::build_block(
+    const int64_t row_cnt,
+    const bool with_hash_index,
+    ObMicroBlockEncoder &encoder,
+    ObMicroBlockData &block_data)
+{
+  ObMicroBlockEncodingCtx ctx = ctx_;
+  ctx.micro_block_size_ = 1L << 20;
+  encoder.data_buffer_.allocator_.set_tenant_id(500);
+  encoder.row_buf_holder_.allocator_.set_tenant_id(500);
+  encoder.hash_index_buffer_.allocator_.set_tenant_id(500);
+  ASSERT_EQ(OB_SUCCESS, encoder.init(ctx));
+  ObDatumRow row;
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator_, full_column_cnt_));
+  ObMicroBlockHashIndexBuilder builder;
+  builder.is_inited_ = with_hash_index;
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    ObDatumRowkey rowkey;
+    uint64_t hash_value = 0;
+    get_rowkey(10000 + i, row, rowkey);
+    ASSERT_EQ(OB_SUCCESS, encoder.append_row(row)) << "i: " << i << std::endl;
+    if (with_hash_index) {
+      ASSERT_EQ(OB_SUCCESS, rowkey.murmurhash(0, read_info_.get_datum_utils(), hash_value));
+      ASSERT_EQ(OB_SUCCESS, builder.internal_add(hash_value, i));
+    }
+  }
+  ASSERT_EQ(OB_SUCCESS, encoder.append_hash_index(builder));
+  char *buf = NULL;
+  int64_t size = 0;
+  ASSERT_EQ(OB_SUCCESS, encoder.build_block(buf, size));
+  block_data = ObMicroBlockData(buf, size);
+  ASSERT_EQ(with_hash_index, block_data.get_micro_header()->is_contain_hash_index());
+}
+
 TEST_F(TestMicroBlockDecoder, decode_test)
 {
   ObDatumRow row;
@@ -192,6 +247,140 @@ TEST_F(TestMicroBlockDecoder, decode_test)
   }
 }
 
+TEST_F(TestMicroBlockDecoder, hash_index_row_data_len)
+{
+  // narrow format and wide format
+  const int64_t row_nums[] = {ROW_CNT, 300};
+  for (int64_t n = 0; n < ARRAYSIZEOF(row_nums); ++n) {
+    const int64_t row_cnt = row_nums[n];
+    ObMicroBlockEncoder plain_encoder;
+    ObMicroBlockEncoder hash_encoder;
+    ObMicroBlockData plain_data;
+    ObMicroBlockData hash_data;
+    build_block(row_cnt, false, plain_encoder, plain_data);
+    build_block(row_cnt, true, hash_encoder, hash_data);
+
+    // the hash index is appended after the row index, nothing else moves
+    int64_t hash_index_size = 0;
+    const ObMicroBlockHeader *header = hash_data.get_micro_header();
+    ASSERT_EQ(OB_SUCCESS, ObMicroBlockHashIndex::get_hash_index_size(
+        *header, hash_data.get_buf(), hash_data.get_buf_size(), hash_index_size));
+    ASSERT_GT(hash_index_size, 0);
+    ASSERT_EQ(hash_encoder.hash_index_buffer_.length(), hash_index_size);
+    ASSERT_EQ(plain_data.get_buf_size() + hash_index_size, hash_data.get_buf_size());
+    ASSERT_EQ(plain_data.get_micro_header()->row_data_offset_, header->row_data_offset_);
+    ASSERT_EQ(plain_data.get_micro_header()->row_index_byte_, header->row_index_byte_);
+
+    ObMicroBlockDecoder plain_decoder;
+    ObMicroBlockDecoder hash_decoder;
+    ASSERT_EQ(OB_SUCCESS, plain_decoder.init(plain_data, nullptr));
+    ASSERT_EQ(OB_SUCCESS, hash_decoder.init(hash_data, nullptr));
+    if (header->row_index_byte_ > 0) {
+      ASSERT_EQ(plain_decoder.var_row_index_.get_index_data() - plain_data.get_buf(),
+                hash_decoder.var_row_index_.get_index_data() - hash_data.get_buf());
+    } else {
+      ASSERT_EQ(plain_decoder.fix_row_index_.row_size_, hash_decoder.fix_row_index_.row_size_);
+    }
+
+    ObDatumRow row;
+    ObDatumRow plain_row;
+    ObDatumRow hash_row;
+    ASSERT_EQ(OB_SUCCESS, row.init(allocator_, full_column_cnt_));
+    ASSERT_EQ(OB_SUCCESS, plain_row.init(allocator_, full_column_cnt_));
+    ASSERT_EQ(OB_SUCCESS, hash_row.init(allocator_, full_column_cnt_));
+    for (int64_t i = 0; i < row_cnt; ++i) {
+      ASSERT_EQ(OB_SUCCESS, row_generate_.get_next_row(10000 + i, row));
+      ASSERT_EQ(OB_SUCCESS, plain_decoder.get_row(i, plain_row));
+      ASSERT_EQ(OB_SUCCESS, hash_decoder.get_row(i, hash_row));
+      for (int64_t j = 0; j < full_column_cnt_; ++j) {
+        ASSERT_TRUE(ObDatum::binary_equal(row.storage_datums_[j], hash_row.storage_datums_[j])) << i << " " << j;
+        ASSERT_TRUE(ObDatum::binary_equal(plain_row.storage_datums_[j], hash_row.storage_datums_[j])) << i << " " << j;
+      }
+    }
+  }
+}
+
+TEST_F(TestMicroBlockDecoder, hash_index_locate_row_fast_path)
+{
+  const ObStorageDatumUtils &datum_utils = read_info_.get_datum_utils();
+  const int64_t row_nums[] = {ROW_CNT, 300};
+  for (int64_t n = 0; n < ARRAYSIZEOF(row_nums); ++n) {
+    const int64_t row_cnt = row_nums[n];
+    ObMicroBlockEncoder encoder;
+    ObMicroBlockData block_data;
+    build_block(row_cnt, true, encoder, block_data);
+
+    ObEncodeBlockGetReader reader;
+    ASSERT_EQ(OB_SUCCESS, reader.init_by_read_info(block_data, read_info_));
+    ASSERT_TRUE(reader.hash_index_.is_inited());
+    ASSERT_EQ(row_cnt > ObMicroBlockHashIndex::MAX_OFFSET_SUPPORTED, reader.hash_index_.is_wide_);
+    ObDatumRow row;
+    ASSERT_EQ(OB_SUCCESS, row.init(allocator_, full_column_cnt_));
+    int64_t fast_path_cnt = 0;
+    for (int64_t i = 0; i < row_cnt; ++i) {
+      ObDatumRowkey rowkey;
+      const char *row_data = nullptr;
+      int64_t row_len = 0;
+      int64_t row_id = -1;
+      bool need_binary_search = false;
+      bool found = false;
+      get_rowkey(10000 + i, row, rowkey);
+      ASSERT_EQ(OB_SUCCESS, reader.locate_row_fast_path(rowkey, datum_utils, row_data, row_len,
+                                                        row_id, need_binary_search, found));
+      if (!need_binary_search) {
+        // only a bucket shared by several rowkeys falls back to binary search
+        ASSERT_TRUE(found) << i;
+        ASSERT_EQ(i, row_id);
+        ASSERT_TRUE(nullptr != row_data);
+        ++fast_path_cnt;
+      }
+      row_id = -1;
+      found = false;
+      ASSERT_EQ(OB_SUCCESS, reader.locate_row(rowkey, datum_utils, row_data, row_len, row_id, found));
+      ASSERT_TRUE(found) << i;
+      ASSERT_EQ(i, row_id);
+    }
+    ASSERT_GT(fast_path_cnt, 0);
+
+    // rowkeys out of the block are never found, whether the bucket is empty, used or collided
+    for (int64_t i = row_cnt; i < 2 * row_cnt; ++i) {
+      ObDatumRowkey rowkey;
+      const char *row_data = nullptr;
+      int64_t row_len = 0;
+      int64_t row_id = -1;
+      bool need_binary_search = false;
+      bool found = true;
+      get_rowkey(10000 + i, row, rowkey);
+      ASSERT_EQ(OB_SUCCESS, reader.locate_row_fast_path(rowkey, datum_utils, row_data, row_len,
+                                                        row_id, need_binary_search, found));
+      ASSERT_FALSE(found && !need_binary_search) << i;
+      ASSERT_EQ(OB_BEYOND_THE_RANGE, reader.get_row_id(block_data, rowkey, read_info_, row_id));
+    }
+  }
+
+  // without hash index the fast path always falls back to binary search
+  ObMicroBlockEncoder encoder;
+  ObMicroBlockData block_data;
+  build_block(ROW_CNT, false, encoder, block_data);
+  ObEncodeBlockGetReader reader;
+  ASSERT_EQ(OB_SUCCESS, reader.init_by_read_info(block_data, read_info_));
+  ASSERT_FALSE(reader.hash_index_.is_inited());
+  ObDatumRow row;
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator_, full_column_cnt_));
+  ObDatumRowkey rowkey;
+  const char *row_data = nullptr;
+  int64_t row_len = 0;
+  int64_t row_id = -1;
+  bool need_binary_search = false;
+  bool found = false;
+  get_rowkey(10000, row, rowkey);
+  ASSERT_EQ(OB_SUCCESS, reader.locate_row_fast_path(rowkey, datum_utils, row_data, row_len,
+                                                    row_id, need_binary_search, found));
+  ASSERT_TRUE(need_binary_search);
+  ASSERT_EQ(OB_SUCCESS, reader.get_row_id(block_data, rowkey, read_info_, row_id));
+  ASSERT_EQ(0, row_id);
+}
+
 } // end namespace blocksstable
 } // end namespace oceanbase
 
@@ -0,0 +1,281 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <gtest/gtest.h>
+#define protected public
+#define private public
+#include "storage/blocksstable/ob_block_cache_warmer.h"
+#include "share/config/ob_server_config.h"
+#include "lib/file/file_directory_utils.h"
+#include "lib/utility/ob_sort.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace blocksstable;
+
+namespace unittest
+{
+static const char *TEST_DIR = "./test_block_cache_warmer_dir";
+
+class TestBlockCacheWarmer : public ::testing::Test
+{
+public:
+  TestBlockCacheWarmer() = default;
+  void SetUp()
+  {
+    system("rm -rf ./test_block_cache_warmer_dir");
+    ASSERT_EQ(OB_SUCCESS, FileDirectoryUtils::create_full_path(TEST_DIR));
+    ASSERT_EQ(OB_SUCCESS, warmer_.init(TEST_DIR));
+  }
+  void TearDown()
+  {
+    warmer_.destroy();
+    system("rm -rf ./test_block_cache_warmer_dir");
+  }
+  static ObBlockCacheWarmKey make_key(const uint64_t tenant_id,
+                                      const int64_t block_index,
+                                      const int64_t offset,
+                                      const int64_t get_cnt)
+  {
+    ObBlockCacheWarmKey key;
+    key.tenant_id_ = tenant_id;
+    key.macro_id_ = MacroBlockId(0, block_index, 0);
+    key.offset_ = offset;
+    key.size_ = 4096;
+    key.get_cnt_ = get_cnt;
+    key.is_index_block_ = (0 == offset % 3);
+    return key;
+  }
+  void prepare_keys(const int64_t cnt, ObIArray<ObBlockCacheWarmKey> &keys)
+  {
+    for (int64_t i = 0; i < cnt; i++) {
+      ASSERT_EQ(OB_SUCCESS, keys.push_back(make_key(1001 + i % 3, 100 + i % 17, 4096 * (i + 1), i)));
+    }
+  }
+  // overwrite %len bytes at %offset of the snapshot, or truncate it to %offset
+  void corrupt_snapshot(const int64_t offset, const char *data, const int64_t len)
+  {
+    int fd = ::open(warmer_.snapshot_path_, O_RDWR);
+    ASSERT_LE(0, fd);
+    if (nullptr == data) {
+      ASSERT_EQ(0, ::ftruncate(fd, offset));
+    } else {
+      ASSERT_EQ(len, ::pwrite(fd, data, len, offset));
+    }
+    ::close(fd);
+  }
+protected:
+  ObBlockCacheWarmer warmer_;
+};
+
+TEST_F(TestBlockCacheWarmer, snapshot_round_trip)
+{
+  ObArray<ObBlockCacheWarmKey> keys;
+  ObArray<ObBlockCacheWarmKey> read_keys;
+  int64_t snapshot_ts = 0;
+
+  // no snapshot yet
+  ASSERT_EQ(OB_SUCCESS, warmer_.read_snapshot(read_keys, snapshot_ts));
+  ASSERT_EQ(0, read_keys.count());
+  ASSERT_EQ(0, snapshot_ts);
+
+  prepare_keys(1000, keys);
+  const int64_t before_ts = ObTimeUtility::current_time();
+  ASSERT_EQ(OB_SUCCESS, warmer_.write_snapshot(keys));
+  ASSERT_EQ(OB_SUCCESS, warmer_.read_snapshot(read_keys, snapshot_ts));
+  ASSERT_LE(before_ts, snapshot_ts);
+  ASSERT_EQ(keys.count(), read_keys.count());
+  for (int64_t i = 0; i < keys.count(); i++) {
+    const ObBlockCacheWarmKey &l = keys.at(i);
+    const ObBlockCacheWarmKey &r = read_keys.at(i);
+    ASSERT_EQ(l.tenant_id_, r.tenant_id_);
+    ASSERT_EQ(l.macro_id_, r.macro_id_);
+    ASSERT_EQ(l.offset_, r.offset_);
+    ASSERT_EQ(l.size_, r.size_);
+    ASSERT_EQ(l.get_cnt_, r.get_cnt_);
+    ASSERT_EQ(l.is_index_block_, r.is_index_block_);
+  }
+
+  // the new snapshot replaces the old one and no tmp file is left
+  keys.reuse();
+  prepare_keys(10, keys);
+  ASSERT_EQ(OB_SUCCESS, warmer_.write_snapshot(keys));
+  ASSERT_EQ(OB_SUCCESS, warmer_.read_snapshot(read_keys, snapshot_ts));
+  ASSERT_EQ(10, read_keys.count());
+  char tmp_path[MAX_PATH_SIZE] = {};
+  bool is_exist = true;
+  snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", warmer_.snapshot_path_);
+  ASSERT_EQ(OB_SUCCESS, FileDirectoryUtils::is_exists(tmp_path, is_exist));
+  ASSERT_FALSE(is_exist);
+
+  // empty snapshot
+  keys.reuse();
+  ASSERT_EQ(OB_SUCCESS, warmer_.write_snapshot(keys));
+  ASSERT_EQ(OB_SUCCESS, warmer_.read_snapshot(read_keys, snapshot_ts));
+  ASSERT_EQ(0, read_keys.count());
+}
+
+TEST_F(TestBlockCacheWarmer, corrupt_snapshot)
+{
+  ObArray<ObBlockCacheWarmKey> keys;
+  ObArray<ObBlockCacheWarmKey> read_keys;
+  int64_t snapshot_ts = 0;
+  int64_t file_size = 0;
+  prepare_keys(100, keys);
+  ObBlockCacheWarmer::SnapshotHeader header;
+  header.key_cnt_ = keys.count();
+  const int64_t header_size = header.get_serialize_size();
+
+  // flipped byte in the body
+  ASSERT_EQ(OB_SUCCESS, warmer_.write_snapshot(keys));
+  ASSERT_EQ(OB_SUCCESS, FileDirectoryUtils::get_file_size(warmer_.snapshot_path_, file_size));
+  corrupt_snapshot(file_size - 5, "\xff", 1);
+  ASSERT_EQ(OB_CHECKSUM_ERROR, warmer_.read_snapshot(read_keys, snapshot_ts));
+  ASSERT_EQ(0, read_keys.count());
+  ASSERT_EQ(0, snapshot_ts);
+
+  // truncated body
+  ASSERT_EQ(OB_SUCCESS, warmer_.write_snapshot(keys));
+  corrupt_snapshot(file_size - 10, nullptr, 0);
+  ASSERT_EQ(OB_INVALID_DATA, warmer_.read_snapshot(read_keys, snapshot_ts));
+  ASSERT_EQ(0, read_keys.count());
+
+  // truncated header
+  ASSERT_EQ(OB_SUCCESS, warmer_.write_snapshot(keys));
+  corrupt_snapshot(header_size / 2, nullptr, 0);
+  ASSERT_NE(OB_SUCCESS, warmer_.read_snapshot(read_keys, snapshot_ts));
+  ASSERT_EQ(0, read_keys.count());
+
+  // empty file
+  ASSERT_EQ(OB_SUCCESS, warmer_.write_snapshot(keys));
+  corrupt_snapshot(0, nullptr, 0);
+  ASSERT_EQ(OB_INVALID_DATA, warmer_.read_snapshot(read_keys, snapshot_ts));
+
+  // wrong magic
+  ASSERT_EQ(OB_SUCCESS, warmer_.write_snapshot(keys));
+  ObBlockCacheWarmer::SnapshotHeader bad_header;
+  bad_header.magic_ = 0x1234;
+  char header_buf[64] = {};
+  int64_t pos = 0;
+  ASSERT_EQ(OB_SUCCESS, bad_header.serialize(header_buf, sizeof(header_buf), pos));
+  corrupt_snapshot(0, header_buf, pos);
+  ASSERT_NE(OB_SUCCESS, warmer_.read_snapshot(read_keys, snapshot_ts));
+  ASSERT_EQ(0, read_keys.count());
+
+  // invalid key with a correct checksum
+  keys.at(50).offset_ = 0;
+  ASSERT_EQ(OB_SUCCESS, warmer_.write_snapshot(keys));
+  ASSERT_EQ(OB_INVALID_DATA, warmer_.read_snapshot(read_keys, snapshot_ts));
+  ASSERT_EQ(0, read_keys.count());
+}
+
+TEST_F(TestBlockCacheWarmer, warm_key_cmp)
+{
+  // tenant first
+  ASSERT_TRUE(ObBlockCacheWarmer::warm_key_cmp(make_key(1001, 200, 4096, 0),
+                                               make_key(1002, 100, 4096, 0)));
+  ASSERT_FALSE(ObBlockCacheWarmer::warm_key_cmp(make_key(1002, 100, 4096, 0),
+                                                make_key(1001, 200, 4096, 0)));
+  // then macro block
+  ASSERT_TRUE(ObBlockCacheWarmer::warm_key_cmp(make_key(1001, 100, 8192, 0),
+                                               make_key(1001, 200, 4096, 0)));
+  ObBlockCacheWarmKey l = make_key(1001, 100, 8192, 0);
+  ObBlockCacheWarmKey r = make_key(1001, 100, 4096, 0);
+  r.macro_id_ = MacroBlockId(1, 100, 0);
+  ASSERT_TRUE(ObBlockCacheWarmer::warm_key_cmp(l, r));
+  r.macro_id_ = MacroBlockId(0, 100, 1);
+  ASSERT_TRUE(ObBlockCacheWarmer::warm_key_cmp(l, r));
+  // then offset
+  ASSERT_TRUE(ObBlockCacheWarmer::warm_key_cmp(make_key(1001, 100, 4096, 0),
+                                               make_key(1001, 100, 8192, 0)));
+  // get count is not compared
+  ASSERT_FALSE(ObBlockCacheWarmer::warm_key_cmp(make_key(1001, 100, 4096, 1),
+                                                make_key(1001, 100, 4096, 0)));
+  ASSERT_FALSE(ObBlockCacheWarmer::warm_key_cmp(make_key(1001, 100, 4096, 0),
+                                                make_key(1001, 100, 4096, 1)));
+
+  // blocks of a macro block are adjacent and in offset order after sorting
+  ObArray<ObBlockCacheWarmKey> keys;
+  prepare_keys(1000, keys);
+  ObBlockCacheWarmKey *first = &keys.at(0);
+  lib::ob_sort(first, first + keys.count(), ObBlockCacheWarmer::warm_key_cmp);
+  for (int64_t i = 1; i < keys.count(); i++) {
+    const ObBlockCacheWarmKey &prev = keys.at(i - 1);
+    const ObBlockCacheWarmKey &cur = keys.at(i);
+    ASSERT_LE(prev.tenant_id_, cur.tenant_id_);
+    if (prev.tenant_id_ == cur.tenant_id_) {
+      ASSERT_LE(prev.macro_id_.second_id(), cur.macro_id_.second_id());
+      if (prev.macro_id_ == cur.macro_id_) {
+        ASSERT_LT(prev.offset_, cur.offset_);
+      }
+    }
+  }
+
+  // hottest first
+  lib::ob_sort(first, first + keys.count(), ObBlockCacheWarmer::hot_key_cmp);
+  for (int64_t i = 1; i < keys.count(); i++) {
+    ASSERT_GE(keys.at(i - 1).get_cnt_, keys.at(i).get_cnt_);
+  }
+}
+
+TEST_F(TestBlockCacheWarmer, throttle)
+{
+  const int64_t bandwidth = 4L << 20;
+  const int64_t now = ObTimeUtility::current_time();
+  warmer_.warm_start_ts_ = now;
+  warmer_.warm_bytes_ = 0;
+  ASSERT_EQ(0, warmer_.calc_throttle_wait_us(bandwidth, now));
+  warmer_.warm_bytes_ = 4L << 20;
+  ASSERT_EQ(1000000, warmer_.calc_throttle_wait_us(bandwidth, now));
+  ASSERT_EQ(500000, warmer_.calc_throttle_wait_us(bandwidth, now + 500000));
+  ASSERT_EQ(0, warmer_.calc_throttle_wait_us(bandwidth, now + 2000000));
+  warmer_.warm_bytes_ = 1L << 20;
+  ASSERT_EQ(250000, warmer_.calc_throttle_wait_us(bandwidth, now));
+  // invalid bandwidth is taken as 1 byte per second
+  warmer_.warm_bytes_ = 1;
+  ASSERT_EQ(1000000, warmer_.calc_throttle_wait_us(0, now));
+
+  // reading 1MB at 4MB/s waits about 250ms
+  GCONF._enable_block_cache_warm_restart = true;
+  GCONF._block_cache_warm_up_bandwidth = bandwidth;
+  warmer_.warm_start_ts_ = ObTimeUtility::current_time();
+  warmer_.warm_bytes_ = 0;
+  int64_t start_ts = ObTimeUtility::current_time();
+  warmer_.throttle(1L << 20);
+  int64_t cost_us = ObTimeUtility::current_time() - start_ts;
+  ASSERT_EQ(1L << 20, warmer_.warm_bytes_);
+  ASSERT_LE(200000, cost_us);
+  ASSERT_GT(2000000, cost_us);
+
+  // no wait once disabled
+  GCONF._enable_block_cache_warm_restart = false;
+  start_ts = ObTimeUtility::current_time();
+  warmer_.throttle(64L << 20);
+  cost_us = ObTimeUtility::current_time() - start_ts;
+  ASSERT_GT(200000, cost_us);
+}
+
+} // namespace unittest
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_block_cache_warmer.log*");
+  OB_LOGGER.set_file_name("test_block_cache_warmer.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
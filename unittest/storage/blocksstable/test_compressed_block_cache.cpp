@@ -0,0 +1,356 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#define private public
+#define protected public
+#include "share/ob_thread_mgr.h"
+#include "share/cache/ob_kv_storecache.h"
+#include "share/ob_simple_mem_limit_getter.h"
+#include "lib/compress/ob_compressor_pool.h"
+#include "lib/checksum/ob_crc64.h"
+#include "storage/blocksstable/ob_storage_cache_suite.h"
+#include "storage/blocksstable/ob_micro_block_header.h"
+#ifdef OB_BUILD_TDE_SECURITY
+#include "storage/blocksstable/ob_micro_block_encryption.h"
+#include "share/ob_master_key_getter.h"
+#endif
+
+namespace oceanbase
+{
+using namespace common;
+static ObSimpleMemLimitGetter getter;
+
+namespace blocksstable
+{
+
+class TestCompressedMicroBlockCache : public ::testing::Test
+{
+public:
+  // coprime with TOUCH_SAMPLE_RATIO, so the sampled touches go round all the blocks
+  static const int64_t BLOCK_CNT = 63;
+  static const int64_t HIT_ROUND = 32;
+  static const int64_t PAYLOAD_SIZE = 4096;
+  TestCompressedMicroBlockCache()
+    : tenant_id_(1001), allocator_(ObModIds::TEST), des_meta_() {}
+  virtual void SetUp();
+  virtual void TearDown();
+protected:
+  static void make_key(const uint64_t tenant_id, const int64_t idx, ObMicroBlockCacheKey &key);
+  static void make_payload(const int64_t idx, char *payload);
+  void build_raw_block(
+      const int64_t idx,
+      const ObCompressorType compressor_type,
+      const char *&block_buf,
+      int64_t &block_size);
+  void check_block(const int64_t idx, const ObMicroBlockBufferHandle &handle);
+  // what the io callback does after the block is read from disk
+  void put_block(const ObMicroBlockCacheKey &key, const char *block_buf, const int64_t block_size);
+protected:
+  uint64_t tenant_id_;
+  ObArenaAllocator allocator_;
+  ObMicroBlockDesMeta des_meta_;
+};
+
+void TestCompressedMicroBlockCache::SetUp()
+{
+  const int64_t bucket_num = 1024;
+  const int64_t max_cache_size = 1024L * 1024L * 1024L;
+  const int64_t block_size = common::OB_MALLOC_BIG_BLOCK_SIZE;
+  ASSERT_EQ(OB_SUCCESS, getter.add_tenant(tenant_id_, max_cache_size, max_cache_size));
+  ASSERT_EQ(OB_SUCCESS, ObKVGlobalCache::get_instance().init(&getter, bucket_num, max_cache_size, block_size));
+  // the scores are refreshed by the test
+  TG_CANCEL(lib::TGDefIDs::KVCacheWash, ObKVGlobalCache::get_instance().wash_task_);
+  TG_CANCEL(lib::TGDefIDs::KVCacheRep, ObKVGlobalCache::get_instance().replace_task_);
+  TG_WAIT(lib::TGDefIDs::KVCacheWash);
+  TG_WAIT(lib::TGDefIDs::KVCacheRep);
+  ASSERT_EQ(OB_SUCCESS, OB_STORE_CACHE.init(1, 1, 1, 1, 1, 10, 1));
+  GCONF._enable_compressed_block_cache = true;
+  des_meta_.compressor_type_ = LZ4_COMPRESSOR;
+  des_meta_.row_store_type_ = FLAT_ROW_STORE;
+}
+
+void TestCompressedMicroBlockCache::TearDown()
+{
+  GCONF._enable_compressed_block_cache = false;
+  OB_STORE_CACHE.destroy();
+  ObKVGlobalCache::get_instance().destroy();
+  getter.reset();
+  allocator_.reset();
+}
+
+void TestCompressedMicroBlockCache::make_key(
+    const uint64_t tenant_id,
+    const int64_t idx,
+    ObMicroBlockCacheKey &key)
+{
+  key.set(tenant_id, MacroBlockId(0, 100 + idx, 0), 0, PAYLOAD_SIZE);
+}
+
+void TestCompressedMicroBlockCache::make_payload(const int64_t idx, char *payload)
+{
+  int64_t pos = 0;
+  while (pos < PAYLOAD_SIZE) {
+    payload[pos] = static_cast<char>('a' + (pos / 64 + idx) % 26);
+    ++pos;
+  }
+}
+
+void TestCompressedMicroBlockCache::build_raw_block(
+    const int64_t idx,
+    const ObCompressorType compressor_type,
+    const char *&block_buf,
+    int64_t &block_size)
+{
+  char *payload = static_cast<char *>(allocator_.alloc(PAYLOAD_SIZE));
+  ASSERT_TRUE(nullptr != payload);
+  make_payload(idx, payload);
+
+  const char *zpayload = payload;
+  int64_t zsize = PAYLOAD_SIZE;
+  if (NONE_COMPRESSOR != compressor_type) {
+    ObCompressor *compressor = nullptr;
+    int64_t max_overflow_size = 0;
+    ASSERT_EQ(OB_SUCCESS, ObCompressorPool::get_instance().get_compressor(compressor_type, compressor));
+    ASSERT_EQ(OB_SUCCESS, compressor->get_max_overflow_size(PAYLOAD_SIZE, max_overflow_size));
+    const int64_t max_zsize = PAYLOAD_SIZE + max_overflow_size;
+    char *zbuf = static_cast<char *>(allocator_.alloc(max_zsize));
+    ASSERT_TRUE(nullptr != zbuf);
+    ASSERT_EQ(OB_SUCCESS, compressor->compress(payload, PAYLOAD_SIZE, zbuf, max_zsize, zsize));
+    ASSERT_LT(zsize, PAYLOAD_SIZE + 0);
+    zpayload = zbuf;
+  }
+#ifdef OB_BUILD_TDE_SECURITY
+  if (share::ObEncryptionUtil::need_encrypt(static_cast<share::ObCipherOpMode>(des_meta_.encrypt_id_))) {
+    ObMicroBlockEncryption encryption;
+    const char *encrypt_buf = nullptr;
+    int64_t encrypt_size = 0;
+    ASSERT_EQ(OB_SUCCESS, encryption.init(des_meta_.encrypt_id_, MTL_ID(), des_meta_.master_key_id_,
+        des_meta_.encrypt_key_, share::OB_MAX_TABLESPACE_ENCRYPT_KEY_LENGTH));
+    ASSERT_EQ(OB_SUCCESS, encryption.encrypt(zpayload, zsize, encrypt_buf, encrypt_size));
+    char *buf = static_cast<char *>(allocator_.alloc(encrypt_size));
+    ASSERT_TRUE(nullptr != buf);
+    MEMCPY(buf, encrypt_buf, encrypt_size);
+    zpayload = buf;
+    zsize = encrypt_size;
+  }
+#endif
+
+  ObMicroBlockHeader header;
+  header.column_count_ = 1;
+  header.rowkey_column_count_ = 1;
+  header.header_size_ = header.get_serialize_size();
+  header.row_store_type_ = FLAT_ROW_STORE;
+  header.row_count_ = 1;
+  header.original_length_ = PAYLOAD_SIZE;
+  header.data_length_ = PAYLOAD_SIZE;
+  header.data_zlength_ = zsize;
+  header.data_checksum_ = ob_crc64_sse42(zpayload, zsize);
+  header.set_header_checksum();
+
+  int64_t pos = 0;
+  block_size = header.header_size_ + zsize;
+  char *buf = static_cast<char *>(allocator_.alloc(block_size));
+  ASSERT_TRUE(nullptr != buf);
+  ASSERT_EQ(OB_SUCCESS, header.serialize(buf, block_size, pos));
+  MEMCPY(buf + pos, zpayload, zsize);
+  block_buf = buf;
+}
+
+void TestCompressedMicroBlockCache::check_block(const int64_t idx, const ObMicroBlockBufferHandle &handle)
+{
+  char payload[PAYLOAD_SIZE];
+  make_payload(idx, payload);
+  const ObMicroBlockData *block_data = handle.get_block_data();
+  ASSERT_TRUE(nullptr != block_data);
+  const ObMicroBlockHeader *header = block_data->get_micro_header();
+  ASSERT_TRUE(nullptr != header);
+  ASSERT_EQ(header->header_size_ + PAYLOAD_SIZE, block_data->get_buf_size());
+  ASSERT_EQ(0, MEMCMP(payload, block_data->get_buf() + header->header_size_, PAYLOAD_SIZE));
+}
+
+void TestCompressedMicroBlockCache::put_block(
+    const ObMicroBlockCacheKey &key,
+    const char *block_buf,
+    const int64_t block_size)
+{
+  ObDataMicroBlockCache &block_cache = OB_STORE_CACHE.get_block_cache();
+  ObMacroBlockReader reader(key.get_tenant_id());
+  ObMicroBlockBufferHandle handle;
+  ASSERT_EQ(OB_SUCCESS, block_cache.put_cache_block(des_meta_, block_buf, block_size, key, reader,
+      block_cache.allocator_, handle.micro_block_, handle.handle_));
+  ASSERT_EQ(OB_SUCCESS, OB_STORE_CACHE.get_compressed_block_cache().put_block(key, block_buf, block_size));
+}
+
+TEST_F(TestCompressedMicroBlockCache, test_put_block)
+{
+  ObCompressedMicroBlockCache &compressed_cache = OB_STORE_CACHE.get_compressed_block_cache();
+  ObMicroBlockCacheKey key;
+  const ObCompressedMicroBlockCacheValue *value = nullptr;
+  ObKVCacheHandle handle;
+  const char *block_buf = nullptr;
+  int64_t block_size = 0;
+
+  make_key(tenant_id_, 0, key);
+  build_raw_block(0, LZ4_COMPRESSOR, block_buf, block_size);
+  ASSERT_EQ(OB_INVALID_ARGUMENT, compressed_cache.put_block(key, nullptr, block_size));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, compressed_cache.get_block(key, value, handle));
+  ASSERT_EQ(OB_SUCCESS, compressed_cache.put_block(key, block_buf, block_size));
+  ASSERT_EQ(OB_SUCCESS, compressed_cache.put_block(key, block_buf, block_size));
+  ASSERT_EQ(OB_SUCCESS, compressed_cache.get_block(key, value, handle));
+  ASSERT_EQ(block_size, value->get_size());
+  ASSERT_EQ(0, MEMCMP(block_buf, value->get_buf(), block_size));
+  handle.reset();
+
+  // an uncompressed block isn't worth caching twice
+  make_key(tenant_id_, 1, key);
+  build_raw_block(1, NONE_COMPRESSOR, block_buf, block_size);
+  ASSERT_EQ(OB_SUCCESS, compressed_cache.put_block(key, block_buf, block_size));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, compressed_cache.get_block(key, value, handle));
+}
+
+TEST_F(TestCompressedMicroBlockCache, test_promote)
+{
+  ObDataMicroBlockCache &block_cache = OB_STORE_CACHE.get_block_cache();
+  ObCompressedMicroBlockCache &compressed_cache = OB_STORE_CACHE.get_compressed_block_cache();
+  ObMicroBlockCacheKey key;
+  ObMicroBlockBufferHandle handle;
+  const char *block_buf = nullptr;
+  int64_t block_size = 0;
+
+  for (int64_t i = 0; i < 2; ++i) {
+    make_key(tenant_id_, i, key);
+    build_raw_block(i, LZ4_COMPRESSOR, block_buf, block_size);
+    ASSERT_EQ(OB_SUCCESS, compressed_cache.put_block(key, block_buf, block_size));
+  }
+
+  // block 0 is decompressed from the compressed tier into the user block cache
+  make_key(tenant_id_, 0, key);
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, block_cache.get_cache_block(key, handle));
+  ASSERT_EQ(OB_SUCCESS, block_cache.get_cache_block(key, des_meta_, handle));
+  check_block(0, handle);
+  handle.reset();
+  ASSERT_EQ(OB_SUCCESS, block_cache.get_cache_block(key, handle));
+  check_block(0, handle);
+  handle.reset();
+
+  // block 1 isn't promoted when the compressed tier is disabled
+  GCONF._enable_compressed_block_cache = false;
+  make_key(tenant_id_, 1, key);
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, block_cache.get_cache_block(key, des_meta_, handle));
+  GCONF._enable_compressed_block_cache = true;
+  ASSERT_EQ(OB_SUCCESS, block_cache.get_cache_block(key, des_meta_, handle));
+  check_block(1, handle);
+  handle.reset();
+
+  // a block in neither cache
+  make_key(tenant_id_, 2, key);
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, block_cache.get_cache_block(key, des_meta_, handle));
+}
+
+#ifdef OB_BUILD_TDE_SECURITY
+TEST_F(TestCompressedMicroBlockCache, test_promote_encrypted_block)
+{
+  const int64_t master_key_id = 123;
+  char master_key[share::OB_MAX_MASTER_KEY_LENGTH] = "12345";
+  char raw_key[OB_MAX_ENCRYPTION_KEY_NAME_LENGTH] = "54321";
+  char encrypt_key[OB_MAX_ENCRYPTION_KEY_NAME_LENGTH];
+  int64_t encrypt_key_len = 0;
+  share::ObCipherOpMode mode = share::ObCipherOpMode::ob_invalid_mode;
+  ASSERT_EQ(OB_SUCCESS, share::ObMasterKeyGetter::instance().init(nullptr));
+  ASSERT_EQ(OB_SUCCESS, share::ObMasterKeyGetter::instance().set_master_key(
+      MTL_ID(), master_key_id, master_key, strlen(master_key)));
+  ASSERT_EQ(OB_SUCCESS, share::ObMasterKeyGetter::get_table_key_algorithm(MTL_ID(), mode));
+  ASSERT_EQ(OB_SUCCESS, share::ObBlockCipher::encrypt(master_key, strlen(master_key), raw_key,
+      strlen(raw_key), OB_MAX_ENCRYPTION_KEY_NAME_LENGTH, nullptr, 0, nullptr, 0,
+      0, mode, encrypt_key, encrypt_key_len, nullptr));
+  des_meta_.encrypt_id_ = static_cast<int64_t>(mode);
+  des_meta_.master_key_id_ = master_key_id;
+  des_meta_.encrypt_key_ = encrypt_key;
+
+  ObDataMicroBlockCache &block_cache = OB_STORE_CACHE.get_block_cache();
+  ObMicroBlockCacheKey key;
+  ObMicroBlockBufferHandle handle;
+  const char *block_buf = nullptr;
+  int64_t block_size = 0;
+  make_key(tenant_id_, 0, key);
+  build_raw_block(0, LZ4_COMPRESSOR, block_buf, block_size);
+  ASSERT_EQ(OB_SUCCESS, OB_STORE_CACHE.get_compressed_block_cache().put_block(key, block_buf, block_size));
+  // the block is decrypted and then decompressed
+  ASSERT_EQ(OB_SUCCESS, block_cache.get_cache_block(key, des_meta_, handle));
+  check_block(0, handle);
+  handle.reset();
+  share::ObMasterKeyGetter::instance().destroy();
+}
+#endif
+
+TEST_F(TestCompressedMicroBlockCache, test_wash_order)
+{
+  ObDataMicroBlockCache &block_cache = OB_STORE_CACHE.get_block_cache();
+  ObCompressedMicroBlockCache &compressed_cache = OB_STORE_CACHE.get_compressed_block_cache();
+  ObMicroBlockCacheKey key;
+  ObMicroBlockBufferHandle handle;
+  const char *block_buf = nullptr;
+  int64_t block_size = 0;
+
+  for (int64_t i = 0; i < BLOCK_CNT; ++i) {
+    make_key(tenant_id_, i, key);
+    build_raw_block(i, LZ4_COMPRESSOR, block_buf, block_size);
+    put_block(key, block_buf, block_size);
+  }
+  // all the reads hit the user block cache
+  for (int64_t round = 0; round < HIT_ROUND; ++round) {
+    for (int64_t i = 0; i < BLOCK_CNT; ++i) {
+      make_key(tenant_id_, i, key);
+      ASSERT_EQ(OB_SUCCESS, block_cache.get_cache_block(key, des_meta_, handle));
+      handle.reset();
+    }
+  }
+  ObKVGlobalCache::get_instance().store_.refresh_score();
+
+  ObArray<ObKVCacheStoreMemblockInfo> memblock_infos;
+  double block_score = 0;
+  double compressed_score = 0;
+  int64_t block_kv_cnt = 0;
+  int64_t compressed_kv_cnt = 0;
+  ASSERT_EQ(OB_SUCCESS, ObKVGlobalCache::get_instance().get_memblock_info(tenant_id_, memblock_infos));
+  for (int64_t i = 0; i < memblock_infos.count(); ++i) {
+    const ObKVCacheStoreMemblockInfo &info = memblock_infos.at(i);
+    if (info.cache_id_ == block_cache.cache_id_) {
+      block_score += info.score_;
+      block_kv_cnt += info.kv_cnt_;
+    } else if (info.cache_id_ == compressed_cache.cache_id_) {
+      compressed_score += info.score_;
+      compressed_kv_cnt += info.kv_cnt_;
+      ASSERT_EQ(ObCompressedMicroBlockCache::TOUCH_SAMPLE_RATIO + 0, info.priority_);
+    }
+  }
+  ASSERT_EQ(BLOCK_CNT + 0, block_kv_cnt);
+  ASSERT_EQ(BLOCK_CNT + 0, compressed_kv_cnt);
+  // the memblocks of lower score are washed first, the compressed copies score
+  // at least like their decompressed copies in much fewer memblocks
+  ASSERT_TRUE(compressed_score >= block_score)
+      << "compressed_score: " << compressed_score << " block_score: " << block_score;
+}
+
+}//namespace blocksstable
+}//namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  system("rm -f test_compressed_block_cache.log*");
+  OB_LOGGER.set_file_name("test_compressed_block_cache.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
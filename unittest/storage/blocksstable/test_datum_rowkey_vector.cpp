@@ -1043,6 +1043,71 @@ TEST_F(ObDatumRowkeyVectorTest, rowkey_vector_deep_copy)
   ASSERT_EQ(&new_vector, endkey.get_discrete_rowkey()->rowkey_vector_);
 }
 
+TEST_F(ObDatumRowkeyVectorTest, datum_utils_norm_key)
+{
+  int cmp_ret = 0;
+  int norm_cmp_ret = 0;
+  ObStorageDatum left;
+  ObStorageDatum right;
+  ObStorageDatumUtils int_utils;
+  prepare_datum_util(2, int_utils);
+  ASSERT_TRUE(int_utils.has_norm_key());
+  const ObStorageDatumCmpFunc &int_cmp = int_utils.get_cmp_funcs().at(0);
+  const int64_t ints[] = {INT64_MIN, INT64_MIN + 1, -100, -1, 0, 1, 100, INT64_MAX - 1, INT64_MAX};
+  for (int64_t i = 0; i < ARRAYSIZEOF(ints); ++i) {
+    for (int64_t j = 0; j < ARRAYSIZEOF(ints); ++j) {
+      left.reuse();
+      right.reuse();
+      left.set_int(ints[i]);
+      right.set_int(ints[j]);
+      ASSERT_EQ(OB_SUCCESS, int_cmp.compare(left, right, cmp_ret));
+      ASSERT_EQ(i != j, int_utils.compare_norm_key(left, right, norm_cmp_ret));
+      if (i != j) {
+        ASSERT_EQ(cmp_ret > 0, norm_cmp_ret > 0);
+      }
+    }
+  }
+  // null and min/max need the full comparison
+  left.set_null();
+  ASSERT_FALSE(int_utils.compare_norm_key(left, right, norm_cmp_ret));
+  left.set_max();
+  ASSERT_FALSE(int_utils.compare_norm_key(left, right, norm_cmp_ret));
+
+  ObSEArray<share::schema::ObColDesc, 2> cols_desc;
+  share::schema::ObColDesc col_desc;
+  col_desc.col_id_ = 16;
+  col_desc.col_type_.set_varchar();
+  col_desc.col_type_.set_collation_type(CS_TYPE_BINARY);
+  ASSERT_EQ(OB_SUCCESS, cols_desc.push_back(col_desc));
+  ObStorageDatumUtils binary_utils;
+  ASSERT_EQ(OB_SUCCESS, binary_utils.init(cols_desc, 1, false, allocator_));
+  ASSERT_TRUE(binary_utils.has_norm_key());
+  const ObStorageDatumCmpFunc &binary_cmp = binary_utils.get_cmp_funcs().at(0);
+  const char *strs[] = {"", "a", "a\x00", "ab", "abcdefgh", "abcdefghi", "abcdefgz", "b", "\xff"};
+  const int64_t str_lens[] = {0, 1, 2, 2, 8, 9, 8, 1, 1};
+  for (int64_t i = 0; i < ARRAYSIZEOF(strs); ++i) {
+    for (int64_t j = 0; j < ARRAYSIZEOF(strs); ++j) {
+      left.reuse();
+      right.reuse();
+      left.set_string(strs[i], str_lens[i]);
+      right.set_string(strs[j], str_lens[j]);
+      ASSERT_EQ(OB_SUCCESS, binary_cmp.compare(left, right, cmp_ret));
+      if (binary_utils.compare_norm_key(left, right, norm_cmp_ret)) {
+        ASSERT_EQ(cmp_ret > 0, norm_cmp_ret > 0) << i << " " << j;
+      } else {
+        ASSERT_TRUE(0 == cmp_ret || (i == 1 && j == 2) || (i == 2 && j == 1)
+                    || (i == 4 && j == 5) || (i == 5 && j == 4)) << i << " " << j;
+      }
+    }
+  }
+
+  // pad space collation has no normalized key
+  cols_desc.at(0).col_type_.set_collation_type(CS_TYPE_UTF8MB4_BIN);
+  ObStorageDatumUtils utf8_utils;
+  ASSERT_EQ(OB_SUCCESS, utf8_utils.init(cols_desc, 1, false, allocator_));
+  ASSERT_FALSE(utf8_utils.has_norm_key());
+}
+
 }
 }
 
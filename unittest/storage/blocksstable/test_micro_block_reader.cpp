@@ -216,6 +216,63 @@ TEST_F(TestMicroBlockReader, test_success)
   ObKVGlobalCache::get_instance().destroy();
 }
 
+TEST_F(TestMicroBlockReader, test_hash_index)
+{
+  ObArray<ObColDesc> columns;
+  ASSERT_EQ(OB_SUCCESS, row_generate_.get_schema().get_column_ids(columns));
+  ASSERT_EQ(OB_SUCCESS, read_info_.init(
+          allocator_, 16000, row_generate_.get_schema().get_rowkey_column_num(), lib::is_oracle_mode(), columns, nullptr/*storage_cols_index*/));
+  const ObStorageDatumUtils &datum_utils = read_info_.get_datum_utils();
+  ObDatumRow row;
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator_, column_num));
+  ObDatumRow multi_version_row;
+  ASSERT_EQ(OB_SUCCESS, multi_version_row.init(allocator_, column_num + 2));
+  // narrow format and wide format
+  const int64_t row_nums[] = {100, 600};
+  for (int64_t n = 0; n < ARRAYSIZEOF(row_nums); ++n) {
+    const int64_t test_row_num = row_nums[n];
+    ObMicroBlockWriter writer;
+    writer.data_buffer_.allocator_.set_tenant_id(500);
+    writer.index_buffer_.allocator_.set_tenant_id(500);
+    ASSERT_EQ(OB_SUCCESS, writer.init(macro_block_size, rowkey_column_count, column_num + 2));
+    ObMicroBlockHashIndexBuilder builder;
+    builder.is_inited_ = true;
+    for (int64_t i = 0; i < test_row_num; ++i) {
+      ObDatumRowkey rowkey;
+      uint64_t hash_value = 0;
+      ASSERT_EQ(OB_SUCCESS, row_generate_.get_next_row(i, row));
+      convert_to_multi_version_row(row, row_generate_.get_schema(), SNAPSHOT_VERSION, multi_version_row);
+      ASSERT_EQ(OB_SUCCESS, writer.append_row(multi_version_row));
+      ASSERT_EQ(OB_SUCCESS, rowkey.assign(multi_version_row.storage_datums_, rowkey_column_count));
+      ASSERT_EQ(OB_SUCCESS, rowkey.murmurhash(0, datum_utils, hash_value));
+      ASSERT_EQ(OB_SUCCESS, builder.internal_add(hash_value, i));
+    }
+    ASSERT_EQ(test_row_num >= ObMicroBlockHashIndex::MAX_OFFSET_SUPPORTED, builder.is_wide());
+    ASSERT_EQ(OB_SUCCESS, writer.append_hash_index(builder));
+    char *buf = NULL;
+    int64_t size = 0;
+    ASSERT_EQ(OB_SUCCESS, writer.build_block(buf, size));
+
+    ObMicroBlockData block(buf, size);
+    ObMicroBlockGetReader get_reader;
+    for (int64_t i = 0; i < test_row_num; ++i) {
+      ObDatumRowkey rowkey;
+      int64_t row_id = -1;
+      ASSERT_EQ(OB_SUCCESS, row_generate_.get_next_row(i, row));
+      ASSERT_EQ(OB_SUCCESS, rowkey.assign(row.storage_datums_, rowkey_column_count));
+      ASSERT_EQ(OB_SUCCESS, get_reader.get_row_id(block, rowkey, read_info_, row_id));
+      ASSERT_TRUE(get_reader.hash_index_.is_inited());
+      ASSERT_EQ(test_row_num >= ObMicroBlockHashIndex::MAX_OFFSET_SUPPORTED, get_reader.hash_index_.is_wide_);
+      ASSERT_EQ(i, row_id);
+    }
+    ObDatumRowkey rowkey;
+    int64_t row_id = -1;
+    ASSERT_EQ(OB_SUCCESS, row_generate_.get_next_row(test_row_num + 1, row));
+    ASSERT_EQ(OB_SUCCESS, rowkey.assign(row.storage_datums_, rowkey_column_count));
+    ASSERT_EQ(OB_BEYOND_THE_RANGE, get_reader.get_row_id(block, rowkey, read_info_, row_id));
+  }
+}
+
 //TEST_F(TestMicroBlockReader, not_init)
 //{
   //int ret = OB_SUCCESS;
@@ -0,0 +1,245 @@
+/**
+ * Copyright (c) 2023 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+#define private public
+#define protected public
+#include "storage/compaction/ob_partition_parallel_merge_ctx.h"
+#include "storage/compaction/ob_medium_compaction_info.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace blocksstable;
+using namespace storage;
+using namespace compaction;
+
+namespace unittest
+{
+
+class TestParallelMergeCtx : public ::testing::Test
+{
+public:
+  TestParallelMergeCtx() : allocator_(ObModIds::TEST), merge_ctx_(allocator_) {}
+  virtual void SetUp()
+  {
+    ObSEArray<share::schema::ObColDesc, 1> &cols_desc = cols_desc_;
+    share::schema::ObColDesc col_desc;
+    col_desc.col_id_ = 16;
+    col_desc.col_type_.set_type(ObIntType);
+    col_desc.col_type_.set_collation_type(CS_TYPE_BINARY);
+    col_desc.col_type_.set_collation_level(CS_LEVEL_NUMERIC);
+    ASSERT_EQ(OB_SUCCESS, cols_desc.push_back(col_desc));
+    ASSERT_EQ(OB_SUCCESS, datum_utils_.init(cols_desc, 1, false, allocator_));
+  }
+  virtual void TearDown()
+  {
+    datum_utils_.reset();
+    cols_desc_.reset();
+    allocator_.reset();
+  }
+  void make_key(const int64_t val, ObDatumRowkey &key)
+  {
+    ObStorageDatum *datum = OB_NEWx(ObStorageDatum, &allocator_);
+    ASSERT_TRUE(nullptr != datum);
+    datum->set_int(val);
+    ASSERT_EQ(OB_SUCCESS, key.assign(datum, 1));
+  }
+  // the end keys of the incremental macro blocks of each sstable
+  void prepare_inc_endkeys(const std::vector<std::vector<int64_t>> &sstables)
+  {
+    for (const std::vector<int64_t> &endkeys : sstables) {
+      ASSERT_EQ(OB_SUCCESS, cursors_.push_back(inc_endkeys_.count()));
+      ASSERT_EQ(OB_SUCCESS, counted_idxs_.push_back(inc_endkeys_.count()));
+      for (const int64_t val : endkeys) {
+        ObDatumRowkey key;
+        make_key(val, key);
+        ASSERT_EQ(OB_SUCCESS, inc_endkeys_.push_back(key));
+      }
+      ASSERT_EQ(OB_SUCCESS, end_idxs_.push_back(inc_endkeys_.count()));
+    }
+  }
+  void count_base_macros(const std::vector<int64_t> &base_endkeys, std::vector<int64_t> &weights)
+  {
+    weights.clear();
+    for (const int64_t val : base_endkeys) {
+      ObDatumRowkey key;
+      int64_t inc_macro_cnt = 0;
+      make_key(val, key);
+      ASSERT_EQ(OB_SUCCESS, ObParallelMergeCtx::count_overlapped_inc_macros(key, inc_endkeys_,
+          end_idxs_, datum_utils_, cursors_, counted_idxs_, inc_macro_cnt));
+      weights.push_back(inc_macro_cnt);
+    }
+  }
+  void check_ranges(const std::vector<int64_t> &weights,
+                    const int64_t concurrent_cnt,
+                    const std::vector<int64_t> &expected)
+  {
+    ObSEArray<int64_t, 16> macro_weights;
+    ObSEArray<int64_t, 16> range_last_idxs;
+    for (const int64_t weight : weights) {
+      ASSERT_EQ(OB_SUCCESS, macro_weights.push_back(weight));
+    }
+    merge_ctx_.concurrent_cnt_ = concurrent_cnt;
+    ASSERT_EQ(OB_SUCCESS, merge_ctx_.get_weighted_range_last_idxs(macro_weights, range_last_idxs));
+    ASSERT_EQ(static_cast<int64_t>(expected.size()), range_last_idxs.count());
+    ASSERT_TRUE(range_last_idxs.count() <= concurrent_cnt);
+    for (int64_t i = 0; i < range_last_idxs.count(); ++i) {
+      ASSERT_EQ(expected[i], range_last_idxs.at(i));
+    }
+  }
+public:
+  ObArenaAllocator allocator_;
+  ObParallelMergeCtx merge_ctx_;
+  ObStorageDatumUtils datum_utils_;
+  ObSEArray<share::schema::ObColDesc, 1> cols_desc_;
+  ObSEArray<ObDatumRowkey, 16> inc_endkeys_;
+  ObSEArray<int64_t, 4> cursors_;
+  ObSEArray<int64_t, 4> counted_idxs_;
+  ObSEArray<int64_t, 4> end_idxs_;
+};
+
+// every base macro block overlapped by an incremental macro block is weighted,
+// not only the ones its end key falls in
+TEST_F(TestParallelMergeCtx, overlapped_inc_macros)
+{
+  // base macro blocks: (-inf,10], (10,20], ..., (70,80]
+  const std::vector<int64_t> base_endkeys = {10, 20, 30, 40, 50, 60, 70, 80};
+  std::vector<int64_t> weights;
+  // (-inf,15] overlaps the first two, (15,35] the 2nd to the 4th
+  prepare_inc_endkeys({{15, 35}});
+  count_base_macros(base_endkeys, weights);
+  ASSERT_EQ(std::vector<int64_t>({1, 2, 1, 1, 0, 0, 0, 0}), weights);
+  ASSERT_EQ(2, counted_idxs_.at(0));
+  ASSERT_EQ(2, cursors_.at(0));
+
+  // another sstable: (-inf,80] overlaps all, (80,95] is beyond the base sstable
+  inc_endkeys_.reuse();
+  cursors_.reuse();
+  counted_idxs_.reuse();
+  end_idxs_.reuse();
+  prepare_inc_endkeys({{15, 35}, {80, 95}});
+  count_base_macros(base_endkeys, weights);
+  ASSERT_EQ(std::vector<int64_t>({2, 3, 2, 2, 1, 1, 1, 1}), weights);
+  // the macro blocks not counted are beyond the last base macro block
+  ASSERT_EQ(0, end_idxs_.at(0) - counted_idxs_.at(0));
+  ASSERT_EQ(1, end_idxs_.at(1) - counted_idxs_.at(1));
+}
+
+// an incremental macro block ending after the base macro block overlaps the next
+TEST_F(TestParallelMergeCtx, inc_macro_across_base_macros)
+{
+  std::vector<int64_t> weights;
+  prepare_inc_endkeys({{5, 100}});
+  count_base_macros({10, 20, 30}, weights);
+  ASSERT_EQ(std::vector<int64_t>({2, 1, 1}), weights);
+  ASSERT_EQ(1, cursors_.at(0));
+  ASSERT_EQ(2, counted_idxs_.at(0));
+}
+
+TEST_F(TestParallelMergeCtx, weighted_range_last_idxs)
+{
+  // all clean, split uniformly
+  check_ranges(std::vector<int64_t>(16, 0), 4, {3, 7, 11, 15});
+  // a dirty macro block weighs (1 + 1) * 16, total weight 78, 20 per range
+  std::vector<int64_t> weights(16, 0);
+  weights[2] = 1;
+  weights[12] = 1;
+  check_ranges(weights, 4, {2, 12, 15});
+  // the heavy ranges may be less than concurrent cnt
+  weights.assign(16, 0);
+  weights[10] = 3;
+  check_ranges(weights, 4, {10, 15});
+  // one range
+  check_ranges(weights, 1, {15});
+
+  ObSEArray<int64_t, 16> macro_weights;
+  ObSEArray<int64_t, 16> range_last_idxs;
+  merge_ctx_.concurrent_cnt_ = 4;
+  ASSERT_EQ(OB_INVALID_ARGUMENT, merge_ctx_.get_weighted_range_last_idxs(macro_weights, range_last_idxs));
+  ASSERT_EQ(OB_SUCCESS, macro_weights.push_back(2));
+  ASSERT_EQ(OB_SUCCESS, macro_weights.push_back(0));
+  ASSERT_EQ(OB_SUCCESS, merge_ctx_.get_weighted_range_last_idxs(macro_weights, range_last_idxs));
+  ASSERT_EQ(3 * ObParallelMergeCtx::REWRITE_MACRO_BLOCK_WEIGHT, macro_weights.at(0));
+  ASSERT_EQ(1, macro_weights.at(1));
+  merge_ctx_.concurrent_cnt_ = 0;
+  ASSERT_EQ(OB_INVALID_ARGUMENT, merge_ctx_.get_weighted_range_last_idxs(macro_weights, range_last_idxs));
+}
+
+// the dirty aware ranges are split by the ls leader and recorded in medium info as schema rowkeys,
+// the replicas rebuild the ranges from medium info whatever their incremental sstables are
+TEST_F(TestParallelMergeCtx, dirty_aware_ranges_in_medium_info)
+{
+  const std::vector<int64_t> leader_endkeys = {20, 50, 60};
+  for (const int64_t val : leader_endkeys) {
+    ObStorageDatum *datums = static_cast<ObStorageDatum *>(allocator_.alloc(sizeof(ObStorageDatum) * 2));
+    ASSERT_TRUE(nullptr != datums);
+    datums[0].reuse();
+    datums[0].set_int(val);
+    datums[1].reuse();
+    datums[1].set_max();
+    ObDatumRange range;
+    ObDatumRowkey end_key;
+    ASSERT_EQ(OB_SUCCESS, end_key.assign(datums, 2));
+    range.set_end_key(end_key);
+    ASSERT_EQ(OB_SUCCESS, merge_ctx_.range_array_.push_back(range));
+  }
+  ObDatumRange last_range;
+  last_range.end_key_.set_max_rowkey();
+  ASSERT_EQ(OB_SUCCESS, merge_ctx_.range_array_.push_back(last_range));
+
+  ObSEArray<ObStoreRange, 16> store_ranges;
+  ASSERT_EQ(OB_SUCCESS, merge_ctx_.get_schema_rowkey_store_ranges(cols_desc_, allocator_, store_ranges));
+  ASSERT_EQ(4, store_ranges.count());
+  ASSERT_TRUE(store_ranges.at(0).get_start_key().is_min());
+  ASSERT_TRUE(store_ranges.at(3).get_end_key().is_max());
+  for (int64_t i = 1; i < store_ranges.count(); ++i) {
+    ASSERT_TRUE(store_ranges.at(i).get_start_key() == store_ranges.at(i - 1).get_end_key());
+  }
+
+  // what ObMediumCompactionInfo::gene_parallel_info records and the replicas read back
+  ObArrayArray<ObStoreRange> range_array;
+  ASSERT_EQ(OB_SUCCESS, range_array.push_back(store_ranges));
+  ObParallelMergeInfo paral_info;
+  paral_info.allocator_ = &allocator_;
+  paral_info.list_size_ = store_ranges.count() - 1;
+  ASSERT_EQ(OB_SUCCESS, paral_info.generate_datum_rowkey_list(allocator_, range_array));
+  ASSERT_EQ(static_cast<int64_t>(leader_endkeys.size()), paral_info.get_size());
+  for (int64_t i = 0; i < paral_info.get_size(); ++i) {
+    ObDatumRowkey key;
+    ASSERT_EQ(OB_SUCCESS, paral_info.deep_copy_datum_rowkey(i, allocator_, key));
+    ASSERT_EQ(1, key.get_datum_cnt());
+    ASSERT_EQ(leader_endkeys[i], key.get_datum(0).get_int());
+  }
+
+  // the leader ranges without any split point
+  ObDatumRange whole_range;
+  whole_range.end_key_.set_max_rowkey();
+  merge_ctx_.range_array_.reuse();
+  ASSERT_EQ(OB_SUCCESS, merge_ctx_.range_array_.push_back(whole_range));
+  ASSERT_EQ(OB_SUCCESS, merge_ctx_.get_schema_rowkey_store_ranges(cols_desc_, allocator_, store_ranges));
+  ASSERT_EQ(1, store_ranges.count());
+  ASSERT_TRUE(store_ranges.at(0).get_end_key().is_max());
+}
+
+}//end namespace unittest
+}//end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_parallel_merge_ctx.log*");
+  OB_LOGGER.set_file_name("test_parallel_merge_ctx.log");
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
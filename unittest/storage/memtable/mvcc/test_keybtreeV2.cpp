@@ -14,6 +14,7 @@
 #include "lib/allocator/ob_malloc.h"
 #include "lib/oblog/ob_log.h"
 #include "lib/random/ob_random.h"
+#include "lib/time/ob_time_utility.h"
 #include "common/object/ob_object.h"
 #include <gtest/gtest.h>
 #include <thread>
@@ -632,6 +633,155 @@ TEST(TestMemoryNotEnough, smoke_test)
   }
 }
 
+TEST(TestBatchInsert, smoke_test)
+{
+  constexpr int64_t KEY_NUM = 3200000;
+  constexpr int64_t THREAD_COUNT = 32;
+  constexpr int64_t BATCH_SIZE = 64;
+
+  FakeAllocator *allocator = FakeAllocator::get_instance();
+  BtreeNodeAllocator<FakeKey, int64_t *> node_allocator(*allocator);
+  ObKeyBtree btree(node_allocator);
+  std::thread threads[THREAD_COUNT];
+  std::atomic<int64_t> next(0);
+
+  ASSERT_EQ(btree.init(), OB_SUCCESS);
+
+  // batches of random keys are sorted and inserted concurrently, so that the
+  // leaves reused by one batch are split by others
+  std::vector<int64_t> data(KEY_NUM);
+  std::vector<FakeKey> keys(KEY_NUM);
+  for (int64_t i = 0; i < KEY_NUM; i++) {
+    data[i] = i;
+  }
+  std::random_shuffle(data.begin(), data.end());
+  for (int64_t i = 0; i < KEY_NUM; i += BATCH_SIZE) {
+    std::sort(data.begin() + i, data.begin() + std::min(i + BATCH_SIZE, KEY_NUM));
+  }
+  for (int64_t i = 0; i < KEY_NUM; i++) {
+    keys[i] = build_int_key(data[i]);
+  }
+
+  for (int thread_id = 0; thread_id < THREAD_COUNT; thread_id++) {
+    threads[thread_id] = std::thread([&]() {
+      int64_t start = 0;
+      while ((start = next.fetch_add(BATCH_SIZE)) < KEY_NUM) {
+        ObKeyBtree::WriteHandle handle(btree);
+        ASSERT_EQ(OB_SUCCESS, btree.begin_batch_insert(handle));
+        for (int64_t i = start; i < std::min(start + BATCH_SIZE, KEY_NUM); i++) {
+          int64_t *val = &(data[i]);
+          ASSERT_EQ(OB_SUCCESS, btree.insert(keys[i], val, handle));
+        }
+        btree.end_batch_insert(handle);
+      }
+    });
+  }
+  for (int thread_id = 0; thread_id < THREAD_COUNT; thread_id++) {
+    threads[thread_id].join();
+  }
+
+  // insert the existed key in batch
+  {
+    ObKeyBtree::WriteHandle handle(btree);
+    int64_t *val = nullptr;
+    ASSERT_EQ(OB_SUCCESS, btree.begin_batch_insert(handle));
+    ASSERT_EQ(OB_ENTRY_EXIST, btree.insert(keys[0], val, handle));
+    ASSERT_EQ(data[0], *val);
+    btree.end_batch_insert(handle);
+  }
+
+  ASSERT_EQ(KEY_NUM, btree.size());
+  FakeKey key;
+  int64_t *val = nullptr;
+  for (int64_t i = 0; i < KEY_NUM; i++) {
+    ASSERT_EQ(OB_SUCCESS, btree.get(keys[i], val));
+    ASSERT_EQ(data[i], *val);
+  }
+  FakeKey start_key = build_int_key(0);
+  FakeKey end_key = build_int_key(KEY_NUM);
+  BtreeIterator iter;
+  btree.set_key_range(iter, start_key, false, end_key, false);
+  int64_t i = 0;
+  while (iter.get_next(key, val) == OB_SUCCESS) {
+    ASSERT_EQ(key.get_ptr()->get_int(), i);
+    i++;
+  }
+  ASSERT_EQ(i, KEY_NUM);
+
+  free_btree(btree);
+  free_key(start_key);
+  free_key(end_key);
+}
+
+// Rows of increasing keys(e.g. auto-increment primary key) are always appended
+// to the rightmost leaf. Compare inserting them one by one with inserting them
+// in sorted batches, which only descends the tree once per leaf.
+void test_hot_tail_insert(const int64_t thread_count, const bool is_batch)
+{
+  constexpr int64_t KEY_NUM = 4000000;
+  constexpr int64_t BATCH_SIZE = 256;
+
+  FakeAllocator *allocator = FakeAllocator::get_instance();
+  BtreeNodeAllocator<FakeKey, int64_t *> node_allocator(*allocator);
+  ObKeyBtree btree(node_allocator);
+  std::vector<std::thread> threads;
+  std::atomic<int64_t> next(0);
+  std::vector<int64_t> data(KEY_NUM);
+  std::vector<FakeKey> keys(KEY_NUM);
+
+  ASSERT_EQ(btree.init(), OB_SUCCESS);
+  for (int64_t i = 0; i < KEY_NUM; i++) {
+    data[i] = i;
+    keys[i] = build_int_key(i);
+  }
+
+  const int64_t start_ts = ObTimeUtility::current_time();
+  for (int64_t thread_id = 0; thread_id < thread_count; thread_id++) {
+    threads.emplace_back([&]() {
+      int64_t start = 0;
+      while ((start = next.fetch_add(BATCH_SIZE)) < KEY_NUM) {
+        const int64_t end = std::min(start + BATCH_SIZE, KEY_NUM);
+        if (is_batch) {
+          ObKeyBtree::WriteHandle handle(btree);
+          ASSERT_EQ(OB_SUCCESS, btree.begin_batch_insert(handle));
+          for (int64_t i = start; i < end; i++) {
+            int64_t *val = &(data[i]);
+            ASSERT_EQ(OB_SUCCESS, btree.insert(keys[i], val, handle));
+          }
+          btree.end_batch_insert(handle);
+        } else {
+          for (int64_t i = start; i < end; i++) {
+            int64_t *val = &(data[i]);
+            ASSERT_EQ(OB_SUCCESS, btree.insert(keys[i], val));
+          }
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  const int64_t cost_us = std::max(ObTimeUtility::current_time() - start_ts, 1L);
+  std::cout << (is_batch ? "batch insert " : "single insert")
+            << " threads=" << thread_count
+            << " rows=" << KEY_NUM
+            << " cost_us=" << cost_us
+            << " Mops/s=" << static_cast<double>(KEY_NUM) / static_cast<double>(cost_us)
+            << std::endl;
+  ASSERT_EQ(KEY_NUM, btree.size());
+
+  free_btree(btree);
+}
+
+TEST(TestHotTailInsert, DISABLED_perf_test)
+{
+  const int64_t thread_counts[] = {1, 4, 16, 64};
+  for (int64_t i = 0; i < ARRAYSIZEOF(thread_counts); i++) {
+    test_hot_tail_insert(thread_counts[i], false /*is_batch*/);
+    test_hot_tail_insert(thread_counts[i], true /*is_batch*/);
+  }
+}
+
 }  // namespace unittest
 }  // namespace oceanbase
 
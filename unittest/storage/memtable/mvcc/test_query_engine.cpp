@@ -10,6 +10,11 @@
  * See the Mulan PubL v2 for more details.
  */
 
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#define private public
 #include "storage/memtable/mvcc/ob_query_engine.h"
 
 #include "storage/memtable/ob_memtable_key.h"
@@ -18,9 +23,6 @@
 #include "../utils_rowkey_builder.h"
 #include "../utils_mod_allocator.h"
 
-#include <gtest/gtest.h>
-#include <thread>
-
 namespace oceanbase
 {
 namespace unittest
@@ -158,6 +160,111 @@ TEST(TestObQueryEngine, smoke_test)
   test_scan(5, false,  5, false);
 }
 
+// enough keys to split segments of the tag hash, so blocks are retired
+static const int64_t TAG_HASH_KEY_COUNT = 20000;
+
+void prepare_keys(ObModAllocator &allocator, std::vector<ObMemtableKey *> &mtk)
+{
+  mtk.resize(TAG_HASH_KEY_COUNT);
+  for (int64_t i = 0; i < TAG_HASH_KEY_COUNT; i++) {
+    INIT_MTK(allocator, mtk[i], V("tag_hash", 8), I(i));
+  }
+}
+
+TEST(TestObQueryEngine, tag_hash_set_and_get)
+{
+  ObModAllocator allocator;
+  ObQueryEngine qe(allocator);
+  std::vector<ObMemtableKey *> mtk;
+  std::vector<ObMvccRow> mtv(TAG_HASH_KEY_COUNT);
+  ObMvccRow *row = nullptr;
+  ObMemtableKey returned_key;
+  prepare_keys(allocator, mtk);
+
+  ASSERT_EQ(OB_SUCCESS, qe.init(true /*use_tag_hash*/));
+  ASSERT_TRUE(qe.use_tag_hash_);
+  // an empty memtable allocates nothing
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, qe.get(mtk[0], row, &returned_key));
+  ASSERT_EQ(0, qe.hash_size());
+
+  for (int64_t i = 0; i < TAG_HASH_KEY_COUNT; i++) {
+    ASSERT_EQ(OB_SUCCESS, qe.set(mtk[i], &mtv[i]));
+  }
+  for (int64_t i = 0; i < TAG_HASH_KEY_COUNT; i += 7) {
+    ASSERT_EQ(OB_ENTRY_EXIST, qe.set(mtk[i], &mtv[(i + 1) % TAG_HASH_KEY_COUNT]));
+  }
+  for (int64_t i = 0; i < TAG_HASH_KEY_COUNT; i++) {
+    ASSERT_EQ(OB_SUCCESS, qe.get(mtk[i], row, &returned_key));
+    ASSERT_EQ(&mtv[i], row);
+    ASSERT_EQ(0, mtk[i]->compare(returned_key));
+  }
+  ObMemtableKey *not_exist_key = nullptr;
+  INIT_MTK(allocator, not_exist_key, V("tag_hash", 8), I(TAG_HASH_KEY_COUNT));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, qe.get(not_exist_key, row, &returned_key));
+  ASSERT_GE(qe.hash_size(), TAG_HASH_KEY_COUNT);
+  ASSERT_GT(qe.hash_alloc_memory(), 0);
+  // the mt hash is not touched
+  ASSERT_EQ(0, qe.keyhash_.get_arr_size());
+
+  qe.destroy();
+  ASSERT_EQ(OB_SUCCESS, qe.init(true /*use_tag_hash*/));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, qe.get(mtk[0], row, &returned_key));
+}
+
+TEST(TestObQueryEngine, tag_hash_destroy)
+{
+  ObModAllocator allocator;
+  std::vector<ObMemtableKey *> mtk;
+  std::vector<ObMvccRow> mtv(TAG_HASH_KEY_COUNT);
+  prepare_keys(allocator, mtk);
+
+  // tag hash off, nothing of it to release
+  {
+    ObQueryEngine qe(allocator);
+    ASSERT_EQ(OB_SUCCESS, qe.init(false /*use_tag_hash*/));
+    for (int64_t i = 0; i < TAG_HASH_KEY_COUNT; i++) {
+      ASSERT_EQ(OB_SUCCESS, qe.set(mtk[i], &mtv[i]));
+    }
+    ASSERT_TRUE(nullptr == qe.tag_keyhash_.dir_);
+    ASSERT_EQ(0, qe.tag_keyhash_.retire_cnt_);
+    qe.destroy();
+  }
+  // destroy purges the retired blocks of the hash itself
+  {
+    ObQueryEngine qe(allocator);
+    ASSERT_EQ(OB_SUCCESS, qe.init(true /*use_tag_hash*/));
+    for (int64_t i = 0; i < TAG_HASH_KEY_COUNT; i++) {
+      ASSERT_EQ(OB_SUCCESS, qe.set(mtk[i], &mtv[i]));
+    }
+    ASSERT_TRUE(nullptr != qe.tag_keyhash_.dir_);
+    ASSERT_GT(qe.tag_keyhash_.retire_cnt_, 0);
+    qe.destroy();
+    ASSERT_TRUE(nullptr == qe.tag_keyhash_.dir_);
+    ASSERT_EQ(0, qe.tag_keyhash_.retire_cnt_);
+    ASSERT_EQ(0, qe.hash_size());
+  }
+  // batch destroy leaves the purge to the batch of memtables
+  {
+    ObQueryEngine qe1(allocator);
+    ObQueryEngine qe2(allocator);
+    ASSERT_EQ(OB_SUCCESS, qe1.init(true /*use_tag_hash*/));
+    ASSERT_EQ(OB_SUCCESS, qe2.init(true /*use_tag_hash*/));
+    for (int64_t i = 0; i < TAG_HASH_KEY_COUNT; i++) {
+      ASSERT_EQ(OB_SUCCESS, qe1.set(mtk[i], &mtv[i]));
+      ASSERT_EQ(OB_SUCCESS, qe2.set(mtk[i], &mtv[i]));
+    }
+    qe1.pre_batch_destroy_keybtree();
+    qe2.pre_batch_destroy_keybtree();
+    ASSERT_TRUE(nullptr == qe1.tag_keyhash_.dir_);
+    ASSERT_EQ(0, qe1.tag_keyhash_.retire_cnt_);
+    ASSERT_EQ(0, qe2.tag_keyhash_.retire_cnt_);
+    ObMemtableKeyBtree::batch_destroy();
+    ObMtTagHash::batch_destroy();
+    qe1.destroy();
+    qe2.destroy();
+  }
+}
+
 }
 }
 
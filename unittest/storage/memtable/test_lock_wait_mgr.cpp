@@ -0,0 +1,283 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#define private public
+#define protected public
+#include "storage/memtable/ob_lock_wait_mgr.h"
+#undef private
+#undef protected
+#include "lib/oblog/ob_log.h"
+#include "lib/time/ob_time_utility.h"
+#include "lib/alloc/ob_malloc_allocator.h"
+#include "share/rc/ob_tenant_base.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace memtable;
+using namespace transaction;
+using namespace share;
+namespace unittest
+{
+
+// Throughput and latency of updating one hot row through ObLockWaitMgr, with
+// and without _enable_lock_wait_hand_off. Every update locks the row, ends the
+// request, and releases the row when its commit finishes 'commit_us' later,
+// like an autocommit update whose row is unlocked after the redo is synced.
+// The benchmark with up to 512 updaters is disabled by default.
+//
+// ./test_lock_wait_mgr --gtest_also_run_disabled_tests [duration_s] [commit_us]
+int64_t duration_s = 1;
+int64_t commit_us = 100;
+
+static const uint64_t TENANT_ID = 1001;
+// the wait timeout of a waiter, it's reposted by the timeout check after it
+static const int64_t WAIT_TIMEOUT_US = 10 * 1000 * 1000;
+
+// A session blocked in the lock wait mgr, it's notified when its request is
+// reposted instead of being pushed to the worker queue.
+struct MockSession
+{
+  MockSession() : reposted_(false) {}
+  void notify()
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    reposted_ = true;
+    cond_.notify_one();
+  }
+  void wait()
+  {
+    std::unique_lock<std::mutex> guard(mutex_);
+    cond_.wait(guard, [this]() { return reposted_; });
+    reposted_ = false;
+  }
+  ObLockWaitMgr::Node node_;
+  bool reposted_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+};
+
+class MockLockWaitMgr : public ObLockWaitMgr
+{
+public:
+  virtual int repost(Node *node) override
+  {
+    static_cast<MockSession *>(node->addr_)->notify();
+    return OB_SUCCESS;
+  }
+};
+
+class TestLockWaitMgr : public ::testing::Test
+{
+public:
+  struct Result
+  {
+    int64_t update_cnt_;
+    int64_t retry_cnt_;
+    int64_t min_updater_cnt_; // the least updates done by one updater
+    int64_t p50_us_;
+    int64_t p99_us_;
+    int64_t max_us_;
+  };
+  TestLockWaitMgr() : tenant_base_(TENANT_ID) {}
+  virtual void SetUp() override
+  {
+    ObMallocAllocator::get_instance()->create_and_add_tenant_allocator(TENANT_ID);
+    ObTenantEnv::set_tenant(&tenant_base_);
+    ASSERT_EQ(OB_SUCCESS, tenant_base_.init());
+    // the waiters are not registered to the deadlock detector
+    GCONF._lcl_op_interval.set_value("0ms");
+  }
+  virtual void TearDown() override
+  {
+    tenant_base_.destroy();
+    ObTenantEnv::set_tenant(nullptr);
+  }
+  void run(const int64_t updater_cnt, const bool hand_off, const int64_t run_us, Result &result)
+  {
+    MockLockWaitMgr mgr;
+    ASSERT_EQ(OB_SUCCESS, mgr.init());
+    ASSERT_EQ(OB_SUCCESS, mgr.start());
+    mgr.enable_hand_off_ = hand_off;
+    ObObj obj;
+    obj.set_int(1);
+    ObStoreRowkey rowkey(&obj, 1);
+    ObMemtableKey key(&rowkey);
+    (void)key.hash();
+    const ObTabletID tablet_id(200001);
+    const ObLSID ls_id(1001);
+    const uint64_t row_hash = LockHashHelper::hash_rowkey(tablet_id, key);
+    int64_t holder = 0;
+    int64_t next_tx_id = 0;
+    std::vector<MockSession> sessions(updater_cnt);
+    std::vector<std::vector<int64_t>> latencies(updater_cnt);
+    std::vector<int64_t> retry_cnts(updater_cnt, 0);
+    std::vector<std::thread> threads;
+    const int64_t end_ts = ObTimeUtility::current_time() + run_us;
+    for (int64_t i = 0; i < updater_cnt; i++) {
+      threads.emplace_back([&, i]() {
+        ObTenantEnv::set_tenant(&tenant_base_);
+        MockSession &session = sessions[i];
+        int64_t now = 0;
+        while ((now = ObTimeUtility::current_time()) < end_ts) {
+          const int64_t recv_ts = now;
+          const int64_t tx_id = ATOMIC_AAF(&next_tx_id, 1);
+          bool locked = false;
+          while (!locked) {
+            bool need_wait = false;
+            mgr.setup(session.node_, recv_ts);
+            if (ATOMIC_BCAS(&holder, 0, tx_id)) {
+              locked = true;
+              mgr.set_hash_holder(tablet_id, key, ObTransID(tx_id));
+              mgr.post_process(false, need_wait);
+              ObLockWaitMgr::clear_thread_node();
+              ob_usleep(commit_us);
+              ATOMIC_STORE(&holder, 0);
+              mgr.wakeup(tablet_id, key);
+            } else {
+              // the same as post_lock
+              const int64_t lock_seq = mgr.get_seq(row_hash);
+              const int64_t holder_tx_id = ATOMIC_LOAD(&holder);
+              if (0 != holder_tx_id) {
+                if (ObLockWaitMgr::get_thread_hold_key() == row_hash) {
+                  ObLockWaitMgr::get_thread_hold_key() = 0;
+                }
+                session.node_.set(&session, row_hash, lock_seq, now + WAIT_TIMEOUT_US,
+                                  tablet_id.id(), 0, 0, "hot row", 0, 0, tx_id, holder_tx_id, ls_id);
+                session.node_.set_need_wait();
+              }
+              retry_cnts[i]++;
+              const bool wait_succ = mgr.post_process(true, need_wait);
+              ObLockWaitMgr::clear_thread_node();
+              if (wait_succ) {
+                session.wait();
+              }
+            }
+          }
+          latencies[i].push_back(ObTimeUtility::current_time() - recv_ts);
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    mgr.stop();
+    mgr.wait();
+    mgr.destroy();
+    std::vector<int64_t> all;
+    result.retry_cnt_ = 0;
+    result.min_updater_cnt_ = INT64_MAX;
+    for (int64_t i = 0; i < updater_cnt; i++) {
+      all.insert(all.end(), latencies[i].begin(), latencies[i].end());
+      result.retry_cnt_ += retry_cnts[i];
+      result.min_updater_cnt_ = std::min(result.min_updater_cnt_, (int64_t)latencies[i].size());
+    }
+    std::sort(all.begin(), all.end());
+    ASSERT_FALSE(all.empty());
+    result.update_cnt_ = all.size();
+    result.p50_us_ = all[all.size() / 2];
+    result.p99_us_ = all[all.size() * 99 / 100];
+    result.max_us_ = all.back();
+  }
+public:
+  ObTenantBase tenant_base_;
+};
+
+TEST_F(TestLockWaitMgr, set_hash_holder_hand_off)
+{
+  MockLockWaitMgr mgr;
+  ASSERT_EQ(OB_SUCCESS, mgr.init());
+  ObObj obj;
+  obj.set_int(1);
+  ObStoreRowkey rowkey(&obj, 1);
+  ObMemtableKey key(&rowkey);
+  (void)key.hash();
+  const ObTabletID tablet_id(200001);
+  const uint64_t row_hash = LockHashHelper::hash_rowkey(tablet_id, key);
+  ObTransID holder;
+  // not woken up for any row
+  mgr.enable_hand_off_ = true;
+  ObLockWaitMgr::get_thread_hold_key() = 0;
+  mgr.set_hash_holder(tablet_id, key, ObTransID(1));
+  ASSERT_EQ(0U, ObLockWaitMgr::get_thread_hold_key());
+  ASSERT_EQ(OB_SUCCESS, mgr.get_hash_holder(row_hash, holder));
+  ASSERT_EQ(ObTransID(1), holder);
+  // woken up for another row, it still wakes up the next waiter of that row
+  ObLockWaitMgr::get_thread_hold_key() = row_hash + 1;
+  mgr.set_hash_holder(tablet_id, key, ObTransID(2));
+  ASSERT_EQ(row_hash + 1, ObLockWaitMgr::get_thread_hold_key());
+  // hand off disabled, the chained wakeup is kept
+  mgr.enable_hand_off_ = false;
+  ObLockWaitMgr::get_thread_hold_key() = row_hash;
+  mgr.set_hash_holder(tablet_id, key, ObTransID(3));
+  ASSERT_EQ(row_hash, ObLockWaitMgr::get_thread_hold_key());
+  // the woken request locks the row it waited for, it takes over the row
+  mgr.enable_hand_off_ = true;
+  mgr.set_hash_holder(tablet_id, key, ObTransID(4));
+  ASSERT_EQ(0U, ObLockWaitMgr::get_thread_hold_key());
+  ASSERT_EQ(OB_SUCCESS, mgr.get_hash_holder(row_hash, holder));
+  ASSERT_EQ(ObTransID(4), holder);
+  ObLockWaitMgr::clear_thread_node();
+  mgr.destroy();
+}
+
+TEST_F(TestLockWaitMgr, hot_row_update_no_lost_waiter)
+{
+  const int64_t UPDATER_CNT = 8;
+  const int64_t RUN_US = 500 * 1000;
+  for (int64_t hand_off = 0; hand_off <= 1; hand_off++) {
+    Result result;
+    run(UPDATER_CNT, hand_off, RUN_US, result);
+    // every updater makes progress, and no waiter is left to the wait timeout
+    ASSERT_GT(result.min_updater_cnt_, 0) << "hand_off=" << hand_off;
+    ASSERT_LT(result.max_us_, WAIT_TIMEOUT_US / 2) << "hand_off=" << hand_off;
+  }
+}
+
+TEST_F(TestLockWaitMgr, DISABLED_hot_row_update)
+{
+  const int64_t updater_cnts[] = {1, 8, 64, 512};
+  for (int64_t i = 0; i < ARRAYSIZEOF(updater_cnts); i++) {
+    for (int64_t hand_off = 0; hand_off <= 1; hand_off++) {
+      Result result;
+      run(updater_cnts[i], hand_off, duration_s * 1000 * 1000, result);
+      fprintf(stdout, "updaters=%3ld hand_off=%ld commit=%ldus updates/s=%8ld retries/update=%6.2f "
+              "p50=%8ldus p99=%8ldus\n",
+              updater_cnts[i], hand_off, commit_us, result.update_cnt_ / duration_s,
+              (double)result.retry_cnt_ / (double)result.update_cnt_, result.p50_us_, result.p99_us_);
+    }
+  }
+}
+
+} // namespace unittest
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_file_name("test_lock_wait_mgr.log", true);
+  OB_LOGGER.set_log_level("WARN");
+  // gtest flags are removed from argv here
+  ::testing::InitGoogleTest(&argc, argv);
+  if (argc > 1) {
+    oceanbase::unittest::duration_s = strtol(argv[1], NULL, 10);
+  }
+  if (argc > 2) {
+    oceanbase::unittest::commit_us = strtol(argv[2], NULL, 10);
+  }
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,264 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#define private public
+#include "storage/memtable/ob_mt_tag_hash.h"
+#include "storage/memtable/ob_mt_hash.h"
+#include "lib/allocator/ob_malloc.h"
+#include "lib/oblog/ob_log.h"
+#include "lib/time/ob_time_utility.h"
+#include "common/object/ob_object.h"
+
+namespace oceanbase
+{
+namespace unittest
+{
+using namespace oceanbase::common;
+using namespace oceanbase::memtable;
+
+class ObTestAllocator : public ObIAllocator
+{
+public:
+  void *alloc(const int64_t size) override { return ob_malloc(size, ObModIds::TEST); }
+  void *alloc(const int64_t size, const ObMemAttr &attr) override
+  {
+    UNUSED(attr);
+    return alloc(size);
+  }
+  void free(void *ptr) override { ob_free(ptr); }
+};
+
+// keys are prepared before the test so that only the hash is measured
+class ObTestKeys
+{
+public:
+  explicit ObTestKeys(const int64_t count) : objs_(count), rowkeys_(count), wrappers_(count)
+  {
+    for (int64_t i = 0; i < count; i++) {
+      objs_[i].set_int(i);
+      rowkeys_[i].assign(&objs_[i], 1);
+      wrappers_[i] = ObStoreRowkeyWrapper(&rowkeys_[i]);
+      (void)rowkeys_[i].hash(); // cache the hash value
+    }
+  }
+  const ObStoreRowkeyWrapper *at(const int64_t i) const { return &wrappers_[i]; }
+  static ObMvccRow *value_of(const int64_t i) { return reinterpret_cast<ObMvccRow *>(i + 1); }
+private:
+  std::vector<ObObj> objs_;
+  std::vector<ObStoreRowkey> rowkeys_;
+  std::vector<ObStoreRowkeyWrapper> wrappers_;
+};
+
+TEST(TestMtTagHash, smoke_test)
+{
+  const int64_t COUNT = 100000;
+  ObTestAllocator allocator;
+  ObMtTagHash hash(allocator);
+  ObTestKeys keys(COUNT);
+  ObMvccRow *row = NULL;
+  const ObStoreRowkeyWrapper *inner_key = NULL;
+
+  // empty hash allocates nothing
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, hash.get(keys.at(0), row));
+  ASSERT_EQ(0, hash.get_arr_size());
+
+  for (int64_t i = 0; i < COUNT; i++) {
+    ASSERT_EQ(OB_SUCCESS, hash.insert(keys.at(i), ObTestKeys::value_of(i)));
+  }
+  for (int64_t i = 0; i < COUNT; i++) {
+    ASSERT_EQ(OB_ENTRY_EXIST, hash.insert(keys.at(i), ObTestKeys::value_of(i + 1)));
+  }
+  for (int64_t i = 0; i < COUNT; i++) {
+    ASSERT_EQ(OB_SUCCESS, hash.get(keys.at(i), row, inner_key));
+    ASSERT_EQ(ObTestKeys::value_of(i), row);
+    ASSERT_EQ(keys.at(i)->get_rowkey(), inner_key->get_rowkey());
+  }
+  ObObj obj;
+  ObStoreRowkey rowkey;
+  obj.set_int(COUNT);
+  rowkey.assign(&obj, 1);
+  ObStoreRowkeyWrapper not_exist_key(&rowkey);
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, hash.get(&not_exist_key, row));
+  ASSERT_GE(hash.get_arr_size(), COUNT);
+  ASSERT_GT(hash.get_alloc_memory(), 0);
+  hash.destroy();
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, hash.get(keys.at(0), row));
+}
+
+TEST(TestMtTagHash, concurrent_insert_and_get)
+{
+  const int64_t THREAD_COUNT = 16;
+  const int64_t COUNT_PER_THREAD = 50000;
+  ObTestAllocator allocator;
+  ObMtTagHash hash(allocator);
+  ObTestKeys keys(THREAD_COUNT * COUNT_PER_THREAD);
+  std::vector<std::thread> threads;
+  std::atomic<int64_t> error_count(0);
+
+  // every key is inserted by two threads, reads of other threads' keys run
+  // concurrently with splits of the segments
+  for (int64_t t = 0; t < THREAD_COUNT; t++) {
+    threads.emplace_back([&, t]() {
+      for (int64_t i = 0; i < COUNT_PER_THREAD * 2; i++) {
+        const int64_t idx = ((t / 2) * 2 * COUNT_PER_THREAD + i) % (THREAD_COUNT * COUNT_PER_THREAD);
+        ObMvccRow *row = NULL;
+        int ret = hash.insert(keys.at(idx), ObTestKeys::value_of(idx));
+        if (OB_SUCCESS != ret && OB_ENTRY_EXIST != ret) {
+          error_count++;
+        }
+        if (OB_SUCCESS != hash.get(keys.at(idx), row) || ObTestKeys::value_of(idx) != row) {
+          error_count++;
+        }
+        const int64_t other = (idx + COUNT_PER_THREAD * 3) % (THREAD_COUNT * COUNT_PER_THREAD);
+        if (OB_SUCCESS == (ret = hash.get(keys.at(other), row))) {
+          if (ObTestKeys::value_of(other) != row) {
+            error_count++;
+          }
+        } else if (OB_ENTRY_NOT_EXIST != ret) {
+          error_count++;
+        }
+      }
+    });
+  }
+  for (auto &th : threads) {
+    th.join();
+  }
+  ASSERT_EQ(0, error_count);
+  for (int64_t i = 0; i < THREAD_COUNT * COUNT_PER_THREAD; i++) {
+    ObMvccRow *row = NULL;
+    ASSERT_EQ(OB_SUCCESS, hash.get(keys.at(i), row));
+    ASSERT_EQ(ObTestKeys::value_of(i), row);
+  }
+}
+
+TEST(TestMtTagHash, split_segment_with_overflow)
+{
+  const int64_t SAME_HASH_COUNT = 2 * ObMtTagHash::BUCKET_SLOT_CNT + 2;
+  const int64_t COUNT = 20000;
+  const uint64_t SAME_HASH = 0x5a5a5a5a12345678ULL;
+  ObTestAllocator allocator;
+  ObMtTagHash hash(allocator);
+  ObTestKeys keys(COUNT);
+  ObObj objs[SAME_HASH_COUNT];
+  ObStoreRowkey rowkeys[SAME_HASH_COUNT];
+  ObStoreRowkeyWrapper same_hash_keys[SAME_HASH_COUNT];
+  ObMvccRow *row = NULL;
+
+  // keys of the same hash fill both of their buckets, the last two overflow
+  for (int64_t i = 0; i < SAME_HASH_COUNT; i++) {
+    objs[i].set_int(-1 - i);
+    rowkeys[i].assign(&objs[i], 1);
+    rowkeys[i].hash_ = SAME_HASH;
+    same_hash_keys[i] = ObStoreRowkeyWrapper(&rowkeys[i]);
+    ASSERT_EQ(OB_SUCCESS, hash.insert(&same_hash_keys[i], ObTestKeys::value_of(COUNT + i)));
+  }
+  ASSERT_EQ(1, hash.seg_cnt_);
+  ASSERT_TRUE(NULL != hash.dir_->segs_[0]->overflow_);
+
+  // split the segment of them by the other buckets
+  for (int64_t i = 0; i < COUNT; i++) {
+    ASSERT_EQ(OB_SUCCESS, hash.insert(keys.at(i), ObTestKeys::value_of(i)));
+  }
+  const ObMtTagHash::Directory *dir = hash.dir_;
+  const ObMtTagHash::Segment *seg = dir->segs_[ObMtTagHash::get_dir_idx(SAME_HASH, dir->global_depth_)];
+  ASSERT_GT(seg->local_depth_, 0);
+  ASSERT_TRUE(NULL != seg->overflow_);
+
+  for (int64_t i = 0; i < SAME_HASH_COUNT; i++) {
+    ASSERT_EQ(OB_SUCCESS, hash.get(&same_hash_keys[i], row)) << "i: " << i;
+    ASSERT_EQ(ObTestKeys::value_of(COUNT + i), row);
+    ASSERT_EQ(OB_ENTRY_EXIST, hash.insert(&same_hash_keys[i], ObTestKeys::value_of(COUNT + i)));
+  }
+  for (int64_t i = 0; i < COUNT; i++) {
+    ASSERT_EQ(OB_SUCCESS, hash.get(keys.at(i), row));
+    ASSERT_EQ(ObTestKeys::value_of(i), row);
+  }
+}
+
+// Multi-threaded insert then get benchmark, comparing with ObMtHash.
+// Each thread works on its own keys, total throughput is reported.
+template <typename Hash>
+void run_perf(const char *name, const int64_t thread_count, const ObTestKeys &keys, const int64_t count)
+{
+  ObTestAllocator allocator;
+  Hash hash(allocator);
+  const int64_t count_per_thread = count / thread_count;
+  std::vector<std::thread> threads;
+  std::atomic<int64_t> error_count(0);
+
+  int64_t start_ts = ObTimeUtility::current_time();
+  for (int64_t t = 0; t < thread_count; t++) {
+    threads.emplace_back([&, t]() {
+      for (int64_t i = t * count_per_thread; i < (t + 1) * count_per_thread; i++) {
+        if (OB_SUCCESS != hash.insert(keys.at(i), ObTestKeys::value_of(i))) {
+          error_count++;
+        }
+      }
+    });
+  }
+  for (auto &th : threads) {
+    th.join();
+  }
+  const int64_t insert_us = ObTimeUtility::current_time() - start_ts;
+  threads.clear();
+
+  start_ts = ObTimeUtility::current_time();
+  for (int64_t t = 0; t < thread_count; t++) {
+    threads.emplace_back([&, t]() {
+      ObMvccRow *row = NULL;
+      // read keys inserted by other threads
+      const int64_t base = ((t + 1) % thread_count) * count_per_thread;
+      for (int64_t i = base; i < base + count_per_thread; i++) {
+        if (OB_SUCCESS != hash.get(keys.at(i), row)) {
+          error_count++;
+        }
+      }
+    });
+  }
+  for (auto &th : threads) {
+    th.join();
+  }
+  const int64_t get_us = ObTimeUtility::current_time() - start_ts;
+  const int64_t total = count_per_thread * thread_count;
+  ASSERT_EQ(0, error_count);
+  fprintf(stdout, "%-12s threads=%2ld rows=%ld insert: %8.3f Mops/s, get: %8.3f Mops/s, memory=%ld\n",
+          name, thread_count, total,
+          static_cast<double>(total) / static_cast<double>(MAX(insert_us, 1)),
+          static_cast<double>(total) / static_cast<double>(MAX(get_us, 1)),
+          hash.get_alloc_memory());
+}
+
+TEST(TestMtTagHash, DISABLED_perf_test)
+{
+  const int64_t COUNT = 4L * 1000L * 1000L;
+  const int64_t thread_counts[] = {1, 2, 4, 8, 16, 32, 64};
+  ObTestKeys keys(COUNT);
+  for (int64_t i = 0; i < ARRAYSIZEOF(thread_counts); i++) {
+    run_perf<ObMtHash>("ObMtHash", thread_counts[i], keys, COUNT);
+    run_perf<ObMtTagHash>("ObMtTagHash", thread_counts[i], keys, COUNT);
+  }
+}
+
+} // namespace unittest
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_file_name("test_mt_tag_hash.log", true);
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,372 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <algorithm>
+
+#define USING_LOG_PREFIX STORAGE
+
+#define protected public
+#define private public
+
+#include "lib/oblog/ob_log.h"
+#include "lib/time/ob_time_utility.h"
+#include "lib/random/ob_random.h"
+#include "lib/thread/thread_pool.h"
+#include "common/storage/ob_io_device.h"
+#include "share/ob_local_device.h"
+#include "share/ob_io_uring.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace share;
+namespace unittest
+{
+
+static const char *TEST_FILE_PATH = "./test_io_uring_device_file";
+static const int64_t TEST_FILE_SIZE = 256L * 1024L * 1024L; // 256MB
+static const int64_t TEST_IO_SIZE = 16L * 1024L; // 16KB, about one micro block
+static const int64_t TEST_ALIGN_SIZE = 4096L;
+static const uint32_t TEST_MAX_EVENTS = 512;
+
+struct TestIORecord
+{
+  TestIORecord() : submit_ts_(0), buf_(nullptr), is_busy_(false) {}
+  int64_t submit_ts_;
+  char *buf_;
+  bool is_busy_;
+};
+
+// N submitters share one io context like the io sender threads of an ObAsyncIOChannel,
+// a single reaper thread plays the role of the IO_GETEVENT thread.
+class IODeviceBench : public lib::ThreadPool
+{
+public:
+  IODeviceBench(ObLocalDevice &device, ObIOFd &fd, const int64_t submit_thread_cnt,
+                const int64_t io_cnt_per_thread, const int64_t depth_per_thread)
+    : device_(device), fd_(fd), io_context_(nullptr), io_events_(nullptr),
+      submit_thread_cnt_(submit_thread_cnt), io_cnt_per_thread_(io_cnt_per_thread),
+      depth_per_thread_(depth_per_thread), complete_cnt_(0), fail_cnt_(0), latencies_(nullptr)
+  {}
+  int prepare()
+  {
+    int ret = OB_SUCCESS;
+    const int64_t total_io_cnt = submit_thread_cnt_ * io_cnt_per_thread_;
+    if (OB_FAIL(device_.io_setup(TEST_MAX_EVENTS, io_context_))) {
+      LOG_WARN("io setup failed", K(ret));
+    } else if (OB_ISNULL(io_events_ = device_.alloc_io_events(TEST_MAX_EVENTS))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+    } else if (OB_ISNULL(latencies_ = static_cast<int64_t *>(ob_malloc(total_io_cnt * sizeof(int64_t), "IOBench")))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+    } else {
+      set_thread_count(static_cast<int>(submit_thread_cnt_ + 1));
+    }
+    return ret;
+  }
+  void cleanup()
+  {
+    if (nullptr != io_events_) {
+      device_.free_io_events(io_events_);
+      io_events_ = nullptr;
+    }
+    if (nullptr != io_context_) {
+      device_.io_destroy(io_context_);
+      io_context_ = nullptr;
+    }
+    ob_free(latencies_);
+    latencies_ = nullptr;
+  }
+  void run1() override
+  {
+    if (0 == get_thread_idx()) {
+      reap();
+    } else {
+      submit();
+    }
+  }
+  void submit()
+  {
+    int ret = OB_SUCCESS;
+    const int64_t block_cnt = TEST_FILE_SIZE / TEST_IO_SIZE;
+    TestIORecord *records = new TestIORecord[depth_per_thread_];
+    for (int64_t i = 0; i < depth_per_thread_; ++i) {
+      records[i].buf_ = static_cast<char *>(ob_malloc_align(TEST_ALIGN_SIZE, TEST_IO_SIZE, "IOBench"));
+    }
+    for (int64_t i = 0; i < io_cnt_per_thread_; ++i) {
+      TestIORecord &record = records[i % depth_per_thread_];
+      while (ATOMIC_LOAD(&record.is_busy_)) {
+        PAUSE();
+      }
+      ObIOCB *iocb = device_.alloc_iocb(OB_SYS_TENANT_ID);
+      const int64_t offset = ObRandom::rand(0, block_cnt - 1) * TEST_IO_SIZE;
+      record.submit_ts_ = ObTimeUtility::current_time();
+      ATOMIC_STORE(&record.is_busy_, true);
+      if (OB_FAIL(device_.io_prepare_pread(fd_, record.buf_, TEST_IO_SIZE, offset, iocb, &record))) {
+        LOG_WARN("prepare pread failed", K(ret));
+      }
+      while (OB_SUCC(ret) && OB_EAGAIN == (ret = device_.io_submit(io_context_, iocb))) {
+        ret = OB_SUCCESS;
+        PAUSE();
+      }
+      if (OB_FAIL(ret)) {
+        ATOMIC_INC(&fail_cnt_);
+        latencies_[ATOMIC_FAA(&complete_cnt_, 1)] = 0;
+        ATOMIC_STORE(&record.is_busy_, false);
+        ret = OB_SUCCESS;
+      }
+      // both libaio and io_uring copy the control block on submit
+      device_.free_iocb(iocb);
+    }
+    for (int64_t i = 0; i < depth_per_thread_; ++i) {
+      while (ATOMIC_LOAD(&records[i].is_busy_)) {
+        PAUSE();
+      }
+      ob_free_align(records[i].buf_);
+    }
+    delete [] records;
+  }
+  void reap()
+  {
+    int ret = OB_SUCCESS;
+    const int64_t total_io_cnt = submit_thread_cnt_ * io_cnt_per_thread_;
+    struct timespec timeout = {0, 10L * 1000L * 1000L}; // 10ms
+    while (ATOMIC_LOAD(&complete_cnt_) < total_io_cnt) {
+      if (OB_FAIL(device_.io_getevents(io_context_, 1, io_events_, &timeout))) {
+        LOG_WARN("get events failed", K(ret));
+      } else {
+        const int64_t now = ObTimeUtility::current_time();
+        for (int64_t i = 0; i < io_events_->get_complete_cnt(); ++i) {
+          TestIORecord *record = static_cast<TestIORecord *>(io_events_->get_ith_data(i));
+          if (0 != io_events_->get_ith_ret_code(i) || TEST_IO_SIZE != io_events_->get_ith_ret_bytes(i)) {
+            ATOMIC_INC(&fail_cnt_);
+          }
+          latencies_[ATOMIC_FAA(&complete_cnt_, 1)] = now - record->submit_ts_;
+          ATOMIC_STORE(&record->is_busy_, false);
+        }
+      }
+    }
+  }
+  int64_t get_percentile(const double ratio)
+  {
+    const int64_t total_io_cnt = submit_thread_cnt_ * io_cnt_per_thread_;
+    std::sort(latencies_, latencies_ + total_io_cnt);
+    return latencies_[std::min(total_io_cnt - 1, static_cast<int64_t>(total_io_cnt * ratio))];
+  }
+public:
+  ObLocalDevice &device_;
+  ObIOFd &fd_;
+  ObIOContext *io_context_;
+  ObIOEvents *io_events_;
+  int64_t submit_thread_cnt_;
+  int64_t io_cnt_per_thread_;
+  int64_t depth_per_thread_;
+  int64_t complete_cnt_;
+  int64_t fail_cnt_;
+  int64_t *latencies_;
+};
+
+class TestIOUringDevice : public ::testing::Test
+{
+public:
+  TestIOUringDevice() : file_fd_(-1) {}
+  virtual ~TestIOUringDevice() = default;
+  virtual void SetUp();
+  virtual void TearDown();
+  void run_bench(const bool enable_io_uring, const int64_t thread_cnt, const int64_t depth);
+protected:
+  int file_fd_;
+};
+
+void TestIOUringDevice::SetUp()
+{
+  file_fd_ = ::open(TEST_FILE_PATH, O_CREAT | O_RDWR | O_TRUNC, 0644);
+  ASSERT_TRUE(file_fd_ >= 0);
+  ASSERT_EQ(0, ::ftruncate(file_fd_, TEST_FILE_SIZE));
+  char *buf = static_cast<char *>(ob_malloc(TEST_IO_SIZE, "IOBench"));
+  ASSERT_TRUE(nullptr != buf);
+  for (int64_t offset = 0; offset < TEST_FILE_SIZE; offset += TEST_IO_SIZE) {
+    MEMSET(buf, static_cast<int>(offset / TEST_IO_SIZE % 255), TEST_IO_SIZE);
+    ASSERT_EQ(TEST_IO_SIZE, ::pwrite(file_fd_, buf, TEST_IO_SIZE, offset));
+  }
+  ASSERT_EQ(0, ::fsync(file_fd_));
+  ::close(file_fd_);
+  ob_free(buf);
+  file_fd_ = ::open(TEST_FILE_PATH, O_RDONLY | O_DIRECT);
+  ASSERT_TRUE(file_fd_ >= 0);
+}
+
+void TestIOUringDevice::TearDown()
+{
+  if (file_fd_ >= 0) {
+    ::close(file_fd_);
+    file_fd_ = -1;
+  }
+  ::unlink(TEST_FILE_PATH);
+}
+
+void TestIOUringDevice::run_bench(const bool enable_io_uring, const int64_t thread_cnt, const int64_t depth)
+{
+  const int64_t io_cnt_per_thread = 20000L;
+  ObLocalDevice device;
+  ObIODOpts opts;
+  ASSERT_EQ(OB_SUCCESS, device.init(opts));
+  device.enable_io_uring_ = enable_io_uring;
+  ObIOFd fd;
+  fd.first_id_ = ObIOFd::NORMAL_FILE_ID;
+  fd.second_id_ = file_fd_;
+  fd.device_handle_ = &device;
+  IODeviceBench *bench = new IODeviceBench(device, fd, thread_cnt, io_cnt_per_thread, depth);
+  ASSERT_EQ(OB_SUCCESS, bench->prepare());
+  ASSERT_EQ(enable_io_uring, static_cast<ObLocalIOContext *>(bench->io_context_)->is_io_uring());
+  const int64_t begin_ts = ObTimeUtility::current_time();
+  ASSERT_EQ(OB_SUCCESS, bench->start());
+  bench->wait();
+  const int64_t cost_us = MAX(1, ObTimeUtility::current_time() - begin_ts);
+  const int64_t total_io_cnt = thread_cnt * io_cnt_per_thread;
+  ASSERT_EQ(0, bench->fail_cnt_);
+  const int64_t iops = total_io_cnt * 1000000L / cost_us;
+  const int64_t p50_us = bench->get_percentile(0.5);
+  const int64_t p99_us = bench->get_percentile(0.99);
+  fprintf(stdout, "backend=%-8s threads=%-3ld depth=%-3ld iops=%-8ld p50_us=%-6ld p99_us=%ld\n",
+      enable_io_uring ? "io_uring" : "libaio", thread_cnt, depth, iops, p50_us, p99_us);
+  LOG_INFO("io device bench", K(enable_io_uring), K(thread_cnt), K(depth), K(iops), K(p50_us), K(p99_us));
+  bench->cleanup();
+  delete bench;
+  device.destroy();
+}
+
+TEST_F(TestIOUringDevice, test_read_correctness)
+{
+  if (!ObIOUring::is_supported()) {
+    LOG_INFO("io_uring is not supported, skip");
+  } else {
+    ObLocalDevice device;
+    ObIODOpts opts;
+    ASSERT_EQ(OB_SUCCESS, device.init(opts));
+    device.enable_io_uring_ = true;
+    ObIOFd fd;
+    fd.first_id_ = ObIOFd::NORMAL_FILE_ID;
+    fd.second_id_ = file_fd_;
+    fd.device_handle_ = &device;
+    ObIOContext *io_context = nullptr;
+    ObIOEvents *io_events = nullptr;
+    ASSERT_EQ(OB_SUCCESS, device.io_setup(TEST_MAX_EVENTS, io_context));
+    ASSERT_TRUE(static_cast<ObLocalIOContext *>(io_context)->is_io_uring());
+    ASSERT_TRUE(nullptr != (io_events = device.alloc_io_events(TEST_MAX_EVENTS)));
+
+    const int64_t io_cnt = 64;
+    char *bufs[io_cnt];
+    for (int64_t i = 0; i < io_cnt; ++i) {
+      bufs[i] = static_cast<char *>(ob_malloc_align(TEST_ALIGN_SIZE, TEST_IO_SIZE, "IOBench"));
+      ObIOCB *iocb = device.alloc_iocb(OB_SYS_TENANT_ID);
+      ASSERT_TRUE(nullptr != iocb);
+      ASSERT_EQ(OB_SUCCESS, device.io_prepare_pread(fd, bufs[i], TEST_IO_SIZE, i * TEST_IO_SIZE, iocb,
+                                                    reinterpret_cast<void *>(i + 1)));
+      ASSERT_EQ(OB_SUCCESS, device.io_submit(io_context, iocb));
+      device.free_iocb(iocb);
+    }
+    int64_t complete_cnt = 0;
+    struct timespec timeout = {1, 0};
+    while (complete_cnt < io_cnt) {
+      ASSERT_EQ(OB_SUCCESS, device.io_getevents(io_context, 1, io_events, &timeout));
+      for (int64_t i = 0; i < io_events->get_complete_cnt(); ++i) {
+        const int64_t idx = reinterpret_cast<int64_t>(io_events->get_ith_data(i)) - 1;
+        ASSERT_EQ(0, io_events->get_ith_ret_code(i));
+        ASSERT_EQ(TEST_IO_SIZE, io_events->get_ith_ret_bytes(i));
+        ASSERT_EQ(static_cast<char>(idx % 255), bufs[idx][0]);
+        ASSERT_EQ(static_cast<char>(idx % 255), bufs[idx][TEST_IO_SIZE - 1]);
+      }
+      complete_cnt += io_events->get_complete_cnt();
+    }
+    // a wait with nothing in flight returns empty after the timeout
+    timeout.tv_sec = 0;
+    timeout.tv_nsec = 1000L * 1000L;
+    ASSERT_EQ(OB_SUCCESS, device.io_getevents(io_context, 1, io_events, &timeout));
+    ASSERT_EQ(0, io_events->get_complete_cnt());
+
+    for (int64_t i = 0; i < io_cnt; ++i) {
+      ob_free_align(bufs[i]);
+    }
+    device.free_io_events(io_events);
+    ASSERT_EQ(OB_SUCCESS, device.io_destroy(io_context));
+    device.destroy();
+  }
+}
+
+// a failed io_uring_enter leaves the published SQE in the ring, the submit succeeds
+// and the request is flushed by the next get_events instead of being lost or freed
+TEST_F(TestIOUringDevice, test_flush_failure)
+{
+  if (!ObIOUring::is_supported()) {
+    LOG_INFO("io_uring is not supported, skip");
+  } else {
+    ObIOUring ring;
+    ASSERT_EQ(OB_SUCCESS, ring.init(8, &file_fd_, 1));
+    char *buf = static_cast<char *>(ob_malloc_align(TEST_ALIGN_SIZE, TEST_IO_SIZE, "IOBench"));
+    ASSERT_TRUE(nullptr != buf);
+    struct iocb cb;
+    io_prep_pread(&cb, file_fd_, buf, TEST_IO_SIZE, 3 * TEST_IO_SIZE);
+    cb.data = buf;
+
+    // inject the failure of io_uring_enter by an invalid ring fd
+    const int ring_fd = ring.ring_fd_;
+    ring.ring_fd_ = -1;
+    ASSERT_EQ(OB_SUCCESS, ring.submit(cb));
+    ASSERT_EQ(ring.sq_tail_, ring.submitted_cnt_ + 1);
+    ASSERT_FALSE(ring.is_flushing_);
+    ring.ring_fd_ = ring_fd;
+
+    struct io_event events[8];
+    struct timespec timeout = {1, 0};
+    int64_t complete_cnt = 0;
+    ASSERT_EQ(OB_SUCCESS, ring.get_events(1, 8, events, &timeout, complete_cnt));
+    ASSERT_EQ(ring.sq_tail_, ring.submitted_cnt_);
+    ASSERT_EQ(1, complete_cnt);
+    ASSERT_EQ(buf, events[0].data);
+    ASSERT_EQ(TEST_IO_SIZE, static_cast<int64_t>(events[0].res));
+    ASSERT_EQ(static_cast<char>(3 % 255), buf[0]);
+
+    // no completion is left for the request
+    timeout.tv_sec = 0;
+    timeout.tv_nsec = 1000L * 1000L;
+    ASSERT_EQ(OB_SUCCESS, ring.get_events(1, 8, events, &timeout, complete_cnt));
+    ASSERT_EQ(0, complete_cnt);
+    ob_free_align(buf);
+    ring.destroy();
+  }
+}
+
+TEST_F(TestIOUringDevice, DISABLED_test_libaio_vs_io_uring_bench)
+{
+  const int64_t thread_cnts[] = {1, 4, 16};
+  const int64_t depth = 16;
+  for (int64_t i = 0; i < ARRAYSIZEOF(thread_cnts); ++i) {
+    run_bench(false/*enable_io_uring*/, thread_cnts[i], depth);
+    if (ObIOUring::is_supported()) {
+      run_bench(true/*enable_io_uring*/, thread_cnts[i], depth);
+    }
+  }
+}
+
+} // end namespace unittest
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_io_uring_device.log*");
+  OB_LOGGER.set_file_name("test_io_uring_device.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,159 @@
+/**
+ * Copyright (c) 2023 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "storage/blocksstable/ob_multi_version_sstable_test.h"
+#include "storage/blocksstable/ob_storage_cache_suite.h"
+#include "storage/test_tablet_helper.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace share::schema;
+using namespace blocksstable;
+using namespace unittest;
+namespace storage
+{
+
+class TestMergeBloomFilter : public ObMultiVersionSSTableTest
+{
+public:
+  TestMergeBloomFilter() : ObMultiVersionSSTableTest("test_merge_bloom_filter") {}
+  virtual ~TestMergeBloomFilter() {}
+  static void SetUpTestCase();
+  static void TearDownTestCase();
+  // check the rowkeys of rowkey_data against the bloom filters of all macro blocks written
+  void check_rowkeys(const char *rowkey_data, int64_t &contain_cnt, int64_t &total_cnt);
+  ObArray<MacroBlockId> macro_ids_;
+  ObMockIterator rowkey_iter_;
+};
+
+void TestMergeBloomFilter::SetUpTestCase()
+{
+  ObMultiVersionSSTableTest::SetUpTestCase();
+  ObClockGenerator::init();
+
+  ObLSID ls_id(ls_id_);
+  ObTabletID tablet_id(tablet_id_);
+  ObLSHandle ls_handle;
+  ObLSService *ls_svr = MTL(ObLSService*);
+  ASSERT_EQ(OB_SUCCESS, ls_svr->get_ls(ls_id, ls_handle, ObLSGetMod::STORAGE_MOD));
+
+  obrpc::ObBatchCreateTabletArg create_tablet_arg;
+  share::schema::ObTableSchema table_schema;
+  ASSERT_EQ(OB_SUCCESS, gen_create_tablet_arg(tenant_id_, ls_id, tablet_id, create_tablet_arg, 1, &table_schema));
+  ASSERT_EQ(OB_SUCCESS, TestTabletHelper::create_tablet(ls_handle, tablet_id, table_schema, ObMultiVersionSSTableTest::allocator_));
+}
+
+void TestMergeBloomFilter::TearDownTestCase()
+{
+  ObMultiVersionSSTableTest::TearDownTestCase();
+  ObClockGenerator::destroy();
+}
+
+void TestMergeBloomFilter::check_rowkeys(const char *rowkey_data, int64_t &contain_cnt, int64_t &total_cnt)
+{
+  const ObStoreRow *row = nullptr;
+  ObDatumRow datum_row;
+  ObDatumRowkey rowkey;
+  contain_cnt = 0;
+  total_cnt = 0;
+  rowkey_iter_.reset();
+  OK(rowkey_iter_.from(rowkey_data));
+  OK(datum_row.init(allocator_, rowkey_iter_.get_column_cnt()));
+  for (int64_t i = 0; i < rowkey_iter_.count(); i++) {
+    bool is_contain = false;
+    OK(rowkey_iter_.get_row(i, row));
+    ASSERT_TRUE(nullptr != row);
+    OK(datum_row.from_store_row(*row));
+    OK(rowkey.assign(datum_row.storage_datums_, TEST_ROWKEY_COLUMN_CNT));
+    for (int64_t j = 0; !is_contain && j < macro_ids_.count(); j++) {
+      OK(OB_STORE_CACHE.get_bf_cache().may_contain(MTL_ID(), macro_ids_.at(j), rowkey,
+                                                     data_desc_.get_desc().get_datum_utils(), is_contain));
+    }
+    contain_cnt += is_contain;
+    total_cnt++;
+  }
+}
+
+TEST_F(TestMergeBloomFilter, minor_merge)
+{
+  const int64_t snapshot_version = 10;
+  ObScnRange scn_range;
+  scn_range.start_scn_.set_min();
+  scn_range.end_scn_.convert_for_tx(snapshot_version);
+  const char *micro_data[2];
+  micro_data[0] =
+      "bigint   var   bigint bigint  flag    multi_version_row_flag\n"
+      "0        var1    -9    0     EXIST   CLF\n"
+      "1        var1    -9    MIN   EXIST   SCF\n"
+      "1        var1    -9    0     EXIST   C\n"
+      "1        var1    -8    0     EXIST   L\n"
+      "2        var1    -9    0     EXIST   CLF\n";
+  micro_data[1] =
+      "bigint   var   bigint bigint  flag    multi_version_row_flag\n"
+      "3        var1    -8    0     EXIST   CLF\n"
+      "4        var1    -9    MIN   EXIST   SCF\n"
+      "4        var1    -9    0     EXIST   C\n"
+      "4        var1    -8    0     EXIST   L\n"
+      "5        var1    -9    0     EXIST   CLF\n";
+  prepare_table_schema(micro_data, TEST_ROWKEY_COLUMN_CNT, scn_range, snapshot_version);
+  reset_writer(snapshot_version);
+  macro_writer_.need_build_bloom_filter_ = true;
+  prepare_one_macro(micro_data, 1);
+  prepare_one_macro(&micro_data[1], 1);
+  ObTableHandleV2 handle;
+  prepare_data_end(handle);
+  OK(macro_ids_.assign(macro_writer_.get_macro_block_write_ctx().get_macro_block_list()));
+  ASSERT_EQ(2, macro_ids_.count());
+
+  int64_t contain_cnt = 0;
+  int64_t total_cnt = 0;
+  const char *written_rowkeys =
+      "bigint   var   bigint bigint  flag    multi_version_row_flag\n"
+      "0        var1    -9    0     EXIST   CLF\n"
+      "1        var1    -9    0     EXIST   CLF\n"
+      "2        var1    -9    0     EXIST   CLF\n"
+      "3        var1    -9    0     EXIST   CLF\n"
+      "4        var1    -9    0     EXIST   CLF\n"
+      "5        var1    -9    0     EXIST   CLF\n";
+  check_rowkeys(written_rowkeys, contain_cnt, total_cnt);
+  ASSERT_EQ(total_cnt, contain_cnt);
+
+  // duplicate checks of new rowkeys are filtered out before reading the macro blocks
+  const char *new_rowkeys =
+      "bigint   var   bigint bigint  flag    multi_version_row_flag\n"
+      "0        var2    -9    0     EXIST   CLF\n"
+      "6        var1    -9    0     EXIST   CLF\n"
+      "7        var1    -9    0     EXIST   CLF\n"
+      "8        var1    -9    0     EXIST   CLF\n"
+      "9        var1    -9    0     EXIST   CLF\n"
+      "10       var1    -9    0     EXIST   CLF\n"
+      "11       var1    -9    0     EXIST   CLF\n"
+      "12       var1    -9    0     EXIST   CLF\n";
+  check_rowkeys(new_rowkeys, contain_cnt, total_cnt);
+  ASSERT_GT(total_cnt / 2, contain_cnt);
+}
+
+} // namespace storage
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_merge_bloom_filter.log*");
+  OB_LOGGER.set_file_name("test_merge_bloom_filter.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -460,6 +460,97 @@ TEST_F(TestTenantTabletStatMgr, bacth_clear_tablet_stat)
   }
 }
 
+static void add_queries(observer::ObRSTTimeCollector &collector, const int64_t cnt, const uint64_t latency)
+{
+  for (int64_t i = 0; i < cnt; ++i) {
+    collector.collect(latency);
+  }
+}
+
+TEST_F(TestTenantTabletStatMgr, sample_p99_query_latency)
+{
+  ObTenantSysLoadShedder shedder;
+  observer::ObRSTTimeCollector collector;
+  int64_t query_cnt = 0;
+  int64_t p99_latency = 0;
+  shedder.is_latency_sampled_ = true;
+
+  // all in [1ms, 10ms), interpolated by the rank instead of the upper bound
+  add_queries(collector, 100, 1500);
+  shedder.sample_p99_query_latency(collector, query_cnt, p99_latency);
+  ASSERT_EQ(100, query_cnt);
+  ASSERT_EQ(1000 + 9000 * 99 / 100, p99_latency);
+
+  // only the queries of this interval are counted
+  add_queries(collector, 99, 50);
+  add_queries(collector, 1, 50000);
+  shedder.sample_p99_query_latency(collector, query_cnt, p99_latency);
+  ASSERT_EQ(100, query_cnt);
+  ASSERT_EQ(100, p99_latency);
+
+  shedder.sample_p99_query_latency(collector, query_cnt, p99_latency);
+  ASSERT_EQ(0, query_cnt);
+  ASSERT_EQ(0, p99_latency);
+}
+
+TEST_F(TestTenantTabletStatMgr, refresh_query_latency)
+{
+  ObTenantSysLoadShedder shedder;
+  observer::ObRSTTimeCollector collector;
+  const int64_t latency_target = 10000; // 10ms
+  const int64_t min_query_cnt = ObTenantSysLoadShedder::MIN_LATENCY_SAMPLE_QUERY_CNT + 0;
+
+  // the first sample is ignored
+  add_queries(collector, 1000, 50000);
+  shedder.update_latency_shedding_factor(latency_target, &collector);
+  ASSERT_TRUE(shedder.is_latency_sampled_);
+  ASSERT_EQ(1, shedder.get_latency_shedding_factor());
+
+  // doubled while slow, up to the max
+  const int64_t doubled_factors[] = {2, 4, 8, 16, 16};
+  for (int64_t i = 0; i < ARRAYSIZEOF(doubled_factors); ++i) {
+    add_queries(collector, 1000, 50000);
+    shedder.update_latency_shedding_factor(latency_target, &collector);
+    ASSERT_EQ(doubled_factors[i], shedder.get_latency_shedding_factor());
+    ASSERT_TRUE(shedder.p99_query_latency_ > latency_target);
+  }
+
+  // too few queries to tell, decayed
+  add_queries(collector, min_query_cnt - 1, 50000);
+  shedder.update_latency_shedding_factor(latency_target, &collector);
+  ASSERT_EQ(15, shedder.get_latency_shedding_factor());
+
+  // fast, decayed
+  add_queries(collector, 1000, 100);
+  shedder.update_latency_shedding_factor(latency_target, &collector);
+  ASSERT_EQ(14, shedder.get_latency_shedding_factor());
+  ASSERT_TRUE(shedder.p99_query_latency_ <= latency_target);
+
+  // the counts restart from 0 after query_response_time_flush
+  collector.flush();
+  add_queries(collector, min_query_cnt, 50000);
+  shedder.update_latency_shedding_factor(latency_target, &collector);
+  ASSERT_EQ(16, shedder.get_latency_shedding_factor());
+  add_queries(collector, 1000, 100);
+  shedder.update_latency_shedding_factor(latency_target, &collector);
+  ASSERT_EQ(15, shedder.get_latency_shedding_factor());
+
+  // query_response_time_stats turned off, and the first sample after turned on is ignored
+  shedder.update_latency_shedding_factor(latency_target, nullptr);
+  ASSERT_EQ(1, shedder.get_latency_shedding_factor());
+  ASSERT_FALSE(shedder.is_latency_sampled_);
+  add_queries(collector, 1000, 50000);
+  shedder.update_latency_shedding_factor(latency_target, &collector);
+  ASSERT_EQ(1, shedder.get_latency_shedding_factor());
+  add_queries(collector, 1000, 50000);
+  shedder.update_latency_shedding_factor(latency_target, &collector);
+  ASSERT_EQ(2, shedder.get_latency_shedding_factor());
+
+  // no target
+  shedder.update_latency_shedding_factor(0, &collector);
+  ASSERT_EQ(1, shedder.get_latency_shedding_factor());
+}
+
 } // end unittest
 } // end oceanbase
 
@@ -0,0 +1,284 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "lib/oblog/ob_log.h"
+#include "lib/time/ob_time_utility.h"
+#include "share/config/ob_server_config.h"
+#include "storage/tx/ob_gts_source.h"
+#include "storage/tx/ob_gts_rpc.h"
+#include "storage/tx/ob_location_adapter.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace transaction;
+namespace unittest
+{
+
+// Commit latency of getting gts from a remote gts leader through ObGtsSource,
+// with and without _gts_request_batch_interval. The benchmark is disabled by
+// default.
+//
+// ./test_gts_source --gtest_also_run_disabled_tests [duration_s] [rtt_us] [thread_cnt]
+int64_t duration_s = 2;
+int64_t rtt_us = 200;
+int64_t thread_cnt = 32;
+
+static const uint64_t TENANT_ID = 1001;
+
+class MockLocationAdapter : public ObILocationAdapter
+{
+public:
+  explicit MockLocationAdapter(const ObAddr &leader) : leader_(leader) {}
+  int init(share::schema::ObMultiVersionSchemaService *, share::ObLocationService *) { return OB_SUCCESS; }
+  void destroy() {}
+  int nonblock_get_leader(const int64_t, const int64_t, const share::ObLSID &, ObAddr &leader)
+  {
+    leader = leader_;
+    return OB_SUCCESS;
+  }
+  int nonblock_renew(const int64_t, const int64_t, const share::ObLSID &) { return OB_SUCCESS; }
+  int nonblock_get(const int64_t, const int64_t, const share::ObLSID &, share::ObLSLocation &)
+  {
+    return OB_NOT_SUPPORTED;
+  }
+private:
+  ObAddr leader_;
+};
+
+// In-process transport and gts leader: a request is handled by the leader half
+// rtt after it's posted, and the response is delivered to the gts source half
+// rtt later, the same as ObGtsRPCCB does.
+class MockGtsRequestRpc : public ObIGtsRequestRpc
+{
+public:
+  MockGtsRequestRpc() : source_(NULL), last_gts_(0), rpc_cnt_(0), stop_(false) {}
+  int start()
+  {
+    stop_ = false;
+    responder_ = std::thread([this]() { run(); });
+    return OB_SUCCESS;
+  }
+  int stop()
+  {
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      stop_ = true;
+    }
+    cond_.notify_all();
+    return OB_SUCCESS;
+  }
+  int wait()
+  {
+    if (responder_.joinable()) {
+      responder_.join();
+    }
+    return OB_SUCCESS;
+  }
+  void destroy() {}
+  int post(const uint64_t tenant_id, const ObAddr &server, const ObGtsRequest &msg)
+  {
+    UNUSED(tenant_id);
+    UNUSED(server);
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      requests_.push_back(Request{msg.get_srr(), ObTimeUtility::current_time() + rtt_us / 2});
+    }
+    ATOMIC_INC(&rpc_cnt_);
+    cond_.notify_all();
+    return OB_SUCCESS;
+  }
+  // the max gts issued by the leader
+  int64_t get_leader_gts() const { return ATOMIC_LOAD(&last_gts_); }
+  int64_t get_rpc_cnt() const { return ATOMIC_LOAD(&rpc_cnt_); }
+  void set_source(ObGtsSource *source) { source_ = source; }
+private:
+  struct Request
+  {
+    MonotonicTs srr_;
+    int64_t arrive_ts_;
+  };
+  int64_t get_timestamp()
+  {
+    int64_t gts = 0;
+    int64_t last = 0;
+    do {
+      last = ATOMIC_LOAD(&last_gts_);
+      gts = std::max(ObTimeUtility::current_time_ns(), last + 1);
+    } while (!ATOMIC_BCAS(&last_gts_, last, gts));
+    return gts;
+  }
+  void wait_until(const int64_t ts)
+  {
+    while (ObTimeUtility::current_time() < ts) {
+      PAUSE();
+    }
+  }
+  void run()
+  {
+    while (true) {
+      Request req;
+      {
+        std::unique_lock<std::mutex> guard(mutex_);
+        cond_.wait(guard, [this]() { return stop_ || !requests_.empty(); });
+        if (stop_) {
+          break;
+        }
+        req = requests_.front();
+        requests_.pop_front();
+      }
+      wait_until(req.arrive_ts_);
+      const int64_t gts = get_timestamp();
+      wait_until(req.arrive_ts_ + rtt_us / 2);
+      bool update = false;
+      EXPECT_EQ(OB_SUCCESS, source_->update_gts(req.srr_, gts, MonotonicTs::current_time(), update));
+      if (update) {
+        for (int64_t i = 0; i < ObGtsSource::TOTAL_GTS_QUEUE_COUNT; i++) {
+          EXPECT_EQ(OB_SUCCESS, source_->handle_gts_result(TENANT_ID, i));
+        }
+      }
+    }
+  }
+private:
+  ObGtsSource *source_;
+  int64_t last_gts_;
+  int64_t rpc_cnt_;
+  bool stop_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::deque<Request> requests_;
+  std::thread responder_;
+};
+
+class TestGtsSource : public ::testing::Test
+{
+public:
+  struct Result
+  {
+    int64_t request_cnt_;
+    int64_t rpc_cnt_;
+    int64_t p50_us_;
+    int64_t p99_us_;
+    int64_t p999_us_;
+  };
+  // Each thread gets gts for a new transaction in a loop like
+  // ObTransService::get_gts_, and checks the external consistency: the gts is
+  // not less than any gts the leader issued before the request.
+  void run(const char *batch_interval, const int64_t thread_cnt, const int64_t run_us, Result &result)
+  {
+    const ObAddr self(ObAddr::IPV4, "10.0.0.1", 10000);
+    const ObAddr leader(ObAddr::IPV4, "10.0.0.2", 10000);
+    const int64_t WAIT_GTS_US = 10;
+    MockLocationAdapter location_adapter(leader);
+    MockGtsRequestRpc rpc;
+    ObGtsSource source;
+    GCONF._gts_request_batch_interval.set_value(batch_interval);
+    ASSERT_EQ(OB_SUCCESS, source.init(TENANT_ID, self, &rpc, &location_adapter));
+    rpc.set_source(&source);
+    ASSERT_EQ(OB_SUCCESS, rpc.start());
+    std::vector<std::vector<int64_t>> latencies(thread_cnt);
+    std::vector<std::thread> threads;
+    const int64_t end_ts = ObTimeUtility::current_time() + run_us;
+    for (int64_t i = 0; i < thread_cnt; i++) {
+      threads.emplace_back([&, i]() {
+        while (ObTimeUtility::current_time() < end_ts) {
+          const int64_t min_gts = rpc.get_leader_gts();
+          const MonotonicTs stc = MonotonicTs::current_time();
+          int64_t gts = 0;
+          MonotonicTs receive_gts_ts;
+          int ret = OB_SUCCESS;
+          while (OB_EAGAIN == (ret = source.get_gts(stc, NULL, gts, receive_gts_ts))) {
+            ob_usleep(WAIT_GTS_US);
+          }
+          ASSERT_EQ(OB_SUCCESS, ret);
+          ASSERT_LE(min_gts, gts);
+          latencies[i].push_back(MonotonicTs::current_time().mts_ - stc.mts_);
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    rpc.stop();
+    rpc.wait();
+    std::vector<int64_t> all;
+    for (int64_t i = 0; i < thread_cnt; i++) {
+      all.insert(all.end(), latencies[i].begin(), latencies[i].end());
+    }
+    std::sort(all.begin(), all.end());
+    ASSERT_FALSE(all.empty());
+    result.request_cnt_ = all.size();
+    result.rpc_cnt_ = rpc.get_rpc_cnt();
+    result.p50_us_ = all[all.size() / 2];
+    result.p99_us_ = all[all.size() * 99 / 100];
+    result.p999_us_ = all[all.size() * 999 / 1000];
+  }
+};
+
+TEST_F(TestGtsSource, batch_gts_request_consistent)
+{
+  const int64_t THREAD_CNT = 8;
+  const int64_t RUN_US = 500 * 1000;
+  Result result;
+  // run() checks every gts is not older than the leader gts before the request
+  run("0us", THREAD_CNT, RUN_US, result);
+  ASSERT_GT(result.request_cnt_, 0);
+  ASSERT_GT(result.rpc_cnt_, 0);
+  // requests arriving while an rpc sent within the interval is on road share one later rpc
+  run("200us", THREAD_CNT, RUN_US, result);
+  ASSERT_GT(result.request_cnt_, 0);
+  ASSERT_GT(result.rpc_cnt_, 0);
+  ASSERT_LT(result.rpc_cnt_, result.request_cnt_);
+  GCONF._gts_request_batch_interval.set_value("0us");
+}
+
+TEST_F(TestGtsSource, DISABLED_batch_gts_request)
+{
+  const char *batch_intervals[] = {"0us", "50us", "200us"};
+  for (int64_t i = 0; i < ARRAYSIZEOF(batch_intervals); i++) {
+    Result result;
+    run(batch_intervals[i], thread_cnt, duration_s * 1000 * 1000, result);
+    fprintf(stdout, "batch_interval=%6s rtt=%ldus threads=%ld requests/s=%8ld rpc/s=%8ld "
+            "p50=%6ldus p99=%6ldus p999=%6ldus\n",
+            batch_intervals[i], rtt_us, thread_cnt, result.request_cnt_ / duration_s,
+            result.rpc_cnt_ / duration_s, result.p50_us_, result.p99_us_, result.p999_us_);
+  }
+  GCONF._gts_request_batch_interval.set_value("0us");
+}
+
+} // namespace unittest
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_file_name("test_gts_source.log", true);
+  OB_LOGGER.set_log_level("WARN");
+  // gtest flags are removed from argv here
+  ::testing::InitGoogleTest(&argc, argv);
+  if (argc > 1) {
+    oceanbase::unittest::duration_s = strtol(argv[1], NULL, 10);
+  }
+  if (argc > 2) {
+    oceanbase::unittest::rtt_us = strtol(argv[2], NULL, 10);
+  }
+  if (argc > 3) {
+    oceanbase::unittest::thread_cnt = strtol(argv[3], NULL, 10);
+  }
+  return RUN_ALL_TESTS();
+}
@@ -12,8 +12,11 @@
 
 #include "share/ob_light_hashmap.h"
 #include <gtest/gtest.h>
+#include <thread>
+#include <vector>
 #include "share/ob_errno.h"
 #include "lib/oblog/ob_log.h"
+#include "lib/time/ob_time_utility.h"
 #include "storage/tx/ob_trans_define.h"
 
 namespace oceanbase
@@ -40,6 +43,10 @@ public :
 const char *TestObTrans::LOCAL_IP = "127.0.0.1";
 const int64_t TIME_OUT = 1;
 
+// ./test_ob_trans_hashmap --gtest_also_run_disabled_tests [duration_s] [thread_cnt]
+int64_t duration_s = 2;
+int64_t thread_cnt = 16;
+
 class ObTransTestValue : public share::ObLightHashLink<ObTransTestValue>
 {
 public:
@@ -206,6 +213,90 @@ TEST_F(TestObTrans, hashmap_init_invalid)
   EXPECT_EQ(0, map.count());
 }
 
+// Throughput of creating and erasing ctxs in a map shaped like ObLSTxCtxMap
+// from many threads, with and without a background scanner iterating the map
+// like checkpoint, gc and virtual table scans do. It's a benchmark, so it's
+// disabled by default.
+typedef share::ObLightHashMap<ObTransID, ObTransTestValue, ObTransTestValueAlloc,
+                              common::SpinRWLock, 1 << 14> TestCtxMap;
+
+class ScanFunctor
+{
+public:
+  ScanFunctor() : cnt_(0) {}
+  bool operator() (ObTransTestValue *val)
+  {
+    UNUSED(val);
+    cnt_++;
+    return true;
+  }
+  int64_t cnt_;
+};
+
+TEST_F(TestObTrans, DISABLED_hashmap_create_erase_contention)
+{
+  TRANS_LOG(INFO, "called", "func", test_info_->name());
+  // keep some ctxs alive per thread, so the scanner always has work to do
+  const int64_t LIVE_CTX_CNT = 256;
+  OB_LOGGER.set_log_level("WARN");
+  for (int64_t with_scanner = 0; with_scanner <= 1; with_scanner++) {
+    TestCtxMap *map = new TestCtxMap();
+    ASSERT_EQ(OB_SUCCESS, map->init(lib::ObMemAttr(OB_SERVER_TENANT_ID, "TestObTrans")));
+    int64_t op_cnt = 0;
+    int64_t scan_cnt = 0;
+    bool stop = false;
+    std::vector<std::thread> threads;
+    const int64_t end_ts = ObTimeUtility::current_time() + duration_s * 1000 * 1000;
+    for (int64_t i = 0; i < thread_cnt; i++) {
+      threads.emplace_back([&, i]() {
+        std::vector<ObTransID> live_ids(LIVE_CTX_CNT);
+        int64_t seq = 0;
+        int64_t local_op_cnt = 0;
+        while (ObTimeUtility::current_time() < end_ts) {
+          for (int64_t j = 0; j < 1000; j++, seq++) {
+            ObTransID &id = live_ids[seq % LIVE_CTX_CNT];
+            ObTransTestValue *val = NULL;
+            if (id.is_valid()) {
+              ASSERT_EQ(OB_SUCCESS, map->get(id, val));
+              ASSERT_EQ(OB_SUCCESS, map->del(id, val));
+              map->revert(val);
+            }
+            id = ObTransID((i + 1) << 40 | (seq + 1));
+            ASSERT_EQ(OB_SUCCESS, map->alloc_value(val));
+            ASSERT_EQ(OB_SUCCESS, val->init(id));
+            ASSERT_EQ(OB_SUCCESS, map->insert_and_get(id, val, NULL));
+            map->revert(val);
+          }
+          local_op_cnt += 1000;
+        }
+        ATOMIC_AAF(&op_cnt, local_op_cnt);
+      });
+    }
+    std::thread scanner;
+    if (with_scanner) {
+      scanner = std::thread([&]() {
+        while (!ATOMIC_LOAD(&stop)) {
+          ScanFunctor fn;
+          EXPECT_EQ(OB_SUCCESS, map->for_each(fn));
+          scan_cnt++;
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    ATOMIC_STORE(&stop, true);
+    if (scanner.joinable()) {
+      scanner.join();
+    }
+    EXPECT_EQ(thread_cnt * LIVE_CTX_CNT, map->count());
+    fprintf(stdout, "threads=%ld scanner=%ld create_erase/s=%10ld scans/s=%6ld\n",
+            thread_cnt, with_scanner, op_cnt / duration_s, scan_cnt / duration_s);
+    delete map;
+  }
+  OB_LOGGER.set_log_level("INFO");
+}
+
 }//end of unittest
 }//end of oceanbase
 
@@ -218,7 +309,14 @@ int main(int argc, char **argv)
   ObLogger &logger = ObLogger::get_logger();
   logger.set_file_name("test_ob_trans_hashmap.log", true);
   logger.set_log_level(OB_LOG_LEVEL_INFO);
+  // gtest flags are removed from argv here
   testing::InitGoogleTest(&argc, argv);
+  if (argc > 1) {
+    oceanbase::unittest::duration_s = strtol(argv[1], NULL, 10);
+  }
+  if (argc > 2) {
+    oceanbase::unittest::thread_cnt = strtol(argv[2], NULL, 10);
+  }
   ret = RUN_ALL_TESTS();
   return ret;
 }
@@ -681,6 +681,43 @@ TEST_F(ObTestRedoFill, parallel_logging_fill_from_all_list_ALL_FILLED_OTHERS_REM
   EXPECT_EQ(mdo_.fill_ctx_.list_log_epoch_arr_[2], INT64_MAX);
 }
 
+TEST_F(ObTestRedoFill, parallel_logging_get_log_guard_HELP_MIN_EPOCH_LIST)
+{
+  set_parallel_logging(true);
+  // 4 list
+  extend_callback_lists_(3);
+  EXPECT_CALL(mdo_, get_logging_list_count()).Times(AtLeast(1)).WillRepeatedly(Return(4));
+  EXPECT_CALL(mdo_, get_log_epoch(_))
+    .Times(AtLeast(1))
+    .WillRepeatedly(Invoke([](int i){
+      int64_t epochs[] = {100,99,98,99};
+      return epochs[i];
+    }));
+  transaction::ObTxSEQ write_seq(1000, 3);
+  ObTxCallbackList *min_epoch_list = callback_mgr_.get_callback_list_(2, false);
+  {
+    // the min_epoch list has little pending, leave it to its writer
+    ObCallbackListLogGuard log_guard;
+    int list_idx = -1;
+    EXPECT_EQ(OB_EAGAIN, callback_mgr_.get_log_guard(write_seq, log_guard, list_idx));
+    EXPECT_EQ(list_idx, -1);
+  }
+  {
+    // the min_epoch list has enough pending, help to flush it
+    min_epoch_list->data_size_ = GCONF._private_buffer_size + 1;
+    ObCallbackListLogGuard log_guard;
+    int list_idx = -1;
+    EXPECT_EQ(OB_EAGAIN, callback_mgr_.get_log_guard(write_seq, log_guard, list_idx));
+    EXPECT_EQ(list_idx, 2);
+    EXPECT_TRUE(NULL == min_epoch_list->try_lock_log());
+  }
+  // the log lock is released with the guard
+  common::ObByteLock *log_lock = min_epoch_list->try_lock_log();
+  EXPECT_TRUE(NULL != log_lock);
+  log_lock->unlock();
+  min_epoch_list->data_size_ = 0;
+}
+
 TEST_F(ObTestRedoFill, parallel_logging_fill_from_one_list_OTHERS_IS_EMPTY)
 {
   set_parallel_logging(true);
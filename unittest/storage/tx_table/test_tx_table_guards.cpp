@@ -226,6 +226,35 @@ TEST_F(TestTxTableGuards, check_on_dest_and_src_3) {
   EXPECT_EQ(src_tx_data.state_, state);
 }
 
+TEST_F(TestTxTableGuards, mini_cache) {
+  ObTxDataMiniCache mini_cache;
+  ObTxCommitData tx_data;
+  ObTxCommitData cached;
+  // tx data of interleaved transactions stay in the cache of one thread
+  for (int64_t i = 1; i <= ObTxDataMiniCache::TX_DATA_MINI_LRU_WAY_CNT; i++) {
+    tx_data.reset();
+    tx_data.tx_id_ = ObTransID(i);
+    tx_data.state_ = ObTxData::COMMIT;
+    tx_data.commit_version_.convert_from_ts(i);
+    mini_cache.set(tx_data);
+  }
+  for (int64_t i = ObTxDataMiniCache::TX_DATA_MINI_LRU_WAY_CNT; i >= 1; i--) {
+    ASSERT_EQ(OB_SUCCESS, mini_cache.get(ObTransID(i), cached));
+    ASSERT_EQ(ObTransID(i), cached.tx_id_);
+    ASSERT_EQ(i, cached.commit_version_.convert_to_ts());
+  }
+  ASSERT_EQ(OB_TRANS_CTX_NOT_EXIST, mini_cache.get(ObTransID(), cached));
+
+  // the oldest one is replaced
+  tx_data.tx_id_ = ObTransID(100);
+  mini_cache.set(tx_data);
+  ASSERT_EQ(OB_TRANS_CTX_NOT_EXIST, mini_cache.get(ObTransID(1), cached));
+  ASSERT_EQ(OB_SUCCESS, mini_cache.get(ObTransID(2), cached));
+  ASSERT_EQ(OB_SUCCESS, mini_cache.get(ObTransID(100), cached));
+
+  mini_cache.reset();
+  ASSERT_EQ(OB_TRANS_CTX_NOT_EXIST, mini_cache.get(ObTransID(100), cached));
+}
 
 } // namespace unittest
 } // namespace oceanbase